@@ -63,6 +63,12 @@ static TerrainManager*  g_sim_terrain;
  GVarStr_A<100>           app_language            ("app_language",            "Language",                  "English");
  GVarStr_A<50>            app_locale              ("app_locale",              "Language Short",            "en");
  GVarPod_A<bool>          app_multithread         ("app_multithread",         "Multi-threading",           true);
+ GVarPod_A<int>           app_render_cpu          ("app_render_cpu",          "Render CPU",                -1);    // Reserved for the main thread, -1 = none. Linux only, like the settings below
+ GVarStr_A<100>           app_worker_cpus         ("app_worker_cpus",         "Worker CPUs",               "");    // Physics/flexbody pool, e.g. "2-7"; empty = any
+ GVarPod_A<int>           app_worker_nice         ("app_worker_nice",         "Worker Priority",           0);     // Nice value, 0 = inherit
+ GVarStr_A<100>           app_sim_thread_cpus     ("app_sim_thread_cpus",     "Sim Thread CPUs",           "");
+ GVarPod_A<int>           app_sim_thread_nice     ("app_sim_thread_nice",     "Sim Thread Priority",       0);
+ GVarStr_A<100>           app_net_thread_cpus     ("app_net_thread_cpus",     "Network Thread CPUs",       "");
  GVarStr_AP<50>           app_screenshot_format   ("app_screenshot_format",   "Screenshot Format",         "jpg",                   "jpg");
 
 // Simulation
@@ -98,10 +104,13 @@ static TerrainManager*  g_sim_terrain;
  GVarStr_A<100>           diag_preset_vehicle     ("diag_preset_vehicle",     "Preselected Truck",         "");
  GVarStr_A<100>           diag_preset_veh_config  ("diag_preset_veh_config",  "Preselected TruckConfig",   "");
  GVarPod_A<bool>          diag_preset_veh_enter   ("diag_preset_veh_enter",   "Enter Preselected Truck",   false);
+ GVarStr_A<300>           diag_perf_scenario      ("diag_perf_scenario",      nullptr,                     "");    // Command line only; see PerfHarness.h
  GVarPod_A<bool>          diag_log_console_echo   ("diag_log_console_echo",   "Enable Ingame Console",     false);
  GVarPod_A<bool>          diag_log_beam_break     ("diag_log_beam_break",     "Beam Break Debug",          false);
  GVarPod_A<bool>          diag_log_beam_deform    ("diag_log_beam_deform",    "Beam Deform Debug",         false);
  GVarPod_A<bool>          diag_log_beam_trigger   ("diag_log_beam_trigger",   "Trigger Debug",             false);
+ GVarPod_A<int>           diag_log_rate_limit     ("diag_log_rate_limit",     "Log Rate Limit",            100);   // Messages per second per category, 0 = unlimited
+ GVarPod_A<int>           diag_actor_mem_warn     ("diag_actor_mem_warn",     "Actor Memory Warning",      0);     // MiB per actor, 0 = off
  GVarPod_A<bool>          diag_dof_effect         ("diag_dof_effect",         "DOFDebug",                  false);
  GVarStr_AP<300>          diag_extra_resource_dir ("diag_extra_resource_dir", "resourceIncludePath",       "",                     "");
 
@@ -128,6 +137,12 @@ static TerrainManager*  g_sim_terrain;
  GVarPod_A<int>           io_outgauge_port        ("io_outgauge_port",        "OutGauge Port",             1337);
  GVarPod_A<float>         io_outgauge_delay       ("io_outgauge_delay",       "OutGauge Delay",            10.f);
  GVarPod_A<int>           io_outgauge_id          ("io_outgauge_id",          "OutGauge ID",               0);
+ GVarPod_A<int>           io_telemetry_mode       ("io_telemetry_mode",       "Telemetry Mode",            0); // 0 = disabled, 1 = UDP, 2 = unix socket
+ GVarStr_A<200>           io_telemetry_target     ("io_telemetry_target",     "Telemetry Target",          "127.0.0.1:4444"); // 'host:port' or socket path
+ GVarPod_A<float>         io_telemetry_rate       ("io_telemetry_rate",       "Telemetry Rate",            500.f); // samples per second, up to physics rate
+ GVarStr_A<200>           io_telemetry_nodes      ("io_telemetry_nodes",      "Telemetry Nodes",           ""); // comma separated node numbers
+ GVarStr_A<50>            io_mplatform_ip         ("io_mplatform_ip",         "Motion Platform IP",        "127.0.0.1");
+ GVarPod_A<int>           io_mplatform_port       ("io_mplatform_port",       "Motion Platform Port",      12345);
 
 // Audio
  GVarPod_A<float>         audio_master_volume     ("audio_master_volume",     "Sound Volume",              0);
@@ -655,6 +655,12 @@ extern GVarEnum_AP<AppState>   app_state;
 extern GVarStr_A<100>          app_language;
 extern GVarStr_A<50>           app_locale;
 extern GVarPod_A<bool>         app_multithread;
+extern GVarPod_A<int>          app_render_cpu;
+extern GVarStr_A<100>          app_worker_cpus;
+extern GVarPod_A<int>          app_worker_nice;
+extern GVarStr_A<100>          app_sim_thread_cpus;
+extern GVarPod_A<int>          app_sim_thread_nice;
+extern GVarStr_A<100>          app_net_thread_cpus;
 extern GVarStr_AP<50>          app_screenshot_format;
 
 // Simulation
@@ -690,10 +696,13 @@ extern GVarStr_APS<100>        diag_preset_terrain;
 extern GVarStr_A<100>          diag_preset_vehicle;
 extern GVarStr_A<100>          diag_preset_veh_config;
 extern GVarPod_A<bool>         diag_preset_veh_enter;
+extern GVarStr_A<300>          diag_perf_scenario;
 extern GVarPod_A<bool>         diag_log_console_echo;
 extern GVarPod_A<bool>         diag_log_beam_break;
 extern GVarPod_A<bool>         diag_log_beam_deform;
 extern GVarPod_A<bool>         diag_log_beam_trigger;
+extern GVarPod_A<int>          diag_log_rate_limit;
+extern GVarPod_A<int>          diag_actor_mem_warn;
 extern GVarPod_A<bool>         diag_dof_effect;
 extern GVarStr_AP<300>         diag_extra_resource_dir;
 
@@ -720,6 +729,12 @@ extern GVarStr_A<50>           io_outgauge_ip;
 extern GVarPod_A<int>          io_outgauge_port;
 extern GVarPod_A<float>        io_outgauge_delay;
 extern GVarPod_A<int>          io_outgauge_id;
+extern GVarPod_A<int>          io_telemetry_mode;
+extern GVarStr_A<200>          io_telemetry_target;
+extern GVarPod_A<float>        io_telemetry_rate;
+extern GVarStr_A<200>          io_telemetry_nodes;
+extern GVarStr_A<50>           io_mplatform_ip;
+extern GVarPod_A<int>          io_mplatform_port;
 
 // Audio
 extern GVarPod_A<float>        audio_master_volume;
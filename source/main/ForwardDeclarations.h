@@ -31,10 +31,15 @@
 namespace RoR
 {
     class  ActorManager;
+    class  ActorTemplate;
+    class  ActorState;
+    struct CapsuleSweepResult;
     class  ConfigFile;
     class  Console;
     class  ContentManager;
     class  FlexFactory;
+    class  ForceFeedback;
+    struct ForceFeedbackSample;
     class  GfxActor;
     class  GUIManager;
     struct GuiManagerImpl;
@@ -42,8 +47,11 @@ namespace RoR
     class  MainMenu;
     class  OgreSubsystem;
     struct PlatformUtils;
+    struct RayCastQuery;
+    struct RayCastResult;
     class  RigLoadingProfiler;
     class  SceneMouse;
+    class  SharedMaterialCache;
     class  Skidmark;
     class  SkidmarkConfig;
     struct SkinDef;
@@ -157,7 +165,6 @@ class FlexAirfoil;
 class FlexBody;
 class FlexMesh;
 class FlexObj;
-class ForceFeedback;
 class HDRListener;
 class HeatHaze;
 class HeightFinder;
@@ -176,7 +183,6 @@ class Network;
 class OverlayWrapper;
 class OutProtocol;
 class PointColDetector;
-class PositionStorage;
 class ProceduralManager;
 class RailSegment;
 class RailGroup;
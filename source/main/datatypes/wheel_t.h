@@ -49,8 +49,6 @@ struct wheel_t
     Ogre::Real  wh_radius;
     Ogre::Real  wh_speed;
     Ogre::Real  wh_last_speed;
-    Ogre::Real  wh_avg_speed;
-    Ogre::Real  wh_delta_rotation;    ///< Difference in wheel position
     float       wh_net_rp;
     float       wh_net_rp1;           //<! Networking; triple buffer
     float       wh_net_rp2;           //<! Networking; triple buffer
@@ -62,7 +60,6 @@ struct wheel_t
     // for skidmarks
     Ogre::Vector3 lastContactInner;
     Ogre::Vector3 lastContactOuter;
-    bool firstLock;
     float lastSlip;
     int lastContactType;
     ground_model_t *lastGroundModel;
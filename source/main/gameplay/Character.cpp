@@ -22,6 +22,7 @@
 
 #include "Application.h"
 #include "BeamFactory.h"
+#include "CapsuleSweep.h"
 #include "CameraManager.h"
 #include "Collisions.h"
 #include "InputEngine.h"
@@ -47,6 +48,8 @@ Character::Character(int source, unsigned int streamid, int color_number, bool i
     , m_character_h_speed(2.0f)
     , m_character_v_speed(0.0f)
     , m_color_number(color_number)
+    , m_net_colour_applied(-1)
+    , m_net_label_height(0.f)
     , m_anim_state(0)
     , m_character_scenenode(0)
     , m_hide_own_net_label(BSETTING("HideOwnNetLabel", false))
@@ -174,19 +177,25 @@ void Character::updateLabels()
         info = RoR::Networking::GetLocalUserData();
     }
 
+    this->updateLabels(info);
+#endif //SOCKETW
+}
+
+void Character::updateLabels(RoRnet::UserInfo const& info)
+{
+#ifdef USE_SOCKETW
     m_color_number = info.colournum;
-    this->updateCharacterNetworkColour();
+    if (m_net_colour_applied != m_color_number)
+    {
+        this->updateCharacterNetworkColour();
+        m_net_colour_applied = m_color_number;
+    }
 
     if (String(info.username).empty())
         return;
     m_net_username = tryConvertUTF(info.username);
 
-    if (m_movable_text)
-    {
-        m_movable_text->setCaption(m_net_username);
-    }
-
-    this->ResizePersonNetLabel();
+    this->ResizePersonNetLabel(gEnv->mainCamera->getPosition());
 #endif //SOCKETW
 }
 
@@ -258,16 +267,20 @@ void Character::SetAnimState(std::string mode, float time)
     }
 }
 
+// Collision shape: vertical capsule from above step height (see 'Auto compensate') to the head
+static const float CAPSULE_RADIUS       = 0.2f;
+static const float CAPSULE_BOTTOM       = 0.5f; //!< Segment start above the feet
+static const float CAPSULE_TOP          = 1.6f; //!< Segment end above the feet
+static const float GROUND_PROBE_RADIUS  = 0.05f;
+
+/// @return Height of static collision surface above the feet, looking up to 1m; 0 if none
 float calculate_collision_depth(Vector3 pos)
 {
-    Vector3 query = pos + Vector3::UNIT_Y;
-    while (query.y > pos.y)
-    {
-        if (gEnv->collisions->collisionCorrect(&query, false))
-            break;
-        query.y -= 0.01f;
-    }
-    return query.y - pos.y;
+    const Vector3 start = pos + Vector3::UNIT_Y * (1.0f + GROUND_PROBE_RADIUS);
+    CapsuleSweepResult hit;
+    if (!gEnv->collisions->sweepCapsule(start, start, GROUND_PROBE_RADIUS, -Vector3::UNIT_Y, hit))
+        return 0.0f;
+    return 1.0f - hit.t;
 }
 
 void Character::update(float dt)
@@ -320,16 +333,18 @@ void Character::update(float dt)
             Vector3 h_diff = Vector3(diff.x, 0.0f, diff.z);
             if (depth <= 0.0f || h_diff.squaredLength() > 0.0f)
             {
-                const int numstep = 100;
-                Vector3 base = lastPosition + Vector3::UNIT_Y * 0.5f;
-                for (int i = 1; i < numstep; i++)
+                Vector3 bottom = lastPosition + Vector3::UNIT_Y * CAPSULE_BOTTOM;
+                Vector3 top = lastPosition + Vector3::UNIT_Y * CAPSULE_TOP;
+                CapsuleSweepResult hit;
+                if (gEnv->collisions->sweepCapsule(bottom, top, CAPSULE_RADIUS, diff, hit))
                 {
-                    Vector3 query = base + diff * ((float)i / numstep);
-                    if (gEnv->collisions->collisionCorrect(&query, false))
-                    {
-                        position = lastPosition + diff * ((float)(i - 1) / numstep);;
-                        break;
-                    }
+                    // Stop at the obstacle, then slide along it with the rest of the movement
+                    Vector3 travel = diff * hit.t;
+                    Vector3 rest = diff - travel;
+                    rest -= hit.normal * rest.dotProduct(hit.normal);
+                    CapsuleSweepResult slide;
+                    gEnv->collisions->sweepCapsule(bottom + travel, top + travel, CAPSULE_RADIUS, rest, slide);
+                    position = lastPosition + travel + rest * slide.t;
                 }
             }
         }
@@ -684,24 +699,31 @@ void Character::receiveStreamData(unsigned int& type, int& source, unsigned int&
 #endif
 }
 
-void Character::ResizePersonNetLabel()
+void Character::ResizePersonNetLabel(Vector3 const& cam_pos)
 {
     if (!m_movable_text)
         return;
     if (m_net_username.empty())
         return;
 
-    float camDist = (m_character_scenenode->getPosition() - gEnv->mainCamera->getPosition()).length();
+    float camDist = (m_character_scenenode->getPosition() - cam_pos).length();
     float h = std::max(9.0f, camDist * 1.2f);
 
-    m_movable_text->setCharacterHeight(h);
+    // Both setters rebuild the text geometry, only call them on visible change
+    if (std::abs(h - m_net_label_height) > m_net_label_height * 0.05f)
+    {
+        m_movable_text->setCharacterHeight(h);
+        m_net_label_height = h;
+    }
 
+    UTFString caption = m_net_username;
     if (camDist > 1000.0f)
-        m_movable_text->setCaption(m_net_username + "  (" + TOSTRING((float)(ceil(camDist / 100) / 10.0f)) + " km)");
+        caption = m_net_username + "  (" + TOSTRING((float)(ceil(camDist / 100) / 10.0f)) + " km)";
     else if (camDist > 20.0f && camDist <= 1000.0f)
-        m_movable_text->setCaption(m_net_username + "  (" + TOSTRING((int)camDist) + " m)");
-    else
-        m_movable_text->setCaption(m_net_username);
+        caption = m_net_username + "  (" + TOSTRING((int)camDist) + " m)";
+
+    if (caption != m_movable_text->getCaption())
+        m_movable_text->setCaption(caption);
 }
 
 void Character::SetActorCoupling(bool enabled, Actor* actor /* = nullptr */)
@@ -29,6 +29,8 @@
 #include <string>
 #include <string>
 
+namespace RoRnet { struct UserInfo; }
+
 class Character
 {
 public:
@@ -53,13 +55,14 @@ public:
     void           updateCharacterRotation();
     void           updateMapIcon();
     void           updateLabels();
+    void           updateLabels(RoRnet::UserInfo const& info); //!< Only touches the label and material if something changed
     void           receiveStreamData(unsigned int& type, int& source, unsigned int& streamid, char* buffer);
     void           SetActorCoupling(bool enabled, Actor* actor = nullptr);    
 
 private:
 
     void           AddPersonToSurveyMap();
-    void           ResizePersonNetLabel();
+    void           ResizePersonNetLabel(Ogre::Vector3 const& cam_pos);
     void           ReportError(const char* detail);
     void           SendStreamData();
     void           SendStreamSetup();
@@ -71,6 +74,8 @@ private:
     float            m_character_h_speed;
     float            m_character_v_speed;
     int              m_color_number;
+    int              m_net_colour_applied; //!< Colour number currently set on the material; -1 = none
+    float            m_net_label_height;
     int              m_stream_id;
     int              m_source_id;
     bool             m_can_jump;
@@ -63,10 +63,31 @@ void CharacterFactory::update(float dt)
     gEnv->player->update(dt);
     gEnv->player->updateLabels();
 
+    if (m_remote_characters.empty())
+        return;
+
+#ifdef USE_SOCKETW
+    // Remote characters are driven by network data; update them in one pass with one user list lookup
+    std::vector<RoRnet::UserInfo> users;
+    if (App::mp_state.GetActive() == MpState::CONNECTED)
+    {
+        users = RoR::Networking::GetUserInfos();
+    }
+#endif // USE_SOCKETW
+
     for (auto& c : m_remote_characters)
     {
         c->update(dt);
-        c->updateLabels();
+#ifdef USE_SOCKETW
+        for (RoRnet::UserInfo const& user : users)
+        {
+            if ((int)user.uniqueid == c->getSourceID())
+            {
+                c->updateLabels(user);
+                break;
+            }
+        }
+#endif // USE_SOCKETW
     }
 }
 
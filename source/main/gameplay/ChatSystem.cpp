@@ -66,6 +66,41 @@ Ogre::UTFString GetColouredName(Ogre::UTFString nick, int colour_number)
 #endif // USE_SOCKETW
 }
 
+Ogre::String FormatChatMessage(int kind, Ogre::String const& sender, Ogre::String const& text)
+{
+    const int colour_number = kind >> 8;
+    Ogre::UTFString msg = tryConvertUTF(text.c_str());
+    switch (static_cast<ChatKind>(kind & 0xFF))
+    {
+    case CHAT_PUBLIC:
+        msg = GetColouredName(tryConvertUTF(sender.c_str()), colour_number) + RoR::Color::NormalColour + ": " + msg;
+        break;
+
+    case CHAT_WHISPER:
+        if (sender.empty())
+            msg = RoR::Color::WhisperColour + _L(" [whispered] ") + RoR::Color::NormalColour + msg;
+        else
+            msg = GetColouredName(tryConvertUTF(sender.c_str()), colour_number) + _L(" [whispered] ") + RoR::Color::NormalColour + ": " + msg;
+        break;
+
+    case CHAT_WHISPER_TO:
+    {
+#ifdef USE_SOCKETW
+        Ogre::UTFString local_username = GetColouredName(RoR::Networking::GetUsername(), RoR::Networking::GetUserColor());
+#else
+        Ogre::UTFString local_username;
+#endif // USE_SOCKETW
+        msg = local_username + RoR::Color::WhisperColour + _L(" [whispered to ") + RoR::Color::NormalColour + GetColouredName(tryConvertUTF(sender.c_str()), colour_number)
+            + RoR::Color::WhisperColour + "]" + RoR::Color::NormalColour + ": " + msg;
+        break;
+    }
+
+    default:
+        break;
+    }
+    return msg.asUTF8();
+}
+
 #ifdef USE_SOCKETW
 void ReceiveStreamData(unsigned int type, int source, char* buffer)
 {
@@ -73,6 +108,8 @@ void ReceiveStreamData(unsigned int type, int source, char* buffer)
         return;
 
     Ogre::UTFString msg = tryConvertUTF(buffer);
+    Ogre::String sender_name; // Stored bare; the prefix is added by `FormatChatMessage()`
+    int kind = CHAT_NOTICE;
 
     if (type == MSG2_UTF8_CHAT)
     {
@@ -83,35 +120,33 @@ void ReceiveStreamData(unsigned int type, int source, char* buffer)
         else if (source == RoR::Networking::GetUID())
         {
             // our message bounced back :D
-            Ogre::UTFString local_username = GetColouredName(RoR::Networking::GetUsername(), RoR::Networking::GetUserColor());
-            msg = local_username + RoR::Color::NormalColour + ": " + msg;
+            sender_name = RoR::Networking::GetUsername().asUTF8();
+            kind = MakeChatKind(CHAT_PUBLIC, RoR::Networking::GetUserColor());
         }
         else
         {
             RoRnet::UserInfo user;
             if (RoR::Networking::GetUserInfo(source, user))
             {
-                msg = GetColouredName(user.username, user.colournum) + RoR::Color::NormalColour + ": " + msg;
+                sender_name = user.username;
+                kind = MakeChatKind(CHAT_PUBLIC, user.colournum);
             }
         }
     }
     else if (type == MSG2_UTF8_PRIVCHAT)
     {
-        if (source == -1)
-        {
-            // server said something
-            msg = RoR::Color::WhisperColour + _L(" [whispered] ") + RoR::Color::NormalColour + msg;
-        }
-        else
+        kind = MakeChatKind(CHAT_WHISPER, 0); // server said something, unless the sender is known
+        if (source != -1)
         {
             RoRnet::UserInfo user;
             if (RoR::Networking::GetUserInfo(source, user))
             {
-                msg = GetColouredName(user.username, user.colournum) + _L(" [whispered] ") + RoR::Color::NormalColour + ": " + msg;
+                sender_name = user.username;
+                kind = MakeChatKind(CHAT_WHISPER, user.colournum);
             }
         }
     }
-    RoR::App::GetGuiManager()->pushMessageChatBox(msg);
+    RoR::App::GetGuiManager()->pushMessageChatBox(msg, kind, source, sender_name);
 }
 #endif // USE_SOCKETW
 
@@ -133,7 +168,7 @@ void SendChat(Ogre::UTFString chatline)
 #endif // USE_SOCKETW
 }
 
-void SendPrivateChat(int target_uid, Ogre::UTFString chatline, Ogre::UTFString target_username)
+void SendPrivateChat(int target_uid, Ogre::UTFString chatline, Ogre::UTFString target_username, int target_colour)
 {
 #ifdef USE_SOCKETW
     char buffer[RORNET_MAX_MESSAGE_LENGTH] = {0};
@@ -154,14 +189,13 @@ void SendPrivateChat(int target_uid, Ogre::UTFString chatline, Ogre::UTFString t
         RoRnet::UserInfo user;
         if (RoR::Networking::GetUserInfo(target_uid, user))
         {
-            target_username = GetColouredName(user.username, user.colournum);
+            target_username = user.username;
+            target_colour = user.colournum;
         }
     }
 
     // add local visual
-    Ogre::UTFString local_username = GetColouredName(RoR::Networking::GetUsername(), RoR::Networking::GetUserColor());
-    Ogre::UTFString nmsg = local_username + RoR::Color::WhisperColour + _L(" [whispered to ") + RoR::Color::NormalColour + target_username + RoR::Color::WhisperColour + "]" + RoR::Color::NormalColour + ": " + chatline;
-    RoR::App::GetGuiManager()->pushMessageChatBox(nmsg);
+    RoR::App::GetGuiManager()->pushMessageChatBox(chatline, MakeChatKind(CHAT_WHISPER_TO, target_colour), target_uid, target_username.asUTF8());
 #endif // USE_SOCKETW
 }
 
@@ -189,7 +223,7 @@ void SendPrivateChat(Ogre::UTFString target_username, Ogre::UTFString chatline)
         return;
     }
 
-    SendPrivateChat(target_user.uniqueid, chatline, GetColouredName(target_user.username, target_user.colournum));
+    SendPrivateChat(target_user.uniqueid, chatline, target_user.username, target_user.colournum);
 #endif // USE_SOCKETW
 }
 
@@ -39,5 +39,20 @@ void HandleStreamData(std::vector<RoR::Networking::recv_packet_t> packet);
 
 Ogre::UTFString GetColouredName(Ogre::UTFString nick, int colour_number);
 
+/// Chat lines are kept bare in the message history, so searching it only matches what was said;
+/// the coloured name prefix is added by `FormatChatMessage()` when displayed.
+enum ChatKind
+{
+    CHAT_NOTICE,     //!< From the game or server, displayed as is
+    CHAT_PUBLIC,     //!< Said by the sender
+    CHAT_WHISPER,    //!< Whispered by the sender; no sender = the server
+    CHAT_WHISPER_TO, //!< Whispered by the local user; the sender fields hold the recipient
+};
+
+/// For `MessageHistory::Message::kind`: the chat kind and the sender's colour number
+inline int MakeChatKind(ChatKind kind, int colour_number) { return static_cast<int>(kind) | (colour_number << 8); }
+
+Ogre::String FormatChatMessage(int kind, Ogre::String const& sender, Ogre::String const& text); //!< UTF-8 with colour codes
+
 } // namespace Chatsystem
 } // namespace RoR
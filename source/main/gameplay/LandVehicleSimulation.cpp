@@ -353,7 +353,7 @@ void LandVehicleSimulation::UpdateVehicle(Actor* vehicle, float seconds_since_la
                 case SimGearboxMode::MANUAL_RANGES: msg = "Fully Manual: stick shift with ranges";
                     break;
                 }
-                RoR::App::GetConsole()->putMessage(RoR::Console::CONSOLE_MSGTYPE_INFO, RoR::Console::CONSOLE_SYSTEM_NOTICE, _L(msg), "cog.png", 3000);
+                RoR::App::GetConsole()->putMessage(RoR::Console::CONSOLE_MSGTYPE_INFO, RoR::Console::CONSOLE_SYSTEM_NOTICE, LanguageEngine::getSingleton().lookUp(msg), "cog.png", 3000);
                 RoR::App::GetGuiManager()->PushNotification("Gearbox Mode:", msg);
             }
 
@@ -36,7 +36,6 @@ OutProtocol::OutProtocol(void) :
     delay(0.1f)
     , id(0)
     , mode(0)
-    , sockfd(-1)
     , timer(0)
     , working(false)
 {
@@ -52,67 +51,24 @@ OutProtocol::OutProtocol(void) :
 
 OutProtocol::~OutProtocol(void)
 {
-    if (sockfd != 0)
-    {
-#ifdef USE_SOCKETW
-#   if _WIN32
-        closesocket(sockfd);
-#   else
-        close( sockfd );
-#   endif
-#endif // USE_SOCKETW
-        sockfd = 0;
-    }
 }
 
 void OutProtocol::startup()
 {
-#if defined(_WIN32) && defined(USE_SOCKETW)
-    SWBaseSocket::SWBaseError error;
-
-    // startup winsock
-    WSADATA wsd;
-    if (WSAStartup(MAKEWORD(2, 2), &wsd) != 0)
-    {
-        LOG("[RoR|OutGauge] Error starting up winsock. OutGauge disabled.");
-        return;
-    }
-
-    // open a new socket
-    if ((sockfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
-    {
-        LOG(String("[RoR|OutGauge] Error creating socket for OutGauge: ").append(strerror(errno)));
-        return;
-    }
-
-    // get the IP of the remote side, this function is compatible with windows 2000
-    hostent* remoteHost = gethostbyname(App::io_outgauge_ip.GetActive());
-    char* ip = inet_ntoa(*(struct in_addr *)*remoteHost->h_addr_list);
-
-    // init socket data
-    struct sockaddr_in sendaddr;
-    memset(&sendaddr, 0, sizeof(sendaddr));
-    sendaddr.sin_family = AF_INET;
-    sendaddr.sin_addr.s_addr = inet_addr(ip);
-    sendaddr.sin_port = htons(App::io_outgauge_port.GetActive());
-
-    // connect
-    if (connect(sockfd, (struct sockaddr *) &sendaddr, sizeof(sendaddr)) == SOCKET_ERROR)
+    socket = std::unique_ptr<UdpTelemetrySink>(new UdpTelemetrySink());
+    if (!socket->Connect(App::io_outgauge_ip.GetActive(), App::io_outgauge_port.GetActive()))
     {
-        LOG(String("[RoR|OutGauge] Error connecting socket for OutGauge: ").append(strerror(errno)));
+        LOG("[RoR|OutGauge] Error connecting socket for OutGauge. OutGauge disabled.");
+        socket.reset();
         return;
     }
 
     LOG("[RoR|OutGauge] Connected successfully");
     working = true;
-#else
-    // TODO: fix linux
-#endif // _WIN32
 }
 
 bool OutProtocol::Update(float dt, Actor* truck)
 {
-#if defined(_WIN32) && defined(USE_SOCKETW)
     if (!working)
     {
         return false;
@@ -203,11 +159,7 @@ bool OutProtocol::Update(float dt, Actor* truck)
         }
     }
     // send the package
-    send(sockfd, (const char*)&gd, sizeof(gd), NULL);
+    socket->Send((const char*)&gd, sizeof(gd));
 
     return true;
-#else
-    // TODO: fix linux
-	return false;
-#endif // _WIN32
 }
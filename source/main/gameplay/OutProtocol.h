@@ -26,13 +26,11 @@
 
 #include "RoRPrerequisites.h"
 #include "Singleton.h"
+#include "TelemetryStream.h"
 
-#ifdef USE_SOCKETW
-#include "SocketW.h"
-#endif //USE_SOCKETW
+#include <memory>
 
 #ifdef _WIN32
-#include <Ws2tcpip.h>
 #define PACK( __Declaration__ ) __pragma( pack(push, 1) ) __Declaration__ __pragma( pack(pop) )
 #else
 #define PACK( __Declaration__ ) __Declaration__ __attribute__((__packed__))
@@ -53,7 +51,7 @@ private:
     float delay, timer;
     int id;
     int mode;
-    int sockfd;
+    std::unique_ptr<RoR::UdpTelemetrySink> socket;
 
     void startup();
 
@@ -0,0 +1,439 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PerfHarness.h"
+
+#include "Application.h"
+#include "InputEngine.h"
+#include "PlatformUtils.h"
+
+#include <OgreStringConverter.h>
+#include <OgreString.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace RoR;
+
+bool PerfHarness::s_last_run_failed = false;
+
+static const char* SUBSYSTEM_NAMES[] =
+    { "frame", "actors", "physics", "physics_forces", "physics_final", "inter_collisions", "flexbodies", "visuals" };
+static_assert(sizeof(SUBSYSTEM_NAMES) / sizeof(SUBSYSTEM_NAMES[0]) == PerfHarness::NUM_SUBSYSTEMS,
+    "SUBSYSTEM_NAMES must match PerfHarness::Subsystem");
+
+static const char* RECORDED_EVENT_PREFIXES[] = { "TRUCK_", "AIRPLANE_", "BOAT_", "COMMANDS_" };
+
+/// Strips comment and whitespace; @return False if nothing is left
+static bool CleanLine(std::string& line)
+{
+    const size_t comment = line.find_first_of(";#");
+    if (comment != std::string::npos)
+        line.erase(comment);
+    Ogre::StringUtil::trim(line);
+    return !line.empty();
+}
+
+static float Percentile(std::vector<float> const& sorted, float p)
+{
+    if (sorted.empty())
+        return 0.f;
+    const size_t index = static_cast<size_t>(std::ceil(p * sorted.size())) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+PerfHarness::Scope::Scope(PerfHarness* harness, Subsystem subsystem):
+    m_harness(harness),
+    m_subsystem(subsystem)
+{
+    if (m_harness != nullptr)
+        m_start = std::chrono::steady_clock::now();
+}
+
+PerfHarness::Scope::~Scope()
+{
+    if (m_harness != nullptr)
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_harness->AddTime(m_subsystem, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+}
+
+PerfHarness::PerfHarness():
+    m_player_actor(-1),
+    m_tolerance(0.15f),
+    m_tolerance_ms(0.05f),
+    m_frame_dt(1.f / 60.f),
+    m_num_frames(600),
+    m_warmup_frames(60),
+    m_frame(0),
+    m_next_input(0),
+    m_saved_water_waves(-1)
+{
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+        m_frame_ns[i] = 0;
+    s_last_run_failed = true; // Until `Finish()` passes
+}
+
+PerfHarness::~PerfHarness()
+{
+    if (m_saved_water_waves != -1)
+        App::gfx_water_waves.SetActive(m_saved_water_waves != 0);
+}
+
+const char* PerfHarness::GetSubsystemName(int subsystem)
+{
+    return (subsystem >= 0 && subsystem < NUM_SUBSYSTEMS) ? SUBSYSTEM_NAMES[subsystem] : "?";
+}
+
+std::string PerfHarness::ResolvePath(std::string const& filename) const
+{
+    const bool absolute = !filename.empty() && (filename[0] == '/' || filename[0] == '\\' || filename.find(':') != std::string::npos);
+    return (absolute || m_dir.empty()) ? filename : m_dir + PATH_SLASH + filename;
+}
+
+bool PerfHarness::LoadScenario(std::string const& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        RoR::LogFormat("[RoR|PerfHarness] Cannot open scenario '%s'", path.c_str());
+        return false;
+    }
+
+    const size_t slash = path.find_last_of("/\\");
+    m_dir = (slash != std::string::npos) ? path.substr(0, slash) : "";
+    m_name = (slash != std::string::npos) ? path.substr(slash + 1) : path;
+    m_name = m_name.substr(0, m_name.find_last_of('.'));
+
+    std::string inputs_file;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        if (!CleanLine(line))
+            continue;
+
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos)
+        {
+            RoR::LogFormat("[RoR|PerfHarness] %s:%d: Expected 'key = value'", m_name.c_str(), line_number);
+            return false;
+        }
+        std::string key = line.substr(0, eq);
+        std::string value = line.substr(eq + 1);
+        Ogre::StringUtil::trim(key);
+        Ogre::StringUtil::trim(value);
+
+        if      (key == "terrain")   { m_terrain = value; }
+        else if (key == "frames")    { m_num_frames = Ogre::StringConverter::parseInt(value); }
+        else if (key == "warmup")    { m_warmup_frames = Ogre::StringConverter::parseInt(value); }
+        else if (key == "frame_dt")  { m_frame_dt = Ogre::StringConverter::parseReal(value); }
+        else if (key == "enter")     { m_player_actor = Ogre::StringConverter::parseInt(value); }
+        else if (key == "inputs")    { inputs_file = value; }
+        else if (key == "baseline")  { m_baseline_path = this->ResolvePath(value); }
+        else if (key == "results")   { m_results_path = this->ResolvePath(value); }
+        else if (key == "tolerance") { m_tolerance = Ogre::StringConverter::parseReal(value); }
+        else if (key == "tolerance_ms") { m_tolerance_ms = Ogre::StringConverter::parseReal(value); }
+        else if (key == "water_waves")
+        {
+            if (m_saved_water_waves == -1)
+                m_saved_water_waves = App::gfx_water_waves.GetActive() ? 1 : 0;
+            App::gfx_water_waves.SetActive(Ogre::StringConverter::parseBool(value));
+        }
+        else if (key == "actor")
+        {
+            Ogre::StringVector args = Ogre::StringUtil::split(value, ";");
+            ActorSpawn spawn;
+            spawn.offset = Ogre::Vector3::ZERO;
+            spawn.heading = 0.f;
+            if (args.size() < 1 || args.size() > 4 ||
+                (args.size() > 1 && std::sscanf(args[1].c_str(), " %f , %f , %f", &spawn.offset.x, &spawn.offset.y, &spawn.offset.z) != 3))
+            {
+                RoR::LogFormat("[RoR|PerfHarness] %s:%d: Expected 'actor = file; x, y, z; heading; config'", m_name.c_str(), line_number);
+                return false;
+            }
+            for (std::string& arg : args)
+                Ogre::StringUtil::trim(arg);
+            spawn.filename = args[0];
+            spawn.heading = (args.size() > 2) ? Ogre::StringConverter::parseReal(args[2]) : 0.f;
+            spawn.config = (args.size() > 3) ? args[3] : "";
+            m_actors.push_back(spawn);
+        }
+        else
+        {
+            RoR::LogFormat("[RoR|PerfHarness] %s:%d: Unknown key '%s'", m_name.c_str(), line_number, key.c_str());
+            return false;
+        }
+    }
+
+    if (m_terrain.empty() || m_num_frames <= 0 || m_frame_dt <= 0.f)
+    {
+        RoR::LogFormat("[RoR|PerfHarness] %s: 'terrain' is required, 'frames' and 'frame_dt' must be positive", m_name.c_str());
+        return false;
+    }
+    if (m_player_actor >= static_cast<int>(m_actors.size()))
+    {
+        RoR::LogFormat("[RoR|PerfHarness] %s: 'enter' refers to actor %d, only %d defined",
+            m_name.c_str(), m_player_actor, static_cast<int>(m_actors.size()));
+        return false;
+    }
+    if (!inputs_file.empty() && !this->LoadInputScript(this->ResolvePath(inputs_file)))
+    {
+        return false;
+    }
+
+    if (m_results_path.empty())
+    {
+        std::string dir = std::string(App::sys_user_dir.GetActive()) + PATH_SLASH + "perf";
+        if (!FolderExists(dir))
+            CreateFolder(dir);
+        m_results_path = dir + PATH_SLASH + m_name + ".results.csv";
+    }
+
+    RoR::LogFormat("[RoR|PerfHarness] Loaded scenario '%s': terrain '%s', %d actors, %d input events, %d+%d frames",
+        m_name.c_str(), m_terrain.c_str(), static_cast<int>(m_actors.size()), static_cast<int>(m_inputs.size()),
+        m_warmup_frames, m_num_frames);
+    return true;
+}
+
+bool PerfHarness::LoadInputScript(std::string const& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        RoR::LogFormat("[RoR|PerfHarness] Cannot open input script '%s'", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        if (!CleanLine(line))
+            continue;
+
+        InputEvent ev;
+        char name[100] = {};
+        if (std::sscanf(line.c_str(), "%f %99s %f", &ev.time, name, &ev.value) != 3 ||
+            (ev.event_id = InputEngine::resolveEventName(name)) == -1)
+        {
+            RoR::LogFormat("[RoR|PerfHarness] %s:%d: Expected '<time> <EVENT_NAME> <value>'", path.c_str(), line_number);
+            return false;
+        }
+        m_inputs.push_back(ev);
+    }
+
+    std::stable_sort(m_inputs.begin(), m_inputs.end(),
+        [](InputEvent const& a, InputEvent const& b) { return a.time < b.time; });
+    return true;
+}
+
+void PerfHarness::Start()
+{
+    App::GetInputEngine()->setInputInjection(true);
+    m_frame = 0;
+    m_next_input = 0;
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+    {
+        m_samples[i].clear();
+        m_samples[i].reserve(m_num_frames);
+    }
+}
+
+void PerfHarness::BeginFrame(float sim_time)
+{
+    for (; m_next_input < m_inputs.size() && m_inputs[m_next_input].time <= sim_time; m_next_input++)
+    {
+        App::GetInputEngine()->setInjectedEventValue(m_inputs[m_next_input].event_id, m_inputs[m_next_input].value);
+    }
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+        m_frame_ns[i] = 0;
+}
+
+void PerfHarness::EndFrame()
+{
+    if (m_frame++ < m_warmup_frames)
+        return;
+
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+        m_samples[i].push_back(static_cast<float>(m_frame_ns[i].load() / 1.0e6));
+}
+
+bool PerfHarness::ReadResults(std::string const& path, Result out[NUM_SUBSYSTEMS], bool out_valid[NUM_SUBSYSTEMS])
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!CleanLine(line))
+            continue;
+        Ogre::StringVector cols = Ogre::StringUtil::split(line, ",");
+        if (cols.size() != 4)
+            continue;
+        for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+        {
+            if (cols[0] == SUBSYSTEM_NAMES[i])
+            {
+                out[i].mean_ms = Ogre::StringConverter::parseReal(cols[1]);
+                out[i].p50_ms  = Ogre::StringConverter::parseReal(cols[2]);
+                out[i].p99_ms  = Ogre::StringConverter::parseReal(cols[3]);
+                out_valid[i] = true;
+            }
+        }
+    }
+    return true;
+}
+
+bool PerfHarness::Finish()
+{
+    App::GetInputEngine()->setInputInjection(false);
+
+    Result results[NUM_SUBSYSTEMS];
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+    {
+        std::vector<float>& samples = m_samples[i];
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (float s : samples)
+            sum += s;
+        results[i].mean_ms = samples.empty() ? 0.f : static_cast<float>(sum / samples.size());
+        results[i].p50_ms  = Percentile(samples, 0.5f);
+        results[i].p99_ms  = Percentile(samples, 0.99f);
+    }
+
+    std::ofstream file(m_results_path);
+    if (file.is_open())
+    {
+        file << "# RoR perf harness: " << m_name << ", " << m_num_frames << " frames, dt " << m_frame_dt << "\n";
+        file << "subsystem,mean_ms,p50_ms,p99_ms\n";
+        for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+        {
+            char buf[200];
+            std::snprintf(buf, sizeof(buf), "%s,%.4f,%.4f,%.4f\n",
+                SUBSYSTEM_NAMES[i], results[i].mean_ms, results[i].p50_ms, results[i].p99_ms);
+            file << buf;
+        }
+        RoR::LogFormat("[RoR|PerfHarness] Results written to '%s'", m_results_path.c_str());
+    }
+    else
+    {
+        RoR::LogFormat("[RoR|PerfHarness] Cannot write results to '%s'", m_results_path.c_str());
+    }
+
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+    {
+        RoR::LogFormat("[RoR|PerfHarness] %-16s mean %8.3f ms, p50 %8.3f ms, p99 %8.3f ms",
+            SUBSYSTEM_NAMES[i], results[i].mean_ms, results[i].p50_ms, results[i].p99_ms);
+    }
+
+    if (m_baseline_path.empty())
+    {
+        s_last_run_failed = false;
+        return true;
+    }
+
+    Result baseline[NUM_SUBSYSTEMS] = {};
+    bool baseline_valid[NUM_SUBSYSTEMS] = {};
+    if (!this->ReadResults(m_baseline_path, baseline, baseline_valid))
+    {
+        RoR::LogFormat("[RoR|PerfHarness] No baseline '%s' yet, results not compared", m_baseline_path.c_str());
+        s_last_run_failed = false;
+        return true;
+    }
+
+    bool passed = true;
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++)
+    {
+        if (!baseline_valid[i])
+            continue;
+
+        const float mean_limit = baseline[i].mean_ms * (1.f + m_tolerance) + m_tolerance_ms;
+        const float p99_limit  = baseline[i].p99_ms  * (1.f + m_tolerance) + m_tolerance_ms;
+        if (results[i].mean_ms > mean_limit || results[i].p99_ms > p99_limit)
+        {
+            RoR::LogFormat("[RoR|PerfHarness] Regression in '%s': mean %.3f ms (limit %.3f), p99 %.3f ms (limit %.3f)",
+                SUBSYSTEM_NAMES[i], results[i].mean_ms, mean_limit, results[i].p99_ms, p99_limit);
+            passed = false;
+        }
+    }
+
+    RoR::LogFormat("[RoR|PerfHarness] %s: scenario '%s' against baseline '%s' (tolerance %.0f%%)",
+        passed ? "PASS" : "FAIL", m_name.c_str(), m_baseline_path.c_str(), m_tolerance * 100.f);
+    s_last_run_failed = !passed;
+    return passed;
+}
+
+bool PerfInputRecorder::Start(std::string const& path, float sim_time)
+{
+    this->Stop();
+    m_file.open(path);
+    if (!m_file.is_open())
+        return false;
+
+    m_event_ids.clear();
+    for (int i = 0; i < EV_MODE_LAST; i++)
+    {
+        const std::string name = InputEngine::eventIDToName(i);
+        for (const char* prefix : RECORDED_EVENT_PREFIXES)
+        {
+            if (name.compare(0, std::strlen(prefix), prefix) == 0)
+            {
+                m_event_ids.push_back(i);
+                break;
+            }
+        }
+    }
+    m_last_values.assign(m_event_ids.size(), 0.f);
+    m_start_time = sim_time;
+
+    m_file << "; RoR perf harness input script - <time> <EVENT_NAME> <value>\n";
+    return true;
+}
+
+void PerfInputRecorder::Stop()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+void PerfInputRecorder::RecordFrame(float sim_time)
+{
+    if (!m_file.is_open())
+        return;
+
+    char buf[200];
+    for (size_t i = 0; i < m_event_ids.size(); i++)
+    {
+        const float value = App::GetInputEngine()->getEventValue(m_event_ids[i]);
+        if (value != m_last_values[i])
+        {
+            std::snprintf(buf, sizeof(buf), "%.4f %s %.3f\n", sim_time - m_start_time,
+                InputEngine::eventIDToName(m_event_ids[i]).c_str(), value);
+            m_file << buf;
+            m_last_values[i] = value;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Repeatable performance measurement of the simulation (`-perftest <scenario>`).
+///
+/// A scenario file names a terrain and a set of actors, the number of frames to simulate
+/// and an input script recorded with the `perfrecord` console command. The game runs the
+/// frames with a fixed timestep and without rendering, then writes per-subsystem frame
+/// timings (mean, p50, p99) as CSV and compares them against a stored baseline.
+///
+/// Scenario format, one `key = value` per line, `;` or `#` starts a comment:
+///   terrain   = simple2.terrn2
+///   actor     = semi.truck; 0, 0.5, 10; 90; [config]   (offset from character spawn; heading in degrees)
+///   enter     = 0                                     (index of actor to drive, -1 = none)
+///   inputs    = crash.inputs                          (relative to the scenario file)
+///   frames    = 600
+///   warmup    = 60
+///   frame_dt  = 0.0166667
+///   baseline  = crash.baseline.csv
+///   tolerance = 0.15                                  (allowed relative slowdown)
+///   results   = crash.results.csv
+///   water_waves = true                                (overrides RoR.cfg for this run)
+
+#pragma once
+
+#include <OgreVector3.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+class PerfHarness
+{
+public:
+    enum Subsystem
+    {
+        FRAME,            //!< Whole simulation frame, excluding rendering
+        ACTORS,           //!< `ActorManager::UpdateActors()` on main thread
+        PHYSICS,          //!< `ActorManager::UpdatePhysicsSimulation()`, all sub-steps
+        PHYSICS_FORCES,   //!< Force computation and intra-actor collisions
+        PHYSICS_FINAL,    //!< `Actor::calcForcesEulerFinal()`
+        INTER_COLLISIONS, //!< Inter-actor collisions
+        FLEXBODIES,       //!< Flexbody tasks and hardware buffer updates
+        VISUALS,          //!< `ActorManager::UpdateActorVisuals()`
+
+        NUM_SUBSYSTEMS
+    };
+
+    struct ActorSpawn
+    {
+        std::string   filename;
+        std::string   config;
+        Ogre::Vector3 offset;  //!< From character spawn; Y is above terrain
+        float         heading; //!< Degrees
+    };
+
+    /// Adds the duration of the enclosing block to the current frame. No-op if harness is null.
+    class Scope
+    {
+    public:
+        Scope(PerfHarness* harness, Subsystem subsystem);
+        ~Scope();
+
+    private:
+        PerfHarness*                          m_harness;
+        Subsystem                             m_subsystem;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    PerfHarness();
+    ~PerfHarness();
+
+    bool LoadScenario(std::string const& path);
+
+    std::string const&             GetTerrain() const           { return m_terrain; }
+    std::vector<ActorSpawn> const& GetActors() const            { return m_actors; }
+    int                            GetPlayerActorIndex() const  { return m_player_actor; }
+    float                          GetFrameDt() const           { return m_frame_dt; }
+    bool                           IsFinished() const           { return m_frame >= m_warmup_frames + m_num_frames; }
+
+    void Start();                    //!< Switches the InputEngine to scripted input.
+    void BeginFrame(float sim_time); //!< Applies input events up to `sim_time`.
+    void EndFrame();                 //!< Stores the frame's timings (after warmup).
+    bool Finish();                   //!< Writes results, compares to baseline. @return False on regression.
+
+    void AddTime(Subsystem subsystem, int64_t ns) { m_frame_ns[subsystem].fetch_add(ns, std::memory_order_relaxed); }
+
+    static const char* GetSubsystemName(int subsystem);
+    static bool        LastRunFailed() { return s_last_run_failed; } //!< For the process exit code
+
+private:
+    struct InputEvent
+    {
+        float time;
+        int   event_id;
+        float value;
+    };
+
+    struct Result
+    {
+        float mean_ms;
+        float p50_ms;
+        float p99_ms;
+    };
+
+    bool LoadInputScript(std::string const& path);
+    bool ReadResults(std::string const& path, Result out[NUM_SUBSYSTEMS], bool out_valid[NUM_SUBSYSTEMS]);
+    std::string ResolvePath(std::string const& filename) const;
+
+    std::string              m_name;
+    std::string              m_dir;
+    std::string              m_terrain;
+    std::vector<ActorSpawn>  m_actors;
+    int                      m_player_actor;
+    std::string              m_baseline_path;
+    std::string              m_results_path;
+    float                    m_tolerance;     //!< Relative
+    float                    m_tolerance_ms;  //!< Absolute; keeps tiny subsystems from failing on noise
+    float                    m_frame_dt;
+    int                      m_num_frames;
+    int                      m_warmup_frames;
+    int                      m_frame;
+    std::vector<InputEvent>  m_inputs;        //!< Sorted by time
+    size_t                   m_next_input;
+    std::atomic<int64_t>     m_frame_ns[NUM_SUBSYSTEMS];
+    std::vector<float>       m_samples[NUM_SUBSYSTEMS]; //!< Milliseconds per frame
+    int                      m_saved_water_waves; //!< Value to restore, -1 = not overriden
+
+    static bool              s_last_run_failed;
+};
+
+/// Writes player input into an input script for `PerfHarness`. Only vehicle controls are recorded.
+class PerfInputRecorder
+{
+public:
+    PerfInputRecorder(): m_start_time(0.f) {}
+
+    bool Start(std::string const& path, float sim_time);
+    void Stop();
+    bool IsRecording() const { return m_file.is_open(); }
+    void RecordFrame(float sim_time); //!< Call after input was captured.
+
+private:
+    std::ofstream      m_file;
+    std::vector<int>   m_event_ids;
+    std::vector<float> m_last_values;
+    float              m_start_time;
+};
+
+} // namespace RoR
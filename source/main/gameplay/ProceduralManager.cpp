@@ -22,6 +22,7 @@
 
 #include "Application.h"
 #include "Road2.h"
+#include "ThreadPool.h"
 
 using namespace Ogre;
 
@@ -56,32 +57,69 @@ std::vector<ProceduralObject>& ProceduralManager::getObjects()
     return pObjects;
 }
 
-int ProceduralManager::updateObject(ProceduralObject& po)
+void ProceduralManager::syncRoad(ProceduralObject& po)
 {
-    if (po.loadingState == 1 && po.road)
+    if (po.points.empty())
+    {
         deleteObject(po);
-    // create new road2 object
-    po.road = new Road2(objectcounter++);;
+        return;
+    }
+
+    if (!po.road)
+    {
+        // create new road2 object
+        po.road = new Road2(objectcounter++);
+    }
 
-    std::vector<ProceduralPoint>::iterator it;
-    for (it = po.points.begin(); it != po.points.end(); it++)
+    for (size_t i = 0; i < po.points.size(); i++)
     {
-        ProceduralPoint pp = *it;
-        po.road->addBlock(pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
+        ProceduralPoint const& pp = po.points[i];
+        if (i < po.road->getNumBlocks())
+            po.road->setBlock(i, pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
+        else
+            po.road->addBlock(pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
     }
-    po.road->finish();
+    po.road->truncateBlocks(po.points.size());
 
     po.loadingState = 1;
+}
+
+int ProceduralManager::updateObject(ProceduralObject& po)
+{
+    syncRoad(po);
+    if (po.road)
+        po.road->finish();
     return 0;
 }
 
 int ProceduralManager::updateAllObjects()
 {
     LOG(" *** ProceduralManager::updateAllObjects");
-    std::vector<ProceduralObject>::iterator it;
-    for (it = pObjects.begin(); it != pObjects.end(); it++)
+    for (ProceduralObject& po : pObjects)
+    {
+        syncRoad(po);
+    }
+
+    // Geometry only depends on the road's own points and the terrain - compute in parallel.
+    // Collision tris and meshes are registered serially by `finish()`.
+    if (gEnv->threadPool)
     {
-        updateObject(*it);
+        std::vector<std::function<void()>> tasks;
+        for (ProceduralObject& po : pObjects)
+        {
+            if (po.road)
+            {
+                Road2* road = po.road;
+                tasks.push_back([road]() { road->computeSegments(); });
+            }
+        }
+        gEnv->threadPool->Parallelize(tasks);
+    }
+
+    for (ProceduralObject& po : pObjects)
+    {
+        if (po.road)
+            po.road->finish();
     }
     return 0;
 }
@@ -99,7 +137,6 @@ int ProceduralManager::deleteAllObjects()
 
 int ProceduralManager::addObject(ProceduralObject& po)
 {
-    updateObject(po);
     pObjects.push_back(po);
     return 0;
 }
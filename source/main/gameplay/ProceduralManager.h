@@ -60,13 +60,19 @@ public:
     ProceduralManager();
     ~ProceduralManager();
 
+    /// Registers the object; its road is built by the next `updateAllObjects()`.
     int addObject(ProceduralObject& po);
 
+    /// Builds/updates all roads; geometry of independent roads is computed in parallel.
     int updateAllObjects();
+    /// Rebuilds only the road segments affected by changed points.
     int updateObject(ProceduralObject& po);
 
     int deleteAllObjects();
     int deleteObject(ProceduralObject& po);
 
     std::vector<ProceduralObject>& getObjects();
+
+private:
+    void syncRoad(ProceduralObject& po); //!< Creates the road or updates its blocks; doesn't build anything
 };
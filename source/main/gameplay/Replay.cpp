@@ -131,6 +131,13 @@ void* Replay::getWriteBuffer(int type)
     return ptr;
 }
 
+size_t Replay::getMemoryUsage() const
+{
+    if (!nodes)
+        return 0;
+    return numFrames * (numNodes * sizeof(node_simple_t) + numBeams * sizeof(beam_simple_t) + sizeof(unsigned long));
+}
+
 void Replay::writeDone()
 {
     if (outOfMemory)
@@ -57,6 +57,7 @@ public:
     bool getVisible();
 
     bool isValid() { return !outOfMemory; };
+    size_t getMemoryUsage() const; //!< Frame buffers in bytes; 0 until the first frame is recorded
 protected:
     Ogre::Timer* replayTimer;
     int numNodes;
@@ -146,6 +146,7 @@ SimController::SimController(RoR::ForceFeedback* ff, RoR::SkidmarkConfig* skid_c
     m_advanced_vehicle_repair_timer(0.f),
     m_actor_info_gui_visible(false)
 {
+    m_actor_manager.SetForceFeedback(m_force_feedback);
 }
 
 void SimController::UpdateForceFeedback(float dt)
@@ -160,37 +161,12 @@ void SimController::UpdateForceFeedback(float dt)
         return;
     }
 
-    if (m_player_actor && m_player_actor->ar_driveable == TRUCK)
-    {
-        int ar_camera_node_pos = 0;
-        int ar_camera_node_dir = 0;
-        int ar_camera_node_roll = 0;
-
-        // TODO: <rant> Per-frame validity check? How about on-spawn check? </rant>
-        // If the camera node is invalid, the FF should be disabled right away, not try to fall back to node0
-        // TODO: Check cam. nodes once on spawn! They never change --> no reason to repeat the check. ~only_a_ptr, 06/2017
-                // ~only_a_ptr, 02/2017
-        if (m_player_actor->IsNodeIdValid(m_player_actor->ar_camera_node_pos[0]))
-            ar_camera_node_pos = m_player_actor->ar_camera_node_pos[0];
-        if (m_player_actor->IsNodeIdValid(m_player_actor->ar_camera_node_dir[0]))
-            ar_camera_node_dir = m_player_actor->ar_camera_node_dir[0];
-        if (m_player_actor->IsNodeIdValid(m_player_actor->ar_camera_node_roll[0]))
-            ar_camera_node_roll = m_player_actor->ar_camera_node_roll[0];
-
-        Vector3 udir = m_player_actor->ar_nodes[ar_camera_node_pos].RelPosition - m_player_actor->ar_nodes[ar_camera_node_dir].RelPosition;
-        Vector3 uroll = m_player_actor->ar_nodes[ar_camera_node_pos].RelPosition - m_player_actor->ar_nodes[ar_camera_node_roll].RelPosition;
-
-        udir.normalise();
-        uroll.normalise();
-
-        Ogre::Vector3 ff_vehicle = m_player_actor->GetFFbBodyForces();
-        m_force_feedback->SetForces(
-            -ff_vehicle.dotProduct(uroll) / 10000.0,
-             ff_vehicle.dotProduct(udir)  / 10000.0,
-            m_player_actor->ar_wheel_speed,
-            m_player_actor->ar_hydro_dir_command,
-            m_player_actor->GetFFbHydroForces());
-    }
+    // Forces are sampled by `ActorManager` every physics step; the device is only driven from this thread (OIS isn't thread-safe).
+    ForceFeedback::Gains gains;
+    gains.master    = App::io_ffb_master_gain.GetActive();
+    gains.stress    = App::io_ffb_stress_gain.GetActive();
+    gains.centering = App::io_ffb_center_gain.GetActive();
+    m_force_feedback->UpdateDevice(gains);
 }
 
 void SimController::StartRaceTimer()
@@ -403,52 +379,52 @@ bool SimController::UpdateInputEvents(float dt)
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS01, 0.5f))
         {
             slot = 0;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS02, 0.5f))
         {
             slot = 1;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS03, 0.5f))
         {
             slot = 2;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS04, 0.5f))
         {
             slot = 3;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS05, 0.5f))
         {
             slot = 4;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS06, 0.5f))
         {
             slot = 5;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS07, 0.5f))
         {
             slot = 6;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS08, 0.5f))
         {
             slot = 7;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS09, 0.5f))
         {
             slot = 8;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_SAVE_POS10, 0.5f))
         {
             slot = 9;
-            res = m_player_actor->savePosition(slot);
+            res = m_player_actor->SaveState(slot);
         };
         if (slot != -1 && !res)
         {
@@ -466,52 +442,52 @@ bool SimController::UpdateInputEvents(float dt)
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS01, 0.5f))
             {
                 slot = 0;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS02, 0.5f))
             {
                 slot = 1;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS03, 0.5f))
             {
                 slot = 2;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS04, 0.5f))
             {
                 slot = 3;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS05, 0.5f))
             {
                 slot = 4;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS06, 0.5f))
             {
                 slot = 5;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS07, 0.5f))
             {
                 slot = 6;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS08, 0.5f))
             {
                 slot = 7;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS09, 0.5f))
             {
                 slot = 8;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_TRUCK_LOAD_POS10, 0.5f))
             {
                 slot = 9;
-                res = m_player_actor->loadPosition(slot);
+                res = m_player_actor->RestoreState(slot);
             };
             if (slot != -1 && res == 0)
             {
@@ -1599,6 +1575,7 @@ bool SimController::frameStarted(const FrameEvent& evt)
 #endif //SOCKETW
 
     RoR::App::GetInputEngine()->Capture();
+    m_perf_recorder.RecordFrame(static_cast<float>(m_time));
     App::GetGuiManager()->NewImGuiFrame(dt);
     const bool is_altkey_pressed =  App::GetInputEngine()->isKeyDown(OIS::KeyCode::KC_LMENU) || App::GetInputEngine()->isKeyDown(OIS::KeyCode::KC_RMENU);
     auto s = App::sim_state.GetActive();
@@ -1607,6 +1584,7 @@ bool SimController::frameStarted(const FrameEvent& evt)
     //
     if ((simRUNNING(s) || simEDITOR(s)) && !simPAUSED(s))
     {
+        PerfHarness::Scope perf_scope(m_perf_harness.get(), PerfHarness::FLEXBODIES);
         m_actor_manager.UpdateFlexbodiesPrepare(); // Pushes all flexbody tasks into the thread pool 
     }
 
@@ -1798,9 +1776,15 @@ bool SimController::frameStarted(const FrameEvent& evt)
 
         if (!simPAUSED(s))
         {
-            m_actor_manager.JoinFlexbodyTasks(); // Waits until all flexbody tasks are finished
+            {
+                PerfHarness::Scope perf_scope(m_perf_harness.get(), PerfHarness::FLEXBODIES);
+                m_actor_manager.JoinFlexbodyTasks(); // Waits until all flexbody tasks are finished
+            }
             m_actor_manager.UpdateActors(m_player_actor, dt);
-            m_actor_manager.UpdateFlexbodiesFinal(); // Updates the harware buffers
+            {
+                PerfHarness::Scope perf_scope(m_perf_harness.get(), PerfHarness::FLEXBODIES);
+                m_actor_manager.UpdateFlexbodiesFinal(); // Updates the harware buffers
+            }
         }
 
         if (simRUNNING(s) && (App::sim_state.GetPending() == SimState::PAUSED))
@@ -2007,6 +1991,7 @@ void SimController::ReloadPlayerActor()
             new_actor->ar_nodes[i].initial_pos = m_player_actor->ar_nodes[i].initial_pos;
             new_actor->ar_origin               = m_player_actor->ar_origin;
         }
+        new_actor->CaptureInitialState();
     }
 
     // TODO:
@@ -2121,6 +2106,11 @@ void SimController::CleanupAfterSimulation()
         App::SetSimTerrain(nullptr);
     }
 
+    if (BSETTING("Unmount Mods After Use", false))
+    {
+        App::GetCacheSystem()->unmountAllArchives();
+    }
+
     App::DeleteSceneMouse();
     App::GetGuiManager()->GetTeleport()->Reset();
 
@@ -2178,7 +2168,18 @@ bool SimController::SetupGameplayLoop()
     // Loading map
     // ============================================================================
 
-    if (!App::diag_preset_terrain.IsActiveEmpty())
+    if (!App::diag_perf_scenario.IsActiveEmpty())
+    {
+        m_perf_harness = std::unique_ptr<PerfHarness>(new PerfHarness());
+        if (!m_perf_harness->LoadScenario(App::diag_perf_scenario.GetActive()))
+        {
+            App::GetGuiManager()->SetVisible_LoadingWindow(false);
+            return false;
+        }
+        App::sim_terrain_name.SetPending(m_perf_harness->GetTerrain().c_str());
+        m_actor_manager.SetPerfHarness(m_perf_harness.get());
+    }
+    else if (!App::diag_preset_terrain.IsActiveEmpty())
     {
         App::sim_terrain_name.SetPending(App::diag_preset_terrain.GetActive());
         App::diag_preset_terrain.SetActive("");
@@ -2252,6 +2253,11 @@ bool SimController::SetupGameplayLoop()
         }
     }
 
+    if (m_perf_harness)
+    {
+        this->SpawnPerfScenarioActors();
+    }
+
     App::GetSimTerrain()->LoadPredefinedActors();
 
     // ========================================================================
@@ -2307,6 +2313,11 @@ void SimController::EnterGameplayLoop()
 
     /* LOOP */
 
+    if (m_perf_harness)
+    {
+        this->RunPerfScenario();
+    }
+
     while (App::app_state.GetPending() == AppState::SIMULATION)
     {
         startTime = RoR::App::GetOgreSubsystem()->GetTimer()->getMilliseconds();
@@ -2355,6 +2366,79 @@ void SimController::EnterGameplayLoop()
     gEnv->cameraManager->DisableDepthOfFieldEffect(); // TODO: de-globalize the CameraManager
 }
 
+void SimController::SpawnPerfScenarioActors()
+{
+    std::vector<Actor*> actors;
+    for (PerfHarness::ActorSpawn const& spawn: m_perf_harness->GetActors())
+    {
+        Vector3 pos = gEnv->player->getPosition() + Vector3(spawn.offset.x, 0.f, spawn.offset.z);
+        pos.y = App::GetSimTerrain()->GetHeightAt(pos.x, pos.z) + spawn.offset.y;
+        Quaternion rot = Quaternion(Degree(spawn.heading), Vector3::UNIT_Y);
+        const std::vector<Ogre::String> actor_config = std::vector<Ogre::String>(1, spawn.config);
+
+        Actor* actor = m_actor_manager.CreateLocalActor(pos, rot, spawn.filename, -1, nullptr, &actor_config);
+        if (actor == nullptr)
+        {
+            RoR::LogFormat("[RoR|PerfHarness] Failed to spawn '%s'", spawn.filename.c_str());
+        }
+        else if (actor->ar_engine)
+        {
+            actor->ar_engine->StartEngine();
+        }
+        actors.push_back(actor);
+    }
+
+    const int player_index = m_perf_harness->GetPlayerActorIndex();
+    if (player_index >= 0 && actors[player_index] != nullptr)
+    {
+        this->SetPlayerActor(actors[player_index]);
+    }
+}
+
+void SimController::RunPerfScenario()
+{
+    RoR::LogFormat("[RoR|PerfHarness] Running scenario (rendering disabled)");
+
+    Ogre::FrameEvent evt;
+    evt.timeSinceLastEvent = m_perf_harness->GetFrameDt();
+    evt.timeSinceLastFrame = m_perf_harness->GetFrameDt();
+
+    m_perf_harness->Start();
+    while (!m_perf_harness->IsFinished() && App::app_state.GetPending() == AppState::SIMULATION)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_LINUX
+        RoRWindowEventUtilities::messagePump();
+#endif
+        m_perf_harness->BeginFrame(static_cast<float>(m_time));
+        {
+            PerfHarness::Scope perf_scope(m_perf_harness.get(), PerfHarness::FRAME);
+            this->frameStarted(evt);
+            m_actor_manager.SyncWithSimThread(); // Count the physics in the frame which started it
+        }
+        m_perf_harness->EndFrame();
+    }
+    m_perf_harness->Finish();
+
+    m_actor_manager.SetPerfHarness(nullptr);
+    App::app_state.SetPending(AppState::SHUTDOWN);
+}
+
+bool SimController::StartInputRecording(std::string const& filename)
+{
+    if (filename.empty() || filename.find_first_of("/\\:") != std::string::npos || filename.find("..") != std::string::npos)
+        return false;
+
+    std::string dir = std::string(App::sys_user_dir.GetActive()) + PATH_SLASH + "perf";
+    if (!FolderExists(dir))
+        CreateFolder(dir);
+    return m_perf_recorder.Start(dir + PATH_SLASH + filename, static_cast<float>(m_time));
+}
+
+void SimController::StopInputRecording()
+{
+    m_perf_recorder.Stop();
+}
+
 void SimController::SetPlayerActor(Actor* actor)
 {
     m_prev_player_actor = m_player_actor;
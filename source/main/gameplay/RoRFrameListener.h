@@ -25,10 +25,12 @@
 #include "CharacterFactory.h"
 #include "EnvironmentMap.h"
 #include "ForceFeedback.h"
+#include "PerfHarness.h"
 #include "RoRPrerequisites.h"
 
 
 #include <Ogre.h>
+#include <memory>
 
 /// The simulation controller object
 /// It's lifetime is tied to single gameplay session. When user returns to main menu, it's destroyed.
@@ -72,6 +74,10 @@ public:
     void   TeleportPlayer        (RoR::Terrn2Telepoint* telepoint); // Teleport UI
     void   TeleportPlayerXZ      (float x, float y); // Teleport UI
 
+    // Performance harness (see PerfHarness.h)
+    bool   StartInputRecording   (std::string const& filename); ///< Console command `perfrecord`; file goes to user dir 'perf/'
+    void   StopInputRecording    ();
+
     /// @return True if everything was prepared OK and simulation may start.
     bool   SetupGameplayLoop     ();
     void   EnterGameplayLoop     ();
@@ -95,6 +101,8 @@ private:
     void   FinalizeActorSpawning   (Actor* local_actor, Actor* previous_actor);
     void   HideGUI                 (bool hidden);
     void   CleanupAfterSimulation  (); /// Unloads all data
+    void   SpawnPerfScenarioActors (); /// `-perftest` mode only
+    void   RunPerfScenario         (); /// `-perftest` mode only; replaces the rendering loop
 
     Actor*                   m_player_actor;           //!< Actor (vehicle or machine) mounted and controlled by player
     Actor*                   m_prev_player_actor;      //!< Previous actor (vehicle or machine) mounted and controlled by player
@@ -135,4 +143,7 @@ private:
 
     Ogre::Vector3            m_reload_pos;
     Ogre::Quaternion         m_reload_dir;
+
+    std::unique_ptr<RoR::PerfHarness> m_perf_harness; //!< Only in `-perftest` mode
+    RoR::PerfInputRecorder   m_perf_recorder;
 };
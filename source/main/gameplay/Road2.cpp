@@ -27,11 +27,10 @@
 using namespace Ogre;
 
 Road2::Road2(int id) :
-    first(true)
-    , mid(id)
+    mainsub(0)
     , snode(0)
-    , tricount(0)
-    , vertexcount(0)
+    , mid(id)
+    , m_mesh_dirty(false)
 {
     msh.setNull();
 }
@@ -47,33 +46,159 @@ Road2::~Road2()
         MeshManager::getSingleton().remove(msh->getName());
         msh.setNull();
     }
-    if (registeredCollTris.size() > 0)
+    for (Segment& seg : m_segments)
+    {
+        this->unregisterCollision(seg);
+    }
+}
+
+void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
+{
+    Block block;
+    block.pos = pos;
+    block.rot = rot;
+    block.type = type;
+    block.width = width;
+    block.bwidth = bwidth;
+    block.bheight = bheight;
+    block.pillartype = pillartype;
+
+    m_blocks.push_back(block);
+    m_resolved_blocks.push_back(block);
+    m_block_dirty.push_back(true);
+    if (m_segments.empty())
+        m_segments.push_back(Segment()); // end cap
+    m_segments.insert(m_segments.end() - 1, Segment());
+
+    this->markBlockDirty(m_blocks.size() - 1);
+}
+
+void Road2::setBlock(size_t index, Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
+{
+    Block& block = m_blocks[index];
+    if (block.pos == pos && block.rot == rot && block.type == type && block.width == width &&
+        block.bwidth == bwidth && block.bheight == bheight && block.pillartype == pillartype)
+    {
+        return;
+    }
+
+    block.pos = pos;
+    block.rot = rot;
+    block.type = type;
+    block.width = width;
+    block.bwidth = bwidth;
+    block.bheight = bheight;
+    block.pillartype = pillartype;
+    this->markBlockDirty(index);
+}
+
+void Road2::truncateBlocks(size_t count)
+{
+    if (count >= m_blocks.size())
+        return;
+
+    // Segments from `count` on go away, except one which becomes the new end cap
+    for (size_t i = count; i < m_segments.size(); i++)
+    {
+        this->unregisterCollision(m_segments[i]);
+    }
+    m_blocks.resize(count);
+    m_resolved_blocks.resize(count);
+    m_block_dirty.resize(count);
+    m_segments.resize((count > 0) ? count + 1 : 0);
+    if (count > 0)
+        m_segments[count].geometry_dirty = true;
+    m_mesh_dirty = true;
+}
+
+void Road2::markBlockDirty(size_t index)
+{
+    // A segment connects its block with the previous one; the next segment (or end cap) depends on it too.
+    m_block_dirty[index] = true;
+    m_segments[index].geometry_dirty = true;
+    m_segments[index + 1].geometry_dirty = true;
+}
+
+void Road2::computeSegments()
+{
+    for (size_t i = 0; i < m_blocks.size(); i++)
+    {
+        if (m_block_dirty[i])
+        {
+            m_resolved_blocks[i] = this->resolveBlock(m_blocks[i], i == 0);
+            m_block_dirty[i] = false;
+        }
+    }
+
+    for (size_t i = 0; i < m_segments.size(); i++)
     {
-        for (int number : registeredCollTris)
+        if (m_segments[i].geometry_dirty)
         {
-            gEnv->collisions->removeCollisionTri(number);
+            this->computeSegment(i);
         }
     }
 }
 
 void Road2::finish()
 {
-    Vector3 pts[8];
-    computePoints(pts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
-    addQuad(pts[7], pts[6], pts[5], pts[4], TEXFIT_NONE, true, lastpos, lastpos, lastwidth);
-    addQuad(pts[7], pts[4], pts[3], pts[0], TEXFIT_NONE, true, lastpos, lastpos, lastwidth);
-    addQuad(pts[3], pts[2], pts[1], pts[0], TEXFIT_NONE, true, lastpos, lastpos, lastwidth);
-
-    createMesh();
-    String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
-    String mesh_name = String("RoadSystem-").append(StringConverter::toString(mid));
-    Entity* ec = gEnv->sceneManager->createEntity(entity_name, mesh_name);
-    snode = gEnv->sceneManager->getRootSceneNode()->createChildSceneNode();
-    snode->attachObject(ec);
+    if (m_blocks.empty())
+        return;
+
+    this->computeSegments();
+
+    for (Segment& seg : m_segments)
+    {
+        if (!seg.collision_dirty)
+            continue;
+
+        this->unregisterCollision(seg);
+        for (CollisionTri const& tri : seg.coll_tris)
+        {
+            int triID = gEnv->collisions->addCollisionTri(tri.a, tri.b, tri.c, tri.gm);
+            if (triID >= 0)
+                seg.registered_coll_tris.push_back(triID);
+        }
+        seg.collision_dirty = false;
+    }
+
+    if (m_mesh_dirty)
+    {
+        this->createMesh();
+        m_mesh_dirty = false;
+    }
+
+    if (!snode)
+    {
+        String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
+        String mesh_name = String("RoadSystem-").append(StringConverter::toString(mid));
+        Entity* ec = gEnv->sceneManager->createEntity(entity_name, mesh_name);
+        snode = gEnv->sceneManager->getRootSceneNode()->createChildSceneNode();
+        snode->attachObject(ec);
+    }
+    else
+    {
+        snode->needUpdate();
+    }
 }
 
-void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
+void Road2::unregisterCollision(Segment& seg)
 {
+    for (int number : seg.registered_coll_tris)
+    {
+        gEnv->collisions->removeCollisionTri(number);
+    }
+    seg.registered_coll_tris.clear();
+}
+
+Road2::Block Road2::resolveBlock(Block const& block, bool first)
+{
+    Vector3 pos = block.pos;
+    Quaternion rot = block.rot;
+    int type = block.type;
+    float width = block.width;
+    float bwidth = block.bwidth;
+    float bheight = block.bheight;
+
     if (type == ROAD_AUTOMATIC)
     {
         width = 10.0;
@@ -101,53 +226,107 @@ void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float b
             bheight = 0.5;
         };
     }
-    if (!first)
+    if (!first && type == ROAD_MONORAIL)
+        pos.y += 2;
+
+    Block resolved = block;
+    resolved.pos = pos;
+    resolved.type = type;
+    resolved.width = width;
+    resolved.bwidth = bwidth;
+    resolved.bheight = bheight;
+    return resolved;
+}
+
+void Road2::computeSegment(size_t index)
+{
+    Segment& seg = m_segments[index];
+    seg.vertices.clear();
+    seg.normals.clear();
+    seg.texcoords.clear();
+    seg.indices.clear();
+    seg.coll_tris.clear();
+
+    if (index == m_blocks.size())
     {
+        // end cap
+        Block const& last = m_resolved_blocks.back();
         Vector3 pts[8];
-        Vector3 lpts[8];
-        if (type == ROAD_MONORAIL)
-            pos.y += 2;
+        computePoints(pts, last.pos, last.rot, last.type, last.width, last.bwidth, last.bheight);
+        addQuad(seg, pts[7], pts[6], pts[5], pts[4], TEXFIT_NONE, true, last.pos, last.pos, last.width);
+        addQuad(seg, pts[7], pts[4], pts[3], pts[0], TEXFIT_NONE, true, last.pos, last.pos, last.width);
+        addQuad(seg, pts[3], pts[2], pts[1], pts[0], TEXFIT_NONE, true, last.pos, last.pos, last.width);
+    }
+    else if (index == 0)
+    {
+        // start cap
+        Block const& b = m_resolved_blocks[0];
+        Vector3 pts[8];
+        computePoints(pts, b.pos, b.rot, b.type, b.width, b.bwidth, b.bheight);
+        addQuad(seg, pts[0], pts[1], pts[2], pts[3], TEXFIT_NONE, true, b.pos, b.pos, b.width);
+        addQuad(seg, pts[0], pts[3], pts[4], pts[7], TEXFIT_NONE, true, b.pos, b.pos, b.width);
+        addQuad(seg, pts[4], pts[5], pts[6], pts[7], TEXFIT_NONE, true, b.pos, b.pos, b.width);
+    }
+    else
+    {
+        Block const& b = m_resolved_blocks[index];
+        Block const& l = m_resolved_blocks[index - 1];
+        Vector3 pos = b.pos;
+        Quaternion rot = b.rot;
+        int type = b.type;
+        float width = b.width;
+        float bwidth = b.bwidth;
+        float bheight = b.bheight;
+        int pillartype = b.pillartype;
+        Vector3 lastpos = l.pos;
+        Quaternion lastrot = l.rot;
+        int lasttype = l.type;
+        float lastwidth = l.width;
+        float lastbwidth = l.bwidth;
+        float lastbheight = l.bheight;
 
+        Vector3 pts[8];
+        Vector3 lpts[8];
         computePoints(pts, pos, rot, type, width, bwidth, bheight);
         computePoints(lpts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
 
         //tarmac
         if (type == ROAD_MONORAIL)
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TEXFIT_CONCRETETOP, true, pos, lastpos, width);
+            addQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TEXFIT_CONCRETETOP, true, pos, lastpos, width);
         else
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TEXFIT_ROAD, true, pos, lastpos, width);
+            addQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TEXFIT_ROAD, true, pos, lastpos, width);
 
         if (type == ROAD_FLAT && lasttype == ROAD_FLAT)
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TEXFIT_ROADS3, true, pos, lastpos, width);
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TEXFIT_ROADS2, true, pos, lastpos, width);
+            addQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TEXFIT_ROADS3, true, pos, lastpos, width);
+            addQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TEXFIT_ROADS2, true, pos, lastpos, width);
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TEXFIT_ROADS4, true, pos, lastpos, width);
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TEXFIT_ROADS1, true, pos, lastpos, width);
+            addQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TEXFIT_ROADS4, true, pos, lastpos, width);
+            addQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TEXFIT_ROADS1, true, pos, lastpos, width);
         }
         else
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TEXFIT_CONCRETEWALLI, true, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TEXFIT_CONCRETEWALLI, true, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
+            addQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TEXFIT_CONCRETEWALLI, true, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
+            addQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TEXFIT_CONCRETEWALLI, true, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TEXFIT_CONCRETETOP, true, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TEXFIT_CONCRETETOP, true, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
+            addQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TEXFIT_CONCRETETOP, true, pos, lastpos, width, (type == ROAD_FLAT || type == ROAD_LEFT));
+            addQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TEXFIT_CONCRETETOP, true, pos, lastpos, width, !(type == ROAD_FLAT || type == ROAD_RIGHT));
         }
         if (type == ROAD_BRIDGE || lasttype == ROAD_BRIDGE || type == ROAD_MONORAIL || lasttype == ROAD_MONORAIL)
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TEXFIT_CONCRETEWALL, true, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TEXFIT_CONCRETEWALL, true, pos, lastpos, width);
+            addQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TEXFIT_CONCRETEWALL, true, pos, lastpos, width);
+            addQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TEXFIT_CONCRETEWALL, true, pos, lastpos, width);
             //underside - we flip the underside so it folds gracefully with the top
-            addQuad(pts[0], lpts[0], lpts[7], pts[7], TEXFIT_CONCRETEUNDER, true, pos, lastpos, width, true);
+            addQuad(seg, pts[0], lpts[0], lpts[7], pts[7], TEXFIT_CONCRETEUNDER, true, pos, lastpos, width, true);
         }
         else
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TEXFIT_BRICKWALL, true, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TEXFIT_BRICKWALL, true, pos, lastpos, width);
+            addQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TEXFIT_BRICKWALL, true, pos, lastpos, width);
+            addQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TEXFIT_BRICKWALL, true, pos, lastpos, width);
         }
         if ((type == ROAD_BRIDGE || type == ROAD_MONORAIL) && pillartype > 0)
         {
@@ -177,15 +356,12 @@ void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float b
                     sidefactor = 0.2;
             }
 
-            static int pillarcounter = 0;
-            pillarcounter++;
-
             if (pillartype == 2)
             {
                 // always in the middle
                 sidefactor = 0.5;
                 // only build every fifth pillar
-                if (pillarcounter % 5)
+                if (index % 5)
                     builtpillars = false;
             }
 
@@ -208,25 +384,25 @@ void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float b
             if (width2 >= 0.2 && builtpillars)
             {
                 //sides
-                addQuad(middle + Vector3(-width2, -len, -width2),
+                addQuad(seg, middle + Vector3(-width2, -len, -width2),
                     middle + Vector3(-width2, 0, -width2),
                     middle + Vector3(width2, 0, -width2),
                     middle + Vector3(width2, -len, -width2),
                     TEXFIT_CONCRETETOP, true, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(width2, -len, width2),
+                addQuad(seg, middle + Vector3(width2, -len, width2),
                     middle + Vector3(width2, 0, width2),
                     middle + Vector3(-width2, 0, width2),
                     middle + Vector3(-width2, -len, width2),
                     TEXFIT_CONCRETETOP, true, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(-width2, -len, width2),
+                addQuad(seg, middle + Vector3(-width2, -len, width2),
                     middle + Vector3(-width2, 0, width2),
                     middle + Vector3(-width2, 0, -width2),
                     middle + Vector3(-width2, -len, -width2),
                     TEXFIT_CONCRETETOP, true, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(width2, -len, -width2),
+                addQuad(seg, middle + Vector3(width2, -len, -width2),
                     middle + Vector3(width2, 0, -width2),
                     middle + Vector3(width2, 0, width2),
                     middle + Vector3(width2, -len, width2),
@@ -234,21 +410,29 @@ void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float b
             }
         }
     }
-    else
+
+    //compute normals
+    seg.normals.assign(seg.vertices.size(), Vector3::ZERO);
+    for (size_t i = 0; i + 2 < seg.indices.size(); i += 3)
     {
-        first = false;
-        Vector3 pts[8];
-        computePoints(pts, pos, rot, type, width, bwidth, bheight);
-        addQuad(pts[0], pts[1], pts[2], pts[3], TEXFIT_NONE, true, pos, pos, width);
-        addQuad(pts[0], pts[3], pts[4], pts[7], TEXFIT_NONE, true, pos, pos, width);
-        addQuad(pts[4], pts[5], pts[6], pts[7], TEXFIT_NONE, true, pos, pos, width);
-    }
-    lastpos = pos;
-    lastrot = rot;
-    lastwidth = width;
-    lastbwidth = bwidth;
-    lastbheight = bheight;
-    lasttype = type;
+        Vector3 v1, v2;
+        v1 = seg.vertices[seg.indices[i + 1]] - seg.vertices[seg.indices[i]];
+        v2 = seg.vertices[seg.indices[i + 2]] - seg.vertices[seg.indices[i]];
+        v1 = v1.crossProduct(v2);
+        v1.normalise();
+        seg.normals[seg.indices[i]] += v1;
+        seg.normals[seg.indices[i + 1]] += v1;
+        seg.normals[seg.indices[i + 2]] += v1;
+    }
+    //normalize
+    for (Vector3& normal : seg.normals)
+    {
+        normal.normalise();
+    }
+
+    seg.geometry_dirty = false;
+    seg.collision_dirty = true;
+    m_mesh_dirty = true;
 }
 
 void Road2::computePoints(Vector3* pts, Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight)
@@ -333,49 +517,46 @@ inline Vector3 Road2::baseOf(Vector3 p)
     return Vector3(p.x, y, p.z);
 }
 
-void Road2::addQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, bool collision, Vector3 pos, Vector3 lastpos, float width, bool flip)
+void Road2::addQuad(Segment& seg, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, bool collision, Vector3 pos, Vector3 lastpos, float width, bool flip)
 {
-    if (vertexcount + 3 >= MAX_VERTEX || tricount * 3 + 3 + 2 >= MAX_TRIS * 3)
-        return;
     Vector2 texf[4];
     textureFit(p1, p2, p3, p4, texfit, texf, pos, lastpos, width);
     //vertexes
-    vertex[vertexcount] = p1;
-    tex[vertexcount] = texf[0];
-    vertex[vertexcount + 1] = p2;
-    tex[vertexcount + 1] = texf[1];
-    vertex[vertexcount + 2] = p3;
-    tex[vertexcount + 2] = texf[2];
-    vertex[vertexcount + 3] = p4;
-    tex[vertexcount + 3] = texf[3];
+    const unsigned short vertexcount = static_cast<unsigned short>(seg.vertices.size());
+    seg.vertices.push_back(p1);
+    seg.texcoords.push_back(texf[0]);
+    seg.vertices.push_back(p2);
+    seg.texcoords.push_back(texf[1]);
+    seg.vertices.push_back(p3);
+    seg.texcoords.push_back(texf[2]);
+    seg.vertices.push_back(p4);
+    seg.texcoords.push_back(texf[3]);
     //tris
     if (flip)
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 3;
-        tris[tricount * 3 + 3] = vertexcount + 1;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        seg.indices.push_back(vertexcount);
+        seg.indices.push_back(vertexcount + 1);
+        seg.indices.push_back(vertexcount + 3);
+        seg.indices.push_back(vertexcount + 1);
+        seg.indices.push_back(vertexcount + 2);
+        seg.indices.push_back(vertexcount + 3);
     }
     else
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 2;
-        tris[tricount * 3 + 3] = vertexcount;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        seg.indices.push_back(vertexcount);
+        seg.indices.push_back(vertexcount + 1);
+        seg.indices.push_back(vertexcount + 2);
+        seg.indices.push_back(vertexcount);
+        seg.indices.push_back(vertexcount + 2);
+        seg.indices.push_back(vertexcount + 3);
     }
     if (collision)
     {
         ground_model_t* gm = gEnv->collisions->getGroundModelByString("concrete");
         if (texfit == TEXFIT_ROAD || texfit == TEXFIT_ROADS1 || texfit == TEXFIT_ROADS2 || texfit == TEXFIT_ROADS3 || texfit == TEXFIT_ROADS4)
             gm = gEnv->collisions->getGroundModelByString("asphalt");
-        addCollisionQuad(p1, p2, p3, p4, gm, flip);
+        addCollisionQuad(seg, p1, p2, p3, p4, gm, flip);
     }
-    tricount += 2;
-    vertexcount += 4;
 }
 
 void Road2::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit, Vector2* texc, Vector3 pos, Vector3 lastpos, float width)
@@ -513,103 +694,94 @@ void Road2::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfi
         texc[i] = Vector2(0, 0);
 }
 
-void Road2::addCollisionQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, ground_model_t* gm, bool flip)
+void Road2::addCollisionQuad(Segment& seg, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, ground_model_t* gm, bool flip)
 {
-    int triID = 0;
+    // Registered with `Collisions` by `finish()` on the main thread
     if (flip)
     {
-        triID = gEnv->collisions->addCollisionTri(p1, p2, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
-
-        triID = gEnv->collisions->addCollisionTri(p4, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+        seg.coll_tris.push_back({p1, p2, p4, gm});
+        seg.coll_tris.push_back({p4, p2, p3, gm});
     }
     else
     {
-        triID = gEnv->collisions->addCollisionTri(p1, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
-
-        triID = gEnv->collisions->addCollisionTri(p1, p3, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+        seg.coll_tris.push_back({p1, p2, p3, gm});
+        seg.coll_tris.push_back({p1, p3, p4, gm});
     }
 }
 
 void Road2::createMesh()
 {
-    AxisAlignedBox aab;
-    union
+    // Segments past the 16-bit index limit are left out of the mesh (they still collide)
+    size_t vertexcount = 0;
+    size_t ibufCount = 0;
+    size_t num_segments = 0;
+    for (Segment const& seg : m_segments)
     {
-        float* vertices;
-        CoVertice_t* covertices;
-    };
-    /// Create the mesh via the MeshManager
-    Ogre::String mesh_name = Ogre::String("RoadSystem-").append(Ogre::StringConverter::toString(mid));
-    msh = MeshManager::getSingleton().createManual(mesh_name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-
-    mainsub = msh->createSubMesh();
-    mainsub->setMaterialName("road2");
-
-    /// Define the vertices
-    size_t vbufCount = (2 * 3 + 2) * vertexcount;
-    vertices = (float*)malloc(vbufCount * sizeof(float));
-    int i;
-    //fill values
-    for (i = 0; i < vertexcount; i++)
-    {
-        covertices[i].texcoord = tex[i];
-        covertices[i].vertex = vertex[i];
-        //normals are computed later
-        covertices[i].normal = Vector3::ZERO;
-        aab.merge(vertex[i]);
+        if (vertexcount + seg.vertices.size() > MAX_VERTEX || ibufCount + seg.indices.size() > MAX_TRIS * 3)
+            break;
+        vertexcount += seg.vertices.size();
+        ibufCount += seg.indices.size();
+        num_segments++;
     }
 
-    /// Define triangles
-    size_t ibufCount = 3 * tricount;
-
-    //compute normals
-    for (i = 0; i < tricount && i * 3 + 2 < MAX_TRIS * 3; i++)
+    AxisAlignedBox aab;
+    std::vector<CoVertice_t> covertices;
+    std::vector<unsigned short> tris;
+    covertices.reserve(vertexcount);
+    tris.reserve(ibufCount);
+    for (size_t s = 0; s < num_segments; s++)
     {
-        Vector3 v1, v2;
-        v1 = covertices[tris[i * 3 + 1]].vertex - covertices[tris[i * 3]].vertex;
-        v2 = covertices[tris[i * 3 + 2]].vertex - covertices[tris[i * 3]].vertex;
-        v1 = v1.crossProduct(v2);
-        v1.normalise();
-        covertices[tris[i * 3]].normal += v1;
-        covertices[tris[i * 3 + 1]].normal += v1;
-        covertices[tris[i * 3 + 2]].normal += v1;
+        Segment const& seg = m_segments[s];
+        const unsigned short base = static_cast<unsigned short>(covertices.size());
+        for (size_t i = 0; i < seg.vertices.size(); i++)
+        {
+            CoVertice_t v;
+            v.vertex = seg.vertices[i];
+            v.normal = seg.normals[i];
+            v.texcoord = seg.texcoords[i];
+            covertices.push_back(v);
+            aab.merge(seg.vertices[i]);
+        }
+        for (unsigned short index : seg.indices)
+        {
+            tris.push_back(base + index);
+        }
     }
-    //normalize
-    for (i = 0; i < vertexcount; i++)
+
+    if (msh.isNull())
     {
-        covertices[i].normal.normalise();
+        /// Create the mesh via the MeshManager
+        Ogre::String mesh_name = Ogre::String("RoadSystem-").append(Ogre::StringConverter::toString(mid));
+        msh = MeshManager::getSingleton().createManual(mesh_name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+        mainsub = msh->createSubMesh();
+        mainsub->setMaterialName("road2");
+        mainsub->useSharedVertices = true;
+
+        /// Create vertex data structure for vertices shared between sub meshes
+        msh->sharedVertexData = new VertexData();
+
+        /// Create declaration (memory format) of vertex data
+        VertexDeclaration* decl = msh->sharedVertexData->vertexDeclaration;
+        size_t offset = 0;
+        decl->addElement(0, offset, VET_FLOAT3, VES_POSITION);
+        offset += VertexElement::getTypeSize(VET_FLOAT3);
+        decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
+        offset += VertexElement::getTypeSize(VET_FLOAT3);
+        decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
+        offset += VertexElement::getTypeSize(VET_FLOAT2);
     }
 
-    /// Create vertex data structure for vertices shared between sub meshes
-    msh->sharedVertexData = new VertexData();
     msh->sharedVertexData->vertexCount = vertexcount;
 
-    /// Create declaration (memory format) of vertex data
-    VertexDeclaration* decl = msh->sharedVertexData->vertexDeclaration;
-    size_t offset = 0;
-    decl->addElement(0, offset, VET_FLOAT3, VES_POSITION);
-    offset += VertexElement::getTypeSize(VET_FLOAT3);
-    decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
-    offset += VertexElement::getTypeSize(VET_FLOAT3);
-    decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
-    offset += VertexElement::getTypeSize(VET_FLOAT2);
-
     /// Allocate vertex buffer of the requested number of vertices (vertexCount)
-    /// and bytes per vertex (offset)
+    /// and bytes per vertex; replaces the previous buffer on rebuild
     HardwareVertexBufferSharedPtr vbuf =
         HardwareBufferManager::getSingleton().createVertexBuffer(
-            offset, msh->sharedVertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            msh->sharedVertexData->vertexDeclaration->getVertexSize(0), vertexcount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
 
     /// Upload the vertex data to the card
-    vbuf->writeData(0, vbuf->getSizeInBytes(), vertices, true);
+    vbuf->writeData(0, vbuf->getSizeInBytes(), covertices.data(), true);
 
     /// Set vertex buffer binding so buffer 0 is bound to our vertex buffer
     VertexBufferBinding* bind = msh->sharedVertexData->vertexBufferBinding;
@@ -624,10 +796,9 @@ void Road2::createMesh()
             HardwareBuffer::HBU_STATIC_WRITE_ONLY);
 
     /// Upload the index data to the card
-    ibuf->writeData(0, ibuf->getSizeInBytes(), tris, true);
+    ibuf->writeData(0, ibuf->getSizeInBytes(), tris.data(), true);
 
     /// Set parameters of the submesh
-    mainsub->useSharedVertices = true;
     mainsub->indexData->indexBuffer = ibuf;
     mainsub->indexData->indexCount = ibufCount;
     mainsub->indexData->indexStart = 0;
@@ -635,7 +806,6 @@ void Road2::createMesh()
     msh->_setBounds(aab, true);
 
     /// Notify Mesh object that it has been loaded
-    msh->load();
-
-    free(vertices);
-};
+    if (!msh->isLoaded())
+        msh->load();
+}
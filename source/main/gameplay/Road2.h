@@ -25,6 +25,9 @@
 #include "RoRPrerequisites.h"
 
 // dynamic roads
+// The road is built per segment (one segment per block, plus the end cap). Changing a block
+// only marks the segments which depend on it; `computeSegments()` regenerates their geometry
+// and `finish()` re-registers their collision tris and re-uploads the mesh.
 class Road2 : public ZeroedMemoryAllocator
 {
 public:
@@ -33,13 +36,16 @@ public:
     ~Road2();
 
     void addBlock(Ogre::Vector3 pos, Ogre::Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype = 1);
-    /**
-     * @param p1 Top left point.
-     * @param p2 Top right point.
-     */
-    void addQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, bool collision, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
-    void addCollisionQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, ground_model_t* gm, bool flip = false);
-    void createMesh();
+    /// Updates an existing block; segments are only marked dirty if anything changed.
+    void setBlock(size_t index, Ogre::Vector3 pos, Ogre::Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype = 1);
+    /// Removes blocks from the end of the road.
+    void truncateBlocks(size_t count);
+    size_t getNumBlocks() const { return m_blocks.size(); }
+
+    /// Regenerates geometry of dirty segments. Doesn't touch the scene or the collision system,
+    /// so different roads can be computed in parallel.
+    void computeSegments();
+    /// Registers collision tris of rebuilt segments and (re)creates the mesh. Main thread only.
     void finish();
 
     static const unsigned int MAX_VERTEX = 50000;
@@ -73,9 +79,51 @@ public:
 
 private:
 
+    struct Block
+    {
+        Ogre::Vector3 pos;
+        Ogre::Quaternion rot;
+        int type;
+        float width;
+        float bwidth;
+        float bheight;
+        int pillartype;
+    };
+
+    struct CollisionTri
+    {
+        Ogre::Vector3 a, b, c;
+        ground_model_t* gm;
+    };
+
+    struct Segment
+    {
+        Segment(): geometry_dirty(true), collision_dirty(false) {}
+
+        std::vector<Ogre::Vector3> vertices;
+        std::vector<Ogre::Vector3> normals;
+        std::vector<Ogre::Vector2> texcoords;
+        std::vector<unsigned short> indices;   //!< Relative to the segment's first vertex
+        std::vector<CollisionTri> coll_tris;
+        std::vector<int> registered_coll_tris; //!< IDs in `Collisions`
+        bool geometry_dirty;
+        bool collision_dirty;
+    };
+
     inline Ogre::Vector3 baseOf(Ogre::Vector3 p);
+    Block resolveBlock(Block const& block, bool first);
+    void markBlockDirty(size_t index);
+    void computeSegment(size_t index);
     void computePoints(Ogre::Vector3* pts, Ogre::Vector3 pos, Ogre::Quaternion rot, int type, float width, float bwidth, float bheight);
     void textureFit(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, Ogre::Vector2* texc, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width);
+    /**
+     * @param p1 Top left point.
+     * @param p2 Top right point.
+     */
+    void addQuad(Segment& seg, Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, bool collision, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
+    void addCollisionQuad(Segment& seg, Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, ground_model_t* gm, bool flip = false);
+    void unregisterCollision(Segment& seg);
+    void createMesh();
 
     typedef struct
     {
@@ -86,22 +134,12 @@ private:
 
     Ogre::MeshPtr msh;
     Ogre::SubMesh* mainsub;
-
-    Ogre::Vector2 tex[MAX_VERTEX];
-    Ogre::Vector3 vertex[MAX_VERTEX];
-    int tricount;
-    int vertexcount;
-    short tris[MAX_TRIS * 3];
-
-    Ogre::Quaternion lastrot;
     Ogre::SceneNode* snode;
-    Ogre::Vector3 lastpos;
-    bool first;
-    float lastbheight;
-    float lastbwidth;
-    float lastwidth;
-    int lasttype;
     int mid;
-    std::vector<int> registeredCollTris;
-};
 
+    std::vector<Block> m_blocks;          //!< As given by the user
+    std::vector<Block> m_resolved_blocks; //!< Automatic types resolved; valid for blocks not marked dirty
+    std::vector<bool> m_block_dirty;
+    std::vector<Segment> m_segments;      //!< One per block, plus the end cap
+    bool m_mesh_dirty;
+};
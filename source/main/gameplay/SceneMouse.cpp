@@ -30,6 +30,7 @@
 #include "Beam.h"
 #include "BeamFactory.h"
 #include "GUIManager.h"
+#include "RayCast.h"
 #include "RoRFrameListener.h"
 
 # include <MyGUI.h>
@@ -122,45 +123,19 @@ bool SceneMouse::mouseMoved(const OIS::MouseEvent& _arg)
         lastMouseY = ms.Y.abs;
         lastMouseX = ms.X.abs;
 
-        Ray mouseRay = getMouseRay();
-
-        // walk all trucks
-        Actor** trucks = App::GetSimController()->GetBeamFactory()->GetInternalActorSlots();
-        int trucksnum  = App::GetSimController()->GetBeamFactory()->GetNumUsedActorSlots();
+        // find the nearest grabbable node
+        RayCastQuery query(getMouseRay(), mindist, RAYCAST_ACTORS);
+        query.node_radius = 0.1f;
+        query.grabbable_nodes_only = true;
+        query.local_actors_only = true;
+        RayCastResult hit;
         minnode = -1;
         grab_truck = NULL;
-        for (int i = 0; i < trucksnum; i++)
+        if (App::GetSimController()->GetBeamFactory()->CastRay(query, hit))
         {
-            if (trucks[i] && trucks[i]->ar_sim_state == Actor::SimState::LOCAL_SIMULATED)
-            {
-                // check if our ray intersects with the bounding box of the truck
-                std::pair<bool, Real> pair = mouseRay.intersects(trucks[i]->ar_bounding_box);
-                if (!pair.first)
-                    continue;
-
-                for (int j = 0; j < trucks[i]->ar_num_nodes; j++)
-                {
-                    if (trucks[i]->ar_nodes[j].no_mouse_grab)
-                        continue;
-
-                    // check if our ray intersects with the node
-                    std::pair<bool, Real> pair = mouseRay.intersects(Sphere(trucks[i]->ar_nodes[j].AbsPosition, 0.1f));
-                    if (pair.first)
-                    {
-                        // we hit it, check if its the nearest node
-                        if (pair.second < mindist)
-                        {
-                            mindist = pair.second;
-                            minnode = j;
-                            grab_truck = trucks[i];
-                            break;
-                        }
-                    }
-                }
-            }
-
-            if (grab_truck)
-                break;
+            mindist = hit.distance;
+            minnode = hit.node;
+            grab_truck = hit.actor;
         }
 
         // check if we hit a node
@@ -0,0 +1,281 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SimSnapshot.h"
+
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace RoR;
+
+static const uint32_t SNAPSHOT_MAGIC   = 0x4D49534E; // "NSIM"
+static const uint32_t SNAPSHOT_VERSION = 2;          // 2: explicit little-endian fields instead of raw structs
+static const uint32_t MAX_ELEMENTS     = 1000000;   // Sanity limit for counts read from file
+
+// ---------------------------- Encoding helpers ----------------------------
+// Same layout rules as `ActorState`: every field is written separately, 32-bit values little-endian.
+
+static void WriteU32(std::ostream& out, uint32_t value)
+{
+    const char bytes[4] = {
+        static_cast<char>(value), static_cast<char>(value >> 8),
+        static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+    out.write(bytes, sizeof(bytes));
+}
+
+static void WriteI32(std::ostream& out, int32_t value)
+{
+    WriteU32(out, static_cast<uint32_t>(value));
+}
+
+static void WriteFloat(std::ostream& out, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteU32(out, bits);
+}
+
+static void WriteU8(std::ostream& out, uint8_t value)
+{
+    out.put(static_cast<char>(value));
+}
+
+static void WriteFloats(std::ostream& out, std::vector<float> const& vec)
+{
+    WriteU32(out, static_cast<uint32_t>(vec.size()));
+    for (float value : vec)
+        WriteFloat(out, value);
+}
+
+static void WriteString(std::ostream& out, std::string const& str)
+{
+    WriteU32(out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), str.size());
+}
+
+static void WriteEngine(std::ostream& out, SimSnapshot::EngineState const& engine)
+{
+    WriteFloat(out, engine.rpm);
+    WriteFloat(out, engine.acc);
+    WriteFloat(out, engine.clutch);
+    WriteI32(out, engine.gear);
+    WriteI32(out, engine.gearbox_mode);
+    WriteI32(out, engine.autoselect);
+    WriteU8(out, engine.running);
+    WriteU8(out, engine.contact);
+}
+
+static void WriteLinks(std::ostream& out, std::vector<SimSnapshot::LinkState> const& links)
+{
+    WriteU32(out, static_cast<uint32_t>(links.size()));
+    for (SimSnapshot::LinkState const& link : links)
+    {
+        WriteI32(out, link.index);
+        WriteI32(out, link.locked);
+        WriteI32(out, link.target_actor);
+        WriteI32(out, link.target);
+        WriteFloat(out, link.length);
+    }
+}
+
+static bool ReadU32(std::istream& in, uint32_t& value)
+{
+    unsigned char bytes[4];
+    in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    value = uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+    return in.good();
+}
+
+static bool ReadI32(std::istream& in, int32_t& value)
+{
+    uint32_t bits = 0;
+    if (!ReadU32(in, bits))
+        return false;
+    value = static_cast<int32_t>(bits);
+    return true;
+}
+
+static bool ReadFloat(std::istream& in, float& value)
+{
+    uint32_t bits = 0;
+    if (!ReadU32(in, bits))
+        return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+static bool ReadU8(std::istream& in, uint8_t& value)
+{
+    const int c = in.get();
+    value = static_cast<uint8_t>(c);
+    return in.good();
+}
+
+static bool ReadFloats(std::istream& in, std::vector<float>& vec)
+{
+    uint32_t size = 0;
+    if (!ReadU32(in, size) || size > MAX_ELEMENTS)
+        return false;
+    vec.resize(size);
+    for (float& value : vec)
+    {
+        if (!ReadFloat(in, value))
+            return false;
+    }
+    return true;
+}
+
+static bool ReadString(std::istream& in, std::string& str)
+{
+    uint32_t size = 0;
+    if (!ReadU32(in, size) || size > MAX_ELEMENTS)
+        return false;
+    str.resize(size);
+    in.read(&str[0], size);
+    return in.good();
+}
+
+static bool ReadEngine(std::istream& in, SimSnapshot::EngineState& engine)
+{
+    return ReadFloat(in, engine.rpm) &&
+        ReadFloat(in, engine.acc) &&
+        ReadFloat(in, engine.clutch) &&
+        ReadI32(in, engine.gear) &&
+        ReadI32(in, engine.gearbox_mode) &&
+        ReadI32(in, engine.autoselect) &&
+        ReadU8(in, engine.running) &&
+        ReadU8(in, engine.contact);
+}
+
+static bool ReadLinks(std::istream& in, std::vector<SimSnapshot::LinkState>& links)
+{
+    uint32_t size = 0;
+    if (!ReadU32(in, size) || size > MAX_ELEMENTS)
+        return false;
+    links.resize(size);
+    for (SimSnapshot::LinkState& link : links)
+    {
+        if (!ReadI32(in, link.index) ||
+            !ReadI32(in, link.locked) ||
+            !ReadI32(in, link.target_actor) ||
+            !ReadI32(in, link.target) ||
+            !ReadFloat(in, link.length))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------- SimSnapshot ----------------------------
+
+bool SimSnapshot::Write(std::ostream& out) const
+{
+    WriteU32(out, SNAPSHOT_MAGIC);
+    WriteU32(out, SNAPSHOT_VERSION);
+    WriteU32(out, static_cast<uint32_t>(actors.size()));
+    for (ActorRecord const& rec : actors)
+    {
+        WriteString(out, rec.filename);
+        rec.state.Write(out);
+        WriteU8(out, rec.has_engine);
+        WriteEngine(out, rec.engine);
+        WriteFloats(out, rec.wheel_speeds);
+        WriteLinks(out, rec.hooks);
+        WriteLinks(out, rec.ties);
+        WriteLinks(out, rec.ropes);
+    }
+    WriteFloats(out, terrain_animations);
+    return out.good();
+}
+
+bool SimSnapshot::Read(std::istream& in)
+{
+    actors.clear();
+    terrain_animations.clear();
+
+    uint32_t magic = 0, version = 0, num_actors = 0;
+    if (!ReadU32(in, magic) || !ReadU32(in, version) || !ReadU32(in, num_actors) ||
+        magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || num_actors > MAX_ELEMENTS)
+    {
+        return false;
+    }
+
+    actors.resize(num_actors);
+    for (ActorRecord& rec : actors)
+    {
+        if (!ReadString(in, rec.filename) ||
+            !rec.state.Read(in) ||
+            !ReadU8(in, rec.has_engine) ||
+            !ReadEngine(in, rec.engine) ||
+            !ReadFloats(in, rec.wheel_speeds) ||
+            !ReadLinks(in, rec.hooks) ||
+            !ReadLinks(in, rec.ties) ||
+            !ReadLinks(in, rec.ropes))
+        {
+            actors.clear();
+            return false;
+        }
+    }
+    if (!ReadFloats(in, terrain_animations))
+    {
+        actors.clear();
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------- SimSnapshotWriter ----------------------------
+
+SimSnapshotWriter::SimSnapshotWriter()
+    : m_thread(new ThreadPool(1, "ror-snapshot"))
+{
+}
+
+SimSnapshotWriter::~SimSnapshotWriter()
+{
+    this->Wait();
+}
+
+void SimSnapshotWriter::Wait()
+{
+    if (m_task)
+    {
+        m_task->join();
+        m_task = nullptr;
+    }
+}
+
+void SimSnapshotWriter::Write(std::unique_ptr<SimSnapshot> snapshot, std::string const& path)
+{
+    this->Wait();
+
+    std::shared_ptr<SimSnapshot> data(std::move(snapshot)); // std::function must be copyable
+    m_task = m_thread->RunTask([data, path]()
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (file.is_open() && data->Write(file))
+                RoR::LogFormat("[RoR|SimSnapshot] Saved %d actors to '%s'", static_cast<int>(data->actors.size()), path.c_str());
+            else
+                RoR::LogFormat("[RoR|SimSnapshot] Failed to write '%s'", path.c_str());
+        });
+}
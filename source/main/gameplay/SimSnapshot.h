@@ -0,0 +1,100 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Checkpoint of the whole running simulation, see `ActorManager::SaveSimState()`.
+///
+/// Capturing only copies data (main thread, simulation thread idle); encoding and
+/// writing the file happens on `SimSnapshotWriter`'s worker thread.
+
+#pragma once
+
+#include "ActorState.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Task;
+class ThreadPool;
+
+namespace RoR {
+
+struct SimSnapshot
+{
+    /// A hook, tie or rope locked to a (possibly other) actor
+    struct LinkState
+    {
+        int32_t index;        //!< Hook/tie/rope index on the owning actor
+        int32_t locked;       //!< Hooks and ropes: `hk_locked`/`rp_locked`; ties: 1 = tied, 2 = still tying
+        int32_t target_actor; //!< Index into `SimSnapshot::actors`
+        int32_t target;       //!< Hooks: node index; ties and ropes: ropable index
+        float   length;       //!< Current beam length
+    };
+
+    struct EngineState
+    {
+        float   rpm;
+        float   acc;
+        float   clutch;
+        int32_t gear;
+        int32_t gearbox_mode; //!< `SimGearboxMode`
+        int32_t autoselect;
+        uint8_t running;
+        uint8_t contact;
+    };
+
+    struct ActorRecord
+    {
+        std::string            filename;
+        ActorState             state;
+        uint8_t                has_engine;
+        EngineState            engine;
+        std::vector<float>     wheel_speeds;
+        std::vector<LinkState> hooks;
+        std::vector<LinkState> ties;
+        std::vector<LinkState> ropes;
+    };
+
+    std::vector<ActorRecord> actors;
+    std::vector<float>       terrain_animations; //!< Time positions of animated terrain objects
+
+    bool Write(std::ostream& out) const;
+    bool Read(std::istream& in);
+};
+
+/// Writes snapshots on a worker thread; at most one write is in flight.
+class SimSnapshotWriter
+{
+public:
+    SimSnapshotWriter();
+    ~SimSnapshotWriter();
+
+    /// Waits for the previous write (if any), then starts writing in background.
+    void Write(std::unique_ptr<SimSnapshot> snapshot, std::string const& path);
+    void Wait();
+
+private:
+    std::unique_ptr<ThreadPool> m_thread;
+    std::shared_ptr<Task>       m_task;
+};
+
+} // namespace RoR
@@ -20,17 +20,28 @@
 */
 
 #include "SkinManager.h"
+
+#include "Application.h"
 #include "OgreSubsystem.h"
+#include "PlatformUtils.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+
+#include <OgreArchive.h>
 #include <OgreEntity.h>
 #include <OgreMaterialManager.h>
 #include <OgrePass.h>
 #include <OgreSubEntity.h>
 #include <OgreTechnique.h>
 
-RoR::SkinManager::SkinManager() : ResourceManager()
+RoR::SkinManager::SkinManager() : ResourceManager(), m_file_cache_dirty(false)
 {
+    this->LoadCache();
+
     mLoadOrder = 200.0f;
     mScriptPatterns.push_back("*.skin");
     mResourceType = "RoRVehicleSkins";
@@ -41,14 +52,35 @@ RoR::SkinManager::SkinManager() : ResourceManager()
 
 RoR::SkinManager::~SkinManager()
 {
+    this->SaveCache(); // Files parsed by background loading or in archives mounted on first use
     Ogre::ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
     Ogre::ResourceGroupManager::getSingleton()._unregisterScriptLoader(this);
 }
 
 void RoR::SkinManager::parseScript(Ogre::DataStreamPtr& stream, const Ogre::String& groupName)
 {
-    SkinDef* skin_def = nullptr;
-    bool     skin_is_new = true;
+    // Unchanged files (same size and modification time) are taken from the cache
+    CachedFile file_info;
+    std::string cache_key;
+    CachedFile* cache_entry = nullptr;
+    if (this->FindFileInfo(stream->getName(), groupName, cache_key, file_info))
+    {
+        auto cached = m_file_cache.find(cache_key);
+        if (cached != m_file_cache.end() && cached->second.file_size == file_info.file_size && cached->second.mtime == file_info.mtime)
+        {
+            for (SkinDef const& def : cached->second.skins)
+            {
+                this->RegisterSkin(def);
+            }
+            return;
+        }
+
+        cache_entry = &m_file_cache[cache_key];
+        *cache_entry = file_info;
+        m_file_cache_dirty = true;
+    }
+
+    std::unique_ptr<SkinDef> skin_def;
     try
     {
         while(!stream->eof())
@@ -65,18 +97,8 @@ void RoR::SkinManager::parseScript(Ogre::DataStreamPtr& stream, const Ogre::Stri
             {
                 // No current skin -- So first valid data should be skin name
                 Ogre::StringUtil::trim(line);
-                auto search = m_skins.find(line);
-                if (search != m_skins.end())
-                {
-                    skin_def = search->second;
-                    skin_is_new = false;
-                }
-                else
-                {
-                    skin_def = new SkinDef;
-                    skin_def->name = line;
-                    skin_is_new = true;
-                }
+                skin_def.reset(new SkinDef);
+                skin_def->name = line;
                 stream->skipLine("{");
             }
             else
@@ -84,13 +106,16 @@ void RoR::SkinManager::parseScript(Ogre::DataStreamPtr& stream, const Ogre::Stri
                 // Already in skin
                 if (line == "}")
                 {
-                    if (skin_is_new)
-                        m_skins.insert(std::make_pair(skin_def->name, skin_def));
-                    skin_def = nullptr;// Finished
+                    if (cache_entry != nullptr)
+                    {
+                        cache_entry->skins.push_back(*skin_def);
+                    }
+                    this->RegisterSkin(*skin_def);
+                    skin_def.reset(); // Finished
                 }
                 else
                 {
-                    this->ParseSkinAttribute(line, skin_def);
+                    this->ParseSkinAttribute(line, skin_def.get());
                 }
             }
         }
@@ -104,6 +129,72 @@ void RoR::SkinManager::parseScript(Ogre::DataStreamPtr& stream, const Ogre::Stri
     }
 }
 
+void RoR::SkinManager::RegisterSkin(SkinDef const& def)
+{
+    auto search = m_skins.find(def.name);
+    if (search == m_skins.end())
+    {
+        SkinDef* skin = new SkinDef(def);
+        m_skins.insert(std::make_pair(skin->name, skin));
+        this->IndexSkin(skin);
+        return;
+    }
+
+    // Same result as parsing the attributes into the existing skin
+    SkinDef* skin = search->second;
+    const std::string old_guid = skin->guid;
+    skin->replace_textures.insert(def.replace_textures.begin(), def.replace_textures.end());
+    if (!def.replace_textures.empty())
+    {
+        skin->texture_swaps.clear(); // Memo was made with the old texture list
+    }
+    skin->replace_materials.insert(def.replace_materials.begin(), def.replace_materials.end());
+    if (!def.thumbnail.empty())   { skin->thumbnail = def.thumbnail; }
+    if (!def.description.empty()) { skin->description = def.description; }
+    if (!def.author_name.empty()) { skin->author_name = def.author_name; }
+    if (def.author_id != -1)      { skin->author_id = def.author_id; }
+    if (!def.guid.empty())        { skin->guid = def.guid; }
+
+    if (skin->guid != old_guid)
+    {
+        std::vector<SkinDef*>& old_list = m_skins_by_guid[old_guid];
+        old_list.erase(std::remove(old_list.begin(), old_list.end(), skin), old_list.end());
+        this->IndexSkin(skin);
+    }
+}
+
+bool RoR::SkinManager::FindFileInfo(std::string const& filename, std::string const& group, std::string& out_key, CachedFile& out_info)
+{
+    try
+    {
+        Ogre::FileInfoListPtr files = Ogre::ResourceGroupManager::getSingleton().findResourceFileInfo(group, filename);
+        if (files.isNull() || files->empty())
+            return false;
+
+        Ogre::FileInfo const& info = files->front();
+        out_key = info.archive->getName() + "|" + info.filename;
+        out_info.disk_path = (info.archive->getType() == "Zip")
+            ? info.archive->getName()
+            : info.archive->getName() + RoR::PATH_SLASH + info.filename;
+        out_info.file_size = static_cast<uint64_t>(info.uncompressedSize);
+        out_info.mtime = static_cast<int64_t>(info.archive->getModifiedTime(info.filename));
+        out_info.skins.clear();
+        return true;
+    }
+    catch (Ogre::Exception&)
+    {
+        return false; // Not cached, just parsed
+    }
+}
+
+void RoR::SkinManager::IndexSkin(SkinDef* skin)
+{
+    std::vector<SkinDef*>& list = m_skins_by_guid[skin->guid];
+    auto pos = std::lower_bound(list.begin(), list.end(), skin,
+        [](SkinDef* a, SkinDef* b) { return a->name < b->name; });
+    list.insert(pos, skin);
+}
+
 void RoR::SkinManager::ParseSkinAttribute(const std::string& line, SkinDef* skin_def)
 {
     Ogre::StringVector params = Ogre::StringUtil::split(line, "\t=,;\n");
@@ -126,52 +217,238 @@ void RoR::SkinManager::ParseSkinAttribute(const std::string& line, SkinDef* skin
 
 void RoR::SkinManager::GetUsableSkins(std::string guid, std::vector<SkinDef *> &out_skins)
 {
-    Ogre::StringUtil::toLowerCase(guid);
-    for (auto entry: m_skins)
+    Ogre::StringUtil::toLowerCase(guid); // Index keys are already trimmed and lowercase
+    auto search = m_skins_by_guid.find(guid);
+    if (search != m_skins_by_guid.end())
     {
-        if (entry.second->guid == guid) // GUID already trimmed and lowercase
-            out_skins.push_back(entry.second);
+        out_skins.insert(out_skins.end(), search->second.begin(), search->second.end());
     }
 }
 
-void RoR::SkinManager::ReplaceMaterialTextures(SkinDef* skin_def, std::string materialName) // Static
+// -------------------------------- Cache file --------------------------------
+
+static const uint32_t SKIN_CACHE_MAGIC   = 0x4E494B53; // "SKIN"
+static const uint32_t SKIN_CACHE_VERSION = 2;
+
+static std::string GetSkinCachePath()
+{
+    return std::string(RoR::App::sys_cache_dir.GetActive()) + RoR::PATH_SLASH + "skins.cache";
+}
+
+static void WriteU32(std::ostream& out, uint32_t value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void WriteString(std::ostream& out, std::string const& str)
+{
+    WriteU32(out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), str.size());
+}
+
+static void WriteStringMap(std::ostream& out, std::map<std::string, std::string> const& map)
+{
+    WriteU32(out, static_cast<uint32_t>(map.size()));
+    for (auto& entry: map)
+    {
+        WriteString(out, entry.first);
+        WriteString(out, entry.second);
+    }
+}
+
+static void WriteU64(std::ostream& out, uint64_t value)
+{
+    WriteU32(out, static_cast<uint32_t>(value));
+    WriteU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+static uint32_t ReadU32(std::istream& in)
+{
+    uint32_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+static uint64_t ReadU64(std::istream& in)
+{
+    const uint64_t lo = ReadU32(in);
+    const uint64_t hi = ReadU32(in);
+    return lo | (hi << 32);
+}
+
+static std::string ReadString(std::istream& in)
+{
+    const uint32_t size = ReadU32(in);
+    if (!in.good() || size > 0xFFFFF) // Corrupted
+    {
+        in.setstate(std::ios::failbit);
+        return "";
+    }
+    std::string str(size, '\0');
+    in.read(&str[0], size);
+    return str;
+}
+
+static void ReadStringMap(std::istream& in, std::map<std::string, std::string>& map)
+{
+    const uint32_t size = ReadU32(in);
+    for (uint32_t i = 0; i < size && in.good(); i++)
+    {
+        std::string key = ReadString(in);
+        map[key] = ReadString(in);
+    }
+}
+
+void RoR::SkinManager::LoadCache()
+{
+    std::ifstream in(GetSkinCachePath(), std::ios::binary);
+    if (!in.is_open() || ReadU32(in) != SKIN_CACHE_MAGIC || ReadU32(in) != SKIN_CACHE_VERSION)
+        return;
+
+    const uint32_t num_files = ReadU32(in);
+    for (uint32_t f = 0; f < num_files && in.good(); f++)
+    {
+        const std::string key = ReadString(in);
+        CachedFile file;
+        file.disk_path = ReadString(in);
+        file.file_size = ReadU64(in);
+        file.mtime     = static_cast<int64_t>(ReadU64(in));
+        const uint32_t num_skins = ReadU32(in);
+        for (uint32_t s = 0; s < num_skins && in.good(); s++)
+        {
+            SkinDef def;
+            def.name        = ReadString(in);
+            def.guid        = ReadString(in);
+            def.thumbnail   = ReadString(in);
+            def.description = ReadString(in);
+            def.author_name = ReadString(in);
+            def.author_id   = static_cast<int>(ReadU32(in));
+            ReadStringMap(in, def.replace_textures);
+            ReadStringMap(in, def.replace_materials);
+            file.skins.push_back(def);
+        }
+        if (!in.good())
+        {
+            break;
+        }
+        if (!RoR::FileExists(file.disk_path))
+        {
+            m_file_cache_dirty = true; // Prune files which were removed
+            continue;
+        }
+        m_file_cache[key] = file;
+    }
+
+    if (!in.good())
+    {
+        LOG("[RoR|SkinManager] Skin cache is corrupted, skins will be parsed again");
+        m_file_cache.clear();
+        m_file_cache_dirty = true;
+    }
+}
+
+void RoR::SkinManager::SaveCache()
+{
+    if (!m_file_cache_dirty)
+        return;
+
+    std::ofstream out(GetSkinCachePath(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        LOG("[RoR|SkinManager] Cannot write skin cache: " + GetSkinCachePath());
+        return;
+    }
+
+    WriteU32(out, SKIN_CACHE_MAGIC);
+    WriteU32(out, SKIN_CACHE_VERSION);
+    WriteU32(out, static_cast<uint32_t>(m_file_cache.size()));
+    for (auto& entry: m_file_cache)
+    {
+        WriteString(out, entry.first);
+        WriteString(out, entry.second.disk_path);
+        WriteU64(out, entry.second.file_size);
+        WriteU64(out, static_cast<uint64_t>(entry.second.mtime));
+        WriteU32(out, static_cast<uint32_t>(entry.second.skins.size()));
+        for (SkinDef const& def: entry.second.skins)
+        {
+            WriteString(out, def.name);
+            WriteString(out, def.guid);
+            WriteString(out, def.thumbnail);
+            WriteString(out, def.description);
+            WriteString(out, def.author_name);
+            WriteU32(out, static_cast<uint32_t>(def.author_id));
+            WriteStringMap(out, def.replace_textures);
+            WriteStringMap(out, def.replace_materials);
+        }
+    }
+    m_file_cache_dirty = false;
+}
+
+// -------------------------------- Materials --------------------------------
+
+void RoR::SkinManager::ReplaceMaterialTextures(SkinDef* skin_def, std::string materialName, std::string const& source_material) // Static
 {
-    const auto not_found = skin_def->replace_textures.end();
     Ogre::MaterialPtr mat = RoR::OgreSubsystem::GetMaterialByName(materialName);
-    if (!mat.isNull())
+    if (mat.isNull())
+        return;
+
+    // Clones of an already processed material: just apply the swaps
+    if (!source_material.empty())
     {
-        for (int t = 0; t < mat->getNumTechniques(); t++)
+        auto memo = skin_def->texture_swaps.find(source_material);
+        if (memo != skin_def->texture_swaps.end())
         {
-            Ogre::Technique* tech = mat->getTechnique(0);
-            if (!tech)
+            for (SkinDef::TextureSwap const& swap: memo->second)
+            {
+                if (swap.technique < mat->getNumTechniques() &&
+                    swap.pass < mat->getTechnique(swap.technique)->getNumPasses() &&
+                    swap.unit < mat->getTechnique(swap.technique)->getPass(swap.pass)->getNumTextureUnitStates())
+                {
+                    mat->getTechnique(swap.technique)->getPass(swap.pass)->getTextureUnitState(swap.unit)->setFrameTextureName(swap.texture, swap.frame);
+                }
+            }
+            return;
+        }
+    }
+
+    const auto not_found = skin_def->replace_textures.end();
+    std::vector<SkinDef::TextureSwap> swaps;
+    for (unsigned short t = 0; t < mat->getNumTechniques(); t++)
+    {
+        Ogre::Technique* tech = mat->getTechnique(t);
+        if (!tech)
+            continue;
+        for (unsigned short p = 0; p < tech->getNumPasses(); p++)
+        {
+            Ogre::Pass* pass = tech->getPass(p);
+            if (!pass)
                 continue;
-            for (int p = 0; p < tech->getNumPasses(); p++)
+            for (unsigned short tu = 0; tu < pass->getNumTextureUnitStates(); tu++)
             {
-                Ogre::Pass* pass = tech->getPass(p);
-                if (!pass)
+                Ogre::TextureUnitState* tus = pass->getTextureUnitState(tu);
+                if (!tus)
                     continue;
-                for (int tu = 0; tu < pass->getNumTextureUnitStates(); tu++)
-                {
-                    Ogre::TextureUnitState* tus = pass->getTextureUnitState(tu);
-                    if (!tus)
-                        continue;
 
-                    //if (tus->getTextureType() != TEX_TYPE_2D) continue; // only replace 2d images
-                    // walk the frames, usually there is only one
-                    for (unsigned int fr = 0; fr < tus->getNumFrames(); fr++)
+                //if (tus->getTextureType() != TEX_TYPE_2D) continue; // only replace 2d images
+                // walk the frames, usually there is only one
+                for (unsigned int fr = 0; fr < tus->getNumFrames(); fr++)
+                {
+                    auto it = skin_def->replace_textures.find(tus->getFrameTextureName(fr));
+                    if (it != not_found)
                     {
-                        Ogre::String textureName = tus->getFrameTextureName(fr);
-                        std::map<Ogre::String, Ogre::String>::iterator it = skin_def->replace_textures.find(textureName);
-                        if (it != not_found)
-                        {
-                            textureName = it->second; //getReplacementForTexture(textureName);
-                            tus->setFrameTextureName(textureName, fr);
-                        }
+                        tus->setFrameTextureName(it->second, fr);
+                        SkinDef::TextureSwap swap = { t, p, tu, fr, it->second };
+                        swaps.push_back(swap);
                     }
                 }
             }
         }
     }
+
+    if (!source_material.empty())
+    {
+        skin_def->texture_swaps.insert(std::make_pair(source_material, swaps));
+    }
 }
 
 void RoR::SkinManager::ApplySkinTextureReplacements(RoR::SkinDef* skin_def, Ogre::Entity* e) // Static
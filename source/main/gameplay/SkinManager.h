@@ -25,7 +25,9 @@
 
 #include <OgreResourceManager.h>
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -33,6 +35,18 @@ namespace RoR {
 
 struct SkinDef
 {
+    SkinDef(): author_id(-1) {}
+
+    /// One texture frame to change in a material; see `SkinManager::ReplaceMaterialTextures()`
+    struct TextureSwap
+    {
+        unsigned short technique;
+        unsigned short pass;
+        unsigned short unit;
+        unsigned int   frame;
+        std::string    texture;
+    };
+
     std::map<std::string, std::string>  replace_textures;
     std::map<std::string, std::string>  replace_materials;
     std::string   name;
@@ -41,6 +55,8 @@ struct SkinDef
     std::string   description;
     std::string   author_name;
     int           author_id;
+
+    std::map<std::string, std::vector<TextureSwap>> texture_swaps; //!< Memo: source material name -> swaps for its clones
 };
 
 /// Manages Skin resources, parsing .skin files and generally organizing them.
@@ -51,6 +67,7 @@ public:
     ~SkinManager();
 
     void GetUsableSkins(std::string guid, std::vector<SkinDef *>& skins);
+    void SaveCache(); //!< Writes parsed skin definitions to the cache directory, if any file had to be parsed
     static void ApplySkinTextureReplacements(SkinDef* skin_def, Ogre::Entity* e);
 
     // == Ogre::ResourceManager interface functions ==
@@ -74,13 +91,30 @@ public:
     void removeAll  () override;
     void reloadAll  (bool reloadableOnly = true) override;
 
-    static void ReplaceMaterialTextures(SkinDef* skin_def, std::string materialName);
+    /// @param source_material If `materialName` is a clone, name of the original; the texture swaps
+    ///                        are then found only once per (material, skin) and reused for other clones.
+    static void ReplaceMaterialTextures(SkinDef* skin_def, std::string materialName, std::string const& source_material = "");
 
 private:
 
+    struct CachedFile
+    {
+        std::string          disk_path; //!< File or zip archive whose removal makes the entry obsolete
+        uint64_t             file_size;
+        int64_t              mtime;
+        std::vector<SkinDef> skins;
+    };
+
     void ParseSkinAttribute(const std::string& line, SkinDef* skin_def);
+    void RegisterSkin(SkinDef const& def); //!< Adds a new skin or merges attributes into the one with the same name
+    void IndexSkin(SkinDef* skin);
+    bool FindFileInfo(std::string const& filename, std::string const& group, std::string& out_key, CachedFile& out_info);
+    void LoadCache();
 
     std::map<std::string, SkinDef*> m_skins;
+    std::unordered_map<std::string, std::vector<SkinDef*>> m_skins_by_guid; //!< Each list sorted by name
+    std::map<std::string, CachedFile> m_file_cache;       //!< Key: archive + file name
+    bool                              m_file_cache_dirty;
 };
 
 }; // namespace RoR
@@ -0,0 +1,108 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Binary layout of telemetry packets (see TelemetryStream.h)
+///
+/// Intentionally free of Ogre/RoR dependencies so external receivers
+/// (i.e. tools/telemetry_receiver) can include it directly.
+///
+/// Packet layout (little endian, no padding):
+///     PacketHeader
+///     num_samples x { VehicleSample, num_wheels x WheelSample, num_nodes x NodeSample }
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RoR {
+namespace Telemetry {
+
+static const char     PACKET_MAGIC[4]  = { 'R', 'o', 'R', 'T' };
+static const uint16_t PROTOCOL_VERSION = 1;
+static const size_t   MAX_PACKET_SIZE  = 1400; ///< Stay below common ethernet MTU to avoid IP fragmentation
+static const uint16_t MAX_NODES        = 32;   ///< Upper limit of explicitly sampled nodes
+
+enum SampleFlags
+{
+    FLAG_HAS_ENGINE     = 1 << 0,
+    FLAG_ENGINE_RUNNING = 1 << 1,
+    FLAG_PARKING_BRAKE  = 1 << 2,
+    FLAG_TC_ACTIVE      = 1 << 3,
+    FLAG_ABS_ACTIVE     = 1 << 4,
+    FLAG_REPLAY         = 1 << 5,
+};
+
+#pragma pack(push, 1)
+
+struct PacketHeader
+{
+    char     magic[4];          ///< PACKET_MAGIC
+    uint16_t version;           ///< PROTOCOL_VERSION
+    uint16_t num_samples;
+    uint32_t sequence;          ///< Increments with every packet; gaps indicate packet loss
+    uint32_t actor_instance_id;
+    uint16_t num_wheels;        ///< WheelSample-s per sample
+    uint16_t num_nodes;         ///< NodeSample-s per sample
+    uint16_t sample_size;       ///< Total bytes per sample, including wheels and nodes
+};
+
+struct VehicleSample
+{
+    double   sim_time;          ///< Seconds of simulated time
+    float    position[3];       ///< World position of the reference node, meters
+    float    velocity[3];       ///< World velocity of the reference node, m/s
+    float    orientation[4];    ///< Quaternion {w, x, y, z} of the reference frame (camera nodes)
+    float    gforce[3];         ///< {vertical, longitudinal, lateral} acceleration in g
+    float    engine_rpm;
+    float    engine_turbo_psi;
+    float    throttle;          ///< 0 - 1
+    float    brake;             ///< 0 - 1
+    float    clutch;            ///< 0 - 1; 1 = fully engaged
+    float    steering;          ///< -1 - 1
+    float    wheel_speed;       ///< m/s
+    int8_t   gear;              ///< -1 = reverse, 0 = neutral
+    uint8_t  flags;             ///< SampleFlags
+};
+
+struct WheelSample
+{
+    float    speed;             ///< m/s at the tyre surface
+    float    delta_rotation;    ///< Rotation since the previous physics step, radians
+    uint8_t  contact;           ///< 1 if any of the wheel's nodes touches ground
+    uint8_t  detached;
+};
+
+struct NodeSample
+{
+    uint16_t node_index;        ///< Index in actor's node array
+    float    position[3];       ///< World position, meters
+    float    velocity[3];       ///< m/s
+};
+
+#pragma pack(pop)
+
+inline size_t CalcSampleSize(uint16_t num_wheels, uint16_t num_nodes)
+{
+    return sizeof(VehicleSample) + (num_wheels * sizeof(WheelSample)) + (num_nodes * sizeof(NodeSample));
+}
+
+} // namespace Telemetry
+} // namespace RoR
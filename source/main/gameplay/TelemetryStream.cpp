@@ -0,0 +1,479 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TelemetryStream.h"
+
+#include "Application.h"
+#include "Beam.h"
+#include "BeamEngine.h"
+#include "TerrainManager.h"
+
+#include <Ogre.h>
+#include <cstring>
+
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <fcntl.h>
+#   include <netdb.h>
+#   include <sys/socket.h>
+#   include <sys/types.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace Ogre;
+
+namespace RoR {
+
+// ================================================================================================
+// Sinks
+// ================================================================================================
+
+#ifdef _WIN32
+static const intptr_t INVALID_SOCK = (intptr_t)INVALID_SOCKET;
+#else
+static const intptr_t INVALID_SOCK = -1;
+#endif
+
+UdpTelemetrySink::UdpTelemetrySink():
+    m_socket(INVALID_SOCK)
+{}
+
+UdpTelemetrySink::~UdpTelemetrySink()
+{
+    if (m_socket == INVALID_SOCK)
+        return;
+#ifdef _WIN32
+    closesocket((SOCKET)m_socket);
+    WSACleanup();
+#else
+    close((int)m_socket);
+#endif
+}
+
+bool UdpTelemetrySink::Connect(const char* host, int port)
+{
+#ifdef _WIN32
+    WSADATA wsd;
+    if (WSAStartup(MAKEWORD(2, 2), &wsd) != 0)
+    {
+        LOG("[RoR|Telemetry] Error starting up winsock");
+        return false;
+    }
+#endif
+
+    char port_str[20];
+    snprintf(port_str, 20, "%d", port);
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* result = nullptr;
+    int err = getaddrinfo(host, port_str, &hints, &result);
+    if (err != 0)
+    {
+        LogFormat("[RoR|Telemetry] Cannot resolve '%s': %s", host, gai_strerror(err));
+        return false;
+    }
+
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next)
+    {
+        intptr_t sock = (intptr_t)socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (sock == INVALID_SOCK)
+            continue;
+
+        // UDP connect() only sets the default destination; no handshake happens
+        if (connect(sock, ai->ai_addr, (int)ai->ai_addrlen) == 0)
+        {
+#ifdef _WIN32
+            u_long nonblocking = 1;
+            ioctlsocket((SOCKET)sock, FIONBIO, &nonblocking);
+#else
+            fcntl((int)sock, F_SETFL, fcntl((int)sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+            m_socket = sock;
+            break;
+        }
+#ifdef _WIN32
+        closesocket((SOCKET)sock);
+#else
+        close((int)sock);
+#endif
+    }
+    freeaddrinfo(result);
+
+    if (m_socket == INVALID_SOCK)
+    {
+        LogFormat("[RoR|Telemetry] Cannot open UDP socket to %s:%d", host, port);
+        return false;
+    }
+
+    LogFormat("[RoR|Telemetry] Sending UDP datagrams to %s:%d", host, port);
+    return true;
+}
+
+bool UdpTelemetrySink::Send(const char* data, size_t len)
+{
+    if (m_socket == INVALID_SOCK)
+        return false;
+#ifdef _WIN32
+    return ::send((SOCKET)m_socket, data, (int)len, 0) == (int)len;
+#else
+    return ::send((int)m_socket, data, len, MSG_DONTWAIT) == (ssize_t)len;
+#endif
+}
+
+#ifndef _WIN32
+
+UnixTelemetrySink::UnixTelemetrySink():
+    m_socket(-1)
+{}
+
+UnixTelemetrySink::~UnixTelemetrySink()
+{
+    if (m_socket != -1)
+        close(m_socket);
+}
+
+bool UnixTelemetrySink::Connect(const char* path)
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        LogFormat("[RoR|Telemetry] Socket path too long: '%s'", path);
+        return false;
+    }
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    m_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (m_socket == -1)
+    {
+        LogFormat("[RoR|Telemetry] Cannot create unix socket: %s", strerror(errno));
+        return false;
+    }
+
+    if (connect(m_socket, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        LogFormat("[RoR|Telemetry] Cannot connect to '%s': %s (is the receiver running?)", path, strerror(errno));
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+
+    LogFormat("[RoR|Telemetry] Sending datagrams to unix socket '%s'", path);
+    return true;
+}
+
+bool UnixTelemetrySink::Send(const char* data, size_t len)
+{
+    if (m_socket == -1)
+        return false;
+    return ::send(m_socket, data, len, MSG_DONTWAIT) == (ssize_t)len;
+}
+
+#endif // !_WIN32
+
+// ================================================================================================
+// Stream
+// ================================================================================================
+
+TelemetryStream::TelemetryStream(std::unique_ptr<TelemetrySink> sink, float sample_rate, std::vector<uint16_t> nodes):
+    m_sink(std::move(sink)),
+    m_actor(nullptr),
+    m_config_nodes(nodes),
+    m_packet(Telemetry::MAX_PACKET_SIZE),
+    m_packet_len(0),
+    m_sample_size(0),
+    m_num_wheels(0),
+    m_num_samples(0),
+    m_sequence(0),
+    m_sample_interval(1.f / std::max(1.f, sample_rate)),
+    m_time_since_sample(0.f),
+    m_sim_time(0.0),
+    m_prev_velocity(Vector3::ZERO),
+    m_num_packets_sent(0),
+    m_num_packets_dropped(0)
+{
+    if (m_config_nodes.size() > Telemetry::MAX_NODES)
+        m_config_nodes.resize(Telemetry::MAX_NODES);
+}
+
+std::unique_ptr<TelemetryStream> TelemetryStream::CreateFromConfig()
+{
+    std::unique_ptr<TelemetrySink> sink;
+    const int mode = App::io_telemetry_mode.GetActive();
+    if (mode == MODE_UDP)
+    {
+        std::string target = App::io_telemetry_target.GetActive();
+        size_t colon = target.rfind(':');
+        if (colon == std::string::npos)
+        {
+            LogFormat("[RoR|Telemetry] Invalid target '%s', expected 'host:port'", target.c_str());
+            return nullptr;
+        }
+        std::unique_ptr<UdpTelemetrySink> udp(new UdpTelemetrySink());
+        if (!udp->Connect(target.substr(0, colon).c_str(), atoi(target.c_str() + colon + 1)))
+            return nullptr;
+        sink = std::move(udp);
+    }
+#ifndef _WIN32
+    else if (mode == MODE_UNIX_SOCKET)
+    {
+        std::unique_ptr<UnixTelemetrySink> uds(new UnixTelemetrySink());
+        if (!uds->Connect(App::io_telemetry_target.GetActive()))
+            return nullptr;
+        sink = std::move(uds);
+    }
+#endif
+    else
+    {
+        return nullptr;
+    }
+
+    std::vector<uint16_t> nodes;
+    for (String& tok: StringUtil::split(App::io_telemetry_nodes.GetActive(), ", "))
+    {
+        nodes.push_back(static_cast<uint16_t>(StringConverter::parseInt(tok)));
+    }
+
+    return std::unique_ptr<TelemetryStream>(
+        new TelemetryStream(std::move(sink), App::io_telemetry_rate.GetActive(), nodes));
+}
+
+void TelemetryStream::SetActor(Actor* actor)
+{
+    if (actor == m_actor)
+        return;
+
+    this->Flush(); // Packets never mix actors
+    m_actor = actor;
+    m_time_since_sample = m_sample_interval; // Sample on next step
+    m_active_nodes.clear();
+    m_num_wheels = 0;
+    if (!actor)
+        return;
+
+    m_num_wheels = static_cast<uint16_t>(actor->ar_num_wheels);
+    for (uint16_t node: m_config_nodes)
+    {
+        if (node < actor->ar_num_nodes)
+            m_active_nodes.push_back(node);
+    }
+
+    // A single sample must always fit a packet
+    while (!m_active_nodes.empty() &&
+           sizeof(Telemetry::PacketHeader) + Telemetry::CalcSampleSize(m_num_wheels, m_active_nodes.size()) > Telemetry::MAX_PACKET_SIZE)
+    {
+        m_active_nodes.pop_back();
+    }
+    m_sample_size = Telemetry::CalcSampleSize(m_num_wheels, static_cast<uint16_t>(m_active_nodes.size()));
+    if (sizeof(Telemetry::PacketHeader) + m_sample_size > Telemetry::MAX_PACKET_SIZE)
+    {
+        LogFormat("[RoR|Telemetry] Actor '%s' has too many wheels, telemetry disabled for it", actor->ar_design_name.c_str());
+        m_actor = nullptr;
+        return;
+    }
+
+    int ref_node = actor->ar_camera_node_pos[0];
+    m_prev_velocity = actor->IsNodeIdValid(ref_node) ? actor->ar_nodes[ref_node].Velocity : Vector3::ZERO;
+}
+
+void TelemetryStream::RecordPhysicsStep(float dt)
+{
+    m_sim_time += dt;
+    if (!m_actor)
+        return;
+
+    m_time_since_sample += dt;
+    if (m_time_since_sample < m_sample_interval)
+        return;
+
+    if (m_num_samples > 0 && m_packet_len + m_sample_size > Telemetry::MAX_PACKET_SIZE)
+        this->Flush();
+    if (m_num_samples == 0)
+        this->BeginPacket();
+
+    this->WriteSample();
+    m_time_since_sample = std::fmod(m_time_since_sample, m_sample_interval);
+}
+
+void TelemetryStream::Flush()
+{
+    if (m_num_samples == 0)
+        return;
+
+    Telemetry::PacketHeader* header = reinterpret_cast<Telemetry::PacketHeader*>(m_packet.data());
+    header->num_samples = m_num_samples;
+
+    if (m_sink->Send(m_packet.data(), m_packet_len))
+        m_num_packets_sent++;
+    else
+        m_num_packets_dropped++; // Receiver not listening or too slow; never block the simulation
+
+    m_num_samples = 0;
+    m_packet_len = 0;
+}
+
+void TelemetryStream::BeginPacket()
+{
+    Telemetry::PacketHeader* header = reinterpret_cast<Telemetry::PacketHeader*>(m_packet.data());
+    memcpy(header->magic, Telemetry::PACKET_MAGIC, 4);
+    header->version           = Telemetry::PROTOCOL_VERSION;
+    header->num_samples       = 0;
+    header->sequence          = m_sequence++;
+    header->actor_instance_id = static_cast<uint32_t>(m_actor->ar_instance_id);
+    header->num_wheels        = m_num_wheels;
+    header->num_nodes         = static_cast<uint16_t>(m_active_nodes.size());
+    header->sample_size       = static_cast<uint16_t>(m_sample_size);
+    m_packet_len = sizeof(Telemetry::PacketHeader);
+}
+
+void TelemetryStream::CalcReferenceFrame(Vector3& dir, Vector3& roll, Vector3& up)
+{
+    const int pos_node  = m_actor->ar_camera_node_pos[0];
+    const int dir_node  = m_actor->ar_camera_node_dir[0];
+    const int roll_node = m_actor->ar_camera_node_roll[0];
+    if (!m_actor->IsNodeIdValid(pos_node) || !m_actor->IsNodeIdValid(dir_node) || !m_actor->IsNodeIdValid(roll_node))
+    {
+        dir = Vector3::NEGATIVE_UNIT_Z;
+        roll = Vector3::NEGATIVE_UNIT_X;
+        up = Vector3::UNIT_Y;
+        return;
+    }
+
+    // Same frame of reference as `Actor::getGForces()`
+    dir  = (m_actor->ar_nodes[pos_node].RelPosition - m_actor->ar_nodes[dir_node].RelPosition).normalisedCopy();
+    roll = (m_actor->ar_nodes[pos_node].RelPosition - m_actor->ar_nodes[roll_node].RelPosition).normalisedCopy();
+    up   = dir.crossProduct(-roll).normalisedCopy();
+}
+
+void TelemetryStream::WriteSample()
+{
+    char* out = m_packet.data() + m_packet_len;
+    Telemetry::VehicleSample* vs = reinterpret_cast<Telemetry::VehicleSample*>(out);
+    memset(vs, 0, sizeof(Telemetry::VehicleSample));
+
+    int ref_node = m_actor->ar_camera_node_pos[0];
+    if (!m_actor->IsNodeIdValid(ref_node))
+        ref_node = 0;
+    const node_t& ref = m_actor->ar_nodes[ref_node];
+
+    Vector3 dir, roll, up;
+    this->CalcReferenceFrame(dir, roll, up);
+
+    const float elapsed = std::max(m_time_since_sample, 0.0001f);
+    const Vector3 acc = (ref.Velocity - m_prev_velocity) / elapsed;
+    m_prev_velocity = ref.Velocity;
+
+    float gravity = DEFAULT_GRAVITY;
+    if (App::GetSimTerrain())
+        gravity = App::GetSimTerrain()->getGravity();
+    gravity = std::abs(gravity);
+
+    const Vector3 z_axis = -dir; // Ogre convention: -Z is forward
+    const Vector3 x_axis = up.crossProduct(z_axis).normalisedCopy();
+    const Quaternion orientation(x_axis, z_axis.crossProduct(x_axis), z_axis);
+
+    vs->sim_time       = m_sim_time;
+    vs->position[0]    = ref.AbsPosition.x;
+    vs->position[1]    = ref.AbsPosition.y;
+    vs->position[2]    = ref.AbsPosition.z;
+    vs->velocity[0]    = ref.Velocity.x;
+    vs->velocity[1]    = ref.Velocity.y;
+    vs->velocity[2]    = ref.Velocity.z;
+    vs->orientation[0] = orientation.w;
+    vs->orientation[1] = orientation.x;
+    vs->orientation[2] = orientation.y;
+    vs->orientation[3] = orientation.z;
+    vs->gforce[0]      = (gravity - acc.dotProduct(-up)) / gravity;
+    vs->gforce[1]      = acc.dotProduct(dir) / gravity;
+    vs->gforce[2]      = acc.dotProduct(roll) / gravity;
+    vs->brake          = (m_actor->ar_brake_force > 0.f) ? (m_actor->ar_brake / m_actor->ar_brake_force) : 0.f;
+    vs->steering       = m_actor->ar_hydro_dir_state;
+    vs->wheel_speed    = m_actor->ar_wheel_speed;
+
+    uint8_t flags = 0;
+    if (m_actor->ar_engine)
+    {
+        vs->engine_rpm       = m_actor->ar_engine->GetEngineRpm();
+        vs->engine_turbo_psi = m_actor->ar_engine->GetTurboPsi();
+        vs->throttle         = m_actor->ar_engine->GetAcceleration();
+        vs->clutch           = m_actor->ar_engine->GetClutch();
+        vs->gear             = static_cast<int8_t>(m_actor->ar_engine->GetGear());
+        flags |= Telemetry::FLAG_HAS_ENGINE;
+        if (m_actor->ar_engine->IsRunning())
+            flags |= Telemetry::FLAG_ENGINE_RUNNING;
+    }
+    if (m_actor->ar_parking_brake)
+        flags |= Telemetry::FLAG_PARKING_BRAKE;
+    if (m_actor->tc_mode)
+        flags |= Telemetry::FLAG_TC_ACTIVE;
+    if (m_actor->alb_mode)
+        flags |= Telemetry::FLAG_ABS_ACTIVE;
+    if (m_actor->ar_replay_mode)
+        flags |= Telemetry::FLAG_REPLAY;
+    vs->flags = flags;
+    out += sizeof(Telemetry::VehicleSample);
+
+    for (int i = 0; i < m_num_wheels; i++)
+    {
+        const wheel_t& wheel = m_actor->ar_wheels[i];
+        Telemetry::WheelSample ws;
+        ws.speed = wheel.wh_speed;
+        ws.delta_rotation = m_actor->GetDrivetrain().GetHub(i).delta_rotation;
+        ws.detached = wheel.wh_is_detached ? 1 : 0;
+        ws.contact = 0;
+        for (int n = 0; n < wheel.wh_num_nodes; n++)
+        {
+            if (wheel.wh_nodes[n]->contacted)
+            {
+                ws.contact = 1;
+                break;
+            }
+        }
+        memcpy(out, &ws, sizeof(ws));
+        out += sizeof(ws);
+    }
+
+    for (uint16_t node_index: m_active_nodes)
+    {
+        const node_t& node = m_actor->ar_nodes[node_index];
+        Telemetry::NodeSample ns;
+        ns.node_index = node_index;
+        ns.position[0] = node.AbsPosition.x;
+        ns.position[1] = node.AbsPosition.y;
+        ns.position[2] = node.AbsPosition.z;
+        ns.velocity[0] = node.Velocity.x;
+        ns.velocity[1] = node.Velocity.y;
+        ns.velocity[2] = node.Velocity.z;
+        memcpy(out, &ns, sizeof(ns));
+        out += sizeof(ns);
+    }
+
+    m_packet_len += m_sample_size;
+    m_num_samples++;
+}
+
+} // namespace RoR
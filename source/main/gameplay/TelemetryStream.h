@@ -0,0 +1,125 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Physics-rate telemetry output for motion rigs and data loggers.
+///
+/// Samples are recorded on the simulation thread after physics sub-steps,
+/// batched into packets (see TelemetrySchema.h) and sent through a
+/// non-blocking datagram socket. Configured by GVars `io_telemetry_*`.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+#include "TelemetrySchema.h"
+
+#include <OgreVector3.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// Datagram destination. Implementations must never block - when the receiver
+/// can't keep up, data is dropped.
+class TelemetrySink
+{
+public:
+    virtual ~TelemetrySink() {}
+    virtual bool Send(const char* data, size_t len) = 0;
+};
+
+/// UDP (IPv4/IPv6) datagram socket. Also used by OutGauge.
+class UdpTelemetrySink: public TelemetrySink
+{
+public:
+    UdpTelemetrySink();
+    ~UdpTelemetrySink();
+
+    bool Connect(const char* host, int port);
+    bool Send(const char* data, size_t len) override;
+
+private:
+    intptr_t m_socket;
+};
+
+#ifndef _WIN32
+/// Unix domain datagram socket; lowest overhead for receivers on the same machine.
+class UnixTelemetrySink: public TelemetrySink
+{
+public:
+    UnixTelemetrySink();
+    ~UnixTelemetrySink();
+
+    bool Connect(const char* path);
+    bool Send(const char* data, size_t len) override;
+
+private:
+    int m_socket;
+};
+#endif // !_WIN32
+
+class TelemetryStream
+{
+public:
+    enum Mode { MODE_DISABLED = 0, MODE_UDP = 1, MODE_UNIX_SOCKET = 2 };
+
+    /// @param sample_rate Samples per second; values >= physics rate sample every sub-step.
+    /// @param nodes Node indices to include in each sample.
+    TelemetryStream(std::unique_ptr<TelemetrySink> sink, float sample_rate, std::vector<uint16_t> nodes);
+
+    /// Creates the stream as configured by GVars `io_telemetry_*`
+    /// @return nullptr if disabled or the sink couldn't be opened.
+    static std::unique_ptr<TelemetryStream> CreateFromConfig();
+
+    /// Main thread, only while the simulation thread is idle.
+    void SetActor(Actor* actor);
+    /// Simulation thread, after each physics sub-step.
+    void RecordPhysicsStep(float dt);
+    /// Simulation thread, at the end of physics frame; sends any pending samples.
+    void Flush();
+
+    size_t GetNumPacketsSent() const   { return m_num_packets_sent; }
+    size_t GetNumPacketsDropped() const { return m_num_packets_dropped; }
+
+private:
+    void BeginPacket();
+    void WriteSample();
+    void CalcReferenceFrame(Ogre::Vector3& dir, Ogre::Vector3& roll, Ogre::Vector3& up);
+
+    std::unique_ptr<TelemetrySink> m_sink;
+    Actor*                   m_actor;
+    std::vector<uint16_t>    m_config_nodes;    ///< As configured
+    std::vector<uint16_t>    m_active_nodes;    ///< Valid for current actor
+    std::vector<char>        m_packet;          ///< Staging buffer, MAX_PACKET_SIZE
+    size_t                   m_packet_len;
+    size_t                   m_sample_size;
+    uint16_t                 m_num_wheels;
+    uint16_t                 m_num_samples;
+    uint32_t                 m_sequence;
+    float                    m_sample_interval;
+    float                    m_time_since_sample;
+    double                   m_sim_time;
+    Ogre::Vector3            m_prev_velocity;
+    size_t                   m_num_packets_sent;
+    size_t                   m_num_packets_dropped;
+};
+
+} // namespace RoR
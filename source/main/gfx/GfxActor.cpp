@@ -23,6 +23,7 @@
 
 #include "Beam.h"
 #include "GlobalEnvironment.h" // TODO: Eliminate!
+#include "SharedMaterialCache.h"
 #include "SkyManager.h"
 #include "TerrainManager.h"
 
@@ -30,6 +31,7 @@
 #include <OgreRenderWindow.h>
 #include <OgreResourceGroupManager.h>
 #include <OgreSceneManager.h>
+#include <OgreSubEntity.h>
 #include <OgreTechnique.h>
 #include <OgreTextureUnitState.h>
 #include <OgreTextureManager.h>
@@ -54,6 +56,28 @@ RoR::GfxActor::~GfxActor()
     }
 
     Ogre::ResourceGroupManager::getSingleton().destroyResourceGroup(m_custom_resource_group);
+
+    if (m_shared_material_cache != nullptr)
+    {
+        for (std::string const& key: m_shared_material_keys)
+        {
+            m_shared_material_cache->Release(key);
+        }
+    }
+}
+
+Ogre::MaterialPtr RoR::GfxActor::MakeMaterialUnique(Ogre::SubEntity* subent)
+{
+    Ogre::MaterialPtr mat = subent->getMaterial();
+    if (m_shared_material_cache == nullptr || !m_shared_material_cache->IsShared(mat))
+        return mat;
+
+    // The shared reference is kept until this actor is deleted - other sub-entities may still use it.
+    char name[300];
+    snprintf(name, 300, "%s@Unique-%p", mat->getName().c_str(), static_cast<void*>(subent));
+    Ogre::MaterialPtr own_mat = mat->clone(name, true, m_custom_resource_group);
+    subent->setMaterial(own_mat);
+    return own_mat;
 }
 
 void RoR::GfxActor::AddMaterialFlare(int flareid, Ogre::MaterialPtr m)
@@ -97,6 +97,7 @@ public:
     GfxActor(Actor* actor, std::string ogre_resource_group):
         m_actor(actor),
         m_custom_resource_group(ogre_resource_group),
+        m_shared_material_cache(nullptr),
         m_vidcam_state(VideoCamState::VCSTATE_ENABLED_ONLINE)
     {}
 
@@ -110,11 +111,14 @@ public:
     void                 SetVideoCamState    (VideoCamState state);
     inline VideoCamState GetVideoCamState    () const { return m_vidcam_state; }
     void                 UpdateVideoCameras  (float dt_sec);
+    Ogre::MaterialPtr    MakeMaterialUnique  (Ogre::SubEntity* subent); ///< Copy-on-write for materials shared with other actors; returns the sub-entity's (now own) material.
 
 private:
 
     Actor*                      m_actor;
     std::string                 m_custom_resource_group; ///< Stores OGRE resources individual to this actor
+    SharedMaterialCache*        m_shared_material_cache;
+    std::vector<std::string>    m_shared_material_keys;  ///< References held in `m_shared_material_cache`
     std::vector<FlareMaterial>  m_flare_materials;
     VideoCamState               m_vidcam_state;
     std::vector<VideoCamera>    m_videocameras;
@@ -0,0 +1,84 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SharedMaterialCache.h"
+
+#include <OgreMaterialManager.h>
+#include <OgreResourceGroupManager.h>
+
+using namespace RoR;
+
+const char* SharedMaterialCache::RESOURCE_GROUP = "SharedActorMaterials";
+
+SharedMaterialCache::SharedMaterialCache()
+    : m_name_counter(0)
+{
+    if (!Ogre::ResourceGroupManager::getSingleton().resourceGroupExists(RESOURCE_GROUP))
+    {
+        Ogre::ResourceGroupManager::getSingleton().createResourceGroup(RESOURCE_GROUP);
+    }
+}
+
+SharedMaterialCache::~SharedMaterialCache()
+{
+    m_entries.clear();
+    Ogre::ResourceGroupManager::getSingleton().destroyResourceGroup(RESOURCE_GROUP);
+}
+
+Ogre::MaterialPtr SharedMaterialCache::Acquire(std::string const& key)
+{
+    auto itor = m_entries.find(key);
+    if (itor == m_entries.end())
+    {
+        return Ogre::MaterialPtr();
+    }
+    ++itor->second.num_refs;
+    return itor->second.material;
+}
+
+Ogre::MaterialPtr SharedMaterialCache::Create(std::string const& key, Ogre::MaterialPtr const& src)
+{
+    char name[300];
+    snprintf(name, 300, "%s@Shared-%u", src->getName().c_str(), static_cast<unsigned>(m_name_counter++));
+
+    Entry entry;
+    entry.material = src->clone(name, true, RESOURCE_GROUP);
+    entry.num_refs = 1;
+    m_entries[key] = entry;
+    return entry.material;
+}
+
+void SharedMaterialCache::Release(std::string const& key)
+{
+    auto itor = m_entries.find(key);
+    if (itor == m_entries.end())
+    {
+        return;
+    }
+    if (--itor->second.num_refs <= 0)
+    {
+        Ogre::MaterialManager::getSingleton().remove(itor->second.material->getHandle());
+        m_entries.erase(itor);
+    }
+}
+
+bool SharedMaterialCache::IsShared(Ogre::MaterialPtr const& mat) const
+{
+    return !mat.isNull() && mat->getGroup() == RESOURCE_GROUP;
+}
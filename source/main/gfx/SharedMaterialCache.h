@@ -0,0 +1,69 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Material instances shared by all actors with identical definition and skin.
+///
+/// `ActorSpawner` looks up materials here by a key describing their full setup
+/// (source material, skin, managed material parameters...) and only clones on a miss.
+/// Materials which are modified per-instance at runtime (flares, cab lights, mirrors,
+/// videocameras) are never shared; other runtime changes must go through
+/// `GfxActor::MakeMaterialUnique()` (copy-on-write).
+
+#pragma once
+
+#include <OgreMaterial.h>
+
+#include <map>
+#include <string>
+
+namespace RoR {
+
+class SharedMaterialCache
+{
+public:
+    SharedMaterialCache();
+    ~SharedMaterialCache();
+
+    /// @return Shared material with a new reference added, or null if `key` isn't cached.
+    Ogre::MaterialPtr Acquire(std::string const& key);
+
+    /// Clones `src` into the shared resource group and adds the first reference.
+    /// The caller finishes the setup (textures...) right away, before anyone else can acquire it.
+    Ogre::MaterialPtr Create(std::string const& key, Ogre::MaterialPtr const& src);
+
+    /// Drops a reference; the material is destroyed with the last one.
+    void Release(std::string const& key);
+
+    bool IsShared(Ogre::MaterialPtr const& mat) const;
+
+    static const char* RESOURCE_GROUP;
+
+private:
+    struct Entry
+    {
+        Ogre::MaterialPtr material;
+        int               num_refs;
+    };
+
+    std::map<std::string, Entry> m_entries;
+    size_t                       m_name_counter;
+};
+
+} // namespace RoR
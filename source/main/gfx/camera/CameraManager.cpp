@@ -34,6 +34,8 @@
 #include "TerrainManager.h"
 #include "GUIManager.h"
 #include "PerVehicleCameraContext.h"
+#include "RayCast.h"
+#include "RoRFrameListener.h"
 
 using namespace Ogre;
 using namespace RoR;
@@ -47,18 +49,12 @@ static const float         ROTATE_SPEED = 100.f;
 
 bool intersectsTerrain(Vector3 a, Vector3 b) // internal helper
 {
-    int steps = std::max(10.0f, a.distance(b));
-    for (int i = 0; i < steps; i++)
-    {
-        Vector3 pos = a + (b - a) * (float)i / steps;
-        float y = a.y + (b.y - a.y) * (float)i / steps;
-        float h = App::GetSimTerrain()->GetHeightAt(pos.x, pos.z);
-        if (h > y)
-        {
-            return true;
-        }
-    }
-    return false;
+    float length = a.distance(b);
+    if (length == 0.0f)
+        return false;
+
+    RayCastResult hit; // Terrain only, like the old height sampling; objects must not move the static camera
+    return gEnv->collisions && gEnv->collisions->castRay(Ray(a, (b - a) / length), length, RAYCAST_TERRAIN, hit);
 }
 
 CameraManager::CameraManager() :
@@ -803,6 +799,16 @@ void CameraManager::CameraBehaviorOrbitUpdate()
 
     if (m_cam_limit_movement && App::GetSimTerrain())
     {
+        // Don't let terrain come between the camera and its target
+        float length = m_cam_look_at.distance(desiredPosition);
+        RayCastResult hit;
+        if (length > 0.0f && gEnv->collisions &&
+            gEnv->collisions->castRay(Ray(m_cam_look_at, (desiredPosition - m_cam_look_at) / length), length, RAYCAST_TERRAIN, hit) &&
+            hit.distance > 0.0f)
+        {
+            desiredPosition = m_cam_look_at + (desiredPosition - m_cam_look_at) * (hit.distance / length);
+        }
+
         float h = App::GetSimTerrain()->GetHeightAt(desiredPosition.x, desiredPosition.z) + 1.0f;
 
         desiredPosition.y = std::max(h, desiredPosition.y);
@@ -1034,7 +1040,7 @@ void CameraManager::CameraBehaviorVehicleSplineUpdate()
         m_cam_target_pitch = -asin(dir.dotProduct(Vector3::UNIT_Y));
     }
 
-    if (m_cct_player_actor->GetAllLinkedActors().size() != m_splinecam_num_linked_beams)
+    if (static_cast<unsigned int>(m_cct_player_actor->GetNumLinkedActors()) != m_splinecam_num_linked_beams)
     {
         this->CameraBehaviorVehicleSplineCreateSpline();
     }
@@ -1154,13 +1160,14 @@ void CameraManager::CameraBehaviorVehicleSplineCreateSpline()
         m_splinecam_spline_nodes.push_back(&m_cct_player_actor->ar_nodes[m_cct_player_actor->ar_camera_rail[i]]);
     }
 
-    std::list<Actor*> linkedBeams = m_cct_player_actor->GetAllLinkedActors();
+    App::GetSimController()->GetBeamFactory()->SyncWithSimThread(); // Link groups are changed on the sim thread; rare, only when the count changed
+    std::vector<Actor*> linkedBeams = m_cct_player_actor->GetAllLinkedActors();
 
     m_splinecam_num_linked_beams = linkedBeams.size();
 
     if (m_splinecam_num_linked_beams > 0)
     {
-        for (std::list<Actor*>::iterator it = linkedBeams.begin(); it != linkedBeams.end(); ++it)
+        for (std::vector<Actor*>::iterator it = linkedBeams.begin(); it != linkedBeams.end(); ++it)
         {
             if ((*it)->ar_num_camera_rails <= 0)
                 continue;
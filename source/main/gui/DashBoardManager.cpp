@@ -26,6 +26,8 @@
 #include "DashBoardManager.h"
 
 #include <Ogre.h>
+#include <cctype>
+#include <climits>
 
 #include "Application.h"
 #include "Settings.h"
@@ -40,6 +42,7 @@ DashBoardManager::DashBoardManager(void) : visible(true), free_dashboard(0)
 {
     // clear some things
     memset(&dashboards, 0, sizeof(dashboards));
+    memset(&numeric_cache, 0, sizeof(numeric_cache));
 
     // init data
     INITDATA(DD_ENGINE_RPM              , DC_FLOAT, "rpm");
@@ -163,6 +166,8 @@ int DashBoardManager::loadDashBoard(Ogre::String filename, bool textureLayer)
 
 void DashBoardManager::update(float& dt)
 {
+    this->updateNumericCache();
+
     // TODO: improve logic: only update visible dashboards
     for (int i = 0; i < free_dashboard; i++)
     {
@@ -192,6 +197,20 @@ float DashBoardManager::getNumeric(size_t key)
     return 0;
 }
 
+void DashBoardManager::updateNumericCache()
+{
+    for (int i = 0; i < DD_MAX; i++)
+    {
+        switch (data[i].type)
+        {
+        case DC_BOOL:  numeric_cache[i] = data[i].data.value_bool ? 1.0f : 0.0f; break;
+        case DC_INT:   numeric_cache[i] = (float)data[i].data.value_int;         break;
+        case DC_FLOAT: numeric_cache[i] = data[i].data.value_float;              break;
+        default:       numeric_cache[i] = 0.f;                                   break;
+        }
+    }
+}
+
 void DashBoardManager::setVisible(bool visibility)
 {
     visible = visibility;
@@ -222,6 +241,50 @@ void DashBoardManager::windowResized()
 
 // DASHBOARD class below
 
+static const int FAST_FORMAT_MAX_PRECISION = 6;
+static const double POW10[FAST_FORMAT_MAX_PRECISION + 1] = { 1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6 };
+
+/// Writes `value / 10^precision` as a decimal number, returns the length or -1 if it doesn't fit.
+static int FormatFixedPoint(char* out, size_t out_len, long long value, int precision)
+{
+    char digits[32];
+    int num_digits = 0;
+    bool negative = (value < 0);
+    unsigned long long v = negative ? (0ull - (unsigned long long)value) : (unsigned long long)value;
+    do
+    {
+        digits[num_digits++] = '0' + (char)(v % 10);
+        v /= 10;
+    } while (v != 0 && num_digits < 32);
+
+    if (v != 0)
+        return -1;
+
+    // ensure at least one integral digit: "0.05"
+    while (num_digits <= precision)
+        digits[num_digits++] = '0';
+
+    bool all_zero = true;
+    for (int i = 0; i < num_digits; i++)
+        all_zero = all_zero && (digits[i] == '0');
+
+    size_t needed = (negative && !all_zero ? 1 : 0) + num_digits + (precision > 0 ? 1 : 0) + 1;
+    if (needed > out_len)
+        return -1;
+
+    int pos = 0;
+    if (negative && !all_zero)
+        out[pos++] = '-';
+    for (int i = num_digits - 1; i >= 0; i--)
+    {
+        out[pos++] = digits[i];
+        if (i == precision && precision > 0)
+            out[pos++] = '.';
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
 DashBoard::DashBoard(DashBoardManager* manager, Ogre::String filename, bool _textureLayer) : manager(manager), filename(filename), free_controls(0), visible(false), mainWidget(nullptr), textureLayer(_textureLayer)
 {
     // use 'this' class pointer to make layout unique
@@ -252,153 +315,270 @@ void DashBoard::updateFeatures()
 void DashBoard::update(float& dt)
 {
     // walk all controls and animate them
+    // widgets are only touched when the displayed value changes
     for (int i = 0; i < free_controls; i++)
     {
+        layoutLink_t& ctrl = controls[i];
+
         // get its value from its linkage
-        if (controls[i].animationType == ANIM_ROTATE)
+        if (ctrl.animationType == ANIM_ROTATE)
         {
             // get the value
-            float val = manager->getNumeric(controls[i].linkID);
-            // calculate the angle
-            float angle = (val - controls[i].vmin) * (controls[i].wmax - controls[i].wmin) / (controls[i].vmax - controls[i].vmin) + controls[i].wmin;
+            float val = manager->getNumericCached(ctrl.linkID);
 
-            if (fabs(val - controls[i].last) < 0.02f)
+            if (fabs(val - ctrl.last) < 0.02f)
                 continue;
 
-            controls[i].last = val;
+            ctrl.last = val;
+
+            // calculate the angle
+            float angle = (val - ctrl.vmin) * (ctrl.wmax - ctrl.wmin) / (ctrl.vmax - ctrl.vmin) + ctrl.wmin;
 
             // enforce limits
-            if (angle < controls[i].wmin)
-                angle = controls[i].wmin;
-            else if (angle > controls[i].wmax)
-                angle = controls[i].wmax;
+            if (angle < ctrl.wmin)
+                angle = ctrl.wmin;
+            else if (angle > ctrl.wmax)
+                angle = ctrl.wmax;
             // rotate finally
-            controls[i].rotImg->setAngle(Ogre::Degree(angle).valueRadians());
+            ctrl.rotImg->setAngle(Ogre::Degree(angle).valueRadians());
         }
-        else if (controls[i].animationType == ANIM_LAMP)
+        else if (ctrl.animationType == ANIM_LAMP)
         {
             // or a lamp?
+            float val = manager->getNumericCached(ctrl.linkID);
             bool state = false;
             // conditional
-            if (controls[i].condition == CONDITION_GREATER)
-            {
-                float val = manager->getNumeric(controls[i].linkID);
-                state = (val > controls[i].conditionArgument);
-            }
-            else if (controls[i].condition == CONDITION_LESSER)
-            {
-                float val = manager->getNumeric(controls[i].linkID);
-                state = (val < controls[i].conditionArgument);
-            }
+            if (ctrl.condition == CONDITION_GREATER)
+                state = (val > ctrl.conditionArgument);
+            else if (ctrl.condition == CONDITION_LESSER)
+                state = (val < ctrl.conditionArgument);
             else
-            {
-                state = (manager->getNumeric(controls[i].linkID) > 0);
-            }
+                state = (val > 0);
 
-            if (state == controls[i].lastState)
+            if (state == ctrl.lastState)
                 continue;
-            controls[i].lastState = state;
+            ctrl.lastState = state;
 
             // switch states
             if (state)
             {
-                controls[i].img->setImageTexture(String(controls[i].texture) + "-on.png");
+                ctrl.img->setImageTexture(String(ctrl.texture) + "-on.png");
             }
             else
             {
-                controls[i].img->setImageTexture(String(controls[i].texture) + "-off.png");
+                ctrl.img->setImageTexture(String(ctrl.texture) + "-off.png");
             }
         }
-        else if (controls[i].animationType == ANIM_SERIES)
+        else if (ctrl.animationType == ANIM_SERIES)
         {
-            float val = manager->getNumeric(controls[i].linkID);
-
-            String fn = String(controls[i].texture) + String("-") + TOSTRING((int)val) + String(".png");
+            const float raw_val = manager->getNumericCached(ctrl.linkID);
+            if (!(fabs(raw_val) < 1e9f)) // Also rejects NaN; the int conversion would be undefined
+                continue;
+            int val = (int)raw_val;
 
-            if (fabs(val - controls[i].last) < 0.2f)
+            if (val == ctrl.lastSeries)
                 continue;
-            controls[i].last = val;
+            ctrl.lastSeries = val;
 
-            controls[i].img->setImageTexture(fn);
+            char fn[300] = "";
+            snprintf(fn, 300, "%s-%d.png", ctrl.texture, val);
+            ctrl.img->setImageTexture(fn);
         }
-        else if (controls[i].animationType == ANIM_SCALE)
+        else if (ctrl.animationType == ANIM_SCALE)
         {
-            float val = manager->getNumeric(controls[i].linkID);
+            float val = manager->getNumericCached(ctrl.linkID);
 
-            if (fabs(val - controls[i].last) < 0.2f)
+            if (fabs(val - ctrl.last) < 0.2f)
                 continue;
-            controls[i].last = val;
+            ctrl.last = val;
 
-            float scale = (val - controls[i].vmin) * (controls[i].wmax - controls[i].wmin) / (controls[i].vmax - controls[i].vmin) + controls[i].wmin;
-            if (controls[i].direction == DIRECTION_UP)
+            float scale = (val - ctrl.vmin) * (ctrl.wmax - ctrl.wmin) / (ctrl.vmax - ctrl.vmin) + ctrl.wmin;
+            if (ctrl.direction == DIRECTION_UP)
             {
-                controls[i].widget->setPosition(controls[i].initialPosition.left, controls[i].initialPosition.top - scale);
-                controls[i].widget->setSize(controls[i].initialSize.width, controls[i].initialSize.height + scale);
+                ctrl.widget->setPosition(ctrl.initialPosition.left, ctrl.initialPosition.top - scale);
+                ctrl.widget->setSize(ctrl.initialSize.width, ctrl.initialSize.height + scale);
             }
-            else if (controls[i].direction == DIRECTION_DOWN)
+            else if (ctrl.direction == DIRECTION_DOWN)
             {
-                controls[i].widget->setPosition(controls[i].initialPosition.left, controls[i].initialPosition.top);
-                controls[i].widget->setSize(controls[i].initialSize.width, controls[i].initialSize.height + scale);
+                ctrl.widget->setPosition(ctrl.initialPosition.left, ctrl.initialPosition.top);
+                ctrl.widget->setSize(ctrl.initialSize.width, ctrl.initialSize.height + scale);
             }
-            else if (controls[i].direction == DIRECTION_LEFT)
+            else if (ctrl.direction == DIRECTION_LEFT)
             {
-                controls[i].widget->setPosition(controls[i].initialPosition.left - scale, controls[i].initialPosition.top);
-                controls[i].widget->setSize(controls[i].initialSize.width + scale, controls[i].initialSize.height);
+                ctrl.widget->setPosition(ctrl.initialPosition.left - scale, ctrl.initialPosition.top);
+                ctrl.widget->setSize(ctrl.initialSize.width + scale, ctrl.initialSize.height);
             }
-            else if (controls[i].direction == DIRECTION_RIGHT)
+            else if (ctrl.direction == DIRECTION_RIGHT)
             {
-                controls[i].widget->setPosition(controls[i].initialPosition.left, controls[i].initialPosition.top);
-                controls[i].widget->setSize(controls[i].initialSize.width + scale, controls[i].initialSize.height);
+                ctrl.widget->setPosition(ctrl.initialPosition.left, ctrl.initialPosition.top);
+                ctrl.widget->setSize(ctrl.initialSize.width + scale, ctrl.initialSize.height);
             }
         }
-        else if (controls[i].animationType == ANIM_TRANSLATE)
+        else if (ctrl.animationType == ANIM_TRANSLATE)
         {
-            float val = manager->getNumeric(controls[i].linkID);
+            float val = manager->getNumericCached(ctrl.linkID);
 
-            if (fabs(val - controls[i].last) < 0.2f)
+            if (fabs(val - ctrl.last) < 0.2f)
                 continue;
-            controls[i].last = val;
-
-            float translation = (val - controls[i].vmin) * (controls[i].wmax - controls[i].wmin) / (controls[i].vmax - controls[i].vmin) + controls[i].wmin;
-            if (controls[i].direction == DIRECTION_UP)
-                controls[i].widget->setPosition(controls[i].initialPosition.left, controls[i].initialPosition.top - translation);
-            else if (controls[i].direction == DIRECTION_DOWN)
-                controls[i].widget->setPosition(controls[i].initialPosition.left, controls[i].initialPosition.top + translation);
-            else if (controls[i].direction == DIRECTION_LEFT)
-                controls[i].widget->setPosition(controls[i].initialPosition.left - translation, controls[i].initialPosition.top);
-            else if (controls[i].direction == DIRECTION_RIGHT)
-                controls[i].widget->setPosition(controls[i].initialPosition.left + translation, controls[i].initialPosition.top);
+            ctrl.last = val;
+
+            float translation = (val - ctrl.vmin) * (ctrl.wmax - ctrl.wmin) / (ctrl.vmax - ctrl.vmin) + ctrl.wmin;
+            if (ctrl.direction == DIRECTION_UP)
+                ctrl.widget->setPosition(ctrl.initialPosition.left, ctrl.initialPosition.top - translation);
+            else if (ctrl.direction == DIRECTION_DOWN)
+                ctrl.widget->setPosition(ctrl.initialPosition.left, ctrl.initialPosition.top + translation);
+            else if (ctrl.direction == DIRECTION_LEFT)
+                ctrl.widget->setPosition(ctrl.initialPosition.left - translation, ctrl.initialPosition.top);
+            else if (ctrl.direction == DIRECTION_RIGHT)
+                ctrl.widget->setPosition(ctrl.initialPosition.left + translation, ctrl.initialPosition.top);
         }
-        else if (controls[i].animationType == ANIM_TEXTFORMAT)
+        else if (ctrl.animationType == ANIM_TEXTFORMAT)
         {
-            float val = manager->getNumeric(controls[i].linkID);
-
-            if (fabs(val - controls[i].last) < 0.2f)
-                continue;
-            controls[i].last = val;
+            float val = manager->getNumericCached(ctrl.linkID);
 
-            MyGUI::UString s;
-            if (strlen(controls[i].format) == 0)
+            bool use_quantised = false;
+            if (ctrl.fastFormat) // Precision is within POW10 only then
             {
-                s = Ogre::StringConverter::toString(val);
+                const double scaled = static_cast<double>(val) * POW10[ctrl.formatPrecision];
+                use_quantised = (fabs(scaled) < 1e15); // Also rejects NaN
+                if (use_quantised)
+                {
+                    // compare the value as it will be displayed
+                    long long quantised = static_cast<long long>(floor(scaled + 0.5));
+                    if (quantised == ctrl.lastQuantised)
+                        continue;
+                    ctrl.lastQuantised = quantised;
+                }
             }
-            else
+            if (!use_quantised)
             {
-                char tmp[1024] = "";
-                sprintf(tmp, controls[i].format, val);
-                s = MyGUI::UString(tmp);
+                if (fabs(val - ctrl.last) < 0.2f)
+                    continue;
+                ctrl.last = val;
             }
 
-            controls[i].txt->setCaption(s);
+            char tmp[1024] = "";
+            this->formatText(ctrl, val, use_quantised, tmp, 1024);
+            ctrl.txt->setCaption(MyGUI::UString(tmp));
         }
-        else if (controls[i].animationType == ANIM_TEXTSTRING)
+        else if (ctrl.animationType == ANIM_TEXTSTRING)
         {
-            char* val = manager->getChar(controls[i].linkID);
-            controls[i].txt->setCaption(MyGUI::UString(val));
+            unsigned int revision = manager->getRevision(ctrl.linkID);
+            if (revision == ctrl.lastRevision)
+                continue;
+            ctrl.lastRevision = revision;
+
+            char* val = manager->getChar(ctrl.linkID);
+            ctrl.txt->setCaption(MyGUI::UString(val));
         }
     }
 }
 
+void DashBoard::parseTextFormat(layoutLink_t& ctrl)
+{
+    // Recognizes formats with exactly one "%[-0][width][.precision]{f|d|i}" conversion,
+    // anything else is handed to sprintf() as before.
+    ctrl.fastFormat = false;
+
+    const char* fmt = ctrl.format;
+    const char* pct = strchr(fmt, '%');
+    if (fmt[0] == '\0' || pct == nullptr)
+        return;
+
+    const char* c = pct + 1;
+    ctrl.formatLeftAlign = false;
+    ctrl.formatZeroPad = false;
+    for (; *c == '-' || *c == '0'; c++)
+    {
+        if (*c == '-')
+            ctrl.formatLeftAlign = true;
+        else
+            ctrl.formatZeroPad = true;
+    }
+
+    ctrl.formatWidth = 0;
+    for (; isdigit(*c); c++)
+        ctrl.formatWidth = (ctrl.formatWidth * 10) + (*c - '0');
+
+    int precision = -1;
+    if (*c == '.')
+    {
+        c++;
+        precision = 0;
+        for (; isdigit(*c); c++)
+            precision = (precision * 10) + (*c - '0');
+    }
+
+    if (*c == 'f')
+        ctrl.formatPrecision = (precision < 0) ? 6 : precision;
+    else if (*c == 'd' || *c == 'i')
+        ctrl.formatPrecision = 0;
+    else
+        return; // %g, %e, %s, %% ...
+
+    if (ctrl.formatPrecision > FAST_FORMAT_MAX_PRECISION || ctrl.formatWidth > 64 || strchr(c + 1, '%') != nullptr)
+        return;
+
+    ctrl.formatStart = static_cast<int>(pct - fmt);
+    ctrl.formatEnd = static_cast<int>(c + 1 - fmt);
+    ctrl.fastFormat = true;
+}
+
+void DashBoard::formatText(layoutLink_t& ctrl, float val, bool use_quantised, char* out, size_t out_len)
+{
+    if (!use_quantised)
+    {
+        if (strlen(ctrl.format) == 0)
+            strncpy(out, Ogre::StringConverter::toString(val).c_str(), out_len - 1);
+        else
+            snprintf(out, out_len, ctrl.format, val);
+        return;
+    }
+
+    // the number itself
+    char num[96];
+    int num_len = FormatFixedPoint(num, sizeof(num), ctrl.lastQuantised, ctrl.formatPrecision);
+    if (num_len < 0)
+    {
+        snprintf(out, out_len, ctrl.format, val); // out of range, let the CRT deal with it
+        return;
+    }
+
+    // prefix
+    size_t pos = 0;
+    for (int i = 0; i < ctrl.formatStart && pos < out_len - 1; i++)
+        out[pos++] = ctrl.format[i];
+
+    // padding + number
+    int pad = std::max(0, ctrl.formatWidth - num_len);
+    if (!ctrl.formatLeftAlign)
+    {
+        int start = 0;
+        if (ctrl.formatZeroPad && num[0] == '-' && pos < out_len - 1)
+        {
+            out[pos++] = '-';
+            start = 1;
+        }
+        for (int i = 0; i < pad && pos < out_len - 1; i++)
+            out[pos++] = ctrl.formatZeroPad ? '0' : ' ';
+        for (int i = start; i < num_len && pos < out_len - 1; i++)
+            out[pos++] = num[i];
+    }
+    else
+    {
+        for (int i = 0; i < num_len && pos < out_len - 1; i++)
+            out[pos++] = num[i];
+        for (int i = 0; i < pad && pos < out_len - 1; i++)
+            out[pos++] = ' ';
+    }
+
+    // suffix
+    for (const char* c = ctrl.format + ctrl.formatEnd; *c != '\0' && pos < out_len - 1; c++)
+        out[pos++] = *c;
+
+    out[pos] = '\0';
+}
+
 void DashBoard::windowResized()
 {
     if (!mainWidget)
@@ -466,6 +646,9 @@ void DashBoard::loadLayoutRecursive(MyGUI::WidgetPtr w)
         ctrl.initialPosition = w->getPosition();
         ctrl.last = 1337.1337f; // force update
         ctrl.lastState = true;
+        ctrl.lastSeries = INT_MIN;
+        ctrl.lastQuantised = LLONG_MIN;
+        ctrl.lastRevision = UINT_MAX;
 
         // establish the link
         {
@@ -538,7 +721,8 @@ void DashBoard::loadLayoutRecursive(MyGUI::WidgetPtr w)
 
         String format = w->getUserString("format");
         if (!format.empty())
-            strncpy(ctrl.format, format.c_str(), 255);
+            strncpy(ctrl.format, format.c_str(), 254);
+        this->parseTextFormat(ctrl);
 
         String direction = w->getUserString("direction");
         if (direction == "right")
@@ -64,14 +64,15 @@ typedef struct dashData_t
     dataContainer_t data;
     bool enabled;
     const char* name; // char string of name
+    unsigned int revision; // bumped whenever a DC_CHAR value actually changes
 
-    dashData_t() : type(DC_INVALID)
+    dashData_t() : type(DC_INVALID), revision(0)
     {
         memset(&data, 0, sizeof(data));
         enabled = false;
     }
 
-    dashData_t(char type, const char* name) : type(type), name(name)
+    dashData_t(char type, const char* name) : type(type), name(name), revision(0)
     {
         memset(&data, 0, sizeof(data));
         enabled = true;
@@ -198,7 +199,17 @@ public:
     inline void setBool(size_t key, bool& val) { data[key].data.value_bool = val; };
     inline void setInt(size_t key, int& val) { data[key].data.value_int = val; };
     inline void setFloat(size_t key, float& val) { data[key].data.value_float = val; };
-    inline void setChar(size_t key, const char* val) { strncpy(data[key].data.value_char, val, DD_MAXCHAR); };
+    inline void setChar(size_t key, const char* val)
+    {
+        if (strncmp(data[key].data.value_char, val, DD_MAXCHAR - 1) == 0)
+            return;
+        strncpy(data[key].data.value_char, val, DD_MAXCHAR - 1);
+        data[key].revision++;
+    };
+    inline unsigned int getRevision(size_t key) { return data[key].revision; };
+
+    /// Values converted to float once per frame by `update()`; dashboards read these instead of `getNumeric()`
+    inline float getNumericCached(size_t key) { return numeric_cache[key]; };
 
     inline void setEnabled(size_t key, bool val) { data[key].enabled = val; };
 
@@ -219,7 +230,10 @@ public:
     void windowResized();
 protected:
     bool visible;
+    void updateNumericCache();
+
     dashData_t data[DD_MAX];
+    float numeric_cache[DD_MAX];
     DashBoard* dashboards[MAX_DASH];
     int free_dashboard;
 };
@@ -304,8 +318,24 @@ protected:
 
         float last;
         bool lastState;
+        int lastSeries;
+        long long lastQuantised; // ANIM_TEXTFORMAT: last displayed value, scaled by 10^precision
+        unsigned int lastRevision; // ANIM_TEXTSTRING: revision of the displayed string
+
+        // ANIM_TEXTFORMAT: pre-parsed numeric conversion for the fast formatter
+        bool fastFormat; // false = fall back to sprintf()
+        int formatStart; // offset of the '%' within `format`
+        int formatEnd; // offset just past the conversion char
+        int formatWidth;
+        int formatPrecision;
+        bool formatZeroPad;
+        bool formatLeftAlign;
     } layoutLink_t;
 
+    void parseTextFormat(layoutLink_t& ctrl);
+    /// @param use_quantised Format `ctrl.lastQuantised` with the fast formatter instead of `val` with sprintf()
+    void formatText(layoutLink_t& ctrl, float val, bool use_quantised, char* out, size_t out_len);
+
     void loadLayout(Ogre::String filename);
     void loadLayoutRecursive(MyGUI::WidgetPtr ptr);
     layoutLink_t controls[MAX_CONTROLS];
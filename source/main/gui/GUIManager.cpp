@@ -356,9 +356,9 @@ void GUIManager::CenterSpawnerReportWindow()
     m_impl->panel_SpawnerReport.CenterToScreen();
 }
 
-void GUIManager::pushMessageChatBox(Ogre::String txt)
+void GUIManager::pushMessageChatBox(Ogre::String txt, int kind, int sender_uid, Ogre::String sender)
 {
-    m_impl->panel_ChatBox.pushMsg(txt);
+    m_impl->panel_ChatBox.pushMsg(txt, kind, sender_uid, sender);
 }
 
 void GUIManager::hideGUI(bool hidden)
@@ -113,7 +113,7 @@ public:
     GUI::TeleportWindow* GetTeleport();
 
     // GUI manipulation
-    void pushMessageChatBox(Ogre::String txt);
+    void pushMessageChatBox(Ogre::String txt, int kind = 0, int sender_uid = -1, Ogre::String sender = ""); //!< See `ChatSystem::ChatKind`; 0 = notice
     void ShowMessageBox(Ogre::String mTitle, Ogre::String mText, bool button1, Ogre::String mButton1, bool AllowClose, bool button2, Ogre::String mButton2);
     void UpdateMessageBox(Ogre::String mTitle, Ogre::String mText, bool button1, Ogre::String mButton1, bool AllowClose, bool button2, Ogre::String mButton2, bool IsVisible);
     void UnfocusGui();
@@ -35,6 +35,7 @@
 #include "Utils.h"
 #include "Language.h"
 #include "GUIManager.h"
+#include "GUI_GameConsole.h"
 #include "Application.h"
 #include "OgreSubsystem.h"
 #include "Settings.h"
@@ -45,6 +46,8 @@ using namespace GUI;
 #define CLASS        GameChatBox
 #define MAIN_WIDGET  ((MyGUI::Window*)mMainWidget)
 
+static const size_t CHATBOX_VIEW_LINES = 50;
+
 CLASS::CLASS() :
     alpha(1.0f)
     , newMsg(false)
@@ -85,11 +88,23 @@ bool CLASS::IsVisible()
     return MAIN_WIDGET->isVisible();
 }
 
-void CLASS::pushMsg(Ogre::String txt)
+void CLASS::pushMsg(Ogre::String txt, int kind, int sender_uid, Ogre::String sender)
 {
-    mHistory += RoR::Color::NormalColour + txt + " \n";
+    App::GetConsole()->putChatMessage(kind, sender_uid, sender, txt);
+    MessageHistory& history = App::GetConsole()->GetHistory();
+
+    // Only the last few lines are displayed; the console can search the full history
+    MessageHistory::Filter filter;
+    filter.channels = (1u << Console::CONSOLE_MSGTYPE_NETWORK);
+    std::vector<MessageHistory::Message> lines;
+    history.Query(filter, 0, 0, CHATBOX_VIEW_LINES, lines);
+
+    Ogre::String text;
+    for (MessageHistory::Message const& line: lines)
+        text += RoR::Color::NormalColour + RoR::ChatSystem::FormatChatMessage(line.kind, line.sender, line.text) + " \n";
+
     newMsg = true;
-    m_Chatbox_MainBox->setCaptionWithReplacing(mHistory);
+    m_Chatbox_MainBox->setCaptionWithReplacing(text);
 }
 
 void CLASS::eventCommandAccept(MyGUI::Edit* _sender)
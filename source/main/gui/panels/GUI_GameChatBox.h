@@ -42,14 +42,13 @@ public:
     void Hide();
     bool IsVisible();
     void SetVisible(bool value);
-    void pushMsg(Ogre::String txt);
+    void pushMsg(Ogre::String txt, int kind = 0, int sender_uid = -1, Ogre::String sender = ""); //!< Stored in the console's message history; `kind` see `ChatSystem::ChatKind`
     void Update(float dt);
 
 private:
 
     void eventCommandAccept(MyGUI::Edit* _sender);
 
-    Ogre::String mHistory;
     bool newMsg;
 
     // logic
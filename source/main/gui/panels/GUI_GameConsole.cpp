@@ -26,6 +26,7 @@
 #include "Beam.h"
 #include "BeamFactory.h"
 #include "Character.h"
+#include "ChatSystem.h"
 #include "GUIManager.h"
 #include "IWater.h"
 #include "Language.h"
@@ -38,8 +39,12 @@
 #include "Settings.h"
 #include "TerrainManager.h"
 #include "TerrainObjectManager.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cstdio>
+
 #if MYGUI_PLATFORM == MYGUI_PLATFORM_LINUX
 #include <iconv.h>
 #endif // LINUX
@@ -47,8 +52,19 @@
 using namespace Ogre;
 using namespace RoR;
 
+static const size_t CONSOLE_HISTORY_MESSAGES   = 10000;
+static const size_t CONSOLE_HISTORY_TEXT_BYTES = 2 * 1024 * 1024;
+static const size_t CONSOLE_VIEW_LINES         = 200; //!< Only this many messages are put in the text box
+static const uint32_t CONSOLE_DEFAULT_CHANNELS = ~(1u << Console::CONSOLE_MSGTYPE_NETWORK);
+
 // class
-Console::Console()
+Console::Console():
+    m_history(CONSOLE_HISTORY_MESSAGES, CONSOLE_HISTORY_TEXT_BYTES),
+    m_view_seq(0),
+    m_view_anchor(0),
+    m_view_skip(0),
+    m_view_total(0),
+    m_view_dirty(true)
 {
     MyGUI::WindowPtr win = dynamic_cast<MyGUI::WindowPtr>(mMainWidget);
     win->eventWindowButtonPressed += MyGUI::newDelegate(this, &Console::notifyWindowButtonPressed); //The "X" button thing
@@ -60,7 +76,7 @@ Console::Console()
     ((MyGUI::Window*)mMainWidget)->setPosition((parentSize.width - windowSize.width) / 2, (parentSize.height - windowSize.height) / 2);
     ((MyGUI::Window*)mMainWidget)->setVisible(false);
 
-    ConsoleText = "";
+    m_view_filter.channels = CONSOLE_DEFAULT_CHANNELS;
     iText = 0;
     HistoryCursor = 0;
 
@@ -93,6 +109,7 @@ void Console::notifyWindowButtonPressed(MyGUI::WidgetPtr _sender, const std::str
 void Console::SetVisible(bool _visible)
 {
     ((MyGUI::Window*)mMainWidget)->setVisible(_visible);
+    m_view_dirty = true;
 }
 
 bool Console::IsVisible()
@@ -107,50 +124,123 @@ void Console::frameEntered(float dt)
 
 void Console::putMessage(int type, int sender_uid, UTFString txt, String icon, unsigned long ttl, bool forcevisible)
 {
-    ConsoleMessage t;
-
-    t.type = type;
-    t.sender_uid = sender_uid;
-    t.time = Root::getSingleton().getTimer()->getMilliseconds();
-    t.ttl = ttl;
-    t.forcevisible = forcevisible;
-    //strncpy(t.txt,  txt.c_str(), 2048);
-    t.txt = txt;
-    strncpy(t.icon, icon.c_str(), 50);
-    //t.channel = "default";
-
-    //showMessage(t);
-    push(t);
+    // `sender_uid` is really the message sub-type (CONSOLE_HELP...), it selects the colour.
+    m_history.Push(type, sender_uid, -1, "", txt.asUTF8(), Root::getSingleton().getTimer()->getMilliseconds());
+}
+
+void Console::putChatMessage(int kind, int user_uid, String const& user_name, String const& msg)
+{
+    m_history.Push(CONSOLE_MSGTYPE_NETWORK, kind, user_uid, user_name, msg, Root::getSingleton().getTimer()->getMilliseconds());
 }
 
 void Console::messageUpdate(float dt)
 {
-    std::vector<ConsoleMessage> tmpWaitingMessages;
-    int results = pull(tmpWaitingMessages);
+    const uint64_t last_seq = m_history.GetLastSeq();
+    if (!this->IsVisible() || (!m_view_dirty && (m_view_seq == last_seq || m_view_anchor != 0)))
+        return;
+
+    m_view_dirty = false;
+    m_view_seq = last_seq;
 
-    int r = 0;
-    if (results > 0)
+    // Only the visible page is formatted; the rest stays packed in the history
+    std::vector<MessageHistory::Message> lines;
+    m_view_total = m_history.Query(m_view_filter, m_view_anchor, m_view_skip, CONSOLE_VIEW_LINES, lines);
+
+    String text;
+    for (MessageHistory::Message const& line: lines)
     {
-        for (int i = 0; i < results; i++ , r++)
+        if (line.channel == CONSOLE_MSGTYPE_NETWORK) // Kind is a `ChatSystem::ChatKind`
         {
-            TextCol = "#FFFFFF";
-            if (tmpWaitingMessages[i].sender_uid == CONSOLE_TITLE)
-                TextCol = "#FF8100"; //Orange
-            else if (tmpWaitingMessages[i].sender_uid == CONSOLE_SYSTEM_ERROR)
-                TextCol = "#FF0000"; //Red
-            else if (tmpWaitingMessages[i].sender_uid == CONSOLE_SYSTEM_REPLY)
-                TextCol = "#00FF00"; //Green
-            else if (tmpWaitingMessages[i].sender_uid == CONSOLE_HELP)
-                TextCol = "#72C0E0"; //Light blue
-
-            ConsoleText += TextCol + tmpWaitingMessages[i].txt + "\n";
-
-            m_Console_MainBox->setMaxTextLength(ConsoleText.length() + 1);
-
-            //if (getVisible())
-            m_Console_MainBox->setCaptionWithReplacing(ConsoleText);
+            text += "#FFFFFF" + ChatSystem::FormatChatMessage(line.kind, line.sender, line.text) + "\n";
+            continue;
         }
+
+        const char* color = "#FFFFFF";
+        if (line.kind == CONSOLE_TITLE)
+            color = "#FF8100"; //Orange
+        else if (line.kind == CONSOLE_SYSTEM_ERROR)
+            color = "#FF0000"; //Red
+        else if (line.kind == CONSOLE_SYSTEM_REPLY)
+            color = "#00FF00"; //Green
+        else if (line.kind == CONSOLE_HELP)
+            color = "#72C0E0"; //Light blue
+
+        text += color + line.text + "\n";
     }
+    if (m_view_anchor != 0)
+        text += "#FF8100" + UTFString(_L("-- scrolled back, press PageDown for newer messages --")).asUTF8() + "\n";
+
+    m_Console_MainBox->setMaxTextLength(text.length() + 1);
+    m_Console_MainBox->setCaptionWithReplacing(text);
+}
+
+void Console::ScrollView(int lines)
+{
+    const long max_skip = std::max(static_cast<long>(m_view_total) - static_cast<long>(CONSOLE_VIEW_LINES), 0L);
+    const size_t skip = static_cast<size_t>(std::min(std::max(static_cast<long>(m_view_skip) + lines, 0L), max_skip));
+    if (skip == m_view_skip)
+        return; // Nothing older/newer to show; keep following new messages
+
+    if (skip == 0)
+        m_view_anchor = 0; // Back at the bottom - follow new messages again
+    else if (m_view_anchor == 0)
+        m_view_anchor = m_view_seq; // Freeze the view (as drawn) while scrolled back
+    m_view_skip = skip;
+    m_view_dirty = true;
+}
+
+bool Console::SetViewFilter(StringVector const& args)
+{
+    MessageHistory::Filter filter;
+    filter.channels = 0;
+    for (size_t i = 1; i < args.size(); i++)
+    {
+        if (StringUtil::startsWith(args[i], "channel=", false))
+        {
+            for (String const& channel: StringUtil::split(args[i].substr(8), ","))
+            {
+                if (channel == "all")
+                    filter.channels = ~0u;
+                else if (channel == "log")
+                    filter.channels |= (1u << CONSOLE_MSGTYPE_LOG);
+                else if (channel == "info")
+                    filter.channels |= (1u << CONSOLE_MSGTYPE_INFO) | (1u << CONSOLE_MSGTYPE_FLASHMESSAGE) | (1u << CONSOLE_MSGTYPE_HIGHSCORE);
+                else if (channel == "script")
+                    filter.channels |= (1u << CONSOLE_MSGTYPE_SCRIPT);
+                else if (channel == "chat")
+                    filter.channels |= (1u << CONSOLE_MSGTYPE_NETWORK);
+                else
+                    return false;
+            }
+        }
+        else if (StringUtil::startsWith(args[i], "sender=", false))
+        {
+            const String sender = args[i].substr(7);
+            if (StringConverter::isNumber(sender))
+                filter.sender_uid = StringConverter::parseInt(sender);
+            else
+                filter.sender = sender;
+        }
+        else if (StringUtil::startsWith(args[i], "since=", false))
+        {
+            const unsigned long now = Root::getSingleton().getTimer()->getMilliseconds();
+            const unsigned long age = static_cast<unsigned long>(std::max(PARSEREAL(args[i].substr(6)), 0.f) * 1000.f);
+            filter.since_ms = (age < now) ? (now - age) : 0;
+        }
+        else
+        {
+            filter.text += (filter.text.empty() ? "" : " ") + args[i];
+        }
+    }
+
+    if (filter.channels == 0) // No channel given - searching by sender means chat
+        filter.channels = (filter.sender_uid != -1 || !filter.sender.empty()) ? ~0u : CONSOLE_DEFAULT_CHANNELS;
+
+    m_view_filter = filter;
+    m_view_anchor = 0;
+    m_view_skip = 0;
+    m_view_dirty = true;
+    return true;
 }
 
 #if OGRE_VERSION < ((1 << 16) | (8 << 8 ) | 0)
@@ -211,6 +301,14 @@ void Console::eventButtonPressed(MyGUI::Widget* _sender, MyGUI::KeyCode _key, My
             HistoryCursor--;
         }
         break;
+
+    case MyGUI::KeyCode::PageUp:
+        this->ScrollView(static_cast<int>(CONSOLE_VIEW_LINES / 2));
+        break;
+
+    case MyGUI::KeyCode::PageDown:
+        this->ScrollView(-static_cast<int>(CONSOLE_VIEW_LINES / 2));
+        break;
     }
 }
 
@@ -254,6 +352,7 @@ void Console::eventCommandAccept(MyGUI::Edit* _sender)
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("terrainheight - get height of terrain at current position"), "world.png");
 
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("log - toggles log output on the console"), "table_save.png");
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("filter [channel=all|log|info|script|chat] [sender=<name|id>] [since=<seconds>] [text] - show only matching messages, no arguments = reset"), "table_save.png");
 
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("quit - exit Rigs of Rods"), "table_save.png");
 
@@ -268,8 +367,16 @@ void Console::eventCommandAccept(MyGUI::Edit* _sender)
 
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("spawnobject <odef name> - spawn a object at the player position"), "script_go.png");
 
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("savestate <name> - save the simulation state of all vehicles"), "table_save.png");
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("loadstate <name> - restore a saved simulation state into the spawned vehicles"), "table_save.png");
+
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("memstats - estimated memory usage of spawned vehicles"), "information.png");
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("perfrecord <file>|stop - record vehicle controls as input script for -perftest"), "information.png");
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("threadstats [reset] - busy/idle time and CPU migrations of simulation worker threads"), "information.png");
+
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_TITLE, _L("Tips:"), "help.png");
         putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("- use Arrow Up/Down Keys in the InputBox to reuse old messages"), "information.png");
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, _L("- use PageUp/PageDown Keys in the InputBox to scroll through older messages"), "information.png");
         return;
     }
     else if (args[0] == "gravity")
@@ -410,10 +517,18 @@ void Console::eventCommandAccept(MyGUI::Edit* _sender)
         // switch to console logging
         bool now_logging = !App::diag_log_console_echo.GetActive();
         const char* msg = (now_logging) ? " logging to console enabled" : " logging to console disabled";
-        this->putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_NOTICE, _L(msg), "information.png");
+        this->putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_NOTICE, LanguageEngine::getSingleton().lookUp(msg), "information.png");
         App::diag_log_console_echo.SetActive(now_logging);
         return;
     }
+    else if (args[0] == "filter")
+    {
+        if (this->SetViewFilter(args))
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, (args.size() > 1) ? _L("Message filter set") : _L("Message filter cleared"), "information.png");
+        else
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_ERROR, _L("usage: filter [channel=all|log|info|script|chat] [sender=<name|id>] [since=<seconds>] [text]"), "error.png");
+        return;
+    }
     else if (args[0] == "spawnobject" && (is_appstate_sim && !is_sim_select))
     {
         Vector3 pos = Vector3::ZERO;
@@ -437,6 +552,87 @@ void Console::eventCommandAccept(MyGUI::Edit* _sender)
 
         return;
     }
+    else if ((args[0] == "savestate" || args[0] == "loadstate") && (is_appstate_sim && !is_sim_select))
+    {
+        if (args.size() != 2)
+        {
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_HELP, RoR::Color::CommandColour + _L("usage: savestate <name>, loadstate <name>"), "information.png");
+            return;
+        }
+
+        ActorManager* actor_manager = App::GetSimController()->GetBeamFactory();
+        if (args[0] == "savestate" && actor_manager->SaveSimState(args[1]))
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Saving simulation state: ") + args[1], "table_save.png");
+        else if (args[0] == "loadstate" && actor_manager->LoadSimState(args[1]))
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Loaded simulation state: ") + args[1], "table_save.png");
+        else
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_ERROR, _L("Invalid name or state file: ") + args[1], "error.png");
+        return;
+    }
+    else if (args[0] == "memstats" && (is_appstate_sim && !is_sim_select))
+    {
+        ActorManager* actor_manager = App::GetSimController()->GetBeamFactory();
+        actor_manager->SyncWithSimThread();
+
+        size_t total = 0;
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_TITLE, _L("Vehicle memory usage:"), "information.png");
+        for (int i = 0; i < actor_manager->GetNumUsedActorSlots(); i++)
+        {
+            Actor* actor = actor_manager->GetInternalActorSlots()[i];
+            if (actor == nullptr)
+                continue;
+            const ActorMemoryUsage usage = actor->ComputeMemoryUsage();
+            total += usage.GetTotal();
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY,
+                " " + TOSTRING(actor->ar_instance_id) + " " + actor->ar_design_name + ": " + usage.ToString(), "information.png");
+        }
+        putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Total: ") + TOSTRING(total / 1024) + " KiB", "information.png");
+        return;
+    }
+    else if (args[0] == "threadstats" && (is_appstate_sim && !is_sim_select))
+    {
+        ThreadPool* pools[] = { gEnv->threadPool, App::GetSimController()->GetBeamFactory()->GetSimThreadPool() };
+        const bool reset = (args.size() > 1 && args[1] == "reset");
+        if (!reset)
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_TITLE, _L("Worker threads:"), "information.png");
+        for (ThreadPool* pool: pools)
+        {
+            if (pool == nullptr)
+                continue;
+            if (reset)
+            {
+                pool->ResetWorkerStats();
+                continue;
+            }
+            const std::vector<ThreadPool::WorkerStats> stats = pool->GetWorkerStats();
+            for (size_t i = 0; i < stats.size(); i++)
+            {
+                const double total_ms = std::max(stats[i].busy_ms + stats[i].idle_ms, 1.0);
+                char line[300];
+                std::snprintf(line, sizeof(line), " %s-%d (CPUs %s): %lu tasks, busy %.0f%%, %.0f ms busy / %.0f ms idle, %lu migrations, last CPU %d",
+                    pool->GetName().c_str(), static_cast<int>(i), ThreadPlacement::FormatCpuList(pool->GetPlacement().cpus).c_str(),
+                    static_cast<unsigned long>(stats[i].tasks), 100.0 * stats[i].busy_ms / total_ms, stats[i].busy_ms, stats[i].idle_ms,
+                    static_cast<unsigned long>(stats[i].migrations), stats[i].last_cpu);
+                putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, line, "information.png");
+            }
+        }
+        if (reset)
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Worker thread statistics reset"), "information.png");
+        return;
+    }
+    else if (args[0] == "perfrecord" && args.size() == 2 && (is_appstate_sim && !is_sim_select))
+    {
+        if (args[1] == "stop")
+        {
+            App::GetSimController()->StopInputRecording();
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Input recording stopped"), "information.png");
+        }
+        else if (App::GetSimController()->StartInputRecording(args[1]))
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_REPLY, _L("Recording inputs to: ") + args[1], "information.png");
+        else
+            putMessage(CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_ERROR, _L("Invalid name or file: ") + args[1], "error.png");
+        return;
+    }
     else
     {
 #ifdef USE_ANGELSCRIPT
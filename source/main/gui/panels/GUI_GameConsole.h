@@ -28,7 +28,7 @@
 #define CONSOLE_PUTMESSAGE_SHORT(a,b,c) while(0) { Console *console = RoR::App::GetConsole(); if (console) console->putMessage(a,b,c); }
 
 #include "RoRPrerequisites.h"
-#include "InterThreadStoreVector.h"
+#include "MessageHistory.h"
 
 #include "mygui/BaseLayout.h"
 #include "GUI_GameConsoleLayout.h"
@@ -36,21 +36,8 @@
 namespace RoR {
 // Special - not in namespace GUI
 
-struct ConsoleMessage
-{
-    //Kept this for comptability rather than remplacing hunderd of lines.
-    char type;
-    int sender_uid; //Not used
-    unsigned long time; //Not used !< post time in milliseconds since RoR start
-    unsigned long ttl; //Not used !< in milliseconds
-    Ogre::UTFString txt; //!< not POD, beware...
-    char icon[50]; //Not used
-    bool forcevisible; //Not used
-};
-
 class Console :
     public Ogre::LogListener,
-    public InterThreadStoreVector<ConsoleMessage>,
     public GUI::GameConsoleLayout,
     public ZeroedMemoryAllocator
 {
@@ -67,7 +54,7 @@ public:
         CONSOLE_MSGTYPE_LOG,
         CONSOLE_MSGTYPE_INFO,
         CONSOLE_MSGTYPE_SCRIPT,
-        CONSOLE_MSGTYPE_NETWORK,
+        CONSOLE_MSGTYPE_NETWORK,      //!< Multiplayer chat; shown in the chat box, not in the console by default
         CONSOLE_MSGTYPE_FLASHMESSAGE,
         CONSOLE_MSGTYPE_HIGHSCORE
     };
@@ -92,15 +79,26 @@ public:
         MSG_CUSTOM,
     };
 
+    /// Thread-safe. `icon`, `ttl` and `forcevisible` are accepted for compatibility and ignored.
     void putMessage(int type, int uid, Ogre::UTFString msg, Ogre::String icon = "bullet_black.png", unsigned long ttl = 30000, bool forcevisible = false);
+    void putChatMessage(int kind, int user_uid, Ogre::String const& user_name, Ogre::String const& msg); //!< Stored bare as CONSOLE_MSGTYPE_NETWORK; `kind` see `ChatSystem::ChatKind`
+
+    MessageHistory& GetHistory() { return m_history; }
 
 protected:
 
     void notifyWindowButtonPressed(MyGUI::WidgetPtr _sender, const std::string& _name);
     void messageUpdate(float dt);
-
-    Ogre::String ConsoleText;
-    Ogre::UTFString TextCol;
+    void ScrollView(int lines); //!< Positive = towards older messages
+    bool SetViewFilter(Ogre::StringVector const& args);
+
+    MessageHistory         m_history;
+    MessageHistory::Filter m_view_filter;
+    uint64_t               m_view_seq;    //!< Newest history message when the view was drawn
+    uint64_t               m_view_anchor; //!< Newest message considered while scrolled back; 0 = follow new messages
+    size_t                 m_view_skip;   //!< Matching messages skipped below the anchor
+    size_t                 m_view_total;  //!< Matching messages when the view was drawn
+    bool                   m_view_dirty;
     bool angelscriptMode;
 
     void frameEntered(float dt);
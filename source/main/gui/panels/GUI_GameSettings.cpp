@@ -223,6 +223,18 @@ void RoR::GUI::GameSettings::Draw()
             DrawGFloatBox(App::io_outgauge_delay, "OutGauge delay");
             ImGui::PopItemWidth();
         }
+
+        ImGui::PushItemWidth(125.f);
+        DrawGIntBox(App::io_telemetry_mode, "Telemetry (0=off, 1=UDP, 2=unix socket)");
+        ImGui::PopItemWidth();
+        if (App::io_telemetry_mode.GetActive())
+        {
+            DrawGTextEdit(App::io_telemetry_target, "Telemetry target", m_buf_io_telemetry_target);
+            DrawGTextEdit(App::io_telemetry_nodes,  "Telemetry nodes",  m_buf_io_telemetry_nodes);
+            ImGui::PushItemWidth(125.f);
+            DrawGFloatBox(App::io_telemetry_rate, "Telemetry samples/sec");
+            ImGui::PopItemWidth();
+        }
     }
 
     ImGui::End();
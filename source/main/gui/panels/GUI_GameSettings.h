@@ -53,6 +53,8 @@ private:
     Str<100> m_buf_diag_preset_veh_config;
     Str<300> m_buf_diag_extra_resource_dir;
     Str<50>  m_buf_io_outgauge_ip;
+    Str<200> m_buf_io_telemetry_target;
+    Str<200> m_buf_io_telemetry_nodes;
 };
 
 } // namespace GUI
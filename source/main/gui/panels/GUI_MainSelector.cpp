@@ -326,33 +326,13 @@ struct sort_cats
     }
 };
 
-template <typename T1>
-struct sort_entries
-{
-    bool operator ()(CacheEntry const& a, CacheEntry const& b) const
-    {
-        Ogre::String first = a.dname;
-        Ogre::String second = b.dname;
-        Ogre::StringUtil::toLowerCase(first);
-        Ogre::StringUtil::toLowerCase(second);
-        return first < second;
-    }
-};
-
-struct sort_search_results
-{
-    bool operator ()(std::pair<CacheEntry*, size_t> const& a, std::pair<CacheEntry*, size_t> const& b) const
-    {
-        return a.second < b.second;
-    }
-};
-
 void CLASS::UpdateGuiData()
 {
     std::map<int, int> mCategoryUsage;
     m_Type->removeAllItems();
     m_Model->removeAllItems();
     m_entries.clear();
+    m_listed.clear();
 
     if (m_loader_type == LT_SKIN)
     {
@@ -382,9 +362,11 @@ void CLASS::UpdateGuiData()
 
     int ts = getTimeStamp();
     std::vector<CacheEntry>* entries = RoR::App::GetCacheSystem()->getEntries();
-    std::sort(entries->begin(), entries->end(), sort_entries<CacheEntry>());
-    for (std::vector<CacheEntry>::iterator it = entries->begin(); it != entries->end(); it++)
+    std::vector<int> const& name_order = RoR::App::GetCacheSystem()->getSearchIndex().GetNameOrder();
+    m_listed.resize(entries->size(), false);
+    for (int pos : name_order)
     {
+        CacheEntry* it = &(*entries)[pos];
         bool add = false;
         if (it->fext == "terrn2")
             add = (m_loader_type == LT_Terrain);
@@ -423,7 +405,8 @@ void CLASS::UpdateGuiData()
         if (ts - it->addtimestamp < CACHE_FILE_FRESHNESS)
             mCategoryUsage[CacheSystem::CID_Fresh]++;
 
-        m_entries.push_back(*it);
+        m_entries.push_back(it);
+        m_listed[pos] = true;
     }
     int tally_categories = 0, current_category = 0;
     std::map<int, Category_Entry>* cats = RoR::App::GetCacheSystem()->getCategories();
@@ -444,7 +427,7 @@ void CLASS::UpdateGuiData()
             Ogre::UTFString title = _L("unknown");
             if (!itc->second.title.empty())
             {
-                title = _L(itc->second.title.c_str());
+                title = LanguageEngine::getSingleton().lookUp(itc->second.title);
             }
             Ogre::UTFString txt = U("[") + TOUTFSTRING(++current_category) + U("/") + TOUTFSTRING(tally_categories) + U("] (") + TOUTFSTRING(num_elements) + U(") ") + title;
             m_Type->addItem(convertToMyGUIString(txt), itc->second.number);
@@ -465,107 +448,6 @@ void CLASS::UpdateGuiData()
     }
 }
 
-size_t CLASS::SearchCompare(Ogre::String searchString, CacheEntry* ce)
-{
-    if (searchString.find(":") == Ogre::String::npos)
-    {
-        // normal search
-
-        // the name
-        Ogre::String dname_lower = ce->dname;
-        Ogre::StringUtil::toLowerCase(dname_lower);
-        if (dname_lower.find(searchString) != Ogre::String::npos)
-            return dname_lower.find(searchString);
-
-        // the filename
-        Ogre::String fname_lower = ce->fname;
-        Ogre::StringUtil::toLowerCase(fname_lower);
-        if (fname_lower.find(searchString) != Ogre::String::npos)
-            return 100 + fname_lower.find(searchString);
-
-        // the description
-        Ogre::String desc = ce->description;
-        Ogre::StringUtil::toLowerCase(desc);
-        if (desc.find(searchString) != Ogre::String::npos)
-            return 200 + desc.find(searchString);
-
-        // the authors
-        if (!ce->authors.empty())
-        {
-            std::vector<AuthorInfo>::const_iterator it;
-            for (it = ce->authors.begin(); it != ce->authors.end(); it++)
-            {
-                // author name
-                Ogre::String aname = it->name;
-                Ogre::StringUtil::toLowerCase(aname);
-                if (aname.find(searchString) != Ogre::String::npos)
-                    return 300 + aname.find(searchString);
-
-                // author email
-                Ogre::String aemail = it->email;
-                Ogre::StringUtil::toLowerCase(aemail);
-                if (aemail.find(searchString) != Ogre::String::npos)
-                    return 400 + aemail.find(searchString);
-            }
-        }
-        return Ogre::String::npos;
-    }
-    else
-    {
-        Ogre::StringVector v = Ogre::StringUtil::split(searchString, ":");
-        if (v.size() < 2)
-            return Ogre::String::npos; //invalid syntax
-
-        if (v[0] == "hash")
-        {
-            Ogre::String hash = ce->hash;
-            Ogre::StringUtil::toLowerCase(hash);
-            return hash.find(v[1]);
-        }
-        else if (v[0] == "guid")
-        {
-            Ogre::String guid = ce->guid;
-            Ogre::StringUtil::toLowerCase(guid);
-            return guid.find(v[1]);
-        }
-        else if (v[0] == "author")
-        {
-            // the authors
-            if (!ce->authors.empty())
-            {
-                std::vector<AuthorInfo>::const_iterator it;
-                for (it = ce->authors.begin(); it != ce->authors.end(); it++)
-                {
-                    // author name
-                    Ogre::String aname = it->name;
-                    Ogre::StringUtil::toLowerCase(aname);
-                    if (aname.find(v[1]) != Ogre::String::npos)
-                        return aname.find(v[1]);
-
-                    // author email
-                    Ogre::String aemail = it->email;
-                    Ogre::StringUtil::toLowerCase(aemail);
-                    if (aemail.find(v[1]) != Ogre::String::npos)
-                        return aemail.find(v[1]);
-                }
-            }
-            return Ogre::String::npos;
-        }
-        else if (v[0] == "wheels")
-        {
-            Ogre::String wheelsStr = TOUTFSTRING(ce->wheelcount) + "x" + TOUTFSTRING(ce->propwheelcount);
-            return wheelsStr.find(v[1]);
-        }
-        else if (v[0] == "file")
-        {
-            Ogre::String fn = ce->fname;
-            Ogre::StringUtil::toLowerCase(fn);
-            return fn.find(v[1]);
-        }
-    }
-    return Ogre::String::npos;
-}
-
 void CLASS::OnCategorySelected(int categoryID)
 {
     if (m_loader_type == LT_SKIN)
@@ -581,36 +463,33 @@ void CLASS::OnCategorySelected(int categoryID)
 
     if (categoryID == CacheSystem::CID_SearchResults)
     {
-        std::vector<std::pair<CacheEntry*, size_t>> search_results;
-        search_results.reserve(m_entries.size());
+        // Results come ranked; only filter out entries not offered for this loader type
+        RoR::App::GetCacheSystem()->getSearchIndex().Query(search_cmd, m_search_results);
+        std::vector<CacheEntry>* entries = RoR::App::GetCacheSystem()->getEntries();
 
-        for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+        for (auto it = m_search_results.begin(); it != m_search_results.end(); it++)
         {
-            size_t score = SearchCompare(search_cmd, &(*it));
-            if (score != Ogre::String::npos)
-                search_results.push_back(std::make_pair(&(*it), score));
-        }
+            if (it->entry >= static_cast<int>(m_listed.size()) || !m_listed[it->entry])
+                continue;
 
-        std::stable_sort(search_results.begin(), search_results.end(), sort_search_results());
-
-        for (auto it = search_results.begin(); it != search_results.end(); it++)
-        {
+            CacheEntry& entry = (*entries)[it->entry];
             counter++;
-            Ogre::String txt = TOSTRING(counter) + ". " + it->first->dname;
+            Ogre::String txt = TOSTRING(counter) + ". " + entry.dname;
             try
             {
-                m_Model->addItem(txt, it->first->number);
+                m_Model->addItem(txt, entry.number);
             }
             catch (...)
             {
-                m_Model->addItem("ENCODING ERROR", it->first->number);
+                m_Model->addItem("ENCODING ERROR", entry.number);
             }
         }
     }
     else
     {
-        for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+        for (auto itor = m_entries.begin(); itor != m_entries.end(); itor++)
         {
+            CacheEntry* it = *itor;
             if (it->categoryid == categoryID || categoryID == CacheSystem::CID_All
                 || categoryID == CacheSystem::CID_Fresh && (ts - it->addtimestamp < CACHE_FILE_FRESHNESS))
             {
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "ForwardDeclarations.h"
+#include "CacheSearchIndex.h"
 #include "GUI_MainSelectorLayout.h"
 
 namespace RoR {
@@ -71,7 +72,6 @@ private:
     void OnCategorySelected(int categoryID);
     void OnEntrySelected(int entryID);
     void OnSelectionDone();
-    size_t SearchCompare(Ogre::String searchString, CacheEntry* ce);
 
     void UpdateControls(CacheEntry* entry);
     void SetPreviewImage(Ogre::String texture);
@@ -82,7 +82,9 @@ private:
     Ogre::String m_preview_image_texture;
     RoR::SkinDef* m_selected_skin;
     bool m_selection_done;
-    std::vector<CacheEntry> m_entries;
+    std::vector<CacheEntry*> m_entries;  //!< Listed for current loader type, sorted by name
+    std::vector<bool> m_listed;          //!< Indexed by position in `CacheSystem::getEntries()`
+    std::vector<RoR::CacheSearchIndex::Result> m_search_results; //!< Reused between keystrokes
     std::vector<Ogre::String> m_vehicle_configs;
     std::vector<RoR::SkinDef *> m_current_skins;
     bool m_keys_bound;
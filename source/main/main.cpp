@@ -20,6 +20,7 @@
 */
 
 #include "Application.h"
+#include "AsyncLog.h"
 #include "RoRPrerequisites.h"
 #include "MainMenu.h"
 #include "Language.h"
@@ -27,6 +28,7 @@
 #include "Utils.h"
 #include "PlatformUtils.h"
 #include "Settings.h"
+#include "ThreadPlacement.h"
 #include "Application.h"
 #include "Beam.h"
 #include "BeamEngine.h"
@@ -55,6 +57,7 @@
 #include "OgreSubsystem.h"
 #include "OverlayWrapper.h"
 #include "OutProtocol.h"
+#include "PerfHarness.h"
 #include "RoRVersion.h"
 #include "RoRFrameListener.h"
 #include "Scripting.h"
@@ -147,6 +150,7 @@ int main(int argc, char *argv[])
         rorlog_path << logs_dir << PATH_SLASH << "RoR.log";
         ogre_log_manager->createLog(Ogre::String(rorlog_path), true, true);
         App::diag_trace_globals.SetActive(true); // We have logger -> we can trace.
+        RoR::AsyncLogStart();
 
         // ### Setup program paths ###
 
@@ -296,7 +300,7 @@ int main(int argc, char *argv[])
         AppState prev_app_state = App::app_state.GetActive();
         App::app_state.SetPending(AppState::MAIN_MENU);
 
-        if (! App::diag_preset_terrain.IsActiveEmpty())
+        if (! App::diag_preset_terrain.IsActiveEmpty() || ! App::diag_perf_scenario.IsActiveEmpty())
         {
             App::app_state.SetPending(AppState::SIMULATION);
         }
@@ -356,6 +360,11 @@ int main(int argc, char *argv[])
             }
             else if (App::app_state.GetPending() == AppState::SIMULATION)
             {
+                if (App::app_render_cpu.GetActive() >= 0)
+                {
+                    // Before the simulation's worker threads are started, so they stay off this CPU
+                    ThreadPlacement::ReserveCpuForCurrentThread(App::app_render_cpu.GetActive());
+                }
                 {
                     SimController sim_controller(&force_feedback, &skidmark_conf);
                     App::SetSimController(&sim_controller);
@@ -366,12 +375,17 @@ int main(int argc, char *argv[])
                         sim_controller.EnterGameplayLoop();
                         App::SetSimController(nullptr);
                     }
+                    else if (! App::diag_perf_scenario.IsActiveEmpty())
+                    {
+                        App::app_state.SetPending(AppState::SHUTDOWN); // Perf test setup failed
+                    }
                     else
                     {
                         App::app_state.SetPending(AppState::MAIN_MENU);
                     }
                 }
                 gEnv->sceneManager->clearScene(); // Wipe the scene after SimController was destroyed (->cleanups invoked)
+                ThreadPlacement::ReleaseReservedCpu();
             }
             else if (App::app_state.GetPending() == AppState::CHANGE_MAP)
             {
@@ -443,11 +457,13 @@ int main(int argc, char *argv[])
         ErrorUtils::ShowError(_L("An exception (std::runtime_error) has occured!"), e.what());
     }
 
+    RoR::AsyncLogStop();
+
 #ifdef USE_CRASHRPT
     UninstallCrashRpt();
 #endif //USE_CRASHRPT
 
-    return 0;
+    return PerfHarness::LastRunFailed() ? 1 : 0;
 }
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
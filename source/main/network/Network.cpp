@@ -24,6 +24,7 @@
 #include "Network.h"
 
 #include "Application.h"
+#include "AsyncLog.h"
 #include "BeamFactory.h"
 #include "CharacterFactory.h"
 #include "ChatSystem.h"
@@ -35,6 +36,7 @@
 #include "SHA1.h"
 #include "ScriptEngine.h"
 #include "Settings.h"
+#include "ThreadPlacement.h"
 #include "Utils.h"
 
 #include <Ogre.h>
@@ -139,7 +141,6 @@ static Ogre::UTFString   m_error_message;
 static StatusStr         m_status_message;
 
 #define LOG_THREAD(_MSG_) { std::stringstream s; s << _MSG_ << " (Thread ID: " << std::this_thread::get_id() << ")"; LOG(s.str()); }
-#define LOGSTREAM         Ogre::LogManager().getSingleton().stream()
 
 static const int RECVMESSAGE_RETVAL_SHUTDOWN = -43;
 
@@ -244,7 +245,7 @@ bool SendMessageRaw(char *buffer, int msgsize)
         int sendnum = socket.send(buffer + rlen, msgsize - rlen, &error);
         if (sendnum < 0)
         {
-            LOG("NET send error: " + error.get_error());
+            RoR::LogAsync(LogCategory::NETWORK, "NET send error: %s", error.get_error());
             return false;
         }
         rlen += sendnum;
@@ -302,7 +303,7 @@ int ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
         int recvnum = socket.recv(buffer + hlen, sizeof(RoRnet::Header) - hlen, &error);
         if (recvnum < 0 && !m_shutdown)
         {
-            LOG("NET receive error 1: " + error.get_error());
+            RoR::LogAsync(LogCategory::NETWORK, "NET receive error 1: %s", error.get_error());
             return -1;
         }
         else if (m_shutdown)
@@ -356,8 +357,15 @@ int ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
     return 0;
 }
 
+static void ApplyNetThreadPlacement(const char* thread_name)
+{
+    const ThreadPlacement placement = ThreadPlacement::FromConfig(App::app_net_thread_cpus.GetActive(), 0, "Network threads");
+    ApplyThreadPlacement(placement, thread_name);
+}
+
 void SendThread()
 {
+    ApplyNetThreadPlacement("ror-net-send");
     LOG("[RoR|Networking] SendThread started");
     while (!m_shutdown)
     {
@@ -385,6 +393,7 @@ void SendThread()
 
 void RecvThread()
 {
+    ApplyNetThreadPlacement("ror-net-recv");
     LOG_THREAD("[RoR|Networking] RecvThread starting...");
 
     RoRnet::Header header;
@@ -413,16 +422,16 @@ void RecvThread()
 
             RoRnet::StreamRegister *reg = (RoRnet::StreamRegister *)buffer;
 
-            LOG(" * received stream registration: " + TOSTRING(header.source) + ": " + TOSTRING(header.streamid) + ", type: " + TOSTRING(reg->type));
+            RoR::LogAsync(LogCategory::NETWORK, " * received stream registration: %d: %u, type: %d", header.source, header.streamid, reg->type);
         }
         else if (header.command == MSG2_STREAM_REGISTER_RESULT)
         {
             RoRnet::StreamRegister *reg = (RoRnet::StreamRegister *)buffer;
-            LOG(" * received stream registration result: " + TOSTRING(header.source) + ": " + TOSTRING(header.streamid) + ", status: " + TOSTRING(reg->status));
+            RoR::LogAsync(LogCategory::NETWORK, " * received stream registration result: %d: %u, status: %d", header.source, header.streamid, reg->status);
         }
         else if (header.command == MSG2_STREAM_UNREGISTER)
         {
-            LOG(" * received stream deregistration: " + TOSTRING(header.source) + ": " + TOSTRING(header.streamid));
+            RoR::LogAsync(LogCategory::NETWORK, " * received stream deregistration: %d: %u", header.source, header.streamid);
         }
         else if (header.command == MSG2_UTF8_CHAT || header.command == MSG2_UTF8_PRIVCHAT)
         {
@@ -803,8 +812,8 @@ void AddPacket(int streamid, int type, int len, char *content)
 {
     if (len > RORNET_MAX_MESSAGE_LENGTH)
     {
-        LOGSTREAM << "[RoR|Networking] Discarding network packet (StreamID: "
-            <<streamid<<", Type: "<<type<<"), length is " << len << ", max is " << RORNET_MAX_MESSAGE_LENGTH;
+        RoR::LogAsync(LogCategory::NETWORK, "[RoR|Networking] Discarding network packet (StreamID: %d, Type: %d), length is %d, max is %d",
+            streamid, type, len, RORNET_MAX_MESSAGE_LENGTH);
         return;
     }
 
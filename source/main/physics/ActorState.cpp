@@ -0,0 +1,236 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ActorState.h"
+
+#include "Application.h"
+#include "BeamData.h"
+#include "PlatformUtils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+using namespace Ogre;
+using namespace RoR;
+
+// The beam fields are copied as one block; keep `beam_t` in sync with `BeamState`.
+static const size_t BEAM_BLOCK_SIZE = offsetof(ActorState::BeamState, disabled);
+static_assert(offsetof(beam_t, plastic_coef) - offsetof(beam_t, L) + sizeof(Real) == BEAM_BLOCK_SIZE,
+    "beam_t fields L ... plastic_coef must be contiguous and match ActorState::BeamState");
+
+static const uint32_t STATE_FILE_MAGIC   = 0x53524F52; // "RORS"
+static const uint32_t STATE_FILE_VERSION = 2;              // 2: explicit little-endian records instead of raw structs
+static const size_t   NODE_RECORD_SIZE   = 6 * 4;          // position, velocity
+static const size_t   BEAM_RECORD_SIZE   = 7 * 4 + 1;      // BeamState reals, flags
+static const uint32_t MAX_ELEMENTS       = 1000000;        // Sanity limit for counts read from file
+static const uint8_t  BEAM_FLAG_DISABLED = 1 << 0;
+static const uint8_t  BEAM_FLAG_BROKEN   = 1 << 1;
+
+static uint8_t* PutU32(uint8_t* dst, uint32_t value)
+{
+    dst[0] = static_cast<uint8_t>(value);
+    dst[1] = static_cast<uint8_t>(value >> 8);
+    dst[2] = static_cast<uint8_t>(value >> 16);
+    dst[3] = static_cast<uint8_t>(value >> 24);
+    return dst + 4;
+}
+
+static uint8_t* PutFloat(uint8_t* dst, Real value)
+{
+    float f = static_cast<float>(value);
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return PutU32(dst, bits);
+}
+
+static const uint8_t* GetU32(const uint8_t* src, uint32_t& value)
+{
+    value = uint32_t(src[0]) | (uint32_t(src[1]) << 8) | (uint32_t(src[2]) << 16) | (uint32_t(src[3]) << 24);
+    return src + 4;
+}
+
+static const uint8_t* GetFloat(const uint8_t* src, Real& value)
+{
+    uint32_t bits;
+    src = GetU32(src, bits);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    value = static_cast<Real>(f);
+    return src;
+}
+
+void ActorState::Capture(const node_t* nodes, int num_nodes, const beam_t* beams, int num_beams)
+{
+    m_nodes.resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++)
+    {
+        m_nodes[i].position = nodes[i].AbsPosition;
+        m_nodes[i].velocity = nodes[i].Velocity;
+    }
+
+    m_beams.resize(num_beams);
+    for (int i = 0; i < num_beams; i++)
+    {
+        std::memcpy(&m_beams[i], &beams[i].L, BEAM_BLOCK_SIZE);
+        m_beams[i].disabled = beams[i].bm_disabled;
+        m_beams[i].broken   = beams[i].bm_broken;
+    }
+}
+
+void ActorState::CaptureInitial(const node_t* nodes, int num_nodes, const beam_t* beams, int num_beams)
+{
+    m_nodes.resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++)
+    {
+        m_nodes[i].position = nodes[i].initial_pos;
+        m_nodes[i].velocity = Vector3::ZERO;
+    }
+
+    m_beams.resize(num_beams);
+    for (int i = 0; i < num_beams; i++)
+    {
+        BeamState& state = m_beams[i];
+        state.L                  = beams[i].refL;
+        state.minmaxposnegstress = beams[i].default_beam_deform;
+        state.maxposstress       = beams[i].default_beam_deform;
+        state.maxnegstress       = -beams[i].default_beam_deform;
+        state.strength           = beams[i].initial_beam_strength;
+        state.stress             = 0.f;
+        state.plastic_coef       = beams[i].default_beam_plastic_coef;
+        state.disabled           = false;
+        state.broken             = false;
+    }
+}
+
+void ActorState::Restore(node_t* nodes, beam_t* beams, Vector3 const& origin, bool with_velocity) const
+{
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        nodes[i].AbsPosition = m_nodes[i].position;
+        nodes[i].RelPosition = m_nodes[i].position - origin;
+        nodes[i].Velocity    = (with_velocity) ? m_nodes[i].velocity : Vector3::ZERO;
+        nodes[i].Forces      = Vector3::ZERO;
+    }
+
+    for (size_t i = 0; i < m_beams.size(); i++)
+    {
+        std::memcpy(&beams[i].L, &m_beams[i], BEAM_BLOCK_SIZE);
+        beams[i].bm_disabled = m_beams[i].disabled;
+        beams[i].bm_broken   = m_beams[i].broken;
+    }
+}
+
+std::string ActorState::GetSaveFilePath(std::string const& filename)
+{
+    if (filename.empty() || filename.find_first_of("/\\:") != std::string::npos || filename.find("..") != std::string::npos)
+        return "";
+
+    std::string dir = std::string(App::sys_user_dir.GetActive()) + PATH_SLASH + "savegames";
+    if (!FolderExists(dir))
+        CreateFolder(dir);
+    return dir + PATH_SLASH + filename;
+}
+
+void ActorState::Clear()
+{
+    m_nodes.clear();
+    m_beams.clear();
+}
+
+bool ActorState::Write(std::ostream& out) const
+{
+    std::vector<uint8_t> buf(4 * 4 + m_nodes.size() * NODE_RECORD_SIZE + m_beams.size() * BEAM_RECORD_SIZE);
+    uint8_t* dst = buf.data();
+    dst = PutU32(dst, STATE_FILE_MAGIC);
+    dst = PutU32(dst, STATE_FILE_VERSION);
+    dst = PutU32(dst, static_cast<uint32_t>(m_nodes.size()));
+    dst = PutU32(dst, static_cast<uint32_t>(m_beams.size()));
+    for (NodeState const& node : m_nodes)
+    {
+        for (int axis = 0; axis < 3; axis++)
+            dst = PutFloat(dst, node.position[axis]);
+        for (int axis = 0; axis < 3; axis++)
+            dst = PutFloat(dst, node.velocity[axis]);
+    }
+    for (BeamState const& beam : m_beams)
+    {
+        dst = PutFloat(dst, beam.L);
+        dst = PutFloat(dst, beam.minmaxposnegstress);
+        dst = PutFloat(dst, beam.maxposstress);
+        dst = PutFloat(dst, beam.maxnegstress);
+        dst = PutFloat(dst, beam.strength);
+        dst = PutFloat(dst, beam.stress);
+        dst = PutFloat(dst, beam.plastic_coef);
+        *dst++ = (beam.disabled ? BEAM_FLAG_DISABLED : 0) | (beam.broken ? BEAM_FLAG_BROKEN : 0);
+    }
+    out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+    return out.good();
+}
+
+bool ActorState::Read(std::istream& in, int num_nodes, int num_beams)
+{
+    this->Clear();
+
+    uint8_t raw_header[4 * 4] = {};
+    in.read(reinterpret_cast<char*>(raw_header), sizeof(raw_header));
+    uint32_t header[4] = {};
+    const uint8_t* src = raw_header;
+    for (uint32_t& field : header)
+        src = GetU32(src, field);
+    if (!in.good() || header[0] != STATE_FILE_MAGIC || header[1] != STATE_FILE_VERSION ||
+        header[2] > MAX_ELEMENTS || header[3] > MAX_ELEMENTS ||
+        (num_nodes != -1 && header[2] != static_cast<uint32_t>(num_nodes)) ||
+        (num_beams != -1 && header[3] != static_cast<uint32_t>(num_beams)))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> buf(header[2] * NODE_RECORD_SIZE + header[3] * BEAM_RECORD_SIZE);
+    in.read(reinterpret_cast<char*>(buf.data()), buf.size());
+    if (!in.good())
+        return false;
+
+    m_nodes.resize(header[2]);
+    m_beams.resize(header[3]);
+    src = buf.data();
+    for (NodeState& node : m_nodes)
+    {
+        for (int axis = 0; axis < 3; axis++)
+            src = GetFloat(src, node.position[axis]);
+        for (int axis = 0; axis < 3; axis++)
+            src = GetFloat(src, node.velocity[axis]);
+    }
+    for (BeamState& beam : m_beams)
+    {
+        src = GetFloat(src, beam.L);
+        src = GetFloat(src, beam.minmaxposnegstress);
+        src = GetFloat(src, beam.maxposstress);
+        src = GetFloat(src, beam.maxnegstress);
+        src = GetFloat(src, beam.strength);
+        src = GetFloat(src, beam.stress);
+        src = GetFloat(src, beam.plastic_coef);
+        const uint8_t flags = *src++;
+        beam.disabled = (flags & BEAM_FLAG_DISABLED) != 0;
+        beam.broken   = (flags & BEAM_FLAG_BROKEN) != 0;
+    }
+    return true;
+}
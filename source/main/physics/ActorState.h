@@ -0,0 +1,92 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Snapshot of an actor's softbody state, used for reset and save/restore slots.
+///
+/// Only the hot physics arrays are stored: node position + velocity, and the block of
+/// beam fields which deformation and breaking modify. Everything else (hooks, ties, engine...)
+/// is handled by `Actor::SyncReset()` as before.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <OgreVector3.h>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+class ActorState
+{
+public:
+    static const int MAX_SLOTS = 10; //!< Save/restore slots per actor
+
+    /// Mirrors the contiguous `beam_t::L` ... `beam_t::plastic_coef` block, plus flags.
+    struct BeamState
+    {
+        Ogre::Real L;
+        Ogre::Real minmaxposnegstress;
+        Ogre::Real maxposstress;
+        Ogre::Real maxnegstress;
+        Ogre::Real strength;
+        Ogre::Real stress;
+        Ogre::Real plastic_coef;
+        bool       disabled;
+        bool       broken;
+    };
+
+    struct NodeState
+    {
+        Ogre::Vector3 position; //!< Absolute
+        Ogre::Vector3 velocity;
+    };
+
+    /// Records current node and beam state
+    void Capture(const node_t* nodes, int num_nodes, const beam_t* beams, int num_beams);
+    /// Records the pristine state: nodes at `initial_pos` and at rest, beams undamaged
+    void CaptureInitial(const node_t* nodes, int num_nodes, const beam_t* beams, int num_beams);
+
+    /// Writes the snapshot back; forces are cleared, `RelPosition` is derived from `origin`.
+    /// @param with_velocity False puts the nodes at rest, like the legacy position storage did.
+    void Restore(node_t* nodes, beam_t* beams, Ogre::Vector3 const& origin, bool with_velocity) const;
+
+    /// Versioned little-endian format with 32-bit floats, portable between platforms and builds.
+    bool Write(std::ostream& out) const;
+    /// Fails (and leaves the snapshot empty) unless the stream holds a snapshot of the given size; -1 accepts any.
+    bool Read(std::istream& in, int num_nodes = -1, int num_beams = -1);
+
+    /// @return Path in the user's 'savegames' directory (created on demand), or "" unless `filename` is a plain file name.
+    static std::string GetSaveFilePath(std::string const& filename);
+
+    void Clear();
+    bool IsEmpty() const      { return m_nodes.empty(); }
+    int  GetNumNodes() const  { return static_cast<int>(m_nodes.size()); }
+    int  GetNumBeams() const  { return static_cast<int>(m_beams.size()); }
+    size_t GetMemoryUsage() const { return m_nodes.capacity() * sizeof(NodeState) + m_beams.capacity() * sizeof(BeamState); }
+
+private:
+    std::vector<NodeState> m_nodes;
+    std::vector<BeamState> m_beams;
+};
+
+} // namespace RoR
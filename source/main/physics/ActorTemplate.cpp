@@ -0,0 +1,113 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ActorTemplate.h"
+
+#include "FlexBody.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace RoR;
+
+// FlexBody frees the buffers with free() and the locators with delete[], allocate accordingly.
+
+template<typename T> static T* MallocCopy(const T* src, size_t count)
+{
+    T* dst = static_cast<T*>(malloc(sizeof(T) * count));
+    std::memcpy(dst, src, sizeof(T) * count);
+    return dst;
+}
+
+static Locator_t* NewCopy(const Locator_t* src, size_t count)
+{
+    Locator_t* dst = new Locator_t[count];
+    std::memcpy(dst, src, sizeof(Locator_t) * count);
+    return dst;
+}
+
+ActorTemplate::~ActorTemplate()
+{
+    this->Clear();
+}
+
+void ActorTemplate::Clear()
+{
+    for (FlexBodyCacheData& data: m_flexbodies)
+    {
+        free(data.dst_pos);
+        free(data.src_normals);
+        free(data.src_colors);
+        delete[] data.locators;
+    }
+    m_flexbodies.clear();
+    m_is_complete = false;
+}
+
+void ActorTemplate::BeginCapture()
+{
+    this->Clear();
+}
+
+void ActorTemplate::CaptureFlexBody(FlexBody* flexbody)
+{
+    FlexBodyCacheData data;
+    data.header.vertex_count         = static_cast<int>(flexbody->m_vertex_count);
+    data.header.node_center          = flexbody->m_node_center;
+    data.header.node_x               = flexbody->m_node_x;
+    data.header.node_y               = flexbody->m_node_y;
+    data.header.center_offset        = flexbody->m_center_offset;
+    data.header.camera_mode          = flexbody->m_camera_mode;
+    data.header.shared_buf_num_verts = flexbody->m_shared_buf_num_verts;
+    data.header.num_submesh_vbufs    = flexbody->m_num_submesh_vbufs;
+    data.header.SetIsEnabled           (flexbody->m_is_enabled);
+    data.header.SetUsesSharedVertexData(flexbody->m_uses_shared_vertex_data);
+    data.header.SetHasTexture          (flexbody->m_has_texture);
+    data.header.SetHasTextureBlend     (flexbody->m_has_texture_blend);
+
+    if (flexbody->m_is_enabled && flexbody->m_locators != nullptr)
+    {
+        const size_t count = flexbody->m_vertex_count;
+        data.locators    = NewCopy(flexbody->m_locators, count);
+        data.dst_pos     = MallocCopy(flexbody->m_dst_pos, count);
+        data.src_normals = MallocCopy(flexbody->m_src_normals, count);
+        if (flexbody->m_has_texture_blend)
+        {
+            data.src_colors = MallocCopy(flexbody->m_src_colors, count);
+        }
+    }
+    m_flexbodies.push_back(data);
+}
+
+bool ActorTemplate::CopyFlexBody(size_t index, FlexBodyCacheData& out) const
+{
+    if (!m_is_complete || index >= m_flexbodies.size() || m_flexbodies[index].locators == nullptr)
+    {
+        return false;
+    }
+
+    FlexBodyCacheData const& src = m_flexbodies[index];
+    const size_t count = static_cast<size_t>(src.header.vertex_count);
+    out.header      = src.header;
+    out.locators    = NewCopy(src.locators, count);
+    out.dst_pos     = MallocCopy(src.dst_pos, count);
+    out.src_normals = MallocCopy(src.src_normals, count);
+    out.src_colors  = (src.src_colors != nullptr) ? MallocCopy(src.src_colors, count) : nullptr;
+    return true;
+}
@@ -0,0 +1,64 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Spawn-time data which only depends on the actor definition (and selected config).
+///
+/// The first spawned instance of a definition fills the template; every further instance
+/// copies from it instead of computing again. Currently holds flexbody vertex locators,
+/// by far the most expensive part of spawning (nearest-node search for every vertex).
+/// Locators are relative to their reference nodes, so they don't depend on spawn position.
+/// See `ActorManager::FetchActorTemplate()`.
+///
+/// Node, beam, shock, prop and wheel setup is not templated: it's linear in the definition size
+/// and interleaved with per-instance side effects in `ActorSpawner` (hooks, exhausts, mass counts).
+
+#pragma once
+
+#include "FlexFactory.h"
+
+#include <vector>
+
+class FlexBody;
+
+namespace RoR {
+
+class ActorTemplate
+{
+public:
+    ActorTemplate(): m_is_complete(false) {}
+    ~ActorTemplate();
+
+    bool IsComplete() const                  { return m_is_complete; }
+    void BeginCapture();                     //!< Discards previous (possibly incomplete) data
+    void CaptureFlexBody(FlexBody* flexbody);
+    void EndCapture()                        { m_is_complete = true; }
+
+    /// Fills `out` with a new copy of the data (ownership passes to the FlexBody created from it).
+    /// @return False if there's no usable data for this flexbody; locators must be computed.
+    bool CopyFlexBody(size_t index, FlexBodyCacheData& out) const;
+
+private:
+    void Clear();
+
+    std::vector<FlexBodyCacheData> m_flexbodies;
+    bool                           m_is_complete;
+};
+
+} // namespace RoR
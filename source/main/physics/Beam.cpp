@@ -34,6 +34,7 @@
 #include "Airfoil.h"
 #include "Application.h"
 #include "ApproxMath.h"
+#include "AsyncLog.h"
 #include "AutoPilot.h"
 #include "BeamData.h"
 #include "BeamEngine.h"
@@ -56,13 +57,13 @@
 #include "FlexMesh.h"
 #include "FlexMeshWheel.h"
 #include "FlexObj.h"
+#include "ForceFeedback.h"
 #include "InputEngine.h"
 #include "Language.h"
 #include "MeshObject.h"
 #include "MovableText.h"
 #include "Network.h"
 #include "PointColDetector.h"
-#include "PositionStorage.h"
 #include "Replay.h"
 #include "RigSpawner.h"
 #include "RoRFrameListener.h"
@@ -81,6 +82,9 @@
 #include "Water.h"
 #include "GUIManager.h"
 
+#include <fstream>
+#include <set>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -124,10 +128,6 @@ Actor::~Actor()
         ar_autopilot = nullptr;
     }
 
-    if (m_fusealge_airfoil)
-        delete m_fusealge_airfoil;
-    m_fusealge_airfoil = 0;
-
     if (m_cab_mesh != nullptr)
     {
         this->fadeMesh(m_cab_scene_node, 1.f); // Reset transparency of "skeleton view"
@@ -177,12 +177,13 @@ Actor::~Actor()
         m_deletion_entities.clear();
     }
 
+    // delete sub-objects allocated by ActorSpawner: wings, aeroengines, screwprops, airbrakes,
+    // fuselage airfoil, collision detectors, inertia filters, axles and rails
+    m_memory.Clear();
+
     // delete wings
     for (int i = 0; i < ar_num_wings; i++)
     {
-        // flexAirfoil, airfoil
-        if (ar_wings[i].fa)
-            delete ar_wings[i].fa;
         if (ar_wings[i].cnode)
         {
             ar_wings[i].cnode->removeAndDestroyAllChildren();
@@ -190,33 +191,6 @@ Actor::~Actor()
         }
     }
 
-    // delete aeroengines
-    for (int i = 0; i < ar_num_aeroengines; i++)
-    {
-        if (ar_aeroengines[i])
-            delete ar_aeroengines[i];
-    }
-
-    // delete screwprops
-    for (int i = 0; i < ar_num_screwprops; i++)
-    {
-        if (ar_screwprops[i])
-        {
-            delete ar_screwprops[i];
-            ar_screwprops[i] = nullptr;
-        }
-    }
-
-    // delete airbrakes
-    for (int i = 0; i < ar_num_airbrakes; i++)
-    {
-        if (ar_airbrakes[i])
-        {
-            delete ar_airbrakes[i];
-            ar_airbrakes[i] = 0;
-        }
-    }
-
     // delete flexbodies
     for (int i = 0; i < ar_num_flexbodies; i++)
     {
@@ -340,11 +314,7 @@ Actor::~Actor()
         }
     }
 
-    // delete Rails
-    for (std::vector<RailGroup*>::iterator it = m_railgroups.begin(); it != m_railgroups.end(); it++)
-    {
-        delete (*it);
-    }
+    m_railgroups.clear();
 
     if (m_net_label_mt)
     {
@@ -353,31 +323,6 @@ Actor::~Actor()
         m_net_label_mt = nullptr;
     }
 
-    if (m_intra_point_col_detector)
-    {
-        delete m_intra_point_col_detector;
-        m_intra_point_col_detector = nullptr;
-    }
-
-    if (m_inter_point_col_detector)
-    {
-        delete m_inter_point_col_detector;
-        m_inter_point_col_detector = nullptr;
-    }
-
-    if (m_command_inertia)
-        delete m_command_inertia;
-    if (m_hydro_inertia)
-        delete m_hydro_inertia;
-    if (m_rotator_inertia)
-        delete m_rotator_inertia;
-
-    for (int i = 0; i < m_num_axles; ++i)
-    {
-        if (m_axles[i] != nullptr)
-            delete (m_axles[i]);
-    }
-
     delete ar_nodes;
     delete ar_beams;
     delete ar_shocks;
@@ -416,6 +361,7 @@ void Actor::ScaleActor(float value)
         ar_nodes[i].Forces *= value;
         ar_nodes[i].mass *= value;
     }
+    this->CaptureInitialState();
     updateSlideNodePositions();
 
     // props and stuff
@@ -955,75 +901,138 @@ float Actor::getTotalMass(bool withLocked)
 
     float mass = m_total_mass;
 
-    for (std::list<Actor*>::iterator it = m_linked_actors.begin(); it != m_linked_actors.end(); ++it)
+    for (Actor* actor : this->GetAllLinkedActors())
     {
-        mass += (*it)->m_total_mass;
+        mass += actor->m_total_mass;
     }
 
     return mass;
 }
 
-void Actor::DetermineLinkedActors() //TODO: Refactor this - logic iterating over all actors should be in `ActorManager`! ~ only_a_ptr, 01/2018
+std::vector<Actor*> Actor::GetAllLinkedActors()
 {
-    m_linked_actors.clear();
-
-    bool found = true;
-    std::map<Actor*, bool> lookup_table;
-    std::pair<std::map<Actor*, bool>::iterator, bool> ret;
+    std::vector<Actor*> linked_actors;
+    Actor* root = App::GetSimController()->GetBeamFactory()->GetLinkRoot(this);
+    for (Actor* actor : root->m_link_members)
+    {
+        if (actor != this)
+            linked_actors.push_back(actor);
+    }
+    return linked_actors;
+}
 
-    lookup_table.insert(std::pair<Actor*, bool>(this, false));
-    
-    auto inter_actor_links = App::GetSimController()->GetBeamFactory()->inter_actor_links; // TODO: Shouldn't this have been a reference?? Also, ugly, see the TODO note above ~ only_a_ptr, 01/2018
+int Actor::getWheelNodeCount()
+{
+    return m_wheel_node_count;
+}
 
-    while (found)
+void Actor::InitStructuralDamage()
+{
+    m_detacher_group_beams.clear();
+    m_detacher_group_wheels.clear();
+    for (int i = 0; i < ar_num_beams; i++)
+    {
+        if (ar_beams[i].detacher_group != 0)
+            m_detacher_group_beams[abs(ar_beams[i].detacher_group)].push_back(i);
+    }
+    for (int i = 0; i < ar_num_wheels; i++)
     {
-        found = false;
+        if (ar_wheels[i].wh_detacher_group > 0)
+            m_detacher_group_wheels[ar_wheels[i].wh_detacher_group].push_back(i);
+    }
 
-        for (std::map<Actor*, bool>::iterator it_beam = lookup_table.begin(); it_beam != lookup_table.end(); ++it_beam)
+    m_buoycab_beams.assign(ar_num_beams, false);
+    for (int i = 0; i < ar_num_beams; i++)
+    {
+        for (int mk = 0; mk < ar_num_buoycabs; mk++)
         {
-            if (!it_beam->second)
+            int tmpv = ar_buoycabs[mk] * 3;
+            if (ar_buoycab_types[mk] == Buoyance::BUOY_DRAGONLY)
+                continue;
+            if ((ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 2]]) &&
+                (ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 2]]))
             {
-                auto actor = it_beam->first;
-                for (auto it = inter_actor_links.begin(); it != inter_actor_links.end(); it++)
-                {
-                    auto actor_pair = it->second;
-                    if (actor == actor_pair.first || actor == actor_pair.second)
-                    {
-                        auto other_actor = (actor != actor_pair.first) ? actor_pair.first : actor_pair.second;
-                        ret = lookup_table.insert(std::pair<Actor*, bool>(other_actor, false));
-                        if (ret.second)
-                        {
-                            m_linked_actors.push_back(other_actor);
-                            found = true;
-                        }
-                    }
-                }
-                it_beam->second = true;
+                m_buoycab_beams[i] = true;
+                break;
             }
         }
     }
+
+    m_beam_break_events.reserve(ar_num_beams);
+    m_node_live_beams_dirty = true;
 }
 
-int Actor::getWheelNodeCount()
+void Actor::ProcessBeamBreakEvents()
 {
-    return m_wheel_node_count;
+    for (int i : m_beam_break_events)
+    {
+        // detachergroup check: beam[i] is already broken, check detacher group# == 0/default skip the check ( performance bypass for beams with default setting )
+        // only perform this check if this is a master detacher beams (positive detacher group id > 0)
+        if (ar_beams[i].bm_broken && ar_beams[i].detacher_group > 0)
+        {
+            // delete & disable all master(positive id) and minor(negative id) beams of this detacher group
+            // Lookups only; inserting here would race with `ApplyState()` iterating the maps on the main thread
+            auto group_beams = m_detacher_group_beams.find(ar_beams[i].detacher_group); // Always found, contains beam `i`
+            for (int j : group_beams->second)
+            {
+                if (!ar_beams[j].bm_disabled && !ar_beams[j].bounded)
+                    m_node_live_beams_dirty = true; // Rare; a recount is simpler than finding the node lists
+                ar_beams[j].bm_broken = true;
+                ar_beams[j].bm_disabled = true;
+                if (m_beam_break_debug_enabled)
+                {
+                    RoR::LogAsync(LogCategory::BEAM_BREAK, "Deleting Detacher BeamID: %d, Detacher Group: %d, actor ID: %d", j, ar_beams[i].detacher_group, ar_instance_id);
+                }
+            }
+            auto group_wheels = m_detacher_group_wheels.find(ar_beams[i].detacher_group);
+            if (group_wheels != m_detacher_group_wheels.end())
+            {
+                for (int j : group_wheels->second)
+                    ar_wheels[j].wh_is_detached = true;
+            }
+        }
+
+        // something broke, check buoyant hull
+        if (m_buoycab_beams[i])
+        {
+            m_buoyance->setsink(1);
+        }
+    }
+    m_beam_break_events.clear();
 }
 
 void Actor::calcNodeConnectivityGraph()
 {
     int i;
 
-    ar_node_to_node_connections.resize(ar_num_nodes, std::vector<int>());
-    ar_node_to_beam_connections.resize(ar_num_nodes, std::vector<int>());
+    // Count connections per node, prefix-sum them into offsets, then fill in beam order
+    ar_node_conn_offsets.assign(ar_num_nodes + 1, 0);
+    for (i = 0; i < ar_num_beams; i++)
+    {
+        if (ar_beams[i].p1 != NULL && ar_beams[i].p2 != NULL && ar_beams[i].p1->pos >= 0 && ar_beams[i].p2->pos >= 0)
+        {
+            ar_node_conn_offsets[ar_beams[i].p1->pos + 1]++;
+            ar_node_conn_offsets[ar_beams[i].p2->pos + 1]++;
+        }
+    }
+    for (i = 0; i < ar_num_nodes; i++)
+    {
+        ar_node_conn_offsets[i + 1] += ar_node_conn_offsets[i];
+    }
 
+    ar_node_conn_nodes.resize(ar_node_conn_offsets[ar_num_nodes]);
+    ar_node_conn_beams.resize(ar_node_conn_offsets[ar_num_nodes]);
+    std::vector<int> fill_pos(ar_node_conn_offsets.begin(), ar_node_conn_offsets.end() - 1);
     for (i = 0; i < ar_num_beams; i++)
     {
         if (ar_beams[i].p1 != NULL && ar_beams[i].p2 != NULL && ar_beams[i].p1->pos >= 0 && ar_beams[i].p2->pos >= 0)
         {
-            ar_node_to_node_connections[ar_beams[i].p1->pos].push_back(ar_beams[i].p2->pos);
-            ar_node_to_beam_connections[ar_beams[i].p1->pos].push_back(i);
-            ar_node_to_node_connections[ar_beams[i].p2->pos].push_back(ar_beams[i].p1->pos);
-            ar_node_to_beam_connections[ar_beams[i].p2->pos].push_back(i);
+            int p1 = ar_beams[i].p1->pos;
+            int p2 = ar_beams[i].p2->pos;
+            ar_node_conn_nodes[fill_pos[p1]] = p2;
+            ar_node_conn_beams[fill_pos[p1]++] = i;
+            ar_node_conn_nodes[fill_pos[p2]] = p1;
+            ar_node_conn_beams[fill_pos[p2]++] = i;
         }
     }
 }
@@ -1216,46 +1225,95 @@ void Actor::resolveCollisions(float max_distance, bool consider_up)
     ResetPosition(ar_nodes[0].AbsPosition.x + offset.x, ar_nodes[0].AbsPosition.z + offset.z, true, ar_nodes[ar_lowest_contacting_node].AbsPosition.y + offset.y);
 }
 
-int Actor::savePosition(int indexPosition)
+int Actor::SaveState(int slot)
 {
-    if (!m_position_storage)
-        return -1;
-    Vector3* nbuff = m_position_storage->getStorage(indexPosition);
-    if (!nbuff)
+    if (slot < 0 || slot >= static_cast<int>(m_saved_states.size()))
         return -3;
-    for (int i = 0; i < ar_num_nodes; i++)
-        nbuff[i] = ar_nodes[i].AbsPosition;
-    m_position_storage->setUsage(indexPosition, true);
+    m_saved_states[slot].Capture(ar_nodes, ar_num_nodes, ar_beams, ar_num_beams);
     return 0;
 }
 
-int Actor::loadPosition(int indexPosition)
+int Actor::RestoreState(int slot)
 {
-    if (!m_position_storage)
-        return -1;
-    if (!m_position_storage->getUsage(indexPosition))
+    if (slot < 0 || slot >= static_cast<int>(m_saved_states.size()))
+        return -3;
+    if (m_saved_states[slot].IsEmpty())
         return -2;
 
-    Vector3* nbuff = m_position_storage->getStorage(indexPosition);
-    if (!nbuff)
-        return -3;
-    Vector3 pos = Vector3(0, 0, 0);
-    for (int i = 0; i < ar_num_nodes; i++)
+    this->ApplyState(m_saved_states[slot], false); // At rest, like the legacy position storage
+    return 0;
+}
+
+void Actor::ApplyState(RoR::ActorState const& state, bool with_velocity)
+{
+    // Hook and tie beams belong to the current lock state, not the snapshot
+    std::vector<beam_t> link_beams;
+    for (hook_t& hook : ar_hooks)
+        link_beams.push_back(*hook.hk_beam);
+    for (tie_t& tie : ar_ties)
+        link_beams.push_back(*tie.ti_beam);
+
+    state.Restore(ar_nodes, ar_beams, ar_origin, with_velocity);
+
+    size_t link_pos = 0;
+    for (hook_t& hook : ar_hooks)
+        *hook.hk_beam = link_beams[link_pos++];
+    for (tie_t& tie : ar_ties)
+        *tie.ti_beam = link_beams[link_pos++];
+
+    // Detached wheels follow their detacher group
+    for (auto& group : m_detacher_group_wheels)
     {
-        ar_nodes[i].AbsPosition = nbuff[i];
-        ar_nodes[i].RelPosition = nbuff[i] - ar_origin;
+        bool detached = false;
+        auto group_beams = m_detacher_group_beams.find(group.first);
+        if (group_beams != m_detacher_group_beams.end())
+        {
+            for (int beam : group_beams->second)
+                detached = detached || ar_beams[beam].bm_broken;
+        }
+        for (int wheel : group.second)
+            ar_wheels[wheel].wh_is_detached = detached;
+    }
+    m_node_live_beams_dirty = true;
 
-        // reset forces
-        ar_nodes[i].Velocity = Vector3::ZERO;
-        ar_nodes[i].Forces = Vector3::ZERO;
+    this->updateBoundingBox();
+    this->calculateAveragePosition();
+    this->resetSlideNodes();
+}
+
+bool Actor::SaveStateToFile(int slot, std::string const& filename)
+{
+    std::string path = RoR::ActorState::GetSaveFilePath(filename);
+    if (path.empty() || slot < 0 || slot >= static_cast<int>(m_saved_states.size()) || m_saved_states[slot].IsEmpty())
+        return false;
 
-        pos = pos + nbuff[i];
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open() || !m_saved_states[slot].Write(file))
+    {
+        LOG("[RoR|Actor] Failed to write state file: " + path);
+        return false;
     }
-    m_avg_node_position = pos / (float)(ar_num_nodes);
+    return true;
+}
+
+bool Actor::LoadStateFromFile(int slot, std::string const& filename)
+{
+    std::string path = RoR::ActorState::GetSaveFilePath(filename);
+    if (path.empty() || slot < 0 || slot >= static_cast<int>(m_saved_states.size()))
+        return false;
 
-    resetSlideNodes();
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open() || !m_saved_states[slot].Read(file, ar_num_nodes, ar_num_beams))
+    {
+        LOG("[RoR|Actor] Failed to read state file (missing, or saved from a different actor): " + path);
+        return false;
+    }
+    return true;
+}
 
-    return 0;
+void Actor::CaptureInitialState()
+{
+    m_initial_state.CaptureInitial(ar_nodes, ar_num_nodes, ar_beams, ar_num_beams);
 }
 
 void Actor::calculateAveragePosition()
@@ -1422,6 +1480,7 @@ void Actor::ResetPosition(Vector3 translation, bool setInitPosition)
         {
             ar_nodes[i].initial_pos = ar_nodes[i].AbsPosition;
         }
+        this->CaptureInitialState();
     }
 
     updateBoundingBox();
@@ -1521,6 +1580,20 @@ void Actor::ToggleAxleLock()
             continue;
         m_axles[i]->ToggleDifferentialMode();
     }
+    this->SyncDrivetrainDiffs();
+}
+
+void Actor::SyncDrivetrainDiffs()
+{
+    int diff = 0;
+    for (int i = 0; i < m_num_axles; ++i)
+    {
+        if (!m_axles[i] || m_axles[i]->ax_wheel_1 < 0 || m_axles[i]->ax_wheel_2 < 0)
+            continue; // Not in the drivetrain, see `ActorSpawner::FinalizeRig()`
+        if (m_axles[i]->HasDifferential())
+            m_drivetrain.SetDifferentialType(diff, m_axles[i]->GetActiveDifferential());
+        diff++;
+    }
 }
 
 int Actor::getAxleLockCount()
@@ -1601,51 +1674,8 @@ Ogre::Vector3 Actor::GetRotationCenter()
     return rotation_center;
 }
 
-void Actor::SyncReset()
+void Actor::ResetHooksRopesTies()
 {
-    ar_hydro_dir_state = 0.0;
-    ar_hydro_aileron_state = 0.0;
-    ar_hydro_rudder_state = 0.0;
-    ar_hydro_elevator_state = 0.0;
-    ar_hydro_dir_wheel_display = 0.0;
-    if (m_hydro_inertia)
-        m_hydro_inertia->resetCmdKeyDelay();
-    ar_parking_brake = 0;
-    cc_mode = false;
-    ar_fusedrag = Vector3::ZERO;
-    ar_origin = Vector3::ZERO;
-    float yPos = ar_nodes[ar_lowest_contacting_node].AbsPosition.y;
-
-    Vector3 cur_position = ar_nodes[0].AbsPosition;
-    float cur_rot = getRotation();
-    if (ar_engine)
-    {
-        ar_engine->StartEngine();
-    }
-
-    for (int i = 0; i < ar_num_nodes; i++)
-    {
-        ar_nodes[i].AbsPosition = ar_nodes[i].initial_pos;
-        ar_nodes[i].RelPosition = ar_nodes[i].initial_pos - ar_origin;
-        ar_nodes[i].Velocity = Vector3::ZERO;
-        ar_nodes[i].Forces = Vector3::ZERO;
-    }
-
-    for (int i = 0; i < ar_num_beams; i++)
-    {
-        ar_beams[i].maxposstress    = ar_beams[i].default_beam_deform;
-        ar_beams[i].maxnegstress    = -ar_beams[i].default_beam_deform;
-        ar_beams[i].minmaxposnegstress = ar_beams[i].default_beam_deform;
-        ar_beams[i].strength        = ar_beams[i].initial_beam_strength;
-        ar_beams[i].plastic_coef    = ar_beams[i].default_beam_plastic_coef;
-        ar_beams[i].L               = ar_beams[i].refL;
-        ar_beams[i].stress          = 0.0;
-        ar_beams[i].bm_broken       = false;
-        ar_beams[i].bm_disabled     = false;
-    }
-
-    this->DisjoinInterActorBeams();
-
     for (std::vector<hook_t>::iterator it = ar_hooks.begin(); it != ar_hooks.end(); it++)
     {
         it->hk_beam->bm_disabled = true;
@@ -1676,6 +1706,35 @@ void Actor::SyncReset()
         it->ti_beam->bm_disabled = true;
         this->RemoveInterActorBeam(it->ti_beam);
     }
+}
+
+void Actor::SyncReset()
+{
+    ar_hydro_dir_state = 0.0;
+    ar_hydro_aileron_state = 0.0;
+    ar_hydro_rudder_state = 0.0;
+    ar_hydro_elevator_state = 0.0;
+    ar_hydro_dir_wheel_display = 0.0;
+    if (m_hydro_inertia)
+        m_hydro_inertia->resetCmdKeyDelay();
+    ar_parking_brake = 0;
+    cc_mode = false;
+    ar_fusedrag = Vector3::ZERO;
+    ar_origin = Vector3::ZERO;
+    float yPos = ar_nodes[ar_lowest_contacting_node].AbsPosition.y;
+
+    Vector3 cur_position = ar_nodes[0].AbsPosition;
+    float cur_rot = getRotation();
+    if (ar_engine)
+    {
+        ar_engine->StartEngine();
+    }
+
+    m_initial_state.Restore(ar_nodes, ar_beams, ar_origin, false);
+    m_node_live_beams_dirty = true;
+
+    this->DisjoinInterActorBeams();
+    this->ResetHooksRopesTies();
 
     for (int i = 0; i < ar_num_aeroengines; i++)
         ar_aeroengines[i]->reset();
@@ -1765,6 +1824,7 @@ bool Actor::ReplayStep()
                 ar_beams[i].bm_broken = bbuff[i].broken;
                 ar_beams[i].bm_disabled = bbuff[i].disabled;
             }
+            m_node_live_beams_dirty = true;
         }
         m_replay_pos_prev = ar_replay_pos;
     }
@@ -1772,13 +1832,154 @@ bool Actor::ReplayStep()
     return true;
 }
 
-void Actor::ForceFeedbackStep(int steps)
+RoR::NodeBvh const& Actor::GetNodeBvh(unsigned long physics_frame)
 {
-    m_force_sensors.out_body_forces = m_force_sensors.accu_body_forces / steps;
-    if (ar_num_hydros != 0) // Vehicle has hydros?
+    if (physics_frame != m_node_bvh_frame)
     {
-        m_force_sensors.out_hydros_forces = (m_force_sensors.accu_hydros_forces / steps) / ar_num_hydros;    
+        m_node_bvh.Update(&ar_nodes[0].AbsPosition, sizeof(node_t), ar_num_nodes);
+        m_node_bvh_frame = physics_frame;
     }
+    return m_node_bvh;
+}
+
+template<typename T, size_t N>
+static size_t UnusedSlotBytes(const T (&)[N], int num_used)
+{
+    const size_t used = static_cast<size_t>(std::max(0, std::min(num_used, static_cast<int>(N))));
+    return (N - used) * sizeof(T);
+}
+
+template<typename T>
+static size_t VectorBytes(std::vector<T> const& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+RoR::ActorMemoryUsage Actor::ComputeMemoryUsage()
+{
+    RoR::ActorMemoryUsage usage;
+
+    // The actor object itself; fixed-size arrays are reserved whether used or not
+    usage.bytes[RoR::ActorMemoryUsage::ACTOR] = sizeof(Actor);
+    usage.unused_fixed_bytes =
+        UnusedSlotBytes(ar_contacters,        ar_num_contacters) +
+        UnusedSlotBytes(ar_wheels,            ar_num_wheels) +
+        UnusedSlotBytes(ar_wheel_visuals,     ar_num_wheels) +
+        UnusedSlotBytes(ar_props,             ar_num_props) +
+        UnusedSlotBytes(ar_custom_particles,  ar_num_custom_particles) +
+        UnusedSlotBytes(ar_soundsources,      ar_num_soundsources) +
+        UnusedSlotBytes(ar_pressure_beams,    ar_free_pressure_beam) +
+        UnusedSlotBytes(ar_aeroengines,       ar_num_aeroengines) +
+        UnusedSlotBytes(ar_screwprops,        ar_num_screwprops) +
+        UnusedSlotBytes(ar_cabs,              ar_num_cabs * 3) +
+        UnusedSlotBytes(ar_hydro,             ar_num_hydros) +
+        UnusedSlotBytes(ar_collcabs,          ar_num_collcabs) +
+        UnusedSlotBytes(ar_inter_collcabrate, ar_num_collcabs) +
+        UnusedSlotBytes(ar_intra_collcabrate, ar_num_collcabs) +
+        UnusedSlotBytes(ar_buoycabs,          ar_num_buoycabs) +
+        UnusedSlotBytes(ar_buoycab_types,     ar_num_buoycabs) +
+        UnusedSlotBytes(ar_airbrakes,         ar_num_airbrakes) +
+        UnusedSlotBytes(ar_flexbodies,        ar_num_flexbodies) +
+        UnusedSlotBytes(ar_camera_rail,       ar_num_camera_rails) +
+        UnusedSlotBytes(m_axles,              m_num_axles);
+
+    // Physics
+    size_t& physics = usage.bytes[RoR::ActorMemoryUsage::PHYSICS];
+    physics += ar_num_nodes     * sizeof(node_t);
+    physics += ar_num_beams     * sizeof(beam_t);
+    physics += ar_num_shocks    * sizeof(shock_t);
+    physics += ar_num_rotators  * sizeof(rotator_t);
+    physics += ar_num_wings     * sizeof(wing_t);
+    physics += VectorBytes(ar_node_conn_offsets) + VectorBytes(ar_node_conn_nodes) + VectorBytes(ar_node_conn_beams);
+    physics += VectorBytes(ar_collision_bounding_boxes) + VectorBytes(ar_predicted_coll_bounding_boxes);
+    physics += VectorBytes(ar_ropes) + VectorBytes(ar_ropables) + VectorBytes(ar_ties) + VectorBytes(ar_hooks);
+    physics += VectorBytes(m_slidenodes) + VectorBytes(m_node_live_beams) + VectorBytes(m_beam_break_events);
+    physics += m_buoycab_beams.capacity() / 8;
+    for (RailGroup* rail : m_railgroups)
+    {
+        physics += VectorBytes(rail->rg_segments);
+    }
+    physics += m_initial_state.GetMemoryUsage();
+    for (RoR::ActorState const& state : m_saved_states)
+    {
+        physics += state.GetMemoryUsage();
+    }
+    physics += m_node_bvh.GetMemoryUsage();
+    physics += m_memory.GetStats().bytes_reserved;
+
+    // Flexbodies
+    for (int i = 0; i < ar_num_flexbodies; i++)
+    {
+        if (ar_flexbodies[i] != nullptr)
+            usage.bytes[RoR::ActorMemoryUsage::FLEXBODIES] += ar_flexbodies[i]->GetMemoryUsage();
+    }
+
+    // Meshes - shared by several entities (i.e. wheels) or even several actors, count each once
+    std::set<Ogre::Mesh*> meshes;
+    std::vector<Ogre::Entity*> entities(m_deletion_entities);
+    entities.push_back(m_cab_entity);
+    for (int i = 0; i < ar_num_props; i++)
+    {
+        if (ar_props[i].mo != nullptr)
+            entities.push_back(ar_props[i].mo->getEntity());
+        if (ar_props[i].wheelmo != nullptr)
+            entities.push_back(ar_props[i].wheelmo->getEntity());
+    }
+    for (Ogre::Entity* entity : entities)
+    {
+        if (entity != nullptr && meshes.insert(entity->getMesh().get()).second)
+            usage.bytes[RoR::ActorMemoryUsage::MESHES] += entity->getMesh()->getSize();
+    }
+
+    // Scene - approximated by object counts
+    size_t num_scene_nodes = m_deletion_scene_nodes.size() + ar_flares.size() + exhausts.size();
+    for (int i = 0; i < ar_num_beams; i++)
+    {
+        if (ar_beams[i].mSceneNode != nullptr)
+            ++num_scene_nodes;
+    }
+    num_scene_nodes += 2 * ar_num_props + ar_num_wheels + ar_num_wings + ar_num_custom_particles;
+    usage.bytes[RoR::ActorMemoryUsage::SCENE] = num_scene_nodes * sizeof(Ogre::SceneNode)
+        + entities.size() * sizeof(Ogre::Entity) + sizeof(RoR::GfxActor);
+
+#ifdef USE_OPENAL
+    for (int i = 0; i < ar_num_soundsources; i++)
+    {
+        if (ar_soundsources[i].ssi != nullptr)
+            usage.bytes[RoR::ActorMemoryUsage::SOUND] += sizeof(SoundScriptInstance);
+    }
+#endif // USE_OPENAL
+
+    if (m_replay_handler != nullptr)
+        usage.bytes[RoR::ActorMemoryUsage::REPLAY] = sizeof(Replay) + m_replay_handler->getMemoryUsage();
+
+    return usage;
+}
+
+unsigned int Actor::getMemoryUsage()
+{
+    return static_cast<unsigned int>(this->ComputeMemoryUsage().GetTotal());
+}
+
+RoR::ForceFeedbackSample Actor::GetForceFeedbackSample() const
+{
+    // If the camera node is invalid, fall back to node0
+    int cam_pos  = this->IsNodeIdValid(ar_camera_node_pos[0])  ? ar_camera_node_pos[0]  : 0;
+    int cam_dir  = this->IsNodeIdValid(ar_camera_node_dir[0])  ? ar_camera_node_dir[0]  : 0;
+    int cam_roll = this->IsNodeIdValid(ar_camera_node_roll[0]) ? ar_camera_node_roll[0] : 0;
+
+    Vector3 udir  = ar_nodes[cam_pos].RelPosition - ar_nodes[cam_dir].RelPosition;
+    Vector3 uroll = ar_nodes[cam_pos].RelPosition - ar_nodes[cam_roll].RelPosition;
+    udir.normalise();
+    uroll.normalise();
+
+    RoR::ForceFeedbackSample sample;
+    sample.roll         = -m_force_sensors.body_forces.dotProduct(uroll) / 10000.f;
+    sample.pitch        =  m_force_sensors.body_forces.dotProduct(udir)  / 10000.f;
+    sample.wheel_speed  = ar_wheel_speed;
+    sample.dir_command  = ar_hydro_dir_command;
+    sample.hydro_stress = (ar_num_hydros != 0) ? (m_force_sensors.hydros_forces / ar_num_hydros) : 0.f;
+    return sample;
 }
 
 void Actor::UpdateAngelScriptEvents(float dt)
@@ -2574,7 +2775,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                         {
                             if (m_trigger_debug_enabled && !ar_beams[scount].shock->trigger_enabled && ar_beams[i].shock->last_debug_state != 1)
                             {
-                                LOG(" Trigger disabled. Blocker BeamID " + TOSTRING(i) + " enabled trigger " + TOSTRING(scount));
+                                RoR::LogAsync(LogCategory::TRIGGER, " Trigger disabled. Blocker BeamID %d enabled trigger %d", i, scount);
                                 ar_beams[i].shock->last_debug_state = 1;
                             }
                             ar_beams[scount].shock->trigger_enabled = false; // disable the trigger
@@ -2589,7 +2790,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                         {
                             if (m_trigger_debug_enabled && ar_beams[scount].shock->trigger_enabled && ar_beams[i].shock->last_debug_state != 9)
                             {
-                                LOG(" Trigger enabled. Inverted Blocker BeamID " + TOSTRING(i) + " disabled trigger " + TOSTRING(scount));
+                                RoR::LogAsync(LogCategory::TRIGGER, " Trigger enabled. Inverted Blocker BeamID %d disabled trigger %d", i, scount);
                                 ar_beams[i].shock->last_debug_state = 9;
                             }
                             ar_beams[scount].shock->trigger_enabled = true; // enable the triggers
@@ -2601,7 +2802,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                     ar_command_key[ar_beams[i].shock->trigger_cmdshort].trigger_cmdkeyblock_state = false; // Release the cmdKey
                     if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 2)
                     {
-                        LOG(" F-key trigger block released. Blocker BeamID " + TOSTRING(i) + " Released F" + TOSTRING(ar_beams[i].shock->trigger_cmdshort));
+                        RoR::LogAsync(LogCategory::TRIGGER, " F-key trigger block released. Blocker BeamID %d Released F%d", i, ar_beams[i].shock->trigger_cmdshort);
                         ar_beams[i].shock->last_debug_state = 2;
                     }
                 }
@@ -2624,7 +2825,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                                 ar_beams[i].shock->trigger_switch_state = ar_beams[i].shock->trigger_boundary_t; //prevent trigger switching again before leaving boundaries or timeout
                                 if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 3)
                                 {
-                                    LOG(" Trigger F-key commands switched. Switch BeamID " + TOSTRING(i)+ " switched commands of Trigger BeamID " + TOSTRING(ar_beams[ar_shocks[scount].beamid].shock->beamid) + " to cmdShort: F" + TOSTRING(ar_beams[ar_shocks[scount].beamid].shock->trigger_cmdshort) + ", cmdlong: F" + TOSTRING(ar_beams[ar_shocks[scount].beamid].shock->trigger_cmdlong));
+                                    RoR::LogAsync(LogCategory::TRIGGER, " Trigger F-key commands switched. Switch BeamID %d switched commands of Trigger BeamID %d to cmdShort: F%d, cmdlong: F%d", i, ar_beams[ar_shocks[scount].beamid].shock->beamid, ar_beams[ar_shocks[scount].beamid].shock->trigger_cmdshort, ar_beams[ar_shocks[scount].beamid].shock->trigger_cmdlong);
                                     ar_beams[i].shock->last_debug_state = 3;
                                 }
                             }
@@ -2666,7 +2867,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                                     ar_command_key[ar_beams[i].shock->trigger_cmdlong].triggerInputValue = 1;
                                 if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 4)
                                 {
-                                    LOG(" Trigger Longbound activated. Trigger BeamID " + TOSTRING(i) + " Triggered F" + TOSTRING(ar_beams[i].shock->trigger_cmdlong));
+                                    RoR::LogAsync(LogCategory::TRIGGER, " Trigger Longbound activated. Trigger BeamID %d Triggered F%d", i, ar_beams[i].shock->trigger_cmdlong);
                                     ar_beams[i].shock->last_debug_state = 4;
                                 }
                             }
@@ -2708,7 +2909,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
 
                                 if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 5)
                                 {
-                                    LOG(" Trigger Shortbound activated. Trigger BeamID " + TOSTRING(i) + " Triggered F" + TOSTRING(ar_beams[i].shock->trigger_cmdshort));
+                                    RoR::LogAsync(LogCategory::TRIGGER, " Trigger Shortbound activated. Trigger BeamID %d Triggered F%d", i, ar_beams[i].shock->trigger_cmdshort);
                                     ar_beams[i].shock->last_debug_state = 5;
                                 }
                             }
@@ -2748,7 +2949,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                         {
                             if (m_trigger_debug_enabled && ar_beams[scount].shock->trigger_enabled && ar_beams[i].shock->last_debug_state != 6)
                             {
-                                LOG(" Trigger enabled. Blocker BeamID " + TOSTRING(i) + " disabled trigger " + TOSTRING(scount));
+                                RoR::LogAsync(LogCategory::TRIGGER, " Trigger enabled. Blocker BeamID %d disabled trigger %d", i, scount);
                                 ar_beams[i].shock->last_debug_state = 6;
                             }
                             ar_beams[scount].shock->trigger_enabled = true; // enable the triggers
@@ -2763,7 +2964,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                         {
                             if (m_trigger_debug_enabled && !ar_beams[scount].shock->trigger_enabled && ar_beams[i].shock->last_debug_state != 10)
                             {
-                                LOG(" Trigger disabled. Inverted Blocker BeamID " + TOSTRING(i) + " enabled trigger " + TOSTRING(scount));
+                                RoR::LogAsync(LogCategory::TRIGGER, " Trigger disabled. Inverted Blocker BeamID %d enabled trigger %d", i, scount);
                                 ar_beams[i].shock->last_debug_state = 10;
                             }
                             ar_beams[scount].shock->trigger_enabled = false; // disable the trigger
@@ -2775,7 +2976,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                     ar_beams[i].shock->trigger_switch_state = 0.0f; //trigger_switch reset
                     if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 7)
                     {
-                        LOG(" Trigger switch reset. Switch BeamID " + TOSTRING(i));
+                        RoR::LogAsync(LogCategory::TRIGGER, " Trigger switch reset. Switch BeamID %d", i);
                         ar_beams[i].shock->last_debug_state = 7;
                     }
                 }
@@ -2784,7 +2985,7 @@ void Actor::calcShocks2(int beam_i, Real difftoBeamL, Real& k, Real& d, Real dt,
                     ar_command_key[ar_beams[i].shock->trigger_cmdshort].trigger_cmdkeyblock_state = true; // activate trigger blocking
                     if (m_trigger_debug_enabled && ar_beams[i].shock->last_debug_state != 8)
                     {
-                        LOG(" F-key trigger blocked. Blocker BeamID " + TOSTRING(i) + " Blocked F" + TOSTRING(ar_beams[i].shock->trigger_cmdshort));
+                        RoR::LogAsync(LogCategory::TRIGGER, " F-key trigger blocked. Blocker BeamID %d Blocked F%d", i, ar_beams[i].shock->trigger_cmdshort);
                         ar_beams[i].shock->last_debug_state = 8;
                     }
                 }
@@ -3811,10 +4012,9 @@ void Actor::ShowSkeleton(bool meshes, bool linked)
     if (linked)
     {
         // apply to all locked actors
-        DetermineLinkedActors();
-        for (std::list<Actor*>::iterator it = m_linked_actors.begin(); it != m_linked_actors.end(); ++it)
+        for (Actor* actor : this->GetAllLinkedActors())
         {
-            (*it)->ShowSkeleton(meshes, false);
+            actor->ShowSkeleton(meshes, false);
         }
     }
 
@@ -3882,10 +4082,9 @@ void Actor::HideSkeleton(bool linked)
     if (linked)
     {
         // apply to all locked actors
-        DetermineLinkedActors();
-        for (std::list<Actor*>::iterator it = m_linked_actors.begin(); it != m_linked_actors.end(); ++it)
+        for (Actor* actor : this->GetAllLinkedActors())
         {
-            (*it)->HideSkeleton(false);
+            actor->HideSkeleton(false);
         }
     }
 }
@@ -3895,7 +4094,7 @@ void Actor::fadeMesh(SceneNode* node, float amount)
     for (int a = 0; a < node->numAttachedObjects(); a++)
     {
         Entity* e = (Entity *)node->getAttachedObject(a);
-        MaterialPtr m = e->getSubEntity(0)->getMaterial();
+        MaterialPtr m = m_gfx_actor->MakeMaterialUnique(e->getSubEntity(0));
         if (m.getPointer() == 0)
             continue;
         for (int x = 0; x < m->getNumTechniques(); x++)
@@ -3935,7 +4134,7 @@ void Actor::setAlphaRejection(SceneNode* node, float amount)
     for (int a = 0; a < node->numAttachedObjects(); a++)
     {
         Entity* e = (Entity *)node->getAttachedObject(a);
-        MaterialPtr m = e->getSubEntity(0)->getMaterial();
+        MaterialPtr m = m_gfx_actor->MakeMaterialUnique(e->getSubEntity(0));
         if (m.getPointer() == 0)
             continue;
         for (int x = 0; x < m->getNumTechniques(); x++)
@@ -3956,7 +4155,7 @@ void Actor::setMeshWireframe(SceneNode* node, bool value)
         Entity* e = (Entity *)node->getAttachedObject(a);
         for (int se = 0; se < (int)e->getNumSubEntities(); se++)
         {
-            MaterialPtr m = e->getSubEntity(se)->getMaterial();
+            MaterialPtr m = m_gfx_actor->MakeMaterialUnique(e->getSubEntity(se)); // Shared materials are copied on write
             if (m.getPointer() == 0)
                 continue;
             for (int x = 0; x < m->getNumTechniques(); x++)
@@ -4071,16 +4270,7 @@ void Actor::AddInterActorBeam(beam_t* beam, Actor* a, Actor* b)
         ar_inter_beams.push_back(beam);
     }
 
-    std::pair<Actor*, Actor*> actor_pair(a, b);
-    App::GetSimController()->GetBeamFactory()->inter_actor_links[beam] = actor_pair;
-
-    a->DetermineLinkedActors();
-    for (auto actor : a->m_linked_actors)
-        actor->DetermineLinkedActors();
-
-    b->DetermineLinkedActors();
-    for (auto actor : b->m_linked_actors)
-        actor->DetermineLinkedActors();
+    App::GetSimController()->GetBeamFactory()->AddInterActorLink(beam, a, b);
 }
 
 void Actor::RemoveInterActorBeam(beam_t* beam)
@@ -4091,20 +4281,7 @@ void Actor::RemoveInterActorBeam(beam_t* beam)
         ar_inter_beams.erase(pos);
     }
 
-    auto it = App::GetSimController()->GetBeamFactory()->inter_actor_links.find(beam);
-    if (it != App::GetSimController()->GetBeamFactory()->inter_actor_links.end())
-    {
-        auto actor_pair = it->second;
-        App::GetSimController()->GetBeamFactory()->inter_actor_links.erase(it);
-
-        actor_pair.first->DetermineLinkedActors();
-        for (auto actor : actor_pair.first->m_linked_actors)
-            actor->DetermineLinkedActors();
-
-        actor_pair.second->DetermineLinkedActors();
-        for (auto actor : actor_pair.second->m_linked_actors)
-            actor->DetermineLinkedActors();
-    }
+    App::GetSimController()->GetBeamFactory()->RemoveInterActorLink(beam);
 }
 
 void Actor::DisjoinInterActorBeams()
@@ -4118,21 +4295,17 @@ void Actor::DisjoinInterActorBeams()
         {
             it->first->bm_inter_actor = false;
             it->first->bm_disabled = true;
+            actor_pair.first->m_node_live_beams_dirty = true;
+            actor_pair.second->m_node_live_beams_dirty = true;
             inter_actor_links->erase(it++);
-
-            actor_pair.first->DetermineLinkedActors();
-            for (auto actor : actor_pair.first->m_linked_actors)
-                actor->DetermineLinkedActors();
-
-            actor_pair.second->DetermineLinkedActors();
-            for (auto actor : actor_pair.second->m_linked_actors)
-                actor->DetermineLinkedActors();
         }
         else
         {
             ++it;
         }
     }
+    // All actors which lost a link were in our group
+    App::GetSimController()->GetBeamFactory()->RebuildLinkGroup(this);
 }
 
 void Actor::ToggleTies(int group)
@@ -4486,6 +4659,7 @@ void Actor::ToggleHooks(int group, hook_states mode, int node_number)
             it->hk_beam->bm_inter_actor = false;
             it->hk_beam->L = (ar_nodes[0].AbsPosition - it->hk_hook_node->AbsPosition).length();
             it->hk_beam->bm_disabled = true;
+            m_node_live_beams_dirty = true;
         }
 
         // update skeletonview on the (un)hooked actor
@@ -4923,13 +5097,20 @@ void Actor::NotifyActorCameraChanged()
 //Returns the number of active (non bounded) beams connected to a node
 int Actor::GetNumActiveConnectedBeams(int nodeid)
 {
-    int totallivebeams = 0;
-    for (unsigned int ni = 0; ni < ar_node_to_beam_connections[nodeid].size(); ++ni)
+    // Counters are kept up to date by `calcBeams()`; anything else which toggles beams marks them dirty
+    if (m_node_live_beams_dirty.exchange(false)) // Clear first, so a mark made during the recount isn't lost
     {
-        if (!ar_beams[ar_node_to_beam_connections[nodeid][ni]].bm_disabled && !ar_beams[ar_node_to_beam_connections[nodeid][ni]].bounded)
-            totallivebeams++;
+        m_node_live_beams.assign(ar_num_nodes, 0);
+        for (int n = 0; n < ar_num_nodes; ++n)
+        {
+            for (int c = ar_node_conn_offsets[n]; c < ar_node_conn_offsets[n + 1]; ++c)
+            {
+                if (!ar_beams[ar_node_conn_beams[c]].bm_disabled && !ar_beams[ar_node_conn_beams[c]].bounded)
+                    m_node_live_beams[n]++;
+            }
+        }
     }
-    return totallivebeams;
+    return m_node_live_beams[nodeid];
 }
 
 bool Actor::isTied()
@@ -5517,6 +5698,7 @@ Actor::Actor(
     , ar_hydro_rudder_command(0)
     , ar_hydro_rudder_state(0)
     , m_increased_accuracy(false)
+    , m_node_live_beams_dirty(true)
     , m_inter_point_col_detector(nullptr)
     , m_intra_point_col_detector(nullptr)
     , ar_net_last_update_time(0)
@@ -5539,6 +5721,10 @@ Actor::Actor(
     , m_min_camera_radius(-1.0f)
     , m_mouse_grab_move_force(0.0f)
     , m_mouse_grab_node(-1)
+    , m_link_parent(this)
+    , m_link_members(1, this)
+    , m_num_linked_actors(0)
+    , m_node_bvh_frame(std::numeric_limits<unsigned long>::max())
     , m_mouse_grab_pos(Ogre::Vector3::ZERO)
     , m_net_brake_light(false)
     , m_net_label_node(0)
@@ -5546,7 +5732,7 @@ Actor::Actor(
     , m_net_reverse_light(false)
     , m_replay_pos_prev(-1)
     , ar_parking_brake(0)
-    , m_position_storage(0)
+    , m_saved_states(RoR::ActorState::MAX_SLOTS)
     , m_avg_node_position(pos)
     , m_previous_gear(0)
     , m_ref_tyre_pressure(50.0)
@@ -21,15 +21,21 @@
 
 #pragma once
 
+#include "ActorMemoryUsage.h"
+#include "ActorState.h"
 #include "Application.h"
 #include "BeamData.h"
+#include "Drivetrain.h"
 #include "GfxActor.h"
+#include "MemoryArena.h"
 #include "PerVehicleCameraContext.h"
+#include "RayCast.h"
 #include "RigDef_Prerequisites.h"
 #include "RoRPrerequisites.h"
 
 #include <OgrePrerequisites.h>
 #include <OgreTimer.h>
+#include <atomic>
 #include <memory>
 
 class Task;
@@ -95,7 +101,6 @@ public:
     void              displace(Ogre::Vector3 translation, float rotation);
     Ogre::Vector3     GetRotationCenter();                 //!< Return the rotation center of the actor
     bool              ReplayStep();
-    void              ForceFeedbackStep(int steps);
     void              UpdateAngelScriptEvents(float dt);
     void              HandleResetRequests(float dt);
     void              UpdateSoundSources();
@@ -115,8 +120,11 @@ public:
     void              ToggleBeacons();                     //!< Event handler
     void              forwardCommands();
     void              setReplayMode(bool rm);              //!< Event handler; toggle replay mode.
-    int               savePosition(int position);
-    int               loadPosition(int position);
+    int               SaveState(int slot);                 //!< Snapshots nodes + beams into a slot; @return 0 on success, -3 if the slot is invalid
+    int               RestoreState(int slot);              //!< Puts the actor at rest in the slot's pose; @return 0 on success, -2 if the slot is empty, -3 if the slot is invalid
+    bool              SaveStateToFile(int slot, std::string const& filename);   //!< Writes a slot to the user's 'savegames' directory; filename without path
+    bool              LoadStateFromFile(int slot, std::string const& filename); //!< Fills a slot from the user's 'savegames' directory; use `RestoreState()` to apply it
+    void              CaptureInitialState();               //!< Re-records the reset state; call after `node_t::initial_pos` or beam reference lengths change
     /// Virtually moves the actor at most 'direction.length()' meters towards 'direction' trying to resolve any collisions
     /// Returns a minimal offset by which the actor needs to be moved to resolve any collisions
     Ogre::Vector3     calculateCollisionOffset(Ogre::Vector3 direction);
@@ -199,8 +207,16 @@ public:
     std::vector<authorinfo_t>     getAuthors();
     std::vector<std::string>      getDescription();
     RoR::PerVehicleCameraContext* GetCameraContext()    { return &m_camera_context; }
-    std::list<Actor*> GetAllLinkedActors()              { return m_linked_actors; }; //!< Returns a list of all connected (hooked) actors
-    Ogre::Vector3     GetFFbBodyForces() const          { return m_force_sensors.out_body_forces; }
+    std::vector<Actor*> GetAllLinkedActors();           //!< Returns all actors connected (hooked, tied...) directly or indirectly
+    int               GetNumLinkedActors() const        { return m_num_linked_actors; } //!< Size of `GetAllLinkedActors()`; cached, safe to poll from the main thread
+    int               GetNumNodeConnections(int node) const { return ar_node_conn_offsets[node + 1] - ar_node_conn_offsets[node]; }
+    const int*        GetConnectedNodes(int node) const     { return ar_node_conn_nodes.data() + ar_node_conn_offsets[node]; } //!< `GetNumNodeConnections()` entries
+    const int*        GetConnectedBeams(int node) const     { return ar_node_conn_beams.data() + ar_node_conn_offsets[node]; } //!< `GetNumNodeConnections()` entries
+    RoR::NodeBvh const& GetNodeBvh(unsigned long physics_frame); //!< For ray casts; refreshed lazily, at most once per physics frame
+    RoR::ActorMemoryUsage ComputeMemoryUsage();         //!< Estimate of CPU-side memory by subsystem; walks all parts, don't call per frame
+    unsigned int      getMemoryUsage();                 //!< Total bytes of `ComputeMemoryUsage()`; for scripting
+    RoR::Drivetrain const& GetDrivetrain() const        { return m_drivetrain; }
+    RoR::MemoryArena const& GetMemoryArena() const     { return m_memory; }
     PointColDetector* IntraPointCD()                    { return m_intra_point_col_detector; }
     PointColDetector* InterPointCD()                    { return m_inter_point_col_detector; }
     Ogre::SceneNode*  getSceneNode()                    { return m_beam_visuals_parent_scenenode; }
@@ -209,7 +225,7 @@ public:
     Ogre::Vector3     getNodePosition(int nodeNumber);     //!< Returns world position of node
     Ogre::Real        getMinimalCameraRadius();
     Replay*           getReplay();
-    float             GetFFbHydroForces() const         { return m_force_sensors.out_hydros_forces; }
+    RoR::ForceFeedbackSample GetForceFeedbackSample() const; //!< Sensor data of the last physics step
     bool              isPreloadedWithTerrain() const    { return m_preloaded_with_terrain; };
     VehicleAI*        getVehicleAI()                    { return ar_vehicle_ai; }
     bool              IsNodeIdValid(int id) const       { return (id > 0) && (id < ar_num_nodes); }
@@ -246,8 +262,9 @@ public:
     std::vector<flare_t>      ar_flares;
     Ogre::AxisAlignedBox      ar_bounding_box;     //!< standard bounding box (surrounds all nodes of an actor)
     Ogre::AxisAlignedBox      ar_predicted_bounding_box;
-    std::vector<std::vector<int>>  ar_node_to_node_connections;
-    std::vector<std::vector<int>>  ar_node_to_beam_connections;
+    std::vector<int>          ar_node_conn_offsets; //!< Node connectivity (CSR); connections of node N are [offsets[N], offsets[N+1]); filled at spawn
+    std::vector<int>          ar_node_conn_nodes;   //!< Node connectivity (CSR); neighbour node per connection
+    std::vector<int>          ar_node_conn_beams;   //!< Node connectivity (CSR); beam per connection
     std::vector<Ogre::AxisAlignedBox>  ar_collision_bounding_boxes; //!< smart bounding boxes, used for determining the state of an actor (every box surrounds only a subset of nodes)
     std::vector<Ogre::AxisAlignedBox>  ar_predicted_coll_bounding_boxes;
     contacter_t       ar_contacters[MAX_CONTACTERS];
@@ -293,7 +310,6 @@ public:
     float             alb_minspeed;       //!< Anti-lock brake attribute;
     int               alb_mode;           //!< Anti-lock brake status; Enabled? {1/0}
     float             alb_pulse_time;     //!< Anti-lock brake attribute;
-    bool              alb_pulse_state;    //!< Anti-lock brake status;
     bool              alb_present;        //!< Anti-lock brake attribute: Display the dashboard indicator?
     bool              alb_notoggle;       //!< Anti-lock brake attribute: Disable in-game toggle?
     float             tc_ratio;           //!< Traction control
@@ -301,11 +317,8 @@ public:
     float             tc_fade;            //!< Traction control
     int               tc_mode;            //!< Traction control status; Enabled? {1/0}
     float             tc_pulse_time;      //!< Traction control attribute;
-    bool              tc_pulse_state;     //!< Traction control
     bool              tc_present;         //!< Traction control attribute; Display the dashboard indicator?
     bool              tc_notoggle;        //!< Traction control attribute; Disable in-game toggle?
-    float             tc_timer;           //!< Traction control
-    float             alb_timer;
     float             ar_anim_shift_timer;//!< For 'animator' with flag 'shifter'
     bool              cc_mode;            //!< Cruise Control
     bool              cc_can_brake;       //!< Cruise Control
@@ -420,9 +433,12 @@ private:
     void              calcAnimators(const int flag_state, float &cstate, int &div, float timer, const float lower_limit, const float upper_limit, const float option3);
     void              SyncReset();                         //!< this one should be called only synchronously (without physics running in background)
     void              SetPropsCastShadows(bool do_cast_shadows);
-    void              DetermineLinkedActors();
     void              RecalculateNodeMasses(Ogre::Real total, bool reCalc=false); //!< Previously 'calc_masses2()'
     void              calcNodeConnectivityGraph();
+    void              InitStructuralDamage();              //!< Precomputes detacher groups, buoyant cab edges and live-beam counters; call after `calcNodeConnectivityGraph()`
+    void              ProcessBeamBreakEvents();            //!< Applies consequences of beams which broke during `calcBeams()`
+    void              ApplyState(RoR::ActorState const& state, bool with_velocity); //!< Restores a snapshot; hook/tie beams keep their current lock state
+    void              ResetHooksRopesTies();               //!< Unlocks everything; inter-actor beams must be disjoined first
     void              moveOrigin(Ogre::Vector3 offset);    //!< move physics origin
     void              AddInterActorBeam(beam_t* beam, Actor* a, Actor* b);
     void              RemoveInterActorBeam(beam_t* beam);
@@ -440,10 +456,7 @@ private:
     void              resetSlideNodePositions();           //!< Recalculate SlideNode positions
     void              resetSlideNodes();                   //!< Reset all the SlideNodes
     void              updateSlideNodePositions();          //!< incrementally update the position of all SlideNodes
-    /// @param actor which actor to retrieve the closest Rail from
-    /// @param node which SlideNode is being checked against
-    /// @return a pair containing the rail, and the distant to the SlideNode
-    std::pair<RailGroup*, Ogre::Real> GetClosestRailOnActor( Actor* actor, const SlideNode& node);
+    void              SyncDrivetrainDiffs();               //!< Pushes axle differential modes to `m_drivetrain`
 
     // -------------------- data -------------------- //
 
@@ -467,7 +480,10 @@ private:
     float             m_avionic_chatter_timer;      //!< Sound fx state
     PointColDetector* m_inter_point_col_detector;   //!< Physics
     PointColDetector* m_intra_point_col_detector;   //!< Physics
-    std::list<Actor*>  m_linked_actors;              //!< Sim state; other actors linked using 'hooks'
+    Actor*            m_link_parent;                //!< Sim state; union-find of actors linked by inter-actor beams, see `ActorManager::FindLinkRoot()`
+    std::vector<Actor*> m_link_members;             //!< Sim state; all actors in the linked group; only valid on the group root
+    std::atomic<int>  m_num_linked_actors;          //!< Sim state; other actors in the linked group, updated by `ActorManager` on link changes
+    std::atomic<bool> m_node_live_beams_dirty;      //!< Physics state; beams were enabled/disabled outside `calcBeams()`, recount. Not in the bitfield below: set from the main thread and physics tasks
     Ogre::Vector3     m_avg_node_position;          //!< average node position
     Ogre::Real        m_min_camera_radius;
     Ogre::Vector3     m_avg_node_position_prev;
@@ -477,12 +493,15 @@ private:
     blinktype         m_blink_type;                 //!< Sim state; Blinker = turn signal
     float             m_stabilizer_shock_sleep;     //!< Sim state
     Replay*           m_replay_handler;
-    PositionStorage*  m_position_storage;
+    RoR::ActorState   m_initial_state;         //!< Physics attr; pristine state restored by `SyncReset()`, see `CaptureInitialState()`
+    std::vector<RoR::ActorState> m_saved_states; //!< Sim state; save/restore slots
     int               m_gfx_detail_level;      //!< Gfx state
     float             m_total_mass;            //!< Physics state; total mass in Kg
     int               m_mouse_grab_node;       //!< Sim state; node currently being dragged by user
     Ogre::Vector3     m_mouse_grab_pos;
     float             m_mouse_grab_move_force;
+    RoR::NodeBvh      m_node_bvh;
+    unsigned long     m_node_bvh_frame;        //!< Physics frame `m_node_bvh` was refreshed in
     float             m_spawn_rotation;
     ResetRequest      m_reset_request;
     RoRnet::VehicleState* oob1;                  //!< Network; Triple buffer for incoming data (actor properties)
@@ -520,6 +539,11 @@ private:
     int               m_net_node_buf_size;     //!< Network attr; buffer size
     int               m_net_buffer_size;       //!< Network attr; buffer size
     int               m_wheel_node_count;      //!< Static attr; filled at spawn
+    std::vector<int>  m_beam_break_events;     //!< Physics state; beams which exceeded their strength during current `calcBeams()` pass
+    std::map<int, std::vector<int>> m_detacher_group_beams;  //!< Physics attr; detacher group -> master and minor beams
+    std::map<int, std::vector<int>> m_detacher_group_wheels; //!< Physics attr; detacher group -> wheels
+    std::vector<bool> m_buoycab_beams;         //!< Physics attr; beam is an edge of a buoyant (not drag-only) cab
+    std::vector<int>  m_node_live_beams;       //!< Physics state; see `GetNumActiveConnectedBeams()`
     int               m_replay_pos_prev;       //!< Sim state
     int               m_previous_gear;         //!< Sim state; land vehicle shifting
     CmdKeyInertia*    m_rotator_inertia;       //!< Physics
@@ -534,6 +558,8 @@ private:
     float             m_odometer_user;         //!< GUI state
     Axle*             m_axles[MAX_WHEELS/2];   //!< Physics
     int               m_num_axles;             //!< Physics attr
+    RoR::Drivetrain   m_drivetrain;            //!< Physics; built from wheels and axles at spawn
+    RoR::MemoryArena  m_memory;                //!< Owns physics sub-objects created by `ActorSpawner` (aeroengines, axles, rails...)
     int               m_num_command_beams;     //!< TODO: Remove! Spawner context only; likely unused feature
     float             m_minimass;              //!< Physics attr; minimum node mass in Kg
     float             m_load_mass;             //!< Physics attr; predefined load mass in Kg
@@ -579,15 +605,11 @@ private:
     {
         inline void Reset()
         {
-            accu_body_forces    = 0;
-            accu_hydros_forces  = 0;
-            out_body_forces     = 0;
-            out_hydros_forces   = 0;
+            body_forces    = 0;
+            hydros_forces  = 0;
         };
 
-        Ogre::Vector3 accu_body_forces;
-        float         accu_hydros_forces;
-        Ogre::Vector3 out_body_forces;
-        float         out_hydros_forces;
-    } m_force_sensors; //!< Data for ForceFeedback devices
+        Ogre::Vector3 body_forces;   //!< Forces at the camera node in the last physics step
+        float         hydros_forces; //!< Summed stress of steering hydros in the last physics step
+    } m_force_sensors; //!< Data for ForceFeedback devices; sampled every physics step, see `ActorManager::UpdatePhysicsSimulation()`
 };
@@ -32,6 +32,7 @@
 #include "ChatSystem.h"
 #include "Collisions.h"
 #include "DynamicCollisions.h"
+#include "ForceFeedback.h"
 #include "GUIManager.h"
 #include "GUI_GameConsole.h"
 #include "GUI_TopMenubar.h"
@@ -40,7 +41,7 @@
 #include "MovableText.h"
 #include "Network.h"
 #include "PointColDetector.h"
-#include "PositionStorage.h"
+#include "RayCast.h"
 #include "Replay.h"
 #include "RigDef_Parser.h"
 #include "RigDef_Validator.h"
@@ -50,6 +51,8 @@
 #include "Scripting.h"
 #include "Settings.h"
 #include "SoundScriptManager.h"
+#include "TerrainManager.h"
+#include "TerrainObjectManager.h"
 #include "ThreadPool.h"
 #include "Utils.h"
 #include "VehicleAI.h"
@@ -67,6 +70,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
   #include <intrin.h>
@@ -154,9 +158,13 @@ using namespace RoR;
 ActorManager::ActorManager()
     : m_dt_remainder(0.0f)
     , m_forced_awake(false)
+    , m_force_feedback(nullptr)
+    , m_force_feedback_actor(nullptr)
+    , m_perf_harness(nullptr)
     , m_free_actor_slot(0)
     , m_num_cpu_cores(0)
     , m_physics_frames(0)
+    , m_rail_bvh_frame(0)
     , m_physics_steps(2000)
     , m_simulation_speed(1.0f)
     , m_actors() // Array
@@ -191,19 +199,27 @@ ActorManager::ActorManager()
         }
         else if (!disableThreadPool)
         {
-            gEnv->threadPool = new ThreadPool(m_num_cpu_cores);
-            LOG("BEAMFACTORY: Creating " + TOSTRING(m_num_cpu_cores) + " threads");
+            const ThreadPlacement placement = ThreadPlacement::FromConfig(
+                App::app_worker_cpus.GetActive(), App::app_worker_nice.GetActive(), "Worker pool");
+            gEnv->threadPool = new ThreadPool(m_num_cpu_cores, "ror-worker", placement);
+            LOG("BEAMFACTORY: Creating " + TOSTRING(m_num_cpu_cores) + " threads, CPUs: " +
+                ThreadPlacement::FormatCpuList(placement.cpus) + ", priority: " + TOSTRING(placement.nice));
         }
 
         // Create worker thread (used for physics calculations)
-        m_sim_thread_pool = std::unique_ptr<ThreadPool>(new ThreadPool(1));
+        const ThreadPlacement sim_placement = ThreadPlacement::FromConfig(
+            App::app_sim_thread_cpus.GetActive(), App::app_sim_thread_nice.GetActive(), "Sim thread");
+        m_sim_thread_pool = std::unique_ptr<ThreadPool>(new ThreadPool(1, "ror-sim", sim_placement));
     }
+
+    m_telemetry = TelemetryStream::CreateFromConfig();
 }
 
 ActorManager::~ActorManager()
 {
     this->SyncWithSimThread(); // Wait for sim task to finish
     delete gEnv->threadPool;
+    gEnv->threadPool = nullptr; // The next session creates its own, with the placement settings of that time
     m_particle_manager.DustManDiscard(gEnv->sceneManager); // TODO: de-globalize SceneManager
 }
 
@@ -246,6 +262,7 @@ void ActorManager::SetupActor(
             spawner.AddModule(*itor);
         }
     }
+    spawner.SetActorTemplate(this->FetchActorTemplate(actor));
     spawner.SpawnActor();
     def->report_num_errors += spawner.GetMessagesNumErrors();
     def->report_num_warnings += spawner.GetMessagesNumWarnings();
@@ -329,6 +346,8 @@ void ActorManager::SetupActor(
 
     //compute node connectivity graph
     actor->calcNodeConnectivityGraph();
+    actor->InitStructuralDamage();
+    actor->CaptureInitialState();
 
     ActorSpawner::RecalculateBoundingBoxes(actor);
 
@@ -425,12 +444,6 @@ void ActorManager::SetupActor(
             actor->ar_replay_precision = 1.0f / ((float)steps);
     }
 
-    // add storage
-    if (App::sim_position_storage.GetActive())
-    {
-        actor->m_position_storage = new PositionStorage(actor->ar_num_nodes, 10);
-    }
-
     // calculate the number of wheel nodes
     actor->m_wheel_node_count = 0;
     for (int i = 0; i < actor->ar_num_nodes; i++)
@@ -522,6 +535,22 @@ void ActorManager::SetupActor(
         }
     }
 
+    const ActorMemoryUsage mem_usage = actor->ComputeMemoryUsage();
+    LOG(" == Memory usage: " + mem_usage.ToString());
+    const size_t mem_warn_mib = static_cast<size_t>(std::max(0, App::diag_actor_mem_warn.GetActive()));
+    if (mem_warn_mib > 0 && mem_usage.GetTotal() > mem_warn_mib * 1024 * 1024)
+    {
+        RoR::Str<200> msg;
+        msg << "Actor '" << actor->ar_design_name << "' uses " << mem_usage.GetTotal() / (1024 * 1024)
+            << " MiB of memory, limit is " << mem_warn_mib << " MiB";
+        RoR::LogFormat("[RoR] WARNING: %s", msg.ToCStr());
+        if (RoR::App::GetConsole())
+        {
+            RoR::App::GetConsole()->putMessage(
+                Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, msg.ToCStr(), "error.png");
+        }
+    }
+
     LOG(" ===== DONE LOADING VEHICLE");
 }
 
@@ -1102,6 +1131,97 @@ void ActorManager::RemoveActorInternal(int actor_id)
     this->DeleteActorInternal(m_actors[actor_id]);
 }
 
+bool ActorManager::CastRay(RayCastQuery const& query, RayCastResult& result)
+{
+    result = RayCastResult();
+    float max_dist = query.max_distance;
+
+    if ((query.flags & RAYCAST_STATIC) && gEnv->collisions)
+    {
+        if (gEnv->collisions->castRay(query.ray, max_dist, query.flags & RAYCAST_STATIC, result))
+            max_dist = result.distance;
+    }
+
+    if (query.flags & RAYCAST_ACTORS)
+    {
+        const Vector3 pad(query.node_radius);
+        for (int t = 0; t < m_free_actor_slot; t++)
+        {
+            Actor* actor = m_actors[t];
+            if (!actor || actor == query.ignore_actor || (query.only_actor && actor != query.only_actor))
+                continue;
+            if (query.local_actors_only && actor->ar_sim_state != Actor::SimState::LOCAL_SIMULATED)
+                continue;
+
+            AxisAlignedBox aabb(actor->ar_bounding_box.getMinimum() - pad, actor->ar_bounding_box.getMaximum() + pad);
+            std::pair<bool, Real> aabb_hit = query.ray.intersects(aabb);
+            if (!aabb_hit.first || aabb_hit.second > max_dist)
+                continue;
+
+            std::function<bool(int)> accept;
+            if (query.grabbable_nodes_only)
+                accept = [actor](int n) { return !actor->ar_nodes[n].no_mouse_grab; };
+
+            float dist = 0;
+            int node = actor->GetNodeBvh(m_physics_frames).CastRay(query.ray, max_dist, query.node_radius, dist, accept);
+            if (node != -1)
+            {
+                max_dist = dist;
+                result.type = RayCastResult::HIT_NODE;
+                result.distance = dist;
+                result.position = query.ray.getPoint(dist);
+                result.normal = (result.position - actor->ar_nodes[node].AbsPosition).normalisedCopy();
+                result.actor = actor;
+                result.node = node;
+                result.ground_model = nullptr;
+            }
+        }
+    }
+
+    return result.IsHit();
+}
+
+RailBvh const& ActorManager::GetRailBvh()
+{
+    // Slots are not reused, so the list of instance IDs identifies the indexed rails
+    std::vector<int> actors;
+    for (int t = 0; t < m_free_actor_slot; t++)
+    {
+        if (m_actors[t] && !m_actors[t]->m_railgroups.empty())
+            actors.push_back(m_actors[t]->ar_instance_id);
+    }
+
+    if (actors != m_rail_bvh_actors)
+    {
+        std::vector<RailBvh::Entry> entries;
+        for (int id : actors)
+        {
+            for (RailGroup* group : m_actors[id]->m_railgroups)
+            {
+                if (group == nullptr)
+                    continue;
+                for (RailSegment& segment : group->rg_segments)
+                {
+                    RailBvh::Entry entry;
+                    entry.segment = &segment;
+                    entry.group = group;
+                    entry.actor = m_actors[id];
+                    entries.push_back(entry);
+                }
+            }
+        }
+        m_rail_bvh.Build(entries);
+        m_rail_bvh_actors = actors;
+        m_rail_bvh_frame = m_physics_frames;
+    }
+    else if (m_rail_bvh_frame != m_physics_frames)
+    {
+        m_rail_bvh.Update();
+        m_rail_bvh_frame = m_physics_frames;
+    }
+    return m_rail_bvh;
+}
+
 void ActorManager::CleanUpAllActors() // Called after simulation finishes
 {
     for (int i = 0; i < m_free_actor_slot; i++)
@@ -1114,6 +1234,329 @@ void ActorManager::CleanUpAllActors() // Called after simulation finishes
     }
 }
 
+void ActorManager::AddInterActorLink(beam_t* beam, Actor* a, Actor* b)
+{
+    auto found = inter_actor_links.find(beam);
+    if (found != inter_actor_links.end())
+    {
+        if (found->second == std::make_pair(a, b))
+            return;
+        this->RemoveInterActorLink(beam); // Re-linked elsewhere
+    }
+    inter_actor_links[beam] = std::make_pair(a, b);
+    this->UniteLinkGroups(a, b);
+
+    Actor* root = this->FindLinkRoot(a);
+    for (Actor* member : root->m_link_members)
+        member->m_num_linked_actors = static_cast<int>(root->m_link_members.size()) - 1;
+}
+
+void ActorManager::RemoveInterActorLink(beam_t* beam)
+{
+    auto found = inter_actor_links.find(beam);
+    if (found == inter_actor_links.end())
+        return;
+
+    Actor* actor = found->second.first;
+    inter_actor_links.erase(found);
+    this->RebuildLinkGroup(actor);
+}
+
+void ActorManager::RebuildLinkGroup(Actor* actor)
+{
+    // Union-find can't split, so dissolve the group and re-unite it from the remaining links.
+    // Links of other groups only unite actors already sharing a root; those are no-ops.
+    // This walks all inter-actor links, O(L) per removal; L is the number of hooks/ties/ropes
+    // currently engaged (tens at most), and removals only happen on user action or actor deletion.
+    Actor* root = this->FindLinkRoot(actor);
+    std::vector<Actor*> members;
+    members.swap(root->m_link_members);
+    for (Actor* member : members)
+    {
+        member->m_link_parent = member;
+        member->m_link_members.assign(1, member);
+    }
+    for (auto& link : inter_actor_links)
+    {
+        this->UniteLinkGroups(link.second.first, link.second.second);
+    }
+    for (Actor* member : members)
+        member->m_num_linked_actors = static_cast<int>(this->FindLinkRoot(member)->m_link_members.size()) - 1;
+}
+
+Actor* ActorManager::FindLinkRoot(Actor* actor)
+{
+    while (actor->m_link_parent != actor)
+    {
+        actor->m_link_parent = actor->m_link_parent->m_link_parent; // Path halving
+        actor = actor->m_link_parent;
+    }
+    return actor;
+}
+
+Actor* ActorManager::GetLinkRoot(Actor const* actor) const
+{
+    while (actor->m_link_parent != actor)
+    {
+        actor = actor->m_link_parent;
+    }
+    return const_cast<Actor*>(actor);
+}
+
+void ActorManager::UniteLinkGroups(Actor* a, Actor* b)
+{
+    Actor* root_a = this->FindLinkRoot(a);
+    Actor* root_b = this->FindLinkRoot(b);
+    if (root_a == root_b)
+        return;
+
+    // Merge smaller into larger
+    if (root_a->m_link_members.size() < root_b->m_link_members.size())
+        std::swap(root_a, root_b);
+    root_b->m_link_parent = root_a;
+    root_a->m_link_members.insert(root_a->m_link_members.end(), root_b->m_link_members.begin(), root_b->m_link_members.end());
+    root_b->m_link_members.clear();
+}
+
+bool ActorManager::SaveSimState(std::string const& filename)
+{
+    std::string path = ActorState::GetSaveFilePath(filename);
+    if (path.empty())
+        return false;
+
+    this->SyncWithSimThread();
+
+    // Only copy data here; encoding and disk I/O run on the writer thread
+    std::unique_ptr<SimSnapshot> snapshot(new SimSnapshot());
+    std::map<Actor*, int> actor_index;
+    std::vector<Actor*> actors;
+    for (int t = 0; t < m_free_actor_slot; t++)
+    {
+        if (m_actors[t] && (m_actors[t]->ar_sim_state == Actor::SimState::LOCAL_SIMULATED || m_actors[t]->ar_sim_state == Actor::SimState::LOCAL_SLEEPING))
+        {
+            actor_index[m_actors[t]] = static_cast<int>(actors.size());
+            actors.push_back(m_actors[t]);
+        }
+    }
+
+    snapshot->actors.resize(actors.size());
+    for (size_t i = 0; i < actors.size(); i++)
+    {
+        Actor* actor = actors[i];
+        SimSnapshot::ActorRecord& rec = snapshot->actors[i];
+        rec.filename = actor->ar_filename;
+        rec.state.Capture(actor->ar_nodes, actor->ar_num_nodes, actor->ar_beams, actor->ar_num_beams);
+
+        rec.has_engine = (actor->ar_engine != nullptr);
+        rec.engine = SimSnapshot::EngineState();
+        if (actor->ar_engine)
+        {
+            rec.engine.rpm          = actor->ar_engine->GetEngineRpm();
+            rec.engine.acc          = actor->ar_engine->GetAcceleration();
+            rec.engine.clutch       = actor->ar_engine->GetClutch();
+            rec.engine.gear         = actor->ar_engine->GetGear();
+            rec.engine.gearbox_mode = static_cast<int32_t>(actor->ar_engine->GetAutoShiftMode());
+            rec.engine.autoselect   = actor->ar_engine->getAutoShift();
+            rec.engine.running      = actor->ar_engine->IsRunning();
+            rec.engine.contact      = actor->ar_engine->HasStarterContact();
+        }
+
+        for (int w = 0; w < actor->ar_num_wheels; w++)
+        {
+            rec.wheel_speeds.push_back(actor->ar_wheels[w].wh_speed);
+        }
+
+        for (size_t h = 0; h < actor->ar_hooks.size(); h++)
+        {
+            hook_t& hook = actor->ar_hooks[h];
+            auto target = actor_index.find(hook.hk_locked_actor);
+            if ((hook.hk_locked == LOCKED || hook.hk_locked == PRELOCK) && hook.hk_lock_node && target != actor_index.end())
+            {
+                rec.hooks.push_back(SimSnapshot::LinkState{ static_cast<int32_t>(h), hook.hk_locked, target->second, hook.hk_lock_node->pos, hook.hk_beam->L });
+            }
+        }
+        for (size_t k = 0; k < actor->ar_ties.size(); k++)
+        {
+            tie_t& tie = actor->ar_ties[k];
+            auto target = actor_index.find(tie.ti_locked_actor);
+            if (tie.ti_tied && tie.ti_locked_ropable && target != actor_index.end())
+            {
+                int32_t ropable = static_cast<int32_t>(tie.ti_locked_ropable - tie.ti_locked_actor->ar_ropables.data());
+                rec.ties.push_back(SimSnapshot::LinkState{ static_cast<int32_t>(k), tie.ti_tying ? 2 : 1, target->second, ropable, tie.ti_beam->L });
+            }
+        }
+        for (size_t r = 0; r < actor->ar_ropes.size(); r++)
+        {
+            rope_t& rope = actor->ar_ropes[r];
+            auto target = actor_index.find(rope.rp_locked_actor);
+            if ((rope.rp_locked == LOCKED || rope.rp_locked == PRELOCK) && rope.rp_locked_ropable && target != actor_index.end())
+            {
+                int32_t ropable = static_cast<int32_t>(rope.rp_locked_ropable - rope.rp_locked_actor->ar_ropables.data());
+                rec.ropes.push_back(SimSnapshot::LinkState{ static_cast<int32_t>(r), rope.rp_locked, target->second, ropable, rope.rp_beam->L });
+            }
+        }
+    }
+
+    if (App::GetSimTerrain() && App::GetSimTerrain()->getObjectManager())
+    {
+        App::GetSimTerrain()->getObjectManager()->GetAnimationTimes(snapshot->terrain_animations);
+    }
+
+    if (!m_snapshot_writer)
+    {
+        m_snapshot_writer = std::unique_ptr<SimSnapshotWriter>(new SimSnapshotWriter());
+    }
+    m_snapshot_writer->Write(std::move(snapshot), path);
+    return true;
+}
+
+bool ActorManager::LoadSimState(std::string const& filename)
+{
+    std::string path = ActorState::GetSaveFilePath(filename);
+    if (m_snapshot_writer)
+    {
+        m_snapshot_writer->Wait(); // The file may still be in progress
+    }
+
+    SimSnapshot snapshot;
+    std::ifstream file(path, std::ios::binary);
+    if (path.empty() || !file.is_open() || !snapshot.Read(file))
+    {
+        LOG("[RoR|SimSnapshot] Failed to read '" + path + "'");
+        return false;
+    }
+
+    this->SyncWithSimThread();
+
+    // Match records to spawned actors with the same truck file and structure, in spawn order
+    std::vector<Actor*> targets(snapshot.actors.size(), nullptr);
+    std::vector<bool> taken(m_free_actor_slot, false);
+    for (size_t i = 0; i < snapshot.actors.size(); i++)
+    {
+        SimSnapshot::ActorRecord const& rec = snapshot.actors[i];
+        for (int t = 0; t < m_free_actor_slot; t++)
+        {
+            Actor* actor = m_actors[t];
+            if (actor && !taken[t] &&
+                (actor->ar_sim_state == Actor::SimState::LOCAL_SIMULATED || actor->ar_sim_state == Actor::SimState::LOCAL_SLEEPING) &&
+                actor->ar_filename == rec.filename &&
+                actor->ar_num_nodes == rec.state.GetNumNodes() && actor->ar_num_beams == rec.state.GetNumBeams())
+            {
+                targets[i] = actor;
+                taken[t] = true;
+                break;
+            }
+        }
+        if (!targets[i])
+        {
+            LOG("[RoR|SimSnapshot] No matching actor spawned for '" + rec.filename + "', skipping");
+        }
+    }
+
+    // Links may point to any actor, so release all of them before restoring
+    for (Actor* actor : targets)
+    {
+        if (actor)
+        {
+            actor->DisjoinInterActorBeams();
+            actor->ResetHooksRopesTies();
+        }
+    }
+
+    int num_restored = 0;
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        Actor* actor = targets[i];
+        if (!actor)
+            continue;
+        SimSnapshot::ActorRecord const& rec = snapshot.actors[i];
+
+        actor->ApplyState(rec.state, true); // Continue the simulation as saved
+        if (actor->ar_engine && rec.has_engine)
+        {
+            actor->ar_engine->PushNetworkState(rec.engine.rpm, rec.engine.acc, rec.engine.clutch, rec.engine.gear, rec.engine.running != 0, rec.engine.contact != 0, -1);
+            actor->ar_engine->SetAutoMode(static_cast<SimGearboxMode>(rec.engine.gearbox_mode));
+            actor->ar_engine->autoShiftSet(rec.engine.autoselect);
+        }
+        for (int w = 0; w < actor->ar_num_wheels && w < static_cast<int>(rec.wheel_speeds.size()); w++)
+        {
+            actor->ar_wheels[w].wh_speed = rec.wheel_speeds[w];
+        }
+        num_restored++;
+    }
+
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        Actor* actor = targets[i];
+        if (!actor)
+            continue;
+        SimSnapshot::ActorRecord const& rec = snapshot.actors[i];
+
+        auto get_target = [&](SimSnapshot::LinkState const& link) -> Actor*
+            {
+                return (link.target_actor >= 0 && link.target_actor < static_cast<int>(targets.size())) ? targets[link.target_actor] : nullptr;
+            };
+
+        // Same as a successful lock attempt, see `Actor::calcHooks()` and `Actor::ToggleTies()`
+        for (SimSnapshot::LinkState const& link : rec.hooks)
+        {
+            Actor* other = get_target(link);
+            if (!other || link.index < 0 || link.index >= static_cast<int>(actor->ar_hooks.size()) || link.target < 0 || link.target >= other->ar_num_nodes)
+                continue;
+            hook_t& hook = actor->ar_hooks[link.index];
+            hook.hk_locked = link.locked;
+            hook.hk_lock_node = &other->ar_nodes[link.target];
+            hook.hk_locked_actor = other;
+            hook.hk_beam->p2 = hook.hk_lock_node;
+            hook.hk_beam->bm_inter_actor = true;
+            hook.hk_beam->L = link.length;
+            hook.hk_beam->bm_disabled = false;
+            actor->AddInterActorBeam(hook.hk_beam, actor, other);
+        }
+        for (SimSnapshot::LinkState const& link : rec.ties)
+        {
+            Actor* other = get_target(link);
+            if (!other || link.index < 0 || link.index >= static_cast<int>(actor->ar_ties.size()) || link.target < 0 || link.target >= static_cast<int>(other->ar_ropables.size()))
+                continue;
+            tie_t& tie = actor->ar_ties[link.index];
+            tie.ti_locked_actor = other;
+            tie.ti_locked_ropable = &other->ar_ropables[link.target];
+            tie.ti_locked_ropable->in_use = true;
+            tie.ti_beam->p2 = tie.ti_locked_ropable->node;
+            tie.ti_beam->bm_inter_actor = (other != actor);
+            tie.ti_beam->L = link.length;
+            tie.ti_beam->bm_disabled = false;
+            tie.ti_tied = true;
+            tie.ti_tying = (link.locked == 2);
+            if (tie.ti_beam->bm_inter_actor)
+            {
+                actor->AddInterActorBeam(tie.ti_beam, actor, other);
+            }
+        }
+        for (SimSnapshot::LinkState const& link : rec.ropes)
+        {
+            Actor* other = get_target(link);
+            if (!other || link.index < 0 || link.index >= static_cast<int>(actor->ar_ropes.size()) || link.target < 0 || link.target >= static_cast<int>(other->ar_ropables.size()))
+                continue;
+            rope_t& rope = actor->ar_ropes[link.index];
+            rope.rp_locked = link.locked;
+            rope.rp_locked_ropable = &other->ar_ropables[link.target];
+            rope.rp_locked_ropable->in_use = true;
+            rope.rp_locked_node = rope.rp_locked_ropable->node;
+            rope.rp_locked_actor = other;
+        }
+        actor->m_node_live_beams_dirty = true;
+    }
+
+    if (App::GetSimTerrain() && App::GetSimTerrain()->getObjectManager())
+    {
+        App::GetSimTerrain()->getObjectManager()->SetAnimationTimes(snapshot.terrain_animations);
+    }
+
+    RoR::LogFormat("[RoR|SimSnapshot] Restored %d of %d actors from '%s'", num_restored, static_cast<int>(snapshot.actors.size()), path.c_str());
+    return true;
+}
+
 void ActorManager::DeleteActorInternal(Actor* actor)
 {
     if (actor == 0)
@@ -1121,6 +1564,12 @@ void ActorManager::DeleteActorInternal(Actor* actor)
 
     this->SyncWithSimThread();
 
+    if (m_telemetry)
+        m_telemetry->SetActor(nullptr);
+
+    if (m_force_feedback_actor == actor)
+        m_force_feedback_actor = nullptr;
+
 #ifdef USE_SOCKETW
     if (actor->ar_uses_networking && actor->ar_sim_state != Actor::SimState::NETWORKED_OK && actor->ar_sim_state != Actor::SimState::INVALID)
     {
@@ -1255,6 +1704,8 @@ void ActorManager::UpdateFlexbodiesFinal()
 
 void ActorManager::UpdateActorVisuals(float dt,  Actor* player_actor)
 {
+    PerfHarness::Scope perf_scope(m_perf_harness, PerfHarness::VISUALS);
+
     dt *= m_simulation_speed;
 
     for (int t = 0; t < m_free_actor_slot; t++)
@@ -1276,6 +1727,8 @@ void ActorManager::UpdateActorVisuals(float dt,  Actor* player_actor)
 
 void ActorManager::UpdateActors(Actor* player_actor, float dt)
 {
+    PerfHarness::Scope perf_scope(m_perf_harness, PerfHarness::ACTORS);
+
     m_physics_frames++;
 
     // do not allow dt > 1/20
@@ -1352,6 +1805,17 @@ void ActorManager::UpdateActors(Actor* player_actor, float dt)
         }
     }
 
+    if (m_telemetry)
+    {
+        m_telemetry->SetActor(player_actor); // Sim thread is idle at this point
+    }
+
+    m_force_feedback_actor = nullptr;
+    if (m_force_feedback && App::io_ffb_enabled.GetActive() && player_actor && player_actor->ar_driveable == TRUCK)
+    {
+        m_force_feedback_actor = player_actor;
+    }
+
     if (simulated_actor != nullptr)
     {
         if ((player_actor != nullptr) && (simulated_actor == player_actor))
@@ -1360,7 +1824,6 @@ void ActorManager::UpdateActors(Actor* player_actor, float dt)
         }
         if (!simulated_actor->ReplayStep())
         {
-            simulated_actor->ForceFeedbackStep(m_physics_steps);
             if (m_sim_thread_pool)
             {
                 auto func = std::function<void()>([this]()
@@ -1401,6 +1864,8 @@ Actor* ActorManager::GetActorByIdInternal(int number)
 
 void ActorManager::UpdatePhysicsSimulation()
 {
+    PerfHarness::Scope perf_scope(m_perf_harness, PerfHarness::PHYSICS);
+
     for (int t = 0; t < m_free_actor_slot; t++)
     {
         if (!m_actors[t])
@@ -1414,6 +1879,7 @@ void ActorManager::UpdatePhysicsSimulation()
             bool have_actors_to_simulate = false;
 
             {
+                PerfHarness::Scope perf_forces(m_perf_harness, PerfHarness::PHYSICS_FORCES);
                 std::vector<std::function<void()>> tasks;
                 for (int t = 0; t < m_free_actor_slot; t++)
                 {
@@ -1443,14 +1909,18 @@ void ActorManager::UpdatePhysicsSimulation()
                 gEnv->threadPool->Parallelize(tasks);
             }
 
-            for (int t = 0; t < m_free_actor_slot; t++)
             {
-                if (m_actors[t] && m_actors[t]->ar_update_physics)
-                    m_actors[t]->calcForcesEulerFinal(i == 0, PHYSICS_DT, i, m_physics_steps);
+                PerfHarness::Scope perf_final(m_perf_harness, PerfHarness::PHYSICS_FINAL);
+                for (int t = 0; t < m_free_actor_slot; t++)
+                {
+                    if (m_actors[t] && m_actors[t]->ar_update_physics)
+                        m_actors[t]->calcForcesEulerFinal(i == 0, PHYSICS_DT, i, m_physics_steps);
+                }
             }
 
             if (have_actors_to_simulate)
             {
+                PerfHarness::Scope perf_collisions(m_perf_harness, PerfHarness::INTER_COLLISIONS);
                 std::vector<std::function<void()>> tasks;
                 for (int t = 0; t < m_free_actor_slot; t++)
                 {
@@ -1477,6 +1947,12 @@ void ActorManager::UpdatePhysicsSimulation()
                 }
                 gEnv->threadPool->Parallelize(tasks);
             }
+
+            if (m_telemetry)
+                m_telemetry->RecordPhysicsStep(PHYSICS_DT);
+
+            if (m_force_feedback_actor)
+                m_force_feedback->PushPhysicsStep(m_force_feedback_actor->GetForceFeedbackSample(), PHYSICS_DT);
         }
     }
     else
@@ -1487,14 +1963,28 @@ void ActorManager::UpdatePhysicsSimulation()
 
             for (int t = 0; t < m_free_actor_slot; t++)
             {
-                if (m_actors[t] && (m_actors[t]->ar_update_physics = m_actors[t]->CalcForcesEulerPrepare(i == 0, PHYSICS_DT, i, m_physics_steps)))
+                if (!m_actors[t])
+                    continue;
+
+                // Same perf subsystems as the threaded path, measured per actor
+                {
+                    PerfHarness::Scope perf_forces(m_perf_harness, PerfHarness::PHYSICS_FORCES);
+                    m_actors[t]->ar_update_physics = m_actors[t]->CalcForcesEulerPrepare(i == 0, PHYSICS_DT, i, m_physics_steps);
+                    if (m_actors[t]->ar_update_physics)
+                        m_actors[t]->calcForcesEulerCompute(i == 0, PHYSICS_DT, i, m_physics_steps);
+                }
+
+                if (m_actors[t]->ar_update_physics)
                 {
                     have_actors_to_simulate = true;
 
-                    m_actors[t]->calcForcesEulerCompute(i == 0, PHYSICS_DT, i, m_physics_steps);
-                    m_actors[t]->calcForcesEulerFinal(i == 0, PHYSICS_DT, i, m_physics_steps);
+                    {
+                        PerfHarness::Scope perf_final(m_perf_harness, PerfHarness::PHYSICS_FINAL);
+                        m_actors[t]->calcForcesEulerFinal(i == 0, PHYSICS_DT, i, m_physics_steps);
+                    }
                     if (!m_actors[t]->ar_disable_self_collision)
                     {
+                        PerfHarness::Scope perf_forces(m_perf_harness, PerfHarness::PHYSICS_FORCES);
                         m_actors[t]->IntraPointCD()->UpdateIntraPoint(m_actors[t]);
                         ResolveIntraActorCollisions(PHYSICS_DT,
                             *(m_actors[t]->IntraPointCD()),
@@ -1511,6 +2001,7 @@ void ActorManager::UpdatePhysicsSimulation()
 
             if (have_actors_to_simulate)
             {
+                PerfHarness::Scope perf_collisions(m_perf_harness, PerfHarness::INTER_COLLISIONS);
                 for (int t = 0; t < m_free_actor_slot; t++)
                 {
                     if (m_actors[t] && m_actors[t]->ar_update_physics && !m_actors[t]->ar_disable_actor2actor_collision)
@@ -1532,8 +2023,18 @@ void ActorManager::UpdatePhysicsSimulation()
                     }
                 }
             }
+
+            if (m_telemetry)
+                m_telemetry->RecordPhysicsStep(PHYSICS_DT);
+
+            if (m_force_feedback_actor)
+                m_force_feedback->PushPhysicsStep(m_force_feedback_actor->GetForceFeedbackSample(), PHYSICS_DT);
         }
     }
+
+    if (m_telemetry)
+        m_telemetry->Flush();
+
     for (int t = 0; t < m_free_actor_slot; t++)
     {
         if (!m_actors[t])
@@ -1564,6 +2065,22 @@ void HandleErrorLoadingTruckfile(const char* filename, const char* exception_msg
     }
 }
 
+RoR::ActorTemplate* ActorManager::FetchActorTemplate(Actor* actor)
+{
+    std::string key = actor->ar_filename;
+    for (std::string const& module: actor->m_actor_config)
+    {
+        key += "|" + module;
+    }
+
+    std::unique_ptr<ActorTemplate>& entry = m_actor_templates[key];
+    if (!entry)
+    {
+        entry.reset(new ActorTemplate());
+    }
+    return entry.get();
+}
+
 #define FETCHACTORDEF_PROF_CHECKPOINT(_ENTRYNAME_) \
     { if (prof != nullptr) { prof->Checkpoint(RoR::RigLoadingProfiler::_ENTRYNAME_); } }
 
@@ -1597,6 +2114,7 @@ std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(const char* filename,
         parser.Finalize();
 
         auto def = parser.GetFile();
+        def->resource_group = resource_groupname;
 
         def->report_num_errors = parser.GetMessagesNumErrors();
         def->report_num_warnings = parser.GetMessagesNumWarnings();
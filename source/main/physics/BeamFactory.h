@@ -26,10 +26,16 @@
 
 #include "RoRPrerequisites.h"
 
+#include "ActorTemplate.h"
 #include "Beam.h"
 #include "DustManager.h" // Particle systems manager
 #include "Network.h"
+#include "PerfHarness.h"
+#include "RailBvh.h"
+#include "SharedMaterialCache.h"
 #include "Singleton.h"
+#include "SimSnapshot.h"
+#include "TelemetryStream.h"
 
 #define PHYSICS_DT 0.0005 // fixed dt of 0.5 ms
 
@@ -77,9 +83,13 @@ public:
     void           UpdateFlexbodiesPrepare();
     void           UpdateFlexbodiesFinal();
     DustManager&   GetParticleManager()                    { return m_particle_manager; }
+    SharedMaterialCache& GetSharedMaterials()              { return m_shared_materials; }
     void           SetTrucksForcedAwake(bool forced)       { m_forced_awake = forced; };
     int            GetNumUsedActorSlots() const            { return m_free_actor_slot; }; // TODO: Tasks requiring search over all actors should be done internally. ~ only_a_ptr, 01/2018
     Actor**        GetInternalActorSlots()                 { return m_actors; }; // TODO: Tasks requiring search over all actors should be done internally. ~ only_a_ptr, 01/2018
+    void           SetForceFeedback(ForceFeedback* ffb)    { m_force_feedback = ffb; }
+    void           SetPerfHarness(PerfHarness* harness)    { m_perf_harness = harness; }
+    ThreadPool*    GetSimThreadPool()                      { return m_sim_thread_pool.get(); } //!< Null if multithreading is disabled
     void           SetSimulationSpeed(float speed)         { m_simulation_speed = std::max(0.0f, speed); };
     float          GetSimulationSpeed() const              { return m_simulation_speed; };
     Actor*         FetchNextVehicleOnList(Actor* player, Actor* prev_player);
@@ -89,6 +99,10 @@ public:
     Actor*         GetActorByNetworkLinks(int source_id, int stream_id); // used by character
     void           RepairActor(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box, bool keepPosition = false);
     void           UpdateSleepingState(Actor* player_actor, float dt);
+    bool           CastRay(RayCastQuery const& query, RayCastResult& result); //!< Nearest hit of terrain, static collision and actor nodes; see RayCast.h
+    RailBvh const& GetRailBvh(); //!< Slide-node rails of all actors; rebuilt when actors change, refitted at most once per physics frame
+    bool           SaveSimState(std::string const& filename); //!< Checkpoints all local actors; the file is written in background. See SimSnapshot.h
+    bool           LoadSimState(std::string const& filename); //!< Restores a checkpoint into the spawned actors with matching truck files
     void           RemoveActorByCollisionBox(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box); //!< Only for scripting
     void           RemoveActorInternal(int actor_id); //!< DO NOT CALL DIRECTLY! Use `SimController` for public interface
     Actor*         GetActorByIdInternal(int number); //!< DO NOT CALL DIRECTLY! Use `SimController` for public interface
@@ -102,6 +116,13 @@ public:
     void           Release() {};
 #endif
 
+    // Linked actors: union-find over `inter_actor_links`, so queries don't have to walk the whole map
+    void           AddInterActorLink(beam_t* beam, Actor* a, Actor* b);
+    void           RemoveInterActorLink(beam_t* beam);
+    void           RebuildLinkGroup(Actor* actor);     //!< Call after removing links of the group directly from `inter_actor_links`
+    Actor*         FindLinkRoot(Actor* actor);         //!< Compresses paths on the way; only where links are changed
+    Actor*         GetLinkRoot(Actor const* actor) const; //!< Read-only lookup; groups are merged by size, so paths stay O(log n) without compression
+
     // A list of all beams interconnecting two actors
     std::map<beam_t*, std::pair<Actor*, Actor*>> inter_actor_links;
 
@@ -128,12 +149,20 @@ private:
     int            GetFreeActorSlot();
     int            FindActorInsideBox(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box);
     void           DeleteActorInternal(Actor* b);
+    void           UniteLinkGroups(Actor* a, Actor* b);
     std::shared_ptr<RigDef::File>   FetchActorDef(const char* filename, bool predefined_on_terrain = false);
+    RoR::ActorTemplate*             FetchActorTemplate(Actor* actor); ///< One per definition + selected config; created empty on first use
 
     std::map<std::string, std::shared_ptr<RigDef::File>>   m_actor_defs;
+    std::map<std::string, std::unique_ptr<RoR::ActorTemplate>> m_actor_templates; //!< Spawn-time data shared by all instances of a definition
     std::map<int, std::vector<int>> m_stream_mismatches; //!< Networking: A list of streams without a corresponding actor in the actor-array for each stream source
     std::unique_ptr<ThreadPool>     m_sim_thread_pool;
     std::shared_ptr<Task>           m_sim_task;
+    std::unique_ptr<TelemetryStream> m_telemetry;    //!< Optional physics-rate data output; see `io_telemetry_*` GVars
+    std::unique_ptr<RoR::SimSnapshotWriter> m_snapshot_writer; //!< Created on first `SaveSimState()`
+    ForceFeedback*  m_force_feedback;
+    Actor*          m_force_feedback_actor; //!< Player vehicle if force feedback is active; sampled every physics step
+    PerfHarness*    m_perf_harness;      //!< Only set by `-perftest` runs; timing scopes are no-ops otherwise
     int             m_num_cpu_cores;
     Actor*          m_actors[MAX_ACTORS];//!< All actors; slots are not reused
     int             m_free_actor_slot;   //!< Slots are not reused
@@ -143,6 +172,10 @@ private:
     float           m_dt_remainder;     ///< Keeps track of the rounding error in the time step calculation
     float           m_simulation_speed; ///< slow motion < 1.0 < fast motion
     DustManager     m_particle_manager;
+    SharedMaterialCache m_shared_materials; //!< Materials of actors with identical definition and skin
+    RailBvh         m_rail_bvh;
+    std::vector<int> m_rail_bvh_actors; //!< Instance IDs of actors indexed in `m_rail_bvh`
+    unsigned long   m_rail_bvh_frame;   //!< Physics frame `m_rail_bvh` was refreshed in
 };
 
 } // namespace RoR
@@ -26,6 +26,7 @@
 #include "Airfoil.h"
 #include "Application.h"
 #include "ApproxMath.h"
+#include "AsyncLog.h"
 #include "Beam.h"
 #include "BeamEngine.h"
 #include "BeamFactory.h"
@@ -33,7 +34,7 @@
 #include "Buoyance.h"
 #include "CmdKeyInertia.h"
 #include "Collisions.h"
-#include "Differentials.h"
+#include "Drivetrain.h"
 #include "DustPool.h"
 #include "FlexAirfoil.h"
 #include "InputEngine.h"
@@ -67,6 +68,7 @@ void Actor::calcForcesEulerCompute(bool doUpdate, Real dt, int step, int maxstep
     }
 
     calcBeams(doUpdate, dt, step, maxsteps);
+    this->ProcessBeamBreakEvents();
 
     if (doUpdate)
     {
@@ -83,14 +85,11 @@ void Actor::calcForcesEulerCompute(bool doUpdate, Real dt, int step, int maxstep
 
     if (is_player_actor) //force feedback sensors
     {
-        if (doUpdate)
-        {
-            m_force_sensors.Reset();
-        }
+        m_force_sensors.Reset();
 
         if (ar_current_cinecam != -1)
         {
-            m_force_sensors.accu_body_forces += ar_nodes[ar_camera_node_pos[ar_current_cinecam]].Forces;
+            m_force_sensors.body_forces = ar_nodes[ar_camera_node_pos[ar_current_cinecam]].Forces;
         }
 
         for (int i = 0; i < ar_num_hydros; i++)
@@ -98,7 +97,7 @@ void Actor::calcForcesEulerCompute(bool doUpdate, Real dt, int step, int maxstep
             beam_t* hydrobeam = &ar_beams[ar_hydro[i]];
             if ((hydrobeam->hydroFlags & (HYDRO_FLAG_DIR | HYDRO_FLAG_SPEED)) && !hydrobeam->bm_broken)
             {
-                m_force_sensors.accu_hydros_forces += hydrobeam->hydroRatio * hydrobeam->refL * hydrobeam->stress;
+                m_force_sensors.hydros_forces += hydrobeam->hydroRatio * hydrobeam->refL * hydrobeam->stress;
             }
         }
     }
@@ -240,276 +239,49 @@ void Actor::calcForcesEulerCompute(bool doUpdate, Real dt, int step, int maxstep
     Real wspeed = 0.0;
     //wheel stuff
 
-    float engine_torque = 0.0;
-
-    // calculate torque per wheel
-    if (ar_engine && m_num_proped_wheels != 0)
-        engine_torque = ar_engine->GetTorque() / m_num_proped_wheels;
-
-    int propcounter = 0;
-    float newspeeds[MAX_WHEELS] = {};
-    float intertorque[MAX_WHEELS] = {};
-    //old-style viscous code
-    if (m_num_axles == 0)
-    {
-        //first, evaluate torque from inter-differential locking
-        for (int i = 0; i < m_num_proped_wheels / 2 - 1; i++)
-        {
-            if (ar_wheels[m_proped_wheel_pairs[i * 2 + 0]].wh_is_detached)
-                ar_wheels[m_proped_wheel_pairs[i * 2 + 0]].wh_speed = ar_wheels[m_proped_wheel_pairs[i * 2 + 1]].wh_speed;
-            if (ar_wheels[m_proped_wheel_pairs[i * 2 + 1]].wh_is_detached)
-                ar_wheels[m_proped_wheel_pairs[i * 2 + 1]].wh_speed = ar_wheels[m_proped_wheel_pairs[i * 2 + 0]].wh_speed;
-            if (ar_wheels[m_proped_wheel_pairs[i * 2 + 2]].wh_is_detached)
-                ar_wheels[m_proped_wheel_pairs[i * 2 + 2]].wh_speed = ar_wheels[m_proped_wheel_pairs[i * 2 + 3]].wh_speed;
-            if (ar_wheels[m_proped_wheel_pairs[i * 2 + 3]].wh_is_detached)
-                ar_wheels[m_proped_wheel_pairs[i * 2 + 3]].wh_speed = ar_wheels[m_proped_wheel_pairs[i * 2 + 2]].wh_speed;
-
-            float speed1 = (ar_wheels[m_proped_wheel_pairs[i * 2 + 0]].wh_speed + ar_wheels[m_proped_wheel_pairs[i * 2 + 1]].wh_speed) * 0.5f;
-            float speed2 = (ar_wheels[m_proped_wheel_pairs[i * 2 + 2]].wh_speed + ar_wheels[m_proped_wheel_pairs[i * 2 + 3]].wh_speed) * 0.5f;
-            float torque = (speed1 - speed2) * 10000.0f;
-
-            intertorque[i * 2 + 0] -= torque * 0.5f;
-            intertorque[i * 2 + 1] -= torque * 0.5f;
-            intertorque[i * 2 + 2] += torque * 0.5f;
-            intertorque[i * 2 + 3] += torque * 0.5f;
-        }
-    }
-
-    // new-style Axles
-    // loop through all axles for inter axle torque, this is the torsion to keep
-    // the axles aligned with each other as if they connected by a shaft
-    for (int i = 1; i < m_num_axles; i++)
-    {
-        if (!m_axles[i])
-            continue;
-
-        if (ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_is_detached)
-            ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_speed = ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_speed;
-        if (ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_is_detached)
-            ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_speed = ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_speed;
-        if (ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_is_detached)
-            ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_speed = ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_speed;
-        if (ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_is_detached)
-            ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_speed = ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_speed;
-
-        if (ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_is_detached && ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_is_detached)
-        {
-            ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_speed = ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_speed;
-            ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_speed = ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_speed;
-        }
-        if (ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_is_detached && ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_is_detached)
-        {
-            ar_wheels[m_axles[i - 0]->ax_wheel_1].wh_speed = ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_speed;
-            ar_wheels[m_axles[i - 0]->ax_wheel_2].wh_speed = ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_speed;
-        }
-
-        Ogre::Real axle_torques[2] = {0.0f, 0.0f};
-        DifferentialData diff_data =
-        {
-            {
-                (ar_wheels[m_axles[i - 1]->ax_wheel_1].wh_speed + ar_wheels[m_axles[i - 1]->ax_wheel_2].wh_speed) * 0.5f,
-                (ar_wheels[m_axles[i]->ax_wheel_1].wh_speed + ar_wheels[m_axles[i]->ax_wheel_2].wh_speed) * 0.5f
-            },
-            m_axles[i - 1]->ax_delta_rotation,
-            {axle_torques[0], axle_torques[1]},
-            0, // no input torque, just calculate forces from different axle positions
-            dt
-        };
-
-#if 0
-        // use an open diff just for fun :)
-		Axle::CalcOpenDiff( diff_data );
-#else
-        // use the locked diff, most vehicles are setup this way...
-        Axle::CalcLockedDiff(diff_data);
-#endif
-
-        m_axles[i - 1]->ax_delta_rotation = diff_data.delta_rotation;
-        m_axles[i]->ax_delta_rotation = -diff_data.delta_rotation;
-
-        intertorque[m_axles[i - 1]->ax_wheel_1] = diff_data.out_torque[0];
-        intertorque[m_axles[i - 1]->ax_wheel_2] = diff_data.out_torque[0];
-        intertorque[m_axles[i]->ax_wheel_1] = diff_data.out_torque[1];
-        intertorque[m_axles[i]->ax_wheel_2] = diff_data.out_torque[1];
-    }
-
-    // loop through all the wheels (new style again)
-    for (int i = 0; i < m_num_axles; i++)
-    {
-        if (!m_axles[i])
-            continue;
-        Ogre::Real axle_torques[2] = {0.0f, 0.0f};
-        wheel_t* axle_wheels[2] = {&ar_wheels[m_axles[i]->ax_wheel_1], &ar_wheels[m_axles[i]->ax_wheel_2]};
-
-        if (axle_wheels[0]->wh_is_detached)
-            axle_wheels[0]->wh_speed = axle_wheels[1]->wh_speed;
-        if (axle_wheels[1]->wh_is_detached)
-            axle_wheels[1]->wh_speed = axle_wheels[0]->wh_speed;
-
-        DifferentialData diff_data =
-        {
-            {axle_wheels[0]->wh_speed, axle_wheels[1]->wh_speed},
-            axle_wheels[0]->wh_delta_rotation,
-            {axle_torques[0], axle_torques[1]},
-            // twice the torque since this is for two wheels, plus extra torque from
-            // inter-axle torsion
-            2.0f * engine_torque + intertorque[m_axles[i]->ax_wheel_1],
-            dt
-        };
-
-        m_axles[i]->CalcAxleTorque(diff_data);
-
-        axle_wheels[0]->wh_delta_rotation = diff_data.delta_rotation;
-        axle_wheels[1]->wh_delta_rotation = -diff_data.delta_rotation;
-
-        intertorque[m_axles[i]->ax_wheel_1] = diff_data.out_torque[0];
-        intertorque[m_axles[i]->ax_wheel_2] = diff_data.out_torque[1];
-    }
-
-    // driving aids traction control & anti-lock brake pulse
-    tc_timer += dt;
-    alb_timer += dt;
-
-    if (alb_timer >= alb_pulse_time)
-    {
-        alb_timer = 0.0f;
-        alb_pulse_state = !alb_pulse_state;
-    }
-    if (tc_timer >= tc_pulse_time)
+    // drivetrain: engine -> shafts -> differentials -> hubs (with brakes and driving aids)
+    for (int i = 0; i < ar_num_wheels; i++)
     {
-        tc_timer = 0.0f;
-        tc_pulse_state = !tc_pulse_state;
+        RoR::Drivetrain::Hub& hub = m_drivetrain.GetHub(i);
+        hub.speed      = ar_wheels[i].wh_speed;
+        hub.last_speed = ar_wheels[i].wh_last_speed;
+        hub.detached   = ar_wheels[i].wh_is_detached;
     }
 
-    bool tc_active = false;
-    bool alb_active = false;
-
-    // get current speed
-    float curspeed = ar_nodes[0].Velocity.length();
-
+    RoR::Drivetrain::Controls controls;
+    controls.engine_torque   = (ar_engine) ? ar_engine->GetTorque() : 0.f;
+    controls.brake           = ar_brake;
+    controls.brake_force     = ar_brake_force;
+    controls.handbrake_force = m_handbrake_force;
+    controls.parking_brake   = ar_parking_brake != 0;
+    controls.steering        = ar_hydro_dir_state;
+    controls.wheel_speed     = ar_wheel_speed;
+    controls.vehicle_speed   = ar_nodes[0].Velocity.length();
     // fix for airplanes crashing when GetAcceleration() is used
-    float currentAcc = 0.0f;
-    if (ar_driveable == TRUCK && ar_engine)
-    {
-        currentAcc = ar_engine->GetAcceleration();
-    }
+    controls.acceleration    = (ar_driveable == TRUCK && ar_engine) ? ar_engine->GetAcceleration() : 0.f;
+    controls.dt              = dt;
+
+    RoR::Drivetrain::DrivingAids aids;
+    aids.alb_mode       = alb_mode != 0;
+    aids.alb_ratio      = alb_ratio;
+    aids.alb_minspeed   = alb_minspeed;
+    aids.alb_pulse_time = alb_pulse_time;
+    aids.tc_mode        = tc_mode != 0;
+    aids.tc_ratio       = tc_ratio;
+    aids.tc_wheelslip   = tc_wheelslip;
+    aids.tc_fade        = tc_fade;
+    aids.tc_pulse_time  = tc_pulse_time;
+
+    float hub_torques[MAX_WHEELS] = {};
+    m_drivetrain.Solve(controls, aids, hub_torques);
 
+    float newspeeds[MAX_WHEELS] = {};
     for (int i = 0; i < ar_num_wheels; i++)
     {
-        Real speedacc = 0.0;
+        ar_wheels[i].wh_speed = m_drivetrain.GetHub(i).speed;
 
-        // total torque estimation
-        Real total_torque = 0.0;
-        if (ar_wheels[i].wh_propulsed > 0)
-        {
-            total_torque = (m_num_axles == 0) ? engine_torque : intertorque[i];
-        }
-
-        if (ar_wheels[i].wh_braking != wheel_t::BrakeCombo::NONE)
-        {
-            // handbrake
-            float hbrake = 0.0f;
-
-            if (ar_parking_brake && (ar_wheels[i].wh_braking != wheel_t::BrakeCombo::FOOT_ONLY))
-            {
-                hbrake = m_handbrake_force;
-            }
-
-            // directional braking
-            float dbrake = 0.0f;
-
-            if ((ar_wheel_speed < 20.0f)
-                && (((ar_wheels[i].wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_LEFT)  && (ar_hydro_dir_state > 0.0f))
-                 || ((ar_wheels[i].wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_RIGHT) && (ar_hydro_dir_state < 0.0f))))
-            {
-                dbrake = ar_brake_force * abs(ar_hydro_dir_state);
-            }
-
-            if ((ar_brake != 0.0 || dbrake != 0.0 || hbrake != 0.0) && m_num_braked_wheels != 0 && fabs(ar_wheels[i].wh_speed) > 0.0f)
-            {
-                float brake_coef = 1.0f;
-                float antilock_coef = 1.0f;
-                // anti-lock braking
-                if (alb_mode && alb_pulse_state && (ar_brake > 0.0f || dbrake > 0.0f) && curspeed > fabs(ar_wheels[i].wh_speed) && curspeed > alb_minspeed)
-                {
-                    antilock_coef = fabs(ar_wheels[i].wh_speed) / curspeed;
-                    antilock_coef = pow(antilock_coef, alb_ratio);
-                    alb_active = (antilock_coef < 0.9);
-                }
-                if (fabs(ar_wheels[i].wh_speed) < 1.0f)
-                {
-                    if (ar_wheels[i].firstLock)
-                    {
-                        ar_wheels[i].wh_avg_speed = 0.0f;
-                        ar_wheels[i].firstLock = false;
-                    }
-                    // anti-jitter
-                    if (fabs(ar_wheels[i].wh_avg_speed) < 2.0f)
-                    {
-                        brake_coef = pow(fabs(ar_wheels[i].wh_speed), 2.0f);
-                    }
-                    else
-                    {
-                        brake_coef = pow(fabs(ar_wheels[i].wh_speed), 0.5f);
-                    }
-                    // anti-skidding
-                    ar_wheels[i].wh_avg_speed += ar_wheels[i].wh_speed;
-                    ar_wheels[i].wh_avg_speed = std::max(-10.0f, std::min(ar_wheels[i].wh_avg_speed, 10.0f));
-                    float speed_diff = ar_wheels[i].wh_speed - ar_wheels[i].wh_last_speed;
-                    float speed_prediction = ar_wheels[i].wh_speed + 0.5f * speed_diff;
-                    if (speed_prediction * ar_wheels[i].wh_avg_speed < 0.0f)
-                    {
-                        brake_coef = 0.0f;
-                    }
-                }
-                else
-                {
-                    ar_wheels[i].firstLock = true;
-                }
-
-                if (ar_wheels[i].wh_speed > 0)
-                    total_torque -= ((ar_brake + dbrake) * antilock_coef + hbrake) * brake_coef;
-                else
-                    total_torque += ((ar_brake + dbrake) * antilock_coef + hbrake) * brake_coef;
-            }
-        }
-        else
-        {
-            ar_wheels[i].firstLock = true;
-        }
-
-        // traction control
-        if (tc_mode && tc_pulse_state && ar_wheels[i].wh_propulsed > 0 && currentAcc > 0.0f && fabs(ar_wheels[i].wh_speed) > curspeed)
-        {
-            curspeed = std::max(0.5f, curspeed);
-
-            // tc_wheelslip = allowed amount of slip in percent
-            float wheelslip = 1.0f + tc_wheelslip;
-            // wheelslip allowed doubles up to tc_fade, a tribute to RoRs wheelspeed calculation and friction
-            wheelslip += tc_wheelslip * (curspeed / tc_fade);
-
-            if (fabs(ar_wheels[i].wh_speed) > curspeed * wheelslip)
-            {
-                float torque_coef = (curspeed * wheelslip) / fabs(ar_wheels[i].wh_speed);
-                torque_coef = pow(torque_coef, tc_ratio);
-                total_torque *= torque_coef;
-                tc_active = (torque_coef < 0.9f);
-            }
-        }
-
-        // old-style
-        if (m_num_axles == 0 && ar_wheels[i].wh_propulsed > 0)
-        {
-            // differential locking
-            if (i % 2)
-                if (!ar_wheels[i].wh_is_detached && !ar_wheels[i - 1].wh_is_detached)
-                    total_torque -= (ar_wheels[i].wh_speed - ar_wheels[i - 1].wh_speed) * 10000.0;
-                else if (!ar_wheels[i].wh_is_detached && !ar_wheels[i + 1].wh_is_detached)
-                    total_torque -= (ar_wheels[i].wh_speed - ar_wheels[i + 1].wh_speed) * 10000.0;
-            // inter differential locking
-            total_torque += intertorque[propcounter];
-            propcounter++;
-        }
+        Real speedacc = 0.0;
+        Real total_torque = hub_torques[i];
 
         if (ar_wheels[i].wh_is_detached)
             continue;
@@ -578,8 +350,8 @@ void Actor::calcForcesEulerCompute(bool doUpdate, Real dt, int step, int maxstep
         m_tractioncontrol = false;
     }
 
-    m_antilockbrake = std::max(m_antilockbrake, (int)alb_active);
-    m_tractioncontrol = std::max(m_tractioncontrol, (int)tc_active);
+    m_antilockbrake = std::max(m_antilockbrake, (int)m_drivetrain.IsAntiLockActive());
+    m_tractioncontrol = std::max(m_tractioncontrol, (int)m_drivetrain.IsTractionControlActive());
 
     if (step == maxsteps)
     {
@@ -1260,30 +1032,6 @@ void Actor::calcForcesEulerFinal(int doUpdate, Ogre::Real dt, int step, int maxs
     calcRopes();
 }
 
-template <size_t L>
-void LogNodeId(RoR::Str<L>& msg, node_t* node) // Internal helper
-{
-    if (node->id <= 0) // Named nodes have '0', generated have '-1'
-    {
-        msg << "\"?unknown?\"";
-    }
-    else
-    {
-        msg << "\"" << node->id << "\"";
-    }
-    msg << " (index: " << node->pos << ")";
-}
-
-template <size_t L>
-void LogBeamNodes(RoR::Str<L>& msg, beam_t& beam) // Internal helper
-{
-    msg << "It was between nodes ";
-    LogNodeId(msg, beam.p1);
-    msg << " and ";
-    LogNodeId(msg, beam.p2);
-    msg << ".";
-}
-
 void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
 {
     // HOT DATA: 
@@ -1371,14 +1119,12 @@ void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
                     if (difftoBeamL > ar_beams[i].L * break_limit)
                     {
                         ar_beams[i].bm_broken = true;
-                        ar_beams[i].bm_disabled = true;
+                        ar_beams[i].bm_disabled = true; // Bounded; doesn't count as live beam
                         if (m_beam_break_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] XXX Support-Beam " << i << " limit extended and broke. "
-                                << "Length: " << difftoBeamL << " / max. Length: " << (ar_beams[i].L*break_limit) << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_BREAK,
+                                "[RoR|Diag] XXX Support-Beam %d limit extended and broke. Length: %f / max. Length: %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, difftoBeamL, ar_beams[i].L*break_limit, ar_beams[i].p1->id, ar_beams[i].p1->pos, ar_beams[i].p2->id, ar_beams[i].p2->pos);
                         }
                     }
                 }
@@ -1427,11 +1173,9 @@ void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
                         //ar_beams[i].strength += deform * k * 0.5f;
                         if (m_beam_deform_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_DEFORM,
+                                "[RoR|Diag] YYY Beam %d just deformed with extension force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_beams[i].strength, ar_beams[i].p1->id, ar_beams[i].p1->pos, ar_beams[i].p2->id, ar_beams[i].p2->pos);
                         }
                     }
                     else if (slen < ar_beams[i].maxnegstress && difftoBeamL > 0.0f) // expansion
@@ -1452,11 +1196,9 @@ void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
                         ar_beams[i].strength -= deform * k;
                         if (m_beam_deform_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_DEFORM,
+                                "[RoR|Diag] YYY Beam %d just deformed with extension force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_beams[i].strength, ar_beams[i].p1->id, ar_beams[i].p1->pos, ar_beams[i].p2->id, ar_beams[i].p2->pos);
                         }
                     }
                 }
@@ -1479,42 +1221,22 @@ void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
                         slen = 0.0f;
                         ar_beams[i].bm_broken = true;
                         ar_beams[i].bm_disabled = true;
-
-                        if (m_beam_break_debug_enabled)
+                        if (!ar_beams[i].bounded && !m_node_live_beams_dirty)
                         {
-                            RoR::Str<200> msg;
-                            msg << "[RoR|Diag] XXX Beam " << i << " just broke with force " << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
+                            for (int n : { ar_beams[i].p1->pos, ar_beams[i].p2->pos })
+                            {
+                                // Hook beams may point elsewhere than when the graph was built
+                                const int* conn = GetConnectedBeams(n);
+                                if (std::find(conn, conn + GetNumNodeConnections(n), i) != conn + GetNumNodeConnections(n))
+                                    m_node_live_beams[n]--;
+                            }
                         }
 
-                        // detachergroup check: beam[i] is already broken, check detacher group# == 0/default skip the check ( performance bypass for beams with default setting )
-                        // only perform this check if this is a master detacher beams (positive detacher group id > 0)
-                        if (ar_beams[i].detacher_group > 0)
+                        if (m_beam_break_debug_enabled)
                         {
-                            // cycle once through the other beams
-                            for (int j = 0; j < ar_num_beams; j++)
-                            {
-                                // beam[i] detacher group# == checked beams detacher group# -> delete & disable checked beam
-                                // do this with all master(positive id) and minor(negative id) beams of this detacher group
-                                if (abs(ar_beams[j].detacher_group) == ar_beams[i].detacher_group)
-                                {
-                                    ar_beams[j].bm_broken = true;
-                                    ar_beams[j].bm_disabled = true;
-                                    if (m_beam_break_debug_enabled)
-                                    {
-                                        LOG("Deleting Detacher BeamID: " + TOSTRING(j) + ", Detacher Group: " + TOSTRING(ar_beams[i].detacher_group)+ ", actor ID: " + TOSTRING(ar_instance_id));
-                                    }
-                                }
-                            }
-                            // cycle once through all wheels
-                            for (int j = 0; j < ar_num_wheels; j++)
-                            {
-                                if (ar_wheels[j].wh_detacher_group == ar_beams[i].detacher_group)
-                                {
-                                    ar_wheels[j].wh_is_detached = true;
-                                }
-                            }
+                            RoR::LogAsync(LogCategory::BEAM_BREAK,
+                                "[RoR|Diag] XXX Beam %d just broke with force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_beams[i].strength, ar_beams[i].p1->id, ar_beams[i].p1->pos, ar_beams[i].p2->id, ar_beams[i].p2->pos);
                         }
                     }
                     else
@@ -1522,18 +1244,8 @@ void Actor::calcBeams(int doUpdate, Ogre::Real dt, int step, int maxsteps)
                         ar_beams[i].strength = 2.0f * ar_beams[i].minmaxposnegstress;
                     }
 
-                    // something broke, check buoyant hull
-                    for (int mk = 0; mk < ar_num_buoycabs; mk++)
-                    {
-                        int tmpv = ar_buoycabs[mk] * 3;
-                        if (ar_buoycab_types[mk] == Buoyance::BUOY_DRAGONLY)
-                            continue;
-                        if ((ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 2]]) &&
-                            (ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 2]]))
-                        {
-                            m_buoyance->setsink(1);
-                        }
-                    }
+                    // Detacher groups and buoyant hull are handled after the spring pass
+                    m_beam_break_events.push_back(i);
                 }
             }
 
@@ -1605,11 +1317,9 @@ void Actor::CalcBeamsInterActor(int doUpdate, Ogre::Real dt, int step, int maxst
                         //ar_inter_beams[i]->strength += deform * k * 0.5f;
                         if (m_beam_deform_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_inter_beams[i]->strength << ". ";
-                            LogBeamNodes(msg, (*ar_inter_beams[i]));
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_DEFORM,
+                                "[RoR|Diag] YYY Beam %d just deformed with extension force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_inter_beams[i]->strength, ar_inter_beams[i]->p1->id, ar_inter_beams[i]->p1->pos, ar_inter_beams[i]->p2->id, ar_inter_beams[i]->p2->pos);
                         }
                     }
                     else if (slen < ar_inter_beams[i]->maxnegstress && difftoBeamL > 0.0f) // expansion
@@ -1629,11 +1339,9 @@ void Actor::CalcBeamsInterActor(int doUpdate, Ogre::Real dt, int step, int maxst
                         ar_inter_beams[i]->strength -= deform * k;
                         if (m_beam_deform_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_inter_beams[i]->strength << ". ";
-                            LogBeamNodes(msg, (*ar_inter_beams[i]));
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_DEFORM,
+                                "[RoR|Diag] YYY Beam %d just deformed with extension force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_inter_beams[i]->strength, ar_inter_beams[i]->p1->id, ar_inter_beams[i]->p1->pos, ar_inter_beams[i]->p2->id, ar_inter_beams[i]->p2->pos);
                         }
                     }
                 }
@@ -1654,13 +1362,13 @@ void Actor::CalcBeamsInterActor(int doUpdate, Ogre::Real dt, int step, int maxst
                         slen = 0.0f;
                         ar_inter_beams[i]->bm_broken = true;
                         ar_inter_beams[i]->bm_disabled = true;
+                        m_node_live_beams_dirty = true; // Inter-actor beams are always our own (hooks, ties)
 
                         if (m_beam_break_debug_enabled)
                         {
-                            RoR::Str<200> msg;
-                            msg << "[RoR|Diag] XXX Beam " << i << " just broke with force " << len << " / " << ar_inter_beams[i]->strength << ". ";
-                            LogBeamNodes(msg, (*ar_inter_beams[i]));
-                            RoR::Log(msg.ToCStr());
+                            RoR::LogAsync(LogCategory::BEAM_BREAK,
+                                "[RoR|Diag] XXX Beam %d just broke with force %f / %f. It was between nodes %d (index: %d) and %d (index: %d).",
+                                i, len, ar_inter_beams[i]->strength, ar_inter_beams[i]->p1->id, ar_inter_beams[i]->p1->pos, ar_inter_beams[i]->p2->id, ar_inter_beams[i]->p2->pos);
                         }
                     }
                     else
@@ -1926,6 +1634,7 @@ void Actor::calcHooks()
                 it->hk_beam->bm_inter_actor = it->hk_locked_actor != 0;
                 it->hk_beam->L = (it->hk_hook_node->AbsPosition - it->hk_lock_node->AbsPosition).length();
                 it->hk_beam->bm_disabled = false;
+                m_node_live_beams_dirty = true;
                 AddInterActorBeam(it->hk_beam, this, it->hk_locked_actor);
             }
             else
@@ -1968,6 +1677,7 @@ void Actor::calcHooks()
                                 it->hk_beam->bm_inter_actor = false;
                                 it->hk_beam->L = (ar_nodes[0].AbsPosition - it->hk_hook_node->AbsPosition).length();
                                 it->hk_beam->bm_disabled = true;
+                                m_node_live_beams_dirty = true;
                                 RemoveInterActorBeam(it->hk_beam);
                             }
                         }
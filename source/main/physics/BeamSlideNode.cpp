@@ -28,21 +28,16 @@
 #include "Application.h"
 #include "Beam.h"
 #include "BeamFactory.h"
+#include "RailBvh.h"
 #include "RoRFrameListener.h"
 
-// ug... BAD PERFORMNCE, BAD!!
 void Actor::ToggleSlideNodeLock()
 {
-    unsigned int num_slots = static_cast<unsigned int>(RoR::App::GetSimController()->GetBeamFactory()->GetNumUsedActorSlots());
     Actor* player_actor = RoR::App::GetSimController()->GetPlayerActor();
-    int player_actor_id = (player_actor != nullptr) ? player_actor->ar_instance_id : -1;
 
     // for every slide node on this truck
     for (std::vector<SlideNode>::iterator itNode = m_slidenodes.begin(); itNode != m_slidenodes.end(); itNode++)
     {
-        std::pair<RailGroup*, Ogre::Real> closest((RailGroup*)NULL, std::numeric_limits<Ogre::Real>::infinity());
-        std::pair<RailGroup*, Ogre::Real> current((RailGroup*)NULL, std::numeric_limits<Ogre::Real>::infinity());
-
         // if neither foreign, nor self attach is set then we cannot change the
         // Rail attachments
         if (!itNode->sn_attach_self && !itNode->sn_attach_foreign)
@@ -56,50 +51,21 @@ void Actor::ToggleSlideNodeLock()
             continue;
         }
 
-        // check all the slide rail on all the other trucks :(
-        for (unsigned int i = 0; i < num_slots; ++i)
-        {
-            // make sure this truck is allowed
-            if (!((player_actor_id != i && itNode->sn_attach_foreign) ||
-                (player_actor_id == i && itNode->sn_attach_self)))
-                continue;
-
-            current = GetClosestRailOnActor(RoR::App::GetSimController()->GetActorById(i), (*itNode));
-            if (current.second < closest.second)
-                closest = current;
-        } // this many
-
-        itNode->AttachToRail(closest.first);
-    } // nests
-
-    m_slidenodes_locked = !m_slidenodes_locked;
-} // is ugly....
-
-std::pair<RailGroup*, Ogre::Real> Actor::GetClosestRailOnActor(Actor* actor, const SlideNode& node)
-{
-    std::pair<RailGroup*, Ogre::Real> closest((RailGroup*)NULL, std::numeric_limits<Ogre::Real>::infinity());
-    RailSegment* curRail = NULL;
-    Ogre::Real lenToCurRail = std::numeric_limits<Ogre::Real>::infinity();
-
-    for (std::vector<RailGroup*>::iterator itGroup = actor->m_railgroups.begin();
-         itGroup != actor->m_railgroups.end();
-         itGroup++)
-    {
-        // find the rail closest to the Node
-        if (*itGroup == nullptr)
-            continue;
-
-        curRail = (*itGroup)->FindClosestSegment(node.GetSlideNodePosition());
-        lenToCurRail = node.getLenTo(curRail);
-
-        if (lenToCurRail < node.GetAttachmentDistance() && lenToCurRail < closest.second)
-        {
-            closest.first = (*itGroup);
-            closest.second = lenToCurRail;
-        }
+        // find the closest rail on all allowed actors
+        const bool attach_self = itNode->sn_attach_self;
+        const bool attach_foreign = itNode->sn_attach_foreign;
+        float distance = 0.f;
+        const RoR::RailBvh::Entry* closest = RoR::App::GetSimController()->GetBeamFactory()->GetRailBvh().FindClosest(
+            itNode->GetSlideNodePosition(), itNode->GetAttachmentDistance(), distance,
+            [player_actor, attach_self, attach_foreign](Actor* actor)
+            {
+                return (actor != player_actor && attach_foreign) || (actor == player_actor && attach_self);
+            });
+
+        itNode->AttachToRail((closest != nullptr) ? closest->group : nullptr);
     }
 
-    return closest;
+    m_slidenodes_locked = !m_slidenodes_locked;
 }
 
 // SlideNode Utility functions /////////////////////////////////////////////////
@@ -22,7 +22,7 @@
 
 #include "RoRPrerequisites.h"
 
-class CmdKeyInertia : public ZeroedMemoryAllocator
+class CmdKeyInertia
 {
 public:
 
@@ -20,25 +20,12 @@
 
 #pragma once
 
+#include "Drivetrain.h"
+
 #include <OgreUTFString.h>
 #include <vector>
 
-struct DifferentialData
-{
-    float speed[2];
-    float delta_rotation; // sign is first relative to the second
-    float out_torque[2];
-    float in_torque;
-    float dt;
-};
-
-enum DiffType
-{
-    SPLIT_DIFF = 0,
-    OPEN_DIFF,
-    LOCKED_DIFF
-};
-
+/// Differential configuration of an axle; the torque is solved by `RoR::Drivetrain`.
 class Axle
 {
 public:
@@ -46,21 +33,15 @@ public:
 
     int       ax_wheel_1; //!< array location of wheel 1
     int       ax_wheel_2; //!< array location of wheel 2
-    float     ax_delta_rotation; //!< difference of rotational position between two axles... a kludge at best
 
     void             AddDifferentialType(DiffType diff);
     void             ToggleDifferentialMode();
-    void             CalcAxleTorque(DifferentialData& diff_data );
+    bool             HasDifferential() const       { return m_which_diff != -1; }
+    DiffType         GetActiveDifferential() const { return m_available_diffs[m_which_diff]; } //!< Only valid if `HasDifferential()`
     Ogre::UTFString  GetDifferentialTypeName();
-    
-    static void      CalcSeparateDiff(DifferentialData& diff_data);  //!< a differential that always splits the torque evenly, this is the original method
-    static void      CalcOpenDiff(DifferentialData& diff_data );     //!< more power goes to the faster spining wheel
-    static void      CalcLockedDiff(DifferentialData& diff_data );   //!< ensures both wheels rotate at the the same speed
 
 private:
 
-    float     m_torsion_rate; //! torsion spring rate binding wheels together.
-    float     m_torsion_damp;    
     int       m_which_diff;
     std::vector<DiffType> m_available_diffs;
 };
@@ -0,0 +1,431 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Drivetrain.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace RoR;
+
+Drivetrain::Drivetrain():
+    m_num_propulsed(0),
+    m_num_braked(0),
+    m_alb_timer(0.f),
+    m_tc_timer(0.f),
+    m_alb_pulse_state(false),
+    m_tc_pulse_state(false),
+    m_alb_active(false),
+    m_tc_active(false)
+{
+}
+
+void Drivetrain::AddHub(bool propulsed, uint8_t brakes)
+{
+    Hub hub;
+    hub.speed = 0.f;
+    hub.last_speed = 0.f;
+    hub.avg_speed = 0.f;
+    hub.delta_rotation = 0.f;
+    hub.brakes = brakes;
+    hub.propulsed = propulsed;
+    hub.detached = false;
+    hub.first_lock = false;
+    m_hubs.push_back(hub);
+    m_shaft_torque.push_back(0.f);
+
+    if (propulsed)
+        m_num_propulsed++;
+    if (brakes != BRAKE_NONE)
+        m_num_braked++;
+}
+
+void Drivetrain::AddDifferential(int hub_1, int hub_2, DiffType type, bool enabled)
+{
+    Differential diff;
+    diff.hub_1 = hub_1;
+    diff.hub_2 = hub_2;
+    diff.type = type;
+    diff.enabled = enabled;
+    diff.shaft_rotation = 0.f;
+    m_diffs.push_back(diff);
+}
+
+void Drivetrain::SetLegacyPairs(const int* pairs, int count)
+{
+    m_legacy_pairs.assign(pairs, pairs + count);
+}
+
+void Drivetrain::SolveLegacyCouplings()
+{
+    // old-style viscous code: evaluate torque from inter-differential locking
+    for (int i = 0; i < static_cast<int>(m_legacy_pairs.size()) / 2 - 1; i++)
+    {
+        Hub& a1 = m_hubs[m_legacy_pairs[i * 2 + 0]];
+        Hub& a2 = m_hubs[m_legacy_pairs[i * 2 + 1]];
+        Hub& b1 = m_hubs[m_legacy_pairs[i * 2 + 2]];
+        Hub& b2 = m_hubs[m_legacy_pairs[i * 2 + 3]];
+        if (a1.detached)
+            a1.speed = a2.speed;
+        if (a2.detached)
+            a2.speed = a1.speed;
+        if (b1.detached)
+            b1.speed = b2.speed;
+        if (b2.detached)
+            b2.speed = b1.speed;
+
+        float speed1 = (a1.speed + a2.speed) * 0.5f;
+        float speed2 = (b1.speed + b2.speed) * 0.5f;
+        float torque = (speed1 - speed2) * 10000.0f;
+
+        m_shaft_torque[i * 2 + 0] -= torque * 0.5f;
+        m_shaft_torque[i * 2 + 1] -= torque * 0.5f;
+        m_shaft_torque[i * 2 + 2] += torque * 0.5f;
+        m_shaft_torque[i * 2 + 3] += torque * 0.5f;
+    }
+}
+
+void Drivetrain::SolveDifferentials(float engine_torque, float dt)
+{
+    // inter-axle torque: torsion keeping the axles aligned with each other as if they were connected by a shaft
+    for (size_t i = 1; i < m_diffs.size(); i++)
+    {
+        Differential& prev = m_diffs[i - 1];
+        Differential& cur = m_diffs[i];
+        Hub& p1 = m_hubs[prev.hub_1];
+        Hub& p2 = m_hubs[prev.hub_2];
+        Hub& c1 = m_hubs[cur.hub_1];
+        Hub& c2 = m_hubs[cur.hub_2];
+
+        if (p1.detached)
+            p1.speed = p2.speed;
+        if (c1.detached)
+            c1.speed = c2.speed;
+        if (p2.detached)
+            p2.speed = p1.speed;
+        if (c2.detached)
+            c2.speed = c1.speed;
+
+        if (p1.detached && p2.detached)
+        {
+            p1.speed = c1.speed;
+            p2.speed = c2.speed;
+        }
+        if (c1.detached && c2.detached)
+        {
+            c1.speed = p1.speed;
+            c2.speed = p2.speed;
+        }
+
+        DifferentialData diff_data =
+        {
+            { (p1.speed + p2.speed) * 0.5f, (c1.speed + c2.speed) * 0.5f },
+            prev.shaft_rotation,
+            { 0.f, 0.f },
+            0, // no input torque, just calculate forces from different axle positions
+            dt
+        };
+
+        // use the locked diff, most vehicles are setup this way...
+        CalcLockedDiff(diff_data);
+
+        prev.shaft_rotation = diff_data.delta_rotation;
+        cur.shaft_rotation = -diff_data.delta_rotation;
+
+        m_shaft_torque[prev.hub_1] = diff_data.out_torque[0];
+        m_shaft_torque[prev.hub_2] = diff_data.out_torque[0];
+        m_shaft_torque[cur.hub_1] = diff_data.out_torque[1];
+        m_shaft_torque[cur.hub_2] = diff_data.out_torque[1];
+    }
+
+    // axle differentials
+    for (Differential& diff : m_diffs)
+    {
+        Hub& h1 = m_hubs[diff.hub_1];
+        Hub& h2 = m_hubs[diff.hub_2];
+        if (h1.detached)
+            h1.speed = h2.speed;
+        if (h2.detached)
+            h2.speed = h1.speed;
+
+        DifferentialData diff_data =
+        {
+            { h1.speed, h2.speed },
+            h1.delta_rotation,
+            { 0.f, 0.f },
+            // twice the torque since this is for two wheels, plus extra torque from
+            // inter-axle torsion
+            2.0f * engine_torque + m_shaft_torque[diff.hub_1],
+            dt
+        };
+
+        if (diff.enabled)
+        {
+            switch (diff.type)
+            {
+            case SPLIT_DIFF:   CalcSplitDiff(diff_data);   break;
+            case OPEN_DIFF:    CalcOpenDiff(diff_data);    break;
+            case LOCKED_DIFF:  CalcLockedDiff(diff_data);  break;
+            }
+        }
+
+        h1.delta_rotation = diff_data.delta_rotation;
+        h2.delta_rotation = -diff_data.delta_rotation;
+
+        m_shaft_torque[diff.hub_1] = diff_data.out_torque[0];
+        m_shaft_torque[diff.hub_2] = diff_data.out_torque[1];
+    }
+}
+
+void Drivetrain::Solve(Controls const& in, DrivingAids const& aids, float* out_torque)
+{
+    // calculate torque per wheel
+    const float engine_torque = (m_num_propulsed != 0) ? in.engine_torque / m_num_propulsed : 0.f;
+    const bool legacy = m_diffs.empty();
+
+    std::fill(m_shaft_torque.begin(), m_shaft_torque.end(), 0.f);
+    if (legacy)
+        this->SolveLegacyCouplings();
+    else
+        this->SolveDifferentials(engine_torque, in.dt);
+
+    // driving aids traction control & anti-lock brake pulse
+    m_tc_timer += in.dt;
+    m_alb_timer += in.dt;
+
+    if (m_alb_timer >= aids.alb_pulse_time)
+    {
+        m_alb_timer = 0.0f;
+        m_alb_pulse_state = !m_alb_pulse_state;
+    }
+    if (m_tc_timer >= aids.tc_pulse_time)
+    {
+        m_tc_timer = 0.0f;
+        m_tc_pulse_state = !m_tc_pulse_state;
+    }
+
+    m_tc_active = false;
+    m_alb_active = false;
+    float curspeed = in.vehicle_speed;
+    int propcounter = 0;
+
+    for (int i = 0; i < static_cast<int>(m_hubs.size()); i++)
+    {
+        Hub& hub = m_hubs[i];
+
+        // total torque estimation
+        float total_torque = 0.0f;
+        if (hub.propulsed)
+        {
+            total_torque = legacy ? engine_torque : m_shaft_torque[i];
+        }
+
+        if (hub.brakes != BRAKE_NONE)
+        {
+            // handbrake
+            float hbrake = 0.0f;
+
+            if (in.parking_brake && (hub.brakes & BRAKE_HAND))
+            {
+                hbrake = in.handbrake_force;
+            }
+
+            // directional braking
+            float dbrake = 0.0f;
+
+            if ((in.wheel_speed < 20.0f)
+                && (((hub.brakes & BRAKE_SKID_LEFT)  && (in.steering > 0.0f))
+                 || ((hub.brakes & BRAKE_SKID_RIGHT) && (in.steering < 0.0f))))
+            {
+                dbrake = in.brake_force * std::fabs(in.steering);
+            }
+
+            if ((in.brake != 0.0f || dbrake != 0.0f || hbrake != 0.0f) && m_num_braked != 0 && std::fabs(hub.speed) > 0.0f)
+            {
+                float brake_coef = 1.0f;
+                float antilock_coef = 1.0f;
+                // anti-lock braking
+                if (aids.alb_mode && m_alb_pulse_state && (in.brake > 0.0f || dbrake > 0.0f) && curspeed > std::fabs(hub.speed) && curspeed > aids.alb_minspeed)
+                {
+                    antilock_coef = std::fabs(hub.speed) / curspeed;
+                    antilock_coef = std::pow(antilock_coef, aids.alb_ratio);
+                    m_alb_active = (antilock_coef < 0.9f);
+                }
+                if (std::fabs(hub.speed) < 1.0f)
+                {
+                    if (hub.first_lock)
+                    {
+                        hub.avg_speed = 0.0f;
+                        hub.first_lock = false;
+                    }
+                    // anti-jitter
+                    if (std::fabs(hub.avg_speed) < 2.0f)
+                    {
+                        brake_coef = std::pow(std::fabs(hub.speed), 2.0f);
+                    }
+                    else
+                    {
+                        brake_coef = std::pow(std::fabs(hub.speed), 0.5f);
+                    }
+                    // anti-skidding
+                    hub.avg_speed += hub.speed;
+                    hub.avg_speed = std::max(-10.0f, std::min(hub.avg_speed, 10.0f));
+                    float speed_diff = hub.speed - hub.last_speed;
+                    float speed_prediction = hub.speed + 0.5f * speed_diff;
+                    if (speed_prediction * hub.avg_speed < 0.0f)
+                    {
+                        brake_coef = 0.0f;
+                    }
+                }
+                else
+                {
+                    hub.first_lock = true;
+                }
+
+                if (hub.speed > 0)
+                    total_torque -= ((in.brake + dbrake) * antilock_coef + hbrake) * brake_coef;
+                else
+                    total_torque += ((in.brake + dbrake) * antilock_coef + hbrake) * brake_coef;
+            }
+        }
+        else
+        {
+            hub.first_lock = true;
+        }
+
+        // traction control
+        if (aids.tc_mode && m_tc_pulse_state && hub.propulsed && in.acceleration > 0.0f && std::fabs(hub.speed) > curspeed)
+        {
+            curspeed = std::max(0.5f, curspeed);
+
+            // tc_wheelslip = allowed amount of slip in percent
+            float wheelslip = 1.0f + aids.tc_wheelslip;
+            // wheelslip allowed doubles up to tc_fade, a tribute to RoRs wheelspeed calculation and friction
+            wheelslip += aids.tc_wheelslip * (curspeed / aids.tc_fade);
+
+            if (std::fabs(hub.speed) > curspeed * wheelslip)
+            {
+                float torque_coef = (curspeed * wheelslip) / std::fabs(hub.speed);
+                torque_coef = std::pow(torque_coef, aids.tc_ratio);
+                total_torque *= torque_coef;
+                m_tc_active = (torque_coef < 0.9f);
+            }
+        }
+
+        // old-style
+        if (legacy && hub.propulsed)
+        {
+            // differential locking
+            if (i % 2)
+            {
+                if (!hub.detached && !m_hubs[i - 1].detached)
+                    total_torque -= (hub.speed - m_hubs[i - 1].speed) * 10000.0f;
+                else if (i + 1 < static_cast<int>(m_hubs.size()) && !hub.detached && !m_hubs[i + 1].detached)
+                    total_torque -= (hub.speed - m_hubs[i + 1].speed) * 10000.0f;
+            }
+            // inter differential locking
+            total_torque += m_shaft_torque[propcounter];
+            propcounter++;
+        }
+
+        out_torque[i] = total_torque;
+    }
+}
+
+void Drivetrain::CalcSplitDiff(DifferentialData& diff_data)
+{
+    diff_data.out_torque[0] = diff_data.out_torque[1] = diff_data.in_torque;
+}
+
+
+void Drivetrain::CalcOpenDiff(DifferentialData& diff_data)
+{
+    /* Open differential calculations *************************
+     * These calculation are surprisingly tricky
+     * the power ratio is based on normalizing the speed of the
+     * wheel. Normalizing is when the sum of all values equals
+     * one. more detail provided below
+     */
+
+    // velocity at which open diff calculations are used 100%
+    // this value is twice the speed of the actual threshold
+    // the factor of 2 comes from finding the average speed and
+    // is done so to remove unessecary calculations
+    const float threshold_vel = 10.0f;
+
+    // combined total velocity
+    const float sum_of_vel =
+        std::fabs(diff_data.speed[0]) + std::fabs(diff_data.speed[1]);
+
+    // normalizing the wheel speeds the wheels to sputter at near 0
+    // speeds, to over come this we gradually transition from even
+    // power distribution to splitting power based on speed. The
+    // Transition ratio defines how much of each formula we take from,
+    // Until a threshold has been reached
+    const float transition_ratio = (sum_of_vel / threshold_vel < 1) ?
+                                            sum_of_vel / threshold_vel : 1;
+
+    // normalize the wheel speed, at a speed of 0 power is split evenly
+    const float power_ratio = (std::fabs(sum_of_vel) > 0.0) ?
+                                       std::fabs(diff_data.speed[0]) / sum_of_vel : 0.5;
+
+    diff_data.out_torque[0] = diff_data.out_torque[1] = diff_data.in_torque;
+
+    // Diff model taken from Torcs, ror needs to model reaction torque for this to work.
+    //const float spider_acc = (diff_data.speed[0] - diff_data.speed[1])/diff_data.dt;
+    //DrTq0 = DrTq*0.5f + spiderTq;
+    //DrTq1 = DrTq*0.5f - spiderTq;
+
+    // get the final ratio based on the speed of the wheels
+    diff_data.out_torque[0] *= 2 * (transition_ratio * power_ratio + (1 - transition_ratio) * 0.5f);
+    diff_data.out_torque[1] *= 2 * (transition_ratio * (1 - power_ratio) + (1 - transition_ratio) * 0.5f);
+
+    diff_data.delta_rotation = 0.0f;
+}
+
+void Drivetrain::CalcLockedDiff(DifferentialData& diff_data)
+{
+    /* Locked axle calculation ********************************
+     * This is straight forward, two wheels are joined together
+     * by a torsion spring. the torsion spring keeps the two
+     * wheels in the same orientation as when they were first
+     * locked.
+     */
+
+    // Torsion spring rate that holds axles together when locked
+    // keep as variable for now since this value will be user configurable
+    const float torsion_rate = 1000000.0f;
+    const float torsion_damp = torsion_rate / 100.0f;
+    const float delta_speed = diff_data.speed[0] - diff_data.speed[1];
+
+    diff_data.out_torque[0] = diff_data.out_torque[1] = diff_data.in_torque;
+
+    // derive how far wheels traveled relative to each during the last time step
+    diff_data.delta_rotation += (delta_speed) * diff_data.dt;
+
+    // torque cause by axle shafts
+    diff_data.out_torque[0] -= diff_data.delta_rotation * torsion_rate;
+    // damping
+    diff_data.out_torque[0] -= (delta_speed) * torsion_damp;
+
+    // torque cause by axle shafts
+    diff_data.out_torque[1] += diff_data.delta_rotation * torsion_rate;
+    // damping
+    diff_data.out_torque[1] -= -(delta_speed) * torsion_damp;
+}
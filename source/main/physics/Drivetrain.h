@@ -0,0 +1,152 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Driveline of an actor, modelled as a graph and solved once per physics step.
+///
+/// Torque flows: engine output shaft -> inter-axle shafts (or legacy paired-wheel couplings)
+/// -> axle differentials -> wheel hubs, where brakes, anti-lock brakes and traction control act.
+/// Clutch and gearbox are part of `EngineSim`; its output torque is the source of the graph.
+///
+/// Only plain data, no `Actor`: the caller copies wheel speeds in and applies the resulting
+/// hub torques to the wheel nodes. See source/microbenchmarks/Bench_Drivetrain.cpp.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct DifferentialData
+{
+    float speed[2];
+    float delta_rotation; // sign is first relative to the second
+    float out_torque[2];
+    float in_torque;
+    float dt;
+};
+
+enum DiffType
+{
+    SPLIT_DIFF = 0,
+    OPEN_DIFF,
+    LOCKED_DIFF
+};
+
+namespace RoR {
+
+class Drivetrain
+{
+public:
+    enum HubBrakes: uint8_t
+    {
+        BRAKE_NONE       = 0,
+        BRAKE_FOOT       = 1 << 0,
+        BRAKE_HAND       = 1 << 1,
+        BRAKE_SKID_LEFT  = 1 << 2, //!< Directional brake; active when steering left
+        BRAKE_SKID_RIGHT = 1 << 3, //!< Directional brake; active when steering right
+    };
+
+    struct Hub
+    {
+        float   speed;          //!< In: tyre speed (m/s); detached wheels get their axle partner's speed
+        float   last_speed;     //!< In: speed in previous step
+        float   avg_speed;      //!< State: brake anti-skid
+        float   delta_rotation; //!< State: rotation relative to the other wheel of the axle (locked differential wind-up)
+        uint8_t brakes;         //!< HubBrakes flags
+        bool    propulsed;
+        bool    detached;       //!< In
+        bool    first_lock;     //!< State: brake anti-skid
+    };
+
+    struct Differential //!< Axle differential; consecutive axles are also linked by a locked shaft
+    {
+        int      hub_1;
+        int      hub_2;
+        DiffType type;
+        bool     enabled;        //!< No torque at all if false (axle without differential types)
+        float    shaft_rotation; //!< State: wind-up of the shaft to the next axle
+    };
+
+    struct Controls //!< Inputs, every step
+    {
+        float engine_torque;    //!< Total, at the output shaft
+        float brake;            //!< Footbrake torque
+        float brake_force;      //!< Max footbrake torque; directional brakes use it
+        float handbrake_force;
+        bool  parking_brake;
+        float steering;         //!< -1 (right) ... 1 (left)
+        float wheel_speed;      //!< Average of driven wheels, last step (m/s)
+        float vehicle_speed;    //!< Reference node (m/s)
+        float acceleration;     //!< Throttle 0-1
+        float dt;
+    };
+
+    struct DrivingAids
+    {
+        bool  alb_mode;
+        float alb_ratio;
+        float alb_minspeed;
+        float alb_pulse_time;
+        bool  tc_mode;
+        float tc_ratio;
+        float tc_wheelslip;
+        float tc_fade;
+        float tc_pulse_time;
+    };
+
+    Drivetrain();
+
+    // Setup
+    void  AddHub(bool propulsed, uint8_t brakes);
+    void  AddDifferential(int hub_1, int hub_2, DiffType type, bool enabled);
+    void  SetDifferentialType(int index, DiffType type) { m_diffs[index].type = type; }
+    void  SetLegacyPairs(const int* pairs, int count); //!< Used when there are no differentials; see `Actor::m_proped_wheel_pairs`
+
+    /// @param out_torque Per hub; torque to apply around the wheel axis
+    void  Solve(Controls const& in, DrivingAids const& aids, float* out_torque);
+
+    Hub&  GetHub(int index)                    { return m_hubs[index]; }
+    Hub const& GetHub(int index) const         { return m_hubs[index]; }
+    int   GetNumHubs() const                   { return static_cast<int>(m_hubs.size()); }
+    bool  IsAntiLockActive() const             { return m_alb_active; } //!< During the last `Solve()`
+    bool  IsTractionControlActive() const      { return m_tc_active; }
+
+    static void CalcSplitDiff(DifferentialData& diff_data);  //!< a differential that always splits the torque evenly, this is the original method
+    static void CalcOpenDiff(DifferentialData& diff_data);   //!< more power goes to the faster spining wheel
+    static void CalcLockedDiff(DifferentialData& diff_data); //!< ensures both wheels rotate at the the same speed
+
+private:
+    void  SolveLegacyCouplings();
+    void  SolveDifferentials(float engine_torque, float dt);
+
+    std::vector<Hub>          m_hubs;
+    std::vector<Differential> m_diffs;
+    std::vector<int>          m_legacy_pairs;
+    std::vector<float>        m_shaft_torque; //!< Scratch, per hub
+    int                       m_num_propulsed;
+    int                       m_num_braked;
+    float                     m_alb_timer;
+    float                     m_tc_timer;
+    bool                      m_alb_pulse_state;
+    bool                      m_tc_pulse_state;
+    bool                      m_alb_active;
+    bool                      m_tc_active;
+};
+
+} // namespace RoR
@@ -0,0 +1,209 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RailBvh.h"
+
+#include "BeamData.h"
+#include "SlideNode.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Ogre;
+using namespace RoR;
+
+void RailBvh::Build(std::vector<Entry> const& entries)
+{
+    m_entries = entries;
+    const int count = static_cast<int>(m_entries.size());
+    m_indices.resize(count);
+    for (int i = 0; i < count; i++)
+        m_indices[i] = i;
+
+    this->UpdateBounds();
+    m_updates_since_build = 0;
+    m_elements.clear();
+    m_elements.reserve(count > 0 ? (2 * count / LEAF_SIZE + 1) : 0);
+    if (count > 0)
+        this->BuildElement(0, count);
+}
+
+void RailBvh::Update()
+{
+    if (m_updates_since_build >= REBUILD_INTERVAL)
+    {
+        std::vector<Entry> entries;
+        entries.swap(m_entries);
+        this->Build(entries);
+    }
+    else
+    {
+        m_updates_since_build++;
+        this->UpdateBounds();
+        this->Refit();
+    }
+}
+
+void RailBvh::UpdateBounds()
+{
+    m_lo.resize(m_entries.size());
+    m_hi.resize(m_entries.size());
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        const beam_t* beam = m_entries[i].segment->rs_beam;
+        m_lo[i] = m_hi[i] = beam->p1->AbsPosition;
+        m_lo[i].makeFloor(beam->p2->AbsPosition);
+        m_hi[i].makeCeil(beam->p2->AbsPosition);
+    }
+}
+
+int RailBvh::BuildElement(int first, int count)
+{
+    int index = static_cast<int>(m_elements.size());
+    m_elements.push_back(Element());
+
+    Vector3 lo(std::numeric_limits<float>::max());
+    Vector3 hi(-std::numeric_limits<float>::max());
+    for (int i = first; i < first + count; i++)
+    {
+        lo.makeFloor(m_lo[m_indices[i]]);
+        hi.makeCeil(m_hi[m_indices[i]]);
+    }
+    m_elements[index].lo = lo;
+    m_elements[index].hi = hi;
+
+    if (count <= LEAF_SIZE)
+    {
+        m_elements[index].first = first;
+        m_elements[index].count = count;
+        m_elements[index].right = -1;
+        return index;
+    }
+
+    // Median split of segment midpoints along the longest axis
+    Vector3 extent = hi - lo;
+    int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+    int half = count / 2;
+    std::nth_element(m_indices.begin() + first, m_indices.begin() + first + half, m_indices.begin() + first + count,
+        [this, axis](int a, int b) { return (m_lo[a][axis] + m_hi[a][axis]) < (m_lo[b][axis] + m_hi[b][axis]); });
+
+    this->BuildElement(first, half);
+    int right = this->BuildElement(first + half, count - half);
+
+    m_elements[index].first = first;
+    m_elements[index].count = 0;
+    m_elements[index].right = right;
+    return index;
+}
+
+void RailBvh::Refit()
+{
+    // Children always follow their parent, so a reverse sweep visits children first.
+    for (int e = static_cast<int>(m_elements.size()) - 1; e >= 0; e--)
+    {
+        Element& elem = m_elements[e];
+        if (elem.count > 0)
+        {
+            elem.lo = m_lo[m_indices[elem.first]];
+            elem.hi = m_hi[m_indices[elem.first]];
+            for (int i = elem.first + 1; i < elem.first + elem.count; i++)
+            {
+                elem.lo.makeFloor(m_lo[m_indices[i]]);
+                elem.hi.makeCeil(m_hi[m_indices[i]]);
+            }
+        }
+        else
+        {
+            elem.lo = m_elements[e + 1].lo;
+            elem.hi = m_elements[e + 1].hi;
+            elem.lo.makeFloor(m_elements[elem.right].lo);
+            elem.hi.makeCeil(m_elements[elem.right].hi);
+        }
+    }
+}
+
+static float SquaredDistanceToBox(Vector3 const& point, Vector3 const& lo, Vector3 const& hi)
+{
+    Vector3 d(0.f, 0.f, 0.f);
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (point[axis] < lo[axis])
+            d[axis] = lo[axis] - point[axis];
+        else if (point[axis] > hi[axis])
+            d[axis] = point[axis] - hi[axis];
+    }
+    return d.squaredLength();
+}
+
+const RailBvh::Entry* RailBvh::FindClosest(Vector3 const& point, float max_dist, float& out_dist, std::function<bool(Actor*)> const& accept) const
+{
+    if (m_elements.empty())
+        return nullptr;
+
+    const Entry* best_entry = nullptr;
+    float best_dist = max_dist;
+
+    int stack[64];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        const int index = stack[--stack_size];
+        const Element& elem = m_elements[index];
+        if (SquaredDistanceToBox(point, elem.lo, elem.hi) >= best_dist * best_dist)
+            continue;
+
+        if (elem.count > 0)
+        {
+            for (int i = elem.first; i < elem.first + elem.count; i++)
+            {
+                const Entry& entry = m_entries[m_indices[i]];
+                if (SquaredDistanceToBox(point, m_lo[m_indices[i]], m_hi[m_indices[i]]) >= best_dist * best_dist)
+                    continue;
+                const float dist = SlideNode::getLenTo(entry.segment, point);
+                if (dist >= best_dist)
+                    continue;
+                if (accept && !accept(entry.actor))
+                    continue;
+                best_dist = dist;
+                best_entry = &entry;
+            }
+        }
+        else // Visit the nearer child first; median split keeps the tree balanced, the stack can't overflow
+        {
+            const float left_dist = SquaredDistanceToBox(point, m_elements[index + 1].lo, m_elements[index + 1].hi);
+            const float right_dist = SquaredDistanceToBox(point, m_elements[elem.right].lo, m_elements[elem.right].hi);
+            if (left_dist < right_dist)
+            {
+                stack[stack_size++] = elem.right;
+                stack[stack_size++] = index + 1;
+            }
+            else
+            {
+                stack[stack_size++] = index + 1;
+                stack[stack_size++] = elem.right;
+            }
+        }
+    }
+
+    if (best_entry != nullptr)
+        out_dist = best_dist;
+    return best_entry;
+}
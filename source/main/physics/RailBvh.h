@@ -0,0 +1,84 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Spatial index of slide-node rail segments of all actors, for rail attachment queries.
+///
+/// Same scheme as `NodeBvh`: topology is built from segment midpoints and then refitted as the
+/// actors move. Per-step tracking along a rail (`RailSegment::CheckCurSlideSegment()`) doesn't use it.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <OgreVector3.h>
+
+#include <functional>
+#include <vector>
+
+namespace RoR {
+
+class RailBvh
+{
+public:
+    struct Entry
+    {
+        RailSegment* segment;
+        RailGroup*   group;
+        Actor*       actor;
+    };
+
+    RailBvh(): m_updates_since_build(0) {}
+
+    void Build(std::vector<Entry> const& entries); //!< New topology; call when the set of rails changes
+    void Update();                                 //!< Refits to current beam positions, periodically rebuilds
+
+    /// Finds the segment nearest to `point` (distance to the beam, as `SlideNode::getLenTo()`)
+    /// @param accept Optional actor filter
+    /// @return Matching entry closer than `max_dist`, or nullptr
+    const Entry* FindClosest(Ogre::Vector3 const& point, float max_dist, float& out_dist,
+                             std::function<bool(Actor*)> const& accept = nullptr) const;
+
+    size_t GetNumSegments() const { return m_entries.size(); }
+
+private:
+    static const int LEAF_SIZE = 4;
+    static const int REBUILD_INTERVAL = 50; //!< Updates between full rebuilds
+
+    struct Element
+    {
+        Ogre::Vector3 lo, hi;
+        int first;        //!< Leaf: index into `m_indices`
+        int count;        //!< Leaf: number of segments; 0 = inner element
+        int right;        //!< Inner: index of right child; left child is always the next element
+    };
+
+    int  BuildElement(int first, int count);
+    void Refit();
+    void UpdateBounds();
+
+    std::vector<Element>       m_elements;  //!< Depth-first order; children always follow parents
+    std::vector<Entry>         m_entries;
+    std::vector<int>           m_indices;
+    std::vector<Ogre::Vector3> m_lo;        //!< Per entry, segment bounds
+    std::vector<Ogre::Vector3> m_hi;
+    int                        m_updates_since_build;
+};
+
+} // namespace RoR
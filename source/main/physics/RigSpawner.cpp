@@ -333,9 +333,7 @@ void ActorSpawner::InitializeRig()
     m_actor->alb_notoggle = false;
     m_actor->alb_present = false;
     m_actor->alb_pulse_time = 2000.0f;
-    m_actor->alb_pulse_state = false;
     m_actor->alb_ratio = 0.0f;
-    m_actor->alb_timer = 0.0f;
     m_actor->ar_anim_shift_timer = 0.0f;
 
     m_actor->m_cab_mesh = nullptr;
@@ -365,10 +363,8 @@ void ActorSpawner::InitializeRig()
     m_actor->tc_notoggle = false;
     m_actor->tc_present = false;
     m_actor->tc_pulse_time = 2000.0f;
-    m_actor->tc_pulse_state = false;
     m_actor->tc_ratio = 0.f;
     m_actor->tc_wheelslip = 0.f;
-    m_actor->tc_timer = 0.f;
 
     m_actor->ar_dashboard = new DashBoardManager();
 
@@ -382,13 +378,13 @@ void ActorSpawner::InitializeRig()
     m_actor->ar_disable_actor2actor_collision = BSETTING("DisableCollisions", false);
     if (! m_actor->ar_disable_actor2actor_collision)
     {
-        m_actor->m_inter_point_col_detector = new PointColDetector();
+        m_actor->m_inter_point_col_detector = m_actor->m_memory.NewZeroed<PointColDetector>();
     }
 
     m_actor->ar_disable_self_collision = BSETTING("DisableSelfCollisions", false);
     if (! m_actor->ar_disable_self_collision)
     {
-        m_actor->m_intra_point_col_detector = new PointColDetector();
+        m_actor->m_intra_point_col_detector = m_actor->m_memory.NewZeroed<PointColDetector>();
     }
 
     m_actor->ar_submesh_ground_model = gEnv->collisions->defaultgm;
@@ -401,9 +397,9 @@ void ActorSpawner::InitializeRig()
     m_actor->m_particles_splash = dustman.getDustPool("splash");
     m_actor->m_particles_ripple = dustman.getDustPool("ripple");
 
-    m_actor->m_command_inertia   = new CmdKeyInertia();
-    m_actor->m_hydro_inertia = new CmdKeyInertia();
-    m_actor->m_rotator_inertia  = new CmdKeyInertia();
+    m_actor->m_command_inertia   = m_actor->m_memory.NewZeroed<CmdKeyInertia>();
+    m_actor->m_hydro_inertia = m_actor->m_memory.NewZeroed<CmdKeyInertia>();
+    m_actor->m_rotator_inertia  = m_actor->m_memory.NewZeroed<CmdKeyInertia>();
 
     // Lights mode
     m_actor->m_flares_mode = App::gfx_flares_mode.GetActive();
@@ -459,6 +455,30 @@ void ActorSpawner::FinalizeRig()
         m_actor->ar_engine->SetAutoMode(App::sim_gearbox_mode.GetActive());
     }
     
+    // Driveline graph, solved every physics step
+    for (int i = 0; i < m_actor->ar_num_wheels; i++)
+    {
+        uint8_t brakes = RoR::Drivetrain::BRAKE_NONE;
+        switch (m_actor->ar_wheels[i].wh_braking)
+        {
+        case wheel_t::BrakeCombo::FOOT_HAND:            brakes = RoR::Drivetrain::BRAKE_FOOT | RoR::Drivetrain::BRAKE_HAND; break;
+        case wheel_t::BrakeCombo::FOOT_HAND_SKID_LEFT:  brakes = RoR::Drivetrain::BRAKE_FOOT | RoR::Drivetrain::BRAKE_HAND | RoR::Drivetrain::BRAKE_SKID_LEFT; break;
+        case wheel_t::BrakeCombo::FOOT_HAND_SKID_RIGHT: brakes = RoR::Drivetrain::BRAKE_FOOT | RoR::Drivetrain::BRAKE_HAND | RoR::Drivetrain::BRAKE_SKID_RIGHT; break;
+        case wheel_t::BrakeCombo::FOOT_ONLY:            brakes = RoR::Drivetrain::BRAKE_FOOT; break;
+        default:;
+        }
+        m_actor->m_drivetrain.AddHub(m_actor->ar_wheels[i].wh_propulsed > 0, brakes);
+    }
+    for (int i = 0; i < m_actor->m_num_axles; i++)
+    {
+        Axle* axle = m_actor->m_axles[i];
+        if (axle->ax_wheel_1 < 0 || axle->ax_wheel_2 < 0)
+            continue; // Already reported by `ProcessAxle()`
+        m_actor->m_drivetrain.AddDifferential(axle->ax_wheel_1, axle->ax_wheel_2,
+            axle->HasDifferential() ? axle->GetActiveDifferential() : SPLIT_DIFF, axle->HasDifferential());
+    }
+    m_actor->m_drivetrain.SetLegacyPairs(m_actor->m_proped_wheel_pairs, m_actor->m_num_proped_wheels);
+
     //calculate gwps height offset
     //get a starting value
     m_actor->ar_posnode_spawn_height=m_actor->ar_nodes[0].RelPosition.y;
@@ -620,6 +640,7 @@ void ActorSpawner::FinalizeRig()
     this->UpdateCollcabContacterNodes();
 
     m_flex_factory.SaveFlexbodiesToCache();
+    m_flex_factory.FinalizeActorTemplate();
 
     this->FinalizeGfxSetup(); // Creates the GfxActor
 }
@@ -685,7 +706,7 @@ void ActorSpawner::ProcessTurbojet(RigDef::Turbojet & def)
     back  = GetNodeIndexOrThrow(def.back_node);
     ref   = GetNodeIndexOrThrow(def.side_node);
     
-    Turbojet *tj=new Turbojet(
+    Turbojet *tj=m_actor->m_memory.NewZeroed<Turbojet>(
         m_actor->ar_num_aeroengines, 
         m_actor->ar_instance_id, 
         m_actor->ar_nodes, 
@@ -749,7 +770,7 @@ void ActorSpawner::ProcessScrewprop(RigDef::Screwprop & def)
     int back_node_idx = GetNodeIndexOrThrow(def.back_node);
     int top_node_idx = GetNodeIndexOrThrow(def.top_node);
 
-    m_actor->ar_screwprops[m_actor->ar_num_screwprops] = new Screwprop(
+    m_actor->ar_screwprops[m_actor->ar_num_screwprops] = m_actor->m_memory.NewZeroed<Screwprop>(
         &RoR::App::GetSimController()->GetBeamFactory()->GetParticleManager(),
         m_actor->ar_nodes,
         ref_node_idx,
@@ -782,7 +803,7 @@ void ActorSpawner::ProcessFusedrag(RigDef::Fusedrag & def)
         factor = def.area_coefficient;
         width  =  (m_fuse_z_max - m_fuse_z_min) * (m_fuse_y_max - m_fuse_y_min) * factor;
 
-        m_actor->m_fusealge_airfoil = new Airfoil(fusefoil);
+        m_actor->m_fusealge_airfoil = m_actor->m_memory.NewZeroed<Airfoil>(fusefoil);
 
         m_actor->m_fusealge_front   = & GetNode(front_node_idx);
         m_actor->m_fusealge_back    = & GetNode(front_node_idx); // This equals v0.38 / v0.4.0.7, but it's probably a bug
@@ -795,7 +816,7 @@ void ActorSpawner::ProcessFusedrag(RigDef::Fusedrag & def)
 
         width  = def.approximate_width;
 
-        m_actor->m_fusealge_airfoil = new Airfoil(fusefoil);
+        m_actor->m_fusealge_airfoil = m_actor->m_memory.NewZeroed<Airfoil>(fusefoil);
 
         m_actor->m_fusealge_front   = & GetNode(front_node_idx);
         m_actor->m_fusealge_back    = & GetNode(front_node_idx); // This equals v0.38 / v0.4.0.7, but it's probably a bug
@@ -819,7 +840,7 @@ void ActorSpawner::BuildAerialEngine(
 {
     SPAWNER_PROFILE_SCOPED();
 
-    Turboprop *turbo_prop = new Turboprop(
+    Turboprop *turbo_prop = m_actor->m_memory.NewZeroed<Turboprop>(
         this->ComposeName("Turboprop", m_actor->ar_num_aeroengines).c_str(),
         m_actor->ar_nodes, 
         ref_node_index,
@@ -924,7 +945,7 @@ void ActorSpawner::ProcessAirbrake(RigDef::Airbrake & def)
         return;
     }
 
-    m_actor->ar_airbrakes[m_actor->ar_num_airbrakes] = new Airbrake(
+    m_actor->ar_airbrakes[m_actor->ar_num_airbrakes] = m_actor->m_memory.NewZeroed<Airbrake>(
         this->ComposeName("Airbrake", m_actor->ar_num_airbrakes).c_str(),
         m_actor->ar_num_airbrakes, 
         GetNodePointerOrThrow(def.reference_node), 
@@ -963,7 +984,7 @@ void ActorSpawner::ProcessWing(RigDef::Wing & def)
     }
 
     const std::string wing_name = this->ComposeName("Wing", m_actor->ar_num_wings);
-    auto flex_airfoil = new FlexAirfoil(
+    auto flex_airfoil = m_actor->m_memory.NewZeroed<FlexAirfoil>(
         wing_name,
         m_actor->ar_nodes,
         node_indices[0],
@@ -1000,8 +1021,7 @@ void ActorSpawner::ProcessWing(RigDef::Wing & def)
     catch (...)
     {
         this->AddMessage(Message::TYPE_ERROR, std::string("Failed to load mesh (flexbody wing): ") + wing_name);
-        delete flex_airfoil;
-        return;
+        return; // `flex_airfoil` is released with the actor's memory arena
     }
 
     // induced drag
@@ -2361,7 +2381,7 @@ void ActorSpawner::ProcessFlare2(RigDef::Flare2 & def)
     m_actor->ar_flares.push_back(flare);
 }
 
-Ogre::MaterialPtr ActorSpawner::InstantiateManagedMaterial(Ogre::String const & source_name, Ogre::String const & clone_name)
+Ogre::MaterialPtr ActorSpawner::InstantiateManagedMaterial(Ogre::String const & source_name, Ogre::String const & clone_name, std::string const & shared_key)
 {
     SPAWNER_PROFILE_SCOPED();
 
@@ -2374,6 +2394,11 @@ Ogre::MaterialPtr ActorSpawner::InstantiateManagedMaterial(Ogre::String const &
         return Ogre::MaterialPtr();
     }
 
+    if (!shared_key.empty())
+    {
+        m_shared_material_keys.push_back(shared_key);
+        return this->GetSharedMaterials().Create(shared_key, src_mat);
+    }
     return src_mat->clone(clone_name, true, m_custom_resource_group);
 }
 
@@ -2395,6 +2420,24 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
         m_placeholder_managedmat->clone(def.name);
     }
 
+    // Actors with identical definition and skin use the same instance, unless it's modified per-actor.
+    std::string shared_key;
+    if (!this->IsPerInstanceMaterial(def.name))
+    {
+        std::stringstream key_buf;
+        key_buf << def.name << "|" << def.type << "|" << def.diffuse_map << "|" << def.damaged_diffuse_map
+                << "|" << def.specular_map << "|" << def.options.double_sided;
+        shared_key = this->ComposeSharedMaterialKey("ManagedMaterial", key_buf.str());
+
+        Ogre::MaterialPtr shared_mat = this->GetSharedMaterials().Acquire(shared_key);
+        if (!shared_mat.isNull())
+        {
+            m_shared_material_keys.push_back(shared_key);
+            m_managed_materials.insert(std::make_pair(def.name, shared_mat));
+            return;
+        }
+    }
+
     std::string custom_name = def.name + ACTOR_ID_TOKEN + TOSTRING(m_actor->ar_instance_id);
     Ogre::MaterialPtr material;
     if (def.type == RigDef::ManagedMaterial::TYPE_FLEXMESH_STANDARD || def.type == RigDef::ManagedMaterial::TYPE_FLEXMESH_TRANSPARENT)
@@ -2409,7 +2452,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
             if (def.HasSpecularMap())
             {
                 /* FLEXMESH, damage, specular */
-                material = this->InstantiateManagedMaterial(mat_name_base + "/speculardamage", custom_name);
+                material = this->InstantiateManagedMaterial(mat_name_base + "/speculardamage", custom_name, shared_key);
                 if (material.isNull())
                 {
                     return;
@@ -2421,7 +2464,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
             else
             {
                 /* FLEXMESH, damage, no_specular */
-                material = this->InstantiateManagedMaterial(mat_name_base + "/damageonly", custom_name);
+                material = this->InstantiateManagedMaterial(mat_name_base + "/damageonly", custom_name, shared_key);
                 if (material.isNull())
                 {
                     return;
@@ -2435,7 +2478,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
             if (def.HasSpecularMap())
             {
                 /* FLEXMESH, no_damage, specular */
-                material = this->InstantiateManagedMaterial(mat_name_base + "/specularonly", custom_name);
+                material = this->InstantiateManagedMaterial(mat_name_base + "/specularonly", custom_name, shared_key);
                 if (material.isNull())
                 {
                     return;
@@ -2446,7 +2489,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
             else
             {
                 /* FLEXMESH, no_damage, no_specular */
-                material = this->InstantiateManagedMaterial(mat_name_base + "/simple", custom_name);
+                material = this->InstantiateManagedMaterial(mat_name_base + "/simple", custom_name, shared_key);
                 if (material.isNull())
                 {
                     return;
@@ -2465,7 +2508,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
         if (def.HasSpecularMap())
         {
             /* MESH, specular */
-            material = this->InstantiateManagedMaterial(mat_name_base + "/specular", custom_name);
+            material = this->InstantiateManagedMaterial(mat_name_base + "/specular", custom_name, shared_key);
             if (material.isNull())
             {
                 return;
@@ -2476,7 +2519,7 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
         else
         {
             /* MESH, no_specular */
-            material = this->InstantiateManagedMaterial(mat_name_base + "/simple", custom_name);
+            material = this->InstantiateManagedMaterial(mat_name_base + "/simple", custom_name, shared_key);
             if (material.isNull())
             {
                 return;
@@ -2500,6 +2543,10 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
 
     /* Finalize */
 
+    if (!shared_key.empty() && m_actor->m_used_skin != nullptr)
+    {
+        RoR::SkinManager::ReplaceMaterialTextures(m_actor->m_used_skin, material->getName()); // Only once, on creation
+    }
     material->compile();
     m_managed_materials.insert(std::make_pair(def.name, material));
 }
@@ -2556,7 +2603,7 @@ void ActorSpawner::ProcessAxle(RigDef::Axle & def)
     node_t *wheel_1_node_2 = GetNodePointerOrThrow(def.wheels[0][1]);
     node_t *wheel_2_node_1 = GetNodePointerOrThrow(def.wheels[1][0]);
     node_t *wheel_2_node_2 = GetNodePointerOrThrow(def.wheels[1][1]);
-    Axle *axle = new Axle();
+    Axle *axle = m_actor->m_memory.New<Axle>();
 
     if (! AssignWheelToAxle(axle->ax_wheel_1, wheel_1_node_1, wheel_1_node_2))
     {
@@ -2962,7 +3009,7 @@ RailGroup *ActorSpawner::CreateRail(std::vector<RigDef::Node::Range> & node_rang
     this->CollectNodesFromRanges(node_ranges, node_indices);
 
     // Build the rail
-    RailGroup* rg = new RailGroup();
+    RailGroup* rg = m_actor->m_memory.New<RailGroup>();
     for (unsigned int i = 0; i < node_indices.size() - 1; i++)
     {
         beam_t *beam = FindBeamInRig(node_indices[i], node_indices[i + 1]);
@@ -2971,8 +3018,7 @@ RailGroup *ActorSpawner::CreateRail(std::vector<RigDef::Node::Range> & node_rang
             std::stringstream msg;
             msg << "No beam between nodes indexed '" << node_indices[i] << "' and '" << node_indices[i + 1] << "'";
             AddMessage(Message::TYPE_ERROR, msg.str());
-            delete rg;
-            return nullptr;
+            return nullptr; // `rg` is released with the actor's memory arena
         }
         rg->rg_segments.emplace_back(beam);
     }
@@ -6912,9 +6958,17 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
                 Ogre::MaterialPtr skin_mat = RoR::OgreSubsystem::GetMaterialByName(skin_res->second);
                 if (!skin_mat.isNull())
                 {
-                    std::stringstream name_buf;
-                    name_buf << skin_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
-                    lookup_entry.material = skin_mat->clone(name_buf.str(), true, m_custom_resource_group);
+                    if (this->IsPerInstanceMaterial(mat_lookup_name))
+                    {
+                        std::stringstream name_buf;
+                        name_buf << skin_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+                        lookup_entry.material = skin_mat->clone(name_buf.str(), true, m_custom_resource_group);
+                    }
+                    else
+                    {
+                        lookup_entry.material = this->AcquireSharedMaterial(
+                            this->ComposeSharedMaterialKey("SkinMaterial", skin_res->second), skin_mat, /*apply_skin=*/false);
+                    }
                     m_material_substitutions.insert(std::make_pair(mat_lookup_name, lookup_entry));
                     return lookup_entry.material;
                 }
@@ -6928,6 +6982,7 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
         }
 
         // Acquire substitute - either use managedmaterial or generate new by cloning.
+        std::string skin_source_material; // Set for plain clones, which get the same texture swaps every spawn
         auto mmat_res = m_managed_materials.find(mat_lookup_name);
         if (mmat_res != m_managed_materials.end())
         {
@@ -6946,15 +7001,24 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
                 return Ogre::MaterialPtr(); // NULL
             }
 
-            std::stringstream name_buf;
-            name_buf << orig_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
-            lookup_entry.material = orig_mat->clone(name_buf.str(), true, m_custom_resource_group);
+            if (this->IsPerInstanceMaterial(mat_lookup_name))
+            {
+                std::stringstream name_buf;
+                name_buf << orig_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+                lookup_entry.material = orig_mat->clone(name_buf.str(), true, m_custom_resource_group);
+                skin_source_material = orig_mat->getName();
+            }
+            else
+            {
+                lookup_entry.material = this->AcquireSharedMaterial(
+                    this->ComposeSharedMaterialKey("Material", mat_lookup_name), orig_mat, /*apply_skin=*/true);
+            }
         }
 
-        // Finally, query SkinZip textures
-        if (m_actor->m_used_skin != nullptr)
+        // Finally, query SkinZip textures (shared materials got them on creation)
+        if (m_actor->m_used_skin != nullptr && !this->GetSharedMaterials().IsShared(lookup_entry.material))
         {
-            RoR::SkinManager::ReplaceMaterialTextures(m_actor->m_used_skin, lookup_entry.material->getName());
+            RoR::SkinManager::ReplaceMaterialTextures(m_actor->m_used_skin, lookup_entry.material->getName(), skin_source_material);
         }
 
         m_material_substitutions.insert(std::make_pair(mat_lookup_name, lookup_entry)); // Register the substitute
@@ -6973,16 +7037,65 @@ Ogre::MaterialPtr ActorSpawner::CreateSimpleMaterial(Ogre::ColourValue color)
 {
     assert(!m_simple_material_base.isNull());
 
-    static size_t simple_mat_counter = 0;
-    char name_buf[300];
-    snprintf(name_buf, 300, "SimpleMaterial-%u%s%d", simple_mat_counter, ACTOR_ID_TOKEN, m_actor->ar_instance_id);
-    Ogre::MaterialPtr newmat = m_simple_material_base->clone(name_buf);
-    ++simple_mat_counter;
+    char color_buf[100];
+    snprintf(color_buf, 100, "%f,%f,%f,%f", color.r, color.g, color.b, color.a);
+    Ogre::MaterialPtr newmat = this->AcquireSharedMaterial(
+        this->ComposeSharedMaterialKey("SimpleMaterial", color_buf), m_simple_material_base, /*apply_skin=*/false);
     newmat->getTechnique(0)->getPass(0)->setAmbient(color);
 
     return newmat;
 }
 
+bool ActorSpawner::IsPerInstanceMaterial(std::string const & material_name)
+{
+    if (this->FindFlareBindingForMaterial(material_name) != nullptr || // Toggled by lights
+        this->FindVideoCameraByMaterial(material_name) != nullptr)     // Own render texture
+    {
+        return true;
+    }
+
+    for (auto& module: m_selected_modules)
+    {
+        if (module->globals != nullptr && module->globals->material_name == material_name)
+        {
+            return true; // Cab material - emissive pass updated in-place, see `GfxActor::SetCabLightsActive()`
+        }
+    }
+    return false;
+}
+
+RoR::SharedMaterialCache& ActorSpawner::GetSharedMaterials()
+{
+    return App::GetSimController()->GetBeamFactory()->GetSharedMaterials();
+}
+
+std::string ActorSpawner::ComposeSharedMaterialKey(const char* type, std::string const & name)
+{
+    // Mods may reuse material and skin names, the resource group tells their textures apart
+    std::string key = std::string(type) + "|" + m_file->resource_group + "|" + name;
+    if (m_actor->m_used_skin != nullptr)
+    {
+        key += "|" + m_actor->m_used_skin->name;
+    }
+    return key;
+}
+
+Ogre::MaterialPtr ActorSpawner::AcquireSharedMaterial(std::string const & key, Ogre::MaterialPtr const & src, bool apply_skin)
+{
+    m_shared_material_keys.push_back(key);
+
+    Ogre::MaterialPtr mat = this->GetSharedMaterials().Acquire(key);
+    if (mat.isNull())
+    {
+        mat = this->GetSharedMaterials().Create(key, src);
+        if (apply_skin && m_actor->m_used_skin != nullptr)
+        {
+            RoR::SkinManager::ReplaceMaterialTextures(m_actor->m_used_skin, mat->getName());
+        }
+    }
+    return mat;
+}
+
 void ActorSpawner::SetupNewEntity(Ogre::Entity* ent, Ogre::ColourValue simple_color)
 {
     // Use simple materials if applicable
@@ -7024,6 +7137,8 @@ void ActorSpawner::FinalizeGfxSetup()
 
     // Create the actor
     m_actor->m_gfx_actor = std::unique_ptr<RoR::GfxActor>(new RoR::GfxActor(m_actor, m_custom_resource_group));
+    m_actor->m_gfx_actor->m_shared_material_cache = &this->GetSharedMaterials();
+    m_actor->m_gfx_actor->m_shared_material_keys = std::move(m_shared_material_keys);
 
     // Process special materials
     for (auto& entry: m_material_substitutions)
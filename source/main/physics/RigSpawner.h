@@ -121,6 +121,9 @@ public:
         int cache_entry_number = -1
         );
 
+    /// Optional; flexbody data is copied from the template (or captured into it, for the first instance).
+    void SetActorTemplate(RoR::ActorTemplate* actor_template) { m_flex_factory.SetActorTemplate(actor_template); }
+
     Actor *SpawnActor();
 
     /**
@@ -147,7 +150,7 @@ public:
     * Finds and clones given material. Reports errors.
     * @return NULL Ogre::MaterialPtr on error.
     */
-    Ogre::MaterialPtr InstantiateManagedMaterial(Ogre::String const & source_name, Ogre::String const & clone_name);
+    Ogre::MaterialPtr InstantiateManagedMaterial(Ogre::String const & source_name, Ogre::String const & clone_name, std::string const & shared_key);
 
     /**
     * Finds existing node by Node::Ref; throws an exception if the node doesn't exist.
@@ -926,6 +929,20 @@ private:
 
     Ogre::MaterialPtr CreateSimpleMaterial(Ogre::ColourValue color);
 
+    /**
+    * Materials modified per-actor at runtime (flares, cab lights, videocameras) can't be shared with other actors.
+    */
+    bool IsPerInstanceMaterial(std::string const & material_name);
+
+    RoR::SharedMaterialCache& GetSharedMaterials();
+
+    std::string ComposeSharedMaterialKey(const char* type, std::string const & name); ///< Includes the definition's resource group; appends skin name, if any
+
+    /**
+    * Finds or creates (by cloning `src`) a material shared by all actors with the same key. Reference is released by GfxActor.
+    */
+    Ogre::MaterialPtr AcquireSharedMaterial(std::string const & key, Ogre::MaterialPtr const & src, bool apply_skin);
+
     RigDef::MaterialFlareBinding* FindFlareBindingForMaterial(std::string const & material_name); ///< Returns NULL if none found
 
     RigDef::VideoCamera* FindVideoCameraByMaterial(std::string const & material_name); ///< Returns NULL if none found
@@ -1085,6 +1102,7 @@ private:
     std::map<Ogre::String, unsigned int>   m_named_nodes;
     std::map<std::string, CustomMaterial>  m_material_substitutions; //!< Maps original material names (shared) to their actor-specific substitutes; There's 1 substitute per 1 material, regardless of user count.
     std::map<std::string, Ogre::MaterialPtr>  m_managed_materials;
+    std::vector<std::string>               m_shared_material_keys; //!< References to `SharedMaterialCache`, handed over to GfxActor
     std::list<std::shared_ptr<RigDef::File::Module>>  m_selected_modules;
 
 };
@@ -24,7 +24,7 @@
 
 #include <OgreMesh.h>
 
-class Airbrake : public ZeroedMemoryAllocator
+class Airbrake
 {
     friend class RigInspector; // Debug utility class
 
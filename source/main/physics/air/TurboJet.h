@@ -23,7 +23,7 @@
 #include "RoRPrerequisites.h"
 #include "AeroEngine.h"
 
-class Turbojet: public AeroEngine, public ZeroedMemoryAllocator
+class Turbojet: public AeroEngine
 {
     friend class RigInspector;
 
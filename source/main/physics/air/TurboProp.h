@@ -24,7 +24,7 @@
 
 #include "AeroEngine.h"
 
-class Turboprop: public AeroEngine, public ZeroedMemoryAllocator
+class Turboprop: public AeroEngine
 {
     friend class RigInspector;
 
@@ -0,0 +1,258 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CapsuleSweep.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Ogre;
+using namespace RoR;
+
+static const int   MAX_ITERATIONS    = 32;
+static const float CONTACT_TOLERANCE = 0.001f; // Meters
+
+// Closest point routines after Ericson, Real-Time Collision Detection (5.1.5, 5.1.9)
+
+static Vector3 ClosestPointOnTriangle(Vector3 const& p, Vector3 const& a, Vector3 const& b, Vector3 const& c)
+{
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 ap = p - a;
+    const float d1 = ab.dotProduct(ap);
+    const float d2 = ac.dotProduct(ap);
+    if (d1 <= 0.f && d2 <= 0.f)
+        return a;
+
+    const Vector3 bp = p - b;
+    const float d3 = ab.dotProduct(bp);
+    const float d4 = ac.dotProduct(bp);
+    if (d3 >= 0.f && d4 <= d3)
+        return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+        return a + ab * (d1 / (d1 - d3));
+
+    const Vector3 cp = p - c;
+    const float d5 = ab.dotProduct(cp);
+    const float d6 = ac.dotProduct(cp);
+    if (d6 >= 0.f && d5 <= d6)
+        return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+        return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    const float denom = 1.f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+static float SegmentSegmentDistanceSq(Vector3 const& p1, Vector3 const& q1, Vector3 const& p2, Vector3 const& q2,
+                                      Vector3& out_c1, Vector3& out_c2)
+{
+    const Vector3 d1 = q1 - p1;
+    const Vector3 d2 = q2 - p2;
+    const Vector3 r = p1 - p2;
+    const float a = d1.squaredLength();
+    const float e = d2.squaredLength();
+    const float f = d2.dotProduct(r);
+    float s = 0.f;
+    float t = 0.f;
+
+    if (a <= 1e-12f && e <= 1e-12f)
+    {
+        // Both segments are points
+    }
+    else if (a <= 1e-12f)
+    {
+        t = Math::Clamp(f / e, 0.f, 1.f);
+    }
+    else
+    {
+        const float c = d1.dotProduct(r);
+        if (e <= 1e-12f)
+        {
+            s = Math::Clamp(-c / a, 0.f, 1.f);
+        }
+        else
+        {
+            const float b = d1.dotProduct(d2);
+            const float denom = a * e - b * b;
+            s = (denom != 0.f) ? Math::Clamp((b * f - c * e) / denom, 0.f, 1.f) : 0.f;
+            t = (b * s + f) / e;
+            if (t < 0.f)
+            {
+                t = 0.f;
+                s = Math::Clamp(-c / a, 0.f, 1.f);
+            }
+            else if (t > 1.f)
+            {
+                t = 1.f;
+                s = Math::Clamp((b - c) / a, 0.f, 1.f);
+            }
+        }
+    }
+
+    out_c1 = p1 + d1 * s;
+    out_c2 = p2 + d2 * t;
+    return out_c1.squaredDistance(out_c2);
+}
+
+float RoR::SegmentTriangleDistanceSq(Vector3 const& p0, Vector3 const& p1, Vector3 const& a, Vector3 const& b, Vector3 const& c,
+                                     Vector3& out_on_segment, Vector3& out_on_triangle)
+{
+    // Segment crossing the triangle
+    const Vector3 n = (b - a).crossProduct(c - a);
+    const float d0 = n.dotProduct(p0 - a);
+    const float d1 = n.dotProduct(p1 - a);
+    if (d0 * d1 <= 0.f && d0 != d1)
+    {
+        const Vector3 x = p0 + (p1 - p0) * (d0 / (d0 - d1));
+        if (n.dotProduct((b - a).crossProduct(x - a)) >= 0.f &&
+            n.dotProduct((c - b).crossProduct(x - b)) >= 0.f &&
+            n.dotProduct((a - c).crossProduct(x - c)) >= 0.f)
+        {
+            out_on_segment = x;
+            out_on_triangle = x;
+            return 0.f;
+        }
+    }
+
+    // Otherwise the closest pair involves a segment endpoint or a triangle edge
+    out_on_segment = p0;
+    out_on_triangle = ClosestPointOnTriangle(p0, a, b, c);
+    float best = p0.squaredDistance(out_on_triangle);
+
+    Vector3 on_tri = ClosestPointOnTriangle(p1, a, b, c);
+    float dist = p1.squaredDistance(on_tri);
+    if (dist < best)
+    {
+        best = dist;
+        out_on_segment = p1;
+        out_on_triangle = on_tri;
+    }
+
+    const Vector3* edges[3][2] = {{&a, &b}, {&b, &c}, {&c, &a}};
+    for (auto& edge : edges)
+    {
+        Vector3 on_seg;
+        dist = SegmentSegmentDistanceSq(p0, p1, *edge[0], *edge[1], on_seg, on_tri);
+        if (dist < best)
+        {
+            best = dist;
+            out_on_segment = on_seg;
+            out_on_triangle = on_tri;
+        }
+    }
+    return best;
+}
+
+bool RoR::SweepCapsuleTriangle(Vector3 const& p0, Vector3 const& p1, float radius, Vector3 const& motion,
+                               Vector3 const& a, Vector3 const& b, Vector3 const& c,
+                               float& out_t, Vector3& out_normal)
+{
+    const float motion_len = motion.length();
+    float t = 0.f;
+    Vector3 normal = Vector3::UNIT_Y;
+    for (int i = 0; i < MAX_ITERATIONS; i++)
+    {
+        const Vector3 offset = motion * t;
+        Vector3 on_seg, on_tri;
+        const float dist = std::sqrt(SegmentTriangleDistanceSq(p0 + offset, p1 + offset, a, b, c, on_seg, on_tri));
+
+        if (dist > 1e-6f)
+        {
+            normal = (on_seg - on_tri) / dist;
+        }
+        else
+        {
+            normal = (b - a).crossProduct(c - a).normalisedCopy();
+            if (normal.dotProduct(motion) > 0.f)
+                normal = -normal;
+        }
+
+        if (dist <= radius + CONTACT_TOLERANCE)
+        {
+            if (normal.dotProduct(motion) >= 0.f)
+                return false; // Touching or overlapping, but moving away
+
+            out_t = t;
+            out_normal = normal;
+            return true;
+        }
+
+        // No point of the capsule moves faster than `motion_len`, so it can't touch before this
+        if (motion_len < 1e-6f)
+            return false;
+        t += (dist - radius) / motion_len;
+        if (t > 1.f)
+            return false;
+    }
+
+    // Still approaching at a grazing angle; report contact here to stay conservative
+    out_t = t;
+    out_normal = normal;
+    return true;
+}
+
+bool RoR::SweepCapsuleBox(Vector3 const& p0, Vector3 const& p1, float radius, Vector3 const& motion,
+                          Vector3 const& lo, Vector3 const& hi,
+                          float& out_t, Vector3& out_normal)
+{
+    // Quick reject: swept bounds of the capsule vs. the box
+    for (int i = 0; i < 3; i++)
+    {
+        const float min = std::min(std::min(p0[i], p1[i]), std::min(p0[i], p1[i]) + motion[i]) - radius;
+        const float max = std::max(std::max(p0[i], p1[i]), std::max(p0[i], p1[i]) + motion[i]) + radius;
+        if (max < lo[i] || min > hi[i])
+            return false;
+    }
+
+    Vector3 corners[8];
+    for (int i = 0; i < 8; i++)
+    {
+        corners[i] = Vector3((i & 1) ? hi.x : lo.x, (i & 2) ? hi.y : lo.y, (i & 4) ? hi.z : lo.z);
+    }
+
+    static const int FACES[6][4] = {{0, 2, 6, 4}, {1, 5, 7, 3}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 6, 7, 5}};
+
+    bool hit = false;
+    for (auto& face : FACES)
+    {
+        for (int tri = 0; tri < 2; tri++)
+        {
+            float t;
+            Vector3 normal;
+            if (SweepCapsuleTriangle(p0, p1, radius, motion,
+                    corners[face[0]], corners[face[1 + tri]], corners[face[2 + tri]], t, normal) &&
+                (!hit || t < out_t))
+            {
+                hit = true;
+                out_t = t;
+                out_normal = normal;
+            }
+        }
+    }
+    return hit;
+}
@@ -0,0 +1,61 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Swept capsule tests against static collision primitives (triangles, boxes).
+///
+/// A capsule is the segment `p0`-`p1` inflated by `radius`. It's moved by `motion` and
+/// the first contact is reported as a fraction `t` of the motion (0-1) plus a contact normal.
+/// Entry point is `Collisions::sweepCapsule()`; these building blocks only depend on Ogre math.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <OgreVector3.h>
+
+namespace RoR {
+
+struct CapsuleSweepResult
+{
+    CapsuleSweepResult(): hit(false), t(1.f), normal(Ogre::Vector3::UNIT_Y), ground_model(nullptr) {}
+
+    bool            hit;
+    float           t;            //!< Fraction of the motion travelled before first contact; 1 if no hit
+    Ogre::Vector3   normal;       //!< Unit length, points from the obstacle towards the capsule
+    ground_model_t* ground_model;
+};
+
+/// @return Squared distance between segment p0-p1 and triangle a-b-c, with the closest points.
+float SegmentTriangleDistanceSq(Ogre::Vector3 const& p0, Ogre::Vector3 const& p1,
+                                Ogre::Vector3 const& a, Ogre::Vector3 const& b, Ogre::Vector3 const& c,
+                                Ogre::Vector3& out_on_segment, Ogre::Vector3& out_on_triangle);
+
+/// Conservative advancement: steps the capsule forward by its current clearance until it touches.
+/// A capsule which already overlaps the triangle only hits if the motion goes deeper.
+bool SweepCapsuleTriangle(Ogre::Vector3 const& p0, Ogre::Vector3 const& p1, float radius, Ogre::Vector3 const& motion,
+                          Ogre::Vector3 const& a, Ogre::Vector3 const& b, Ogre::Vector3 const& c,
+                          float& out_t, Ogre::Vector3& out_normal);
+
+/// Axis aligned box; transform the capsule and motion into the box space first.
+bool SweepCapsuleBox(Ogre::Vector3 const& p0, Ogre::Vector3 const& p1, float radius, Ogre::Vector3 const& motion,
+                     Ogre::Vector3 const& lo, Ogre::Vector3 const& hi,
+                     float& out_t, Ogre::Vector3& out_normal);
+
+} // namespace RoR
@@ -24,16 +24,22 @@
 #include "Application.h"
 #include "ApproxMath.h"
 #include "BeamFactory.h"
+#include "CapsuleSweep.h"
 #include "ErrorUtils.h"
 #include "Landusemap.h"
 #include "Language.h"
 #include "MovableText.h"
 #include "PlatformUtils.h"
+#include "RayCast.h"
 #include "RoRFrameListener.h"
 #include "Scripting.h"
 #include "Settings.h"
 #include "TerrainManager.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 // some gcc fixes
 #if OGRE_PLATFORM == OGRE_PLATFORM_LINUX
 #pragma GCC diagnostic ignored "-Wfloat-equal"
@@ -1286,6 +1292,306 @@ bool Collisions::groundCollision(node_t *node, float dt, ground_model_t** ogm, f
     return false;
 }
 
+// Internal helper; slab test which also reports the entry face normal
+static bool IntersectRayBox(const Vector3& origin, const Vector3& dir, const Vector3& lo, const Vector3& hi, float& out_t, Vector3& out_normal)
+{
+    float tmin = -std::numeric_limits<float>::max();
+    float tmax = std::numeric_limits<float>::max();
+    int axis = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (std::abs(dir[i]) < 1e-9f)
+        {
+            if (origin[i] < lo[i] || origin[i] > hi[i])
+                return false;
+            continue;
+        }
+        float t1 = (lo[i] - origin[i]) / dir[i];
+        float t2 = (hi[i] - origin[i]) / dir[i];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        if (t1 > tmin)
+        {
+            tmin = t1;
+            axis = i;
+        }
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax || tmax < 0)
+            return false;
+    }
+
+    out_t = std::max(0.0f, tmin);
+    out_normal = Vector3::ZERO;
+    out_normal[axis] = (dir[axis] > 0) ? -1.0f : 1.0f;
+    return true;
+}
+
+bool Collisions::castRay(const Ray& ray, float max_dist, int flags, RayCastResult& result)
+{
+    result = RayCastResult();
+    result.distance = max_dist;
+
+    if ((flags & RAYCAST_TERRAIN) && App::GetSimTerrain())
+    {
+        TerrainManager* terrain = App::GetSimTerrain();
+        float dist = 0;
+        if (RayMarchHeightfield(ray, max_dist, CELL_SIZE * 0.5f, terrain->getMaxTerrainSize(),
+                [terrain](float x, float z) { return terrain->GetHeightAt(x, z); }, dist))
+        {
+            result.type = RayCastResult::HIT_TERRAIN;
+            result.distance = dist;
+            result.position = ray.getPoint(dist);
+            result.normal = terrain->GetNormalAt(result.position.x, result.position.y, result.position.z);
+            result.ground_model = (landuse) ? landuse->getGroundModelAt(result.position.x, result.position.z) : nullptr;
+            if (!result.ground_model)
+                result.ground_model = defaultgroundgm;
+        }
+    }
+
+    if (flags & (RAYCAST_COLLISION_TRIS | RAYCAST_COLLISION_BOXES))
+    {
+        // Walk the cells under the ray (2D DDA); elements are registered in every cell they overlap,
+        // so once a hit lies within the cells visited so far, nothing further can be nearer.
+        // Only the part of the ray over the grid is walked.
+        const float grid_size = static_cast<float>((MAXIMUM_CELL + 1) * CELL_SIZE);
+        const Vector3 dir = ray.getDirection();
+        float t_enter = 0.f;
+        float t_leave = max_dist;
+        for (int axis = 0; axis < 3; axis += 2) // X and Z
+        {
+            const float o = ray.getOrigin()[axis];
+            if (dir[axis] == 0.f)
+            {
+                if (o < 0.f || o >= grid_size)
+                    t_leave = -1.f; // Never over the grid
+                continue;
+            }
+            float t0 = -o / dir[axis];
+            float t1 = (grid_size - o) / dir[axis];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            t_enter = std::max(t_enter, t0);
+            t_leave = std::min(t_leave, t1);
+        }
+
+        if (t_enter <= t_leave)
+        {
+            const Vector3 origin = ray.getPoint(t_enter);
+            int cell_x = std::min(std::max(static_cast<int>(std::floor(origin.x / CELL_SIZE)), 0), static_cast<int>(MAXIMUM_CELL));
+            int cell_z = std::min(std::max(static_cast<int>(std::floor(origin.z / CELL_SIZE)), 0), static_cast<int>(MAXIMUM_CELL));
+            const int step_x = (dir.x > 0) ? 1 : -1;
+            const int step_z = (dir.z > 0) ? 1 : -1;
+            const float inf = std::numeric_limits<float>::max();
+            const float delta_x = (dir.x != 0) ? std::abs(CELL_SIZE / dir.x) : inf;
+            const float delta_z = (dir.z != 0) ? std::abs(CELL_SIZE / dir.z) : inf;
+            float next_x = (dir.x != 0) ? t_enter + (((cell_x + (step_x > 0)) * CELL_SIZE) - origin.x) / dir.x : inf;
+            float next_z = (dir.z != 0) ? t_enter + (((cell_z + (step_z > 0)) * CELL_SIZE) - origin.z) / dir.z : inf;
+
+            float cell_exit = t_enter;
+            while (cell_exit < result.distance && cell_exit <= t_leave &&
+                   cell_x >= 0 && cell_z >= 0 && cell_x <= MAXIMUM_CELL && cell_z <= MAXIMUM_CELL)
+            {
+                this->castRayCell(cell_x, cell_z, ray, flags, result);
+
+                cell_exit = std::min(next_x, next_z);
+                if (next_x < next_z)
+                {
+                    next_x += delta_x;
+                    cell_x += step_x;
+                }
+                else
+                {
+                    next_z += delta_z;
+                    cell_z += step_z;
+                }
+            }
+        }
+    }
+
+    return result.IsHit();
+}
+
+bool Collisions::sweepCapsule(const Vector3& p0, const Vector3& p1, float radius, const Vector3& motion, CapsuleSweepResult& result)
+{
+    result = CapsuleSweepResult();
+
+    // Bounds of the swept capsule
+    Vector3 lo, hi;
+    for (int i = 0; i < 3; i++)
+    {
+        lo[i] = std::min(std::min(p0[i], p1[i]), std::min(p0[i], p1[i]) + motion[i]) - radius;
+        hi[i] = std::max(std::max(p0[i], p1[i]), std::max(p0[i], p1[i]) + motion[i]) + radius;
+    }
+
+    const int min_x = std::max(0, (int)(lo.x / CELL_SIZE));
+    const int min_z = std::max(0, (int)(lo.z / CELL_SIZE));
+    const int max_x = std::min(MAXIMUM_CELL, (int)(hi.x / CELL_SIZE));
+    const int max_z = std::min(MAXIMUM_CELL, (int)(hi.z / CELL_SIZE));
+
+    // Elements are registered in every cell they overlap; collect each once
+    std::vector<int> elements;
+    for (int cell_x = min_x; cell_x <= max_x; cell_x++)
+    {
+        for (int cell_z = min_z; cell_z <= max_z; cell_z++)
+        {
+            const unsigned int cell_id = (cell_x << 16) + cell_z;
+            for (hash_coll_element_t const& element : hashtable[hash_find(cell_x, cell_z)])
+            {
+                if (element.cell_id == cell_id)
+                    elements.push_back(element.element_index);
+            }
+        }
+    }
+    std::sort(elements.begin(), elements.end());
+    elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+
+    for (int element_index : elements)
+    {
+        float t;
+        Vector3 normal;
+        if (element_index < hash_coll_element_t::ELEMENT_TRI_BASE_INDEX)
+        {
+            collision_box_t* cbox = &m_collision_boxes[element_index];
+            if (!cbox->enabled || cbox->virt || !(hi > cbox->lo && lo < cbox->hi))
+                continue;
+
+            // Change of repere, see `nodeCollision()`
+            Vector3 a = p0;
+            Vector3 b = p1;
+            Vector3 dir = motion;
+            Vector3 box_lo = cbox->lo;
+            Vector3 box_hi = cbox->hi;
+            if (cbox->refined || cbox->selfrotated)
+            {
+                a = a - cbox->center;
+                b = b - cbox->center;
+                if (cbox->refined)
+                {
+                    a = cbox->unrot * a;
+                    b = cbox->unrot * b;
+                    dir = cbox->unrot * dir;
+                }
+                if (cbox->selfrotated)
+                {
+                    a = cbox->selfunrot * (a - cbox->selfcenter) + cbox->selfcenter;
+                    b = cbox->selfunrot * (b - cbox->selfcenter) + cbox->selfcenter;
+                    dir = cbox->selfunrot * dir;
+                }
+                box_lo = cbox->relo;
+                box_hi = cbox->rehi;
+            }
+
+            if (SweepCapsuleBox(a, b, radius, dir, box_lo, box_hi, t, normal) && t < result.t)
+            {
+                if (cbox->selfrotated) normal = cbox->selfrot * normal;
+                if (cbox->refined) normal = cbox->rot * normal;
+
+                result.hit = true;
+                result.t = t;
+                result.normal = normal;
+                result.ground_model = defaultgm;
+            }
+        }
+        else
+        {
+            collision_tri_t* ctri = &m_collision_tris[element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX];
+            if (!ctri->enabled)
+                continue;
+
+            if (SweepCapsuleTriangle(p0, p1, radius, motion, ctri->a, ctri->b, ctri->c, t, normal) && t < result.t)
+            {
+                result.hit = true;
+                result.t = t;
+                result.normal = normal;
+                result.ground_model = ctri->gm;
+            }
+        }
+    }
+
+    return result.hit;
+}
+
+void Collisions::castRayCell(int cell_x, int cell_z, const Ray& ray, int flags, RayCastResult& result)
+{
+    const unsigned int cell_id = (cell_x << 16) + cell_z;
+    const int hash = hash_find(cell_x, cell_z);
+
+    for (hash_coll_element_t const& element : hashtable[hash])
+    {
+        if (element.cell_id != cell_id)
+            continue;
+
+        if (element.IsCollisionBox())
+        {
+            if (!(flags & RAYCAST_COLLISION_BOXES))
+                continue;
+
+            collision_box_t* cbox = &m_collision_boxes[element.element_index];
+            if (!cbox->enabled || cbox->virt)
+                continue;
+
+            // Change of repere, see `nodeCollision()`
+            Vector3 origin = ray.getOrigin();
+            Vector3 dir = ray.getDirection();
+            Vector3 lo = cbox->lo;
+            Vector3 hi = cbox->hi;
+            if (cbox->refined || cbox->selfrotated)
+            {
+                origin = origin - cbox->center;
+                if (cbox->refined)
+                {
+                    origin = cbox->unrot * origin;
+                    dir = cbox->unrot * dir;
+                }
+                if (cbox->selfrotated)
+                {
+                    origin = cbox->selfunrot * (origin - cbox->selfcenter) + cbox->selfcenter;
+                    dir = cbox->selfunrot * dir;
+                }
+                lo = cbox->relo;
+                hi = cbox->rehi;
+            }
+
+            float t;
+            Vector3 normal;
+            if (IntersectRayBox(origin, dir, lo, hi, t, normal) && t < result.distance)
+            {
+                if (cbox->selfrotated) normal = cbox->selfrot * normal;
+                if (cbox->refined) normal = cbox->rot * normal;
+
+                result.type = RayCastResult::HIT_COLLISION_BOX;
+                result.distance = t;
+                result.position = ray.getPoint(t);
+                result.normal = normal;
+                result.ground_model = defaultgm; // Collision boxes are always out of concrete, see `nodeCollision()`
+            }
+        }
+        else
+        {
+            if (!(flags & RAYCAST_COLLISION_TRIS))
+                continue;
+
+            collision_tri_t* ctri = &m_collision_tris[element.element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX];
+            if (!ctri->enabled)
+                continue;
+
+            std::pair<bool, Real> hit = Math::intersects(ray, ctri->a, ctri->b, ctri->c, true, true);
+            if (hit.first && hit.second >= 0 && hit.second < result.distance)
+            {
+                Vector3 normal = (ctri->b - ctri->a).crossProduct(ctri->c - ctri->a).normalisedCopy();
+                if (normal.dotProduct(ray.getDirection()) > 0)
+                    normal = -normal;
+
+                result.type = RayCastResult::HIT_COLLISION_TRI;
+                result.distance = hit.second;
+                result.position = ray.getPoint(hit.second);
+                result.normal = normal;
+                result.ground_model = ctri->gm;
+            }
+        }
+    }
+}
+
 void primitiveCollision(node_t *node, Vector3 &force, const Vector3 &velocity, const Vector3 &normal, float dt, ground_model_t* gm, float* nso, float penetration, float reaction)
 {
     // normal velocity
@@ -143,6 +143,7 @@ private:
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
 
     Ogre::Vector3 calcCollidedSide(const Ogre::Vector3& pos, const Ogre::Vector3& lo, const Ogre::Vector3& hi);
+    void castRayCell(int cell_x, int cell_z, const Ogre::Ray& ray, int flags, RoR::RayCastResult& result);
 
 public:
 
@@ -168,6 +169,8 @@ public:
     bool isInside(Ogre::Vector3 pos, const Ogre::String& inst, const Ogre::String& box, float border = 0);
     bool isInside(Ogre::Vector3 pos, collision_box_t* cbox, float border = 0);
     bool nodeCollision(node_t* node, bool contacted, float dt, float* nso, ground_model_t** ogm);
+    bool castRay(const Ogre::Ray& ray, float max_dist, int flags, RoR::RayCastResult& result); //!< Terrain and static collision only; `flags` are `RoR::RayCastFlags`
+    bool sweepCapsule(const Ogre::Vector3& p0, const Ogre::Vector3& p1, float radius, const Ogre::Vector3& motion, RoR::CapsuleSweepResult& result); //!< Static collision boxes and tris; no events. See CapsuleSweep.h
 
     void clearEventCache();
     void finishLoadingTerrain();
@@ -49,7 +49,8 @@ using namespace Ogre;
 static bool BackfaceCollisionTest(const float distance,
         const Vector3 &normal,
         const node_t &surface_point,
-        const std::vector<int> &neighbour_node_ids,
+        const int* neighbour_node_ids,
+        const int num_neighbours,
         const node_t nodes[])
 {
     auto sign = [](float x){ return (x >= 0) ? 1 : -1; };
@@ -63,9 +64,9 @@ static bool BackfaceCollisionTest(const float distance,
     int face_indicator = weight * sign(distance);
 
     // calculate the contribution of neighbouring nodes (if it can still change the final outcome)
-    if (neighbour_node_ids.size() > weight) {
-        for (auto id : neighbour_node_ids) {
-            const auto neighbour_distance = normal.dotProduct(nodes[id].AbsPosition - surface_point.AbsPosition);
+    if (num_neighbours > weight) {
+        for (int i = 0; i < num_neighbours; i++) {
+            const auto neighbour_distance = normal.dotProduct(nodes[neighbour_node_ids[i]].AbsPosition - surface_point.AbsPosition);
             face_indicator += sign(neighbour_distance);
         }
     }
@@ -193,8 +194,8 @@ void ResolveInterActorCollisions(const float dt, PointColDetector &interPointCD,
                     auto normal     = triangle.normal();
 
                     // adapt in case the collision is occuring on the backface of the triangle
-                    const auto neighbour_node_ids = hit_actor->ar_node_to_node_connections[hitnodeid];
-                    const bool is_backface = BackfaceCollisionTest(distance, normal, *no, neighbour_node_ids, hit_actor->ar_nodes);
+                    const bool is_backface = BackfaceCollisionTest(distance, normal, *no,
+                            hit_actor->GetConnectedNodes(hitnodeid), hit_actor->GetNumNodeConnections(hitnodeid), hit_actor->ar_nodes);
                     if (is_backface)
                     {
                         // flip surface normal and distance to triangle plane
@@ -21,7 +21,7 @@
 
 #include "RoRPrerequisites.h"
 
-class PointColDetector : public ZeroedMemoryAllocator
+class PointColDetector
 {
 public:
 
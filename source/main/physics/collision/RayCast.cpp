@@ -0,0 +1,204 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RayCast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Ogre;
+using namespace RoR;
+
+/// Ray vs. axis-aligned box. Axes where the ray is parallel to the slabs are checked
+/// explicitly: with the origin on a slab plane, `0 * inf` would give NaN.
+static bool IntersectSlabs(Vector3 const& origin, Vector3 const& dir, Vector3 const& inv_dir,
+                           Vector3 const& lo, Vector3 const& hi, float& out_tmin)
+{
+    float tmin = -std::numeric_limits<float>::infinity();
+    float tmax = std::numeric_limits<float>::infinity();
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (dir[axis] == 0.f)
+        {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+                return false;
+            continue;
+        }
+        float t1 = (lo[axis] - origin[axis]) * inv_dir[axis];
+        float t2 = (hi[axis] - origin[axis]) * inv_dir[axis];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+    }
+    out_tmin = tmin;
+    return tmax >= std::max(tmin, 0.f);
+}
+
+void NodeBvh::Update(const Vector3* first, size_t stride, int count)
+{
+    m_positions.resize(count);
+    const char* src = reinterpret_cast<const char*>(first);
+    for (int i = 0; i < count; i++)
+    {
+        m_positions[i] = *reinterpret_cast<const Vector3*>(src + i * stride);
+    }
+
+    if (count != m_num_nodes || m_updates_since_build >= REBUILD_INTERVAL)
+    {
+        m_num_nodes = count;
+        m_updates_since_build = 0;
+        m_indices.resize(count);
+        for (int i = 0; i < count; i++)
+            m_indices[i] = i;
+        m_elements.clear();
+        m_elements.reserve(count > 0 ? (2 * count / LEAF_SIZE + 1) : 0);
+        if (count > 0)
+            this->Build(0, count);
+    }
+    else
+    {
+        m_updates_since_build++;
+        this->Refit();
+    }
+}
+
+int NodeBvh::Build(int first, int count)
+{
+    int index = static_cast<int>(m_elements.size());
+    m_elements.push_back(Element());
+
+    Vector3 lo(std::numeric_limits<float>::max());
+    Vector3 hi(-std::numeric_limits<float>::max());
+    for (int i = first; i < first + count; i++)
+    {
+        lo.makeFloor(m_positions[m_indices[i]]);
+        hi.makeCeil(m_positions[m_indices[i]]);
+    }
+    m_elements[index].lo = lo;
+    m_elements[index].hi = hi;
+
+    if (count <= LEAF_SIZE)
+    {
+        m_elements[index].first = first;
+        m_elements[index].count = count;
+        m_elements[index].right = -1;
+        return index;
+    }
+
+    // Median split along the longest axis
+    Vector3 extent = hi - lo;
+    int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+    int half = count / 2;
+    std::nth_element(m_indices.begin() + first, m_indices.begin() + first + half, m_indices.begin() + first + count,
+        [this, axis](int a, int b) { return m_positions[a][axis] < m_positions[b][axis]; });
+
+    this->Build(first, half);
+    int right = this->Build(first + half, count - half);
+
+    m_elements[index].first = first;
+    m_elements[index].count = 0;
+    m_elements[index].right = right;
+    return index;
+}
+
+void NodeBvh::Refit()
+{
+    // Children always follow their parent, so a reverse sweep visits children first.
+    for (int e = static_cast<int>(m_elements.size()) - 1; e >= 0; e--)
+    {
+        Element& elem = m_elements[e];
+        if (elem.count > 0)
+        {
+            elem.lo = elem.hi = m_positions[m_indices[elem.first]];
+            for (int i = elem.first + 1; i < elem.first + elem.count; i++)
+            {
+                elem.lo.makeFloor(m_positions[m_indices[i]]);
+                elem.hi.makeCeil(m_positions[m_indices[i]]);
+            }
+        }
+        else
+        {
+            elem.lo = m_elements[e + 1].lo;
+            elem.hi = m_elements[e + 1].hi;
+            elem.lo.makeFloor(m_elements[elem.right].lo);
+            elem.hi.makeCeil(m_elements[elem.right].hi);
+        }
+    }
+}
+
+int NodeBvh::CastRay(Ray const& ray, float max_dist, float radius, float& out_dist, std::function<bool(int)> const& accept) const
+{
+    if (m_elements.empty())
+        return -1;
+
+    const Vector3 origin = ray.getOrigin();
+    const Vector3 dir = ray.getDirection();
+    const Vector3 inv_dir(1.f / dir.x, 1.f / dir.y, 1.f / dir.z); // Unused for zero components, see `IntersectSlabs()`
+    const Vector3 pad(radius);
+    const float radius_sq = radius * radius;
+
+    int best_node = -1;
+    float best_dist = max_dist;
+
+    int stack[64];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        const int index = stack[--stack_size];
+        const Element& elem = m_elements[index];
+
+        // Slab test against node bounds inflated by the sphere radius
+        float tmin;
+        if (!IntersectSlabs(origin, dir, inv_dir, elem.lo - pad, elem.hi + pad, tmin) || tmin > best_dist)
+            continue;
+
+        if (elem.count > 0)
+        {
+            for (int i = elem.first; i < elem.first + elem.count; i++)
+            {
+                int n = m_indices[i];
+                Vector3 to_center = m_positions[n] - origin;
+                float t_center = to_center.dotProduct(dir);
+                float dist_sq = (to_center - dir * t_center).squaredLength(); // Not |to_center|^2 - t^2, that loses precision
+                if (dist_sq > radius_sq)
+                    continue;
+                float t_hit = t_center - std::sqrt(radius_sq - dist_sq);
+                if (t_hit < 0.f)
+                    t_hit = (t_center + std::sqrt(radius_sq - dist_sq) >= 0.f) ? 0.f : -1.f; // Origin inside the sphere
+                if (t_hit < 0.f || t_hit >= best_dist)
+                    continue;
+                if (accept && !accept(n))
+                    continue;
+                best_dist = t_hit;
+                best_node = n;
+            }
+        }
+        else // Median split keeps the tree balanced, the stack can't overflow
+        {
+            stack[stack_size++] = elem.right;
+            stack[stack_size++] = index + 1;
+        }
+    }
+
+    if (best_node != -1)
+        out_dist = best_dist;
+    return best_node;
+}
@@ -0,0 +1,200 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Ray/segment casting against the simulation: terrain, static collision, actor nodes.
+///
+/// Entry point is `ActorManager::CastRay()`; the building blocks here only depend on Ogre math
+/// so they can be benchmarked standalone (see source/microbenchmarks/Bench_RayCast.cpp).
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <OgreRay.h>
+#include <OgreVector3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace RoR {
+
+enum RayCastFlags
+{
+    RAYCAST_TERRAIN         = 1 << 0,
+    RAYCAST_COLLISION_TRIS  = 1 << 1,
+    RAYCAST_COLLISION_BOXES = 1 << 2,
+    RAYCAST_ACTORS          = 1 << 3,
+    RAYCAST_STATIC          = RAYCAST_TERRAIN | RAYCAST_COLLISION_TRIS | RAYCAST_COLLISION_BOXES,
+    RAYCAST_ALL             = RAYCAST_STATIC | RAYCAST_ACTORS,
+};
+
+struct RayCastQuery
+{
+    RayCastQuery(Ogre::Ray const& r, float max_dist, int f = RAYCAST_ALL):
+        ray(r), max_distance(max_dist), flags(f), node_radius(0.1f),
+        only_actor(nullptr), ignore_actor(nullptr), grabbable_nodes_only(false), local_actors_only(false)
+    {}
+
+    Ogre::Ray ray;               //!< Direction must be normalised
+    float     max_distance;      //!< Segment length; hits beyond are ignored
+    int       flags;             //!< RayCastFlags
+    float     node_radius;       //!< Nodes are tested as spheres of this radius
+    Actor*    only_actor;        //!< If set, other actors are skipped
+    Actor*    ignore_actor;
+    bool      grabbable_nodes_only; //!< Skip nodes with `no_mouse_grab`
+    bool      local_actors_only;    //!< Skip networked and sleeping actors
+};
+
+struct RayCastResult
+{
+    enum HitType { HIT_NONE, HIT_TERRAIN, HIT_COLLISION_TRI, HIT_COLLISION_BOX, HIT_NODE };
+
+    RayCastResult(): type(HIT_NONE), distance(0.f), position(Ogre::Vector3::ZERO), normal(Ogre::Vector3::UNIT_Y),
+        actor(nullptr), node(-1), ground_model(nullptr)
+    {}
+
+    bool IsHit() const { return type != HIT_NONE; }
+
+    HitType         type;
+    float           distance;     //!< Along the ray
+    Ogre::Vector3   position;
+    Ogre::Vector3   normal;       //!< Unit length; for nodes it's the sphere normal
+    Actor*          actor;        //!< HIT_NODE only
+    int             node;         //!< HIT_NODE only
+    ground_model_t* ground_model; //!< Static hits only
+};
+
+/// Bounding volume hierarchy over actor nodes.
+/// Topology is built from the node positions once and then only refitted (O(n)) as nodes move;
+/// it's rebuilt periodically because refitting degrades the tree when the actor deforms.
+class NodeBvh
+{
+public:
+    NodeBvh(): m_num_nodes(0), m_updates_since_build(0) {}
+
+    /// @param first Position of the first node
+    /// @param stride Bytes between consecutive positions, i.e. `sizeof(node_t)`
+    void Update(const Ogre::Vector3* first, size_t stride, int count);
+
+    /// @param accept Optional node filter; only called for nodes which are hit
+    /// @return Index of nearest hit node, or -1
+    int  CastRay(Ogre::Ray const& ray, float max_dist, float radius, float& out_dist,
+                 std::function<bool(int)> const& accept = nullptr) const;
+
+    int  GetNumNodes() const { return m_num_nodes; }
+    size_t GetMemoryUsage() const
+    {
+        return m_elements.capacity() * sizeof(Element) + m_indices.capacity() * sizeof(int)
+            + m_positions.capacity() * sizeof(Ogre::Vector3);
+    }
+
+private:
+    static const int LEAF_SIZE = 4;
+    static const int REBUILD_INTERVAL = 200; //!< Updates between full rebuilds
+
+    struct Element
+    {
+        Ogre::Vector3 lo, hi;
+        int first;        //!< Leaf: index into `m_indices`
+        int count;        //!< Leaf: number of nodes; 0 = inner element
+        int right;        //!< Inner: index of right child; left child is always the next element
+    };
+
+    int  Build(int first, int count);
+    void Refit();
+
+    std::vector<Element>       m_elements;  //!< Depth-first order; children always follow parents
+    std::vector<int>           m_indices;
+    std::vector<Ogre::Vector3> m_positions;
+    int                        m_num_nodes;
+    int                        m_updates_since_build;
+};
+
+/// Marches a ray over a heightfield and refines the crossing by bisection.
+/// Only the part of the ray above the terrain area is marched, so the cost is bounded by the terrain size.
+/// @param height_at Callable `float(float x, float z)`
+/// @param terrain_size Terrain area is [0, x] * [0, z]; y is the highest point, rays above it going up stop early.
+template<typename HeightFn>
+bool RayMarchHeightfield(Ogre::Ray const& ray, float max_dist, float step, Ogre::Vector3 const& terrain_size, HeightFn height_at, float& out_dist)
+{
+    Ogre::Vector3 const& origin = ray.getOrigin();
+    Ogre::Vector3 const& dir = ray.getDirection();
+    const float max_height = terrain_size.y;
+
+    // Clip the segment to the terrain area
+    float t_min = 0.f;
+    float t_max = max_dist;
+    for (int axis = 0; axis < 3; axis += 2) // X and Z
+    {
+        if (dir[axis] == 0.f)
+        {
+            if (origin[axis] < 0.f || origin[axis] > terrain_size[axis])
+                return false;
+            continue;
+        }
+        float t0 = -origin[axis] / dir[axis];
+        float t1 = (terrain_size[axis] - origin[axis]) / dir[axis];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        t_min = std::max(t_min, t0);
+        t_max = std::min(t_max, t1);
+    }
+    if (!(t_min <= t_max) || step <= 0.f) // Also rejects NaN
+        return false;
+
+    const Ogre::Vector3 start = origin + dir * t_min;
+    if (start.y < height_at(start.x, start.z))
+    {
+        out_dist = t_min; // Starts (or enters the terrain area) below ground
+        return true;
+    }
+
+    // Integer step count; a float accumulator stops advancing once `t` is large
+    const int num_steps = static_cast<int>(std::ceil((t_max - t_min) / step));
+    float prev_t = t_min;
+    for (int i = 1; i <= num_steps; i++)
+    {
+        const float t = (i == num_steps) ? t_max : t_min + step * i;
+        Ogre::Vector3 p = origin + dir * t;
+        if (p.y < height_at(p.x, p.z))
+        {
+            float lo = prev_t, hi = t;
+            for (int i = 0; i < 8; i++)
+            {
+                float mid = (lo + hi) * 0.5f;
+                Ogre::Vector3 m = origin + dir * mid;
+                if (m.y < height_at(m.x, m.z))
+                    hi = mid;
+                else
+                    lo = mid;
+            }
+            out_dist = hi;
+            return true;
+        }
+        if (p.y > max_height && dir.y >= 0.f)
+            return false;
+        prev_t = t;
+    }
+    return false;
+}
+
+} // namespace RoR
@@ -25,7 +25,7 @@
 #include "RoRPrerequisites.h"
 #include "BeamData.h" // For MAX_AEROENGINES
 
-class FlexAirfoil : public ZeroedMemoryAllocator
+class FlexAirfoil
 {
     friend class RigInspector; // Debug utility class
 
@@ -584,6 +584,17 @@ FlexBody::~FlexBody()
     Ogre::MeshManager::getSingleton().remove(mesh->getHandle());
 }
 
+size_t FlexBody::GetMemoryUsage() const
+{
+    size_t bytes = sizeof(FlexBody);
+    bytes += m_vertex_count * (3 * sizeof(Vector3) + sizeof(Locator_t));
+    if (m_src_colors != nullptr)
+        bytes += m_vertex_count * sizeof(ARGB);
+    if (m_scene_entity != nullptr)
+        bytes += m_scene_entity->getMesh()->getSize();
+    return bytes;
+}
+
 void FlexBody::setEnabled(bool e)
 {
     setVisible(e);
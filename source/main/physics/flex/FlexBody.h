@@ -34,6 +34,7 @@
 // Forward decl
 namespace RoR
 {
+    class  ActorTemplate;
     class  FlexFactory;
     class  FlexBodyFileIO;
     struct FlexBodyCacheData;
@@ -41,6 +42,7 @@ namespace RoR
 
 class FlexBody : public Flexable
 {
+    friend class RoR::ActorTemplate;
     friend class RoR::FlexFactory;
     friend class RoR::FlexBodyFileIO;
 
@@ -83,6 +85,8 @@ public:
 
     void setVisible(bool visible);
 
+    size_t GetMemoryUsage() const; //!< CPU-side vertex/locator buffers and the per-instance mesh, in bytes
+
 private:
 
     node_t*           m_nodes;
@@ -24,6 +24,7 @@
 
 #include "FlexFactory.h"
 
+#include "ActorTemplate.h"
 #include "Application.h"
 #include "Beam.h"
 #include "FlexBody.h"
@@ -59,7 +60,9 @@ FlexFactory::FlexFactory(
     m_rig_spawner(rig_spawner),
     m_is_flexbody_cache_loaded(false),
     m_is_flexbody_cache_enabled(is_flexbody_cache_enabled),
-    m_flexbody_cache_next_index(0)
+    m_flexbody_cache_next_index(0),
+    m_actor_template(nullptr),
+    m_actor_template_next_index(0)
 {
     m_flexbody_cache.SetCacheEntryNumber(cache_entry_number);
 }
@@ -98,6 +101,14 @@ FlexBody* FlexFactory::CreateFlexBody(
         from_cache = m_flexbody_cache.GetLoadedItem(m_flexbody_cache_next_index);
         m_flexbody_cache_next_index++;
     }
+    FlexBodyCacheData from_template;
+    if (from_cache == nullptr && m_actor_template != nullptr &&
+        m_actor_template->CopyFlexBody(m_actor_template_next_index, from_template))
+    {
+        FLEX_DEBUG_LOG(__FUNCTION__ " >> Copy entry from actor template ");
+        from_cache = &from_template;
+    }
+    m_actor_template_next_index++;
 
     FlexBody* new_flexbody = new FlexBody(
         def,
@@ -115,6 +126,10 @@ FlexBody* FlexFactory::CreateFlexBody(
     {
         m_flexbody_cache.AddItemToSave(new_flexbody);
     }
+    if (m_actor_template != nullptr && !m_actor_template->IsComplete())
+    {
+        m_actor_template->CaptureFlexBody(new_flexbody);
+    }
     return new_flexbody;
 }
 
@@ -441,3 +456,21 @@ void FlexFactory::ResolveFlexbodyLOD(std::string meshname, Ogre::MeshPtr newmesh
         newmesh->createManualLodLevel(distance, fn);
     }
 }
+
+void FlexFactory::SetActorTemplate(ActorTemplate* actor_template)
+{
+    m_actor_template = actor_template;
+    m_actor_template_next_index = 0;
+    if (m_actor_template != nullptr && !m_actor_template->IsComplete())
+    {
+        m_actor_template->BeginCapture();
+    }
+}
+
+void FlexFactory::FinalizeActorTemplate()
+{
+    if (m_actor_template != nullptr && !m_actor_template->IsComplete())
+    {
+        m_actor_template->EndCapture();
+    }
+}
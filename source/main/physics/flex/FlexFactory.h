@@ -195,6 +195,9 @@ public:
     void  CheckAndLoadFlexbodyCache();
     void  SaveFlexbodiesToCache();
 
+    void  SetActorTemplate(ActorTemplate* actor_template); ///< Copies flexbody data from the template, or captures it if it's not complete yet.
+    void  FinalizeActorTemplate();
+
 private:
 
     void  ResolveFlexbodyLOD(std::string meshname, Ogre::MeshPtr newmesh);
@@ -205,6 +208,9 @@ private:
     bool                    m_is_flexbody_cache_enabled;
     bool                    m_is_flexbody_cache_loaded;
     unsigned int            m_flexbody_cache_next_index;
+
+    ActorTemplate*          m_actor_template;
+    unsigned int            m_actor_template_next_index;
 };
 
 } // namespace RoR
@@ -21,6 +21,8 @@
 #ifdef USE_MPLATFORM
 #include "MPlatformFD.h"
 
+#include "Application.h"
+
 MPlatform_FD::MPlatform_FD()
 {}
 
@@ -30,15 +32,16 @@ MPlatform_FD::~MPlatform_FD()
 
 bool MPlatform_FD::connect()
 {
-    
-    if (mySocket.connect(12345, "127.0.0.1"))
+    const int port = RoR::App::io_mplatform_port.GetActive();
+    const char* host = RoR::App::io_mplatform_ip.GetActive();
+    if (mySocket.connect(port, host))
     {
-        LOG("Connected to feedback server: ");
+        RoR::LogFormat("Connected to feedback server: %s:%d", host, port);
         return true;
     }
     else
     {
-        LOG("Unable to connect to feedback server: ");
+        RoR::LogFormat("Unable to connect to feedback server: %s:%d", host, port);
         return false;
     }
 }
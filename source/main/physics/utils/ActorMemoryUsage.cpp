@@ -0,0 +1,71 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ActorMemoryUsage.h"
+
+#include <cstdio>
+
+using namespace RoR;
+
+static const char* CATEGORY_NAMES[] = { "actor", "physics", "flexbodies", "meshes", "scene", "sound", "replay" };
+static_assert(sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]) == ActorMemoryUsage::NUM_CATEGORIES,
+    "CATEGORY_NAMES must match ActorMemoryUsage::Category");
+
+ActorMemoryUsage::ActorMemoryUsage():
+    bytes(),
+    unused_fixed_bytes(0)
+{
+}
+
+size_t ActorMemoryUsage::GetTotal() const
+{
+    size_t total = 0;
+    for (size_t b : bytes)
+    {
+        total += b;
+    }
+    return total;
+}
+
+const char* ActorMemoryUsage::GetCategoryName(Category category)
+{
+    return (category < NUM_CATEGORIES) ? CATEGORY_NAMES[category] : "";
+}
+
+std::string ActorMemoryUsage::ToString() const
+{
+    char buf[100];
+    std::snprintf(buf, sizeof(buf), "total %lu KiB |", static_cast<unsigned long>(this->GetTotal() / 1024));
+    std::string out = buf;
+    for (int i = 0; i < NUM_CATEGORIES; ++i)
+    {
+        std::snprintf(buf, sizeof(buf), " %s %lu KiB", CATEGORY_NAMES[i], static_cast<unsigned long>(bytes[i] / 1024));
+        out += buf;
+        if (i == ACTOR)
+        {
+            std::snprintf(buf, sizeof(buf), " (%lu KiB unused slots)", static_cast<unsigned long>(unused_fixed_bytes / 1024));
+            out += buf;
+        }
+        if (i + 1 < NUM_CATEGORIES)
+        {
+            out += ',';
+        }
+    }
+    return out;
+}
@@ -0,0 +1,58 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Breakdown of CPU-side memory attributed to one actor, see `Actor::ComputeMemoryUsage()`.
+///
+/// Sizes are computed from element counts and capacities, not measured by the allocator,
+/// so they're estimates: heap bookkeeping and memory owned by Ogre internals aren't included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace RoR {
+
+struct ActorMemoryUsage
+{
+    enum Category
+    {
+        ACTOR,      //!< The `Actor` object itself, including its fixed-size arrays
+        PHYSICS,    //!< Node/beam/shock arrays, connectivity, snapshots, sub-objects in the actor's arena
+        FLEXBODIES, //!< Flexbody vertex and locator buffers, and their per-instance meshes
+        MESHES,     //!< Other Ogre meshes used by the actor's entities (each counted once)
+        SCENE,      //!< Scene nodes, entities and the gfx actor
+        SOUND,      //!< Sound script instances
+        REPLAY,     //!< Replay frame buffers; allocated on first recorded frame
+
+        NUM_CATEGORIES
+    };
+
+    ActorMemoryUsage();
+
+    size_t       GetTotal() const;
+    std::string  ToString() const;  //!< One line, sizes in KiB
+    static const char* GetCategoryName(Category category);
+
+    size_t bytes[NUM_CATEGORIES];
+    size_t unused_fixed_bytes;      //!< Part of `ACTOR` occupied by unused slots of the fixed-size arrays
+};
+
+} // namespace RoR
@@ -22,7 +22,7 @@
 
 #include "RoRPrerequisites.h"
 
-class Screwprop : public ZeroedMemoryAllocator
+class Screwprop
 {
     friend class RigInspector;
 
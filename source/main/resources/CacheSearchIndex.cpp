@@ -0,0 +1,266 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CacheSearchIndex.h"
+
+#include "CacheSystem.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace RoR;
+
+static const size_t NO_MATCH = std::string::npos;
+
+std::string CacheSearchIndex::ToLower(std::string const& str)
+{
+    std::string out(str);
+    for (char& c : out)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+void CacheSearchIndex::Clear()
+{
+    m_docs.clear();
+    m_name_order.clear();
+    m_name_rank.clear();
+    m_trigrams.clear();
+    m_by_number.clear();
+    m_by_hash.clear();
+    m_by_guid.clear();
+}
+
+void CacheSearchIndex::Build(std::vector<CacheEntry> const& entries)
+{
+    this->Clear();
+    m_docs.resize(entries.size());
+
+    for (int i = 0; i < static_cast<int>(entries.size()); i++)
+    {
+        CacheEntry const& entry = entries[i];
+        Document& doc = m_docs[i];
+        doc.dname       = ToLower(entry.dname);
+        doc.fname       = ToLower(entry.fname);
+        doc.description = ToLower(entry.description);
+        doc.hash        = ToLower(entry.hash);
+        doc.guid        = ToLower(entry.guid);
+        doc.wheels      = std::to_string(entry.wheelcount) + "x" + std::to_string(entry.propwheelcount);
+        for (AuthorInfo const& author : entry.authors)
+        {
+            doc.author_names.push_back(ToLower(author.name));
+            doc.author_emails.push_back(ToLower(author.email));
+        }
+
+        this->AddTrigrams(doc.dname, i);
+        this->AddTrigrams(doc.fname, i);
+        this->AddTrigrams(doc.description, i);
+        for (size_t a = 0; a < doc.author_names.size(); a++)
+        {
+            this->AddTrigrams(doc.author_names[a], i);
+            this->AddTrigrams(doc.author_emails[a], i);
+        }
+
+        m_by_number[entry.number] = i;
+        if (!doc.hash.empty())
+            m_by_hash[doc.hash].push_back(i);
+        if (!doc.guid.empty())
+            m_by_guid.insert(std::make_pair(doc.guid, i)); // Keeps the first one
+    }
+
+    m_name_order.resize(entries.size());
+    for (int i = 0; i < static_cast<int>(entries.size()); i++)
+        m_name_order[i] = i;
+    std::stable_sort(m_name_order.begin(), m_name_order.end(),
+        [this](int a, int b) { return m_docs[a].dname < m_docs[b].dname; });
+
+    m_name_rank.resize(entries.size());
+    for (int rank = 0; rank < static_cast<int>(m_name_order.size()); rank++)
+        m_name_rank[m_name_order[rank]] = rank;
+}
+
+void CacheSearchIndex::AddTrigrams(std::string const& text, int doc)
+{
+    for (size_t i = 0; i + 3 <= text.size(); i++)
+    {
+        std::vector<int>& postings = m_trigrams[MakeTrigram(text.c_str() + i)];
+        if (postings.empty() || postings.back() != doc) // Documents are added in order, this keeps the list sorted and unique
+            postings.push_back(doc);
+    }
+}
+
+void CacheSearchIndex::FindCandidates(std::string const& term, std::vector<int>& out) const
+{
+    out.clear();
+
+    // Gather posting lists; any missing trigram means no document contains the term
+    std::vector<std::vector<int> const*> lists;
+    for (size_t i = 0; i + 3 <= term.size(); i++)
+    {
+        auto found = m_trigrams.find(MakeTrigram(term.c_str() + i));
+        if (found == m_trigrams.end())
+            return;
+        lists.push_back(&found->second);
+    }
+
+    auto shortest = std::min_element(lists.begin(), lists.end(),
+        [](std::vector<int> const* a, std::vector<int> const* b) { return a->size() < b->size(); });
+
+    for (int doc : **shortest)
+    {
+        bool in_all = true;
+        for (std::vector<int> const* list : lists)
+        {
+            if (list != *shortest && !std::binary_search(list->begin(), list->end(), doc))
+            {
+                in_all = false;
+                break;
+            }
+        }
+        if (in_all)
+            out.push_back(doc);
+    }
+}
+
+size_t CacheSearchIndex::Score(Document const& doc, std::string const& cmd, std::string const& term) const
+{
+    size_t pos = NO_MATCH;
+    if (cmd.empty())
+    {
+        if ((pos = doc.dname.find(term)) != NO_MATCH)
+            return pos;
+        if ((pos = doc.fname.find(term)) != NO_MATCH)
+            return 100 + pos;
+        if ((pos = doc.description.find(term)) != NO_MATCH)
+            return 200 + pos;
+        for (size_t a = 0; a < doc.author_names.size(); a++)
+        {
+            if ((pos = doc.author_names[a].find(term)) != NO_MATCH)
+                return 300 + pos;
+            if ((pos = doc.author_emails[a].find(term)) != NO_MATCH)
+                return 400 + pos;
+        }
+        return NO_MATCH;
+    }
+    else if (cmd == "author")
+    {
+        for (size_t a = 0; a < doc.author_names.size(); a++)
+        {
+            if ((pos = doc.author_names[a].find(term)) != NO_MATCH)
+                return pos;
+            if ((pos = doc.author_emails[a].find(term)) != NO_MATCH)
+                return pos;
+        }
+        return NO_MATCH;
+    }
+    else if (cmd == "file")
+    {
+        return doc.fname.find(term);
+    }
+    else if (cmd == "hash")
+    {
+        return doc.hash.find(term);
+    }
+    else if (cmd == "guid")
+    {
+        return doc.guid.find(term);
+    }
+    else if (cmd == "wheels")
+    {
+        return doc.wheels.find(term);
+    }
+    return NO_MATCH;
+}
+
+void CacheSearchIndex::Query(std::string const& query, std::vector<Result>& out) const
+{
+    out.clear();
+
+    std::string cmd;
+    std::string term = ToLower(query);
+    size_t colon = term.find(':');
+    if (colon != std::string::npos)
+    {
+        cmd = term.substr(0, colon);
+        term = term.substr(colon + 1);
+        term = term.substr(0, term.find(':'));
+        if (cmd.empty() || term.empty())
+            return; // Invalid syntax
+    }
+
+    // A complete hash is a direct lookup (GUIDs aren't indexed for search, those are always scanned)
+    if (cmd == "hash")
+    {
+        auto found = m_by_hash.find(term);
+        if (found != m_by_hash.end())
+        {
+            for (int doc : found->second)
+                out.push_back(Result{doc, 0});
+            std::sort(out.begin(), out.end(), [this](Result const& a, Result const& b)
+                {
+                    return m_name_rank[a.entry] < m_name_rank[b.entry];
+                });
+            return;
+        }
+    }
+
+    // Only full-text fields are in the trigram index
+    std::vector<int> candidates;
+    const bool use_trigrams = (term.size() >= 3) && (cmd.empty() || cmd == "author" || cmd == "file");
+    if (use_trigrams)
+    {
+        this->FindCandidates(term, candidates);
+    }
+    else
+    {
+        candidates.resize(m_docs.size());
+        for (int i = 0; i < static_cast<int>(m_docs.size()); i++)
+            candidates[i] = i;
+    }
+
+    for (int doc : candidates)
+    {
+        size_t score = this->Score(m_docs[doc], cmd, term);
+        if (score != NO_MATCH)
+            out.push_back(Result{doc, score});
+    }
+
+    std::sort(out.begin(), out.end(), [this](Result const& a, Result const& b)
+        {
+            return (a.score != b.score) ? (a.score < b.score) : (m_name_rank[a.entry] < m_name_rank[b.entry]);
+        });
+}
+
+int CacheSearchIndex::FindByNumber(int number) const
+{
+    auto found = m_by_number.find(number);
+    return (found != m_by_number.end()) ? found->second : -1;
+}
+
+int CacheSearchIndex::FindByHash(std::string const& hash) const
+{
+    auto found = m_by_hash.find(ToLower(hash));
+    return (found != m_by_hash.end()) ? found->second.front() : -1;
+}
+
+int CacheSearchIndex::FindByGuid(std::string const& guid) const
+{
+    auto found = m_by_guid.find(ToLower(guid));
+    return (found != m_by_guid.end()) ? found->second : -1;
+}
@@ -0,0 +1,104 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Search index over cache entries, built once when the cache is loaded.
+///
+/// All text is lower-cased up front; a trigram index narrows full-text queries
+/// down to a few candidates which are then scored. Query syntax and scoring is
+/// the same the selector always used:
+///     "text"          name (0+), filename (100+), description (200+), author name (300+), email (400+)
+///     "author:text"   author name or email
+///     "file:text"     filename
+///     "hash:text"     file hash
+///     "guid:text"     GUID
+///     "wheels:AxB"    wheel count x propelled wheel count
+/// Lower score = better match; ties are broken by name.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CacheEntry;
+
+namespace RoR {
+
+class CacheSearchIndex
+{
+public:
+    struct Result
+    {
+        int    entry; //!< Position in `CacheSystem::getEntries()`
+        size_t score;
+    };
+
+    /// Indexes `entries` by position; must be rebuilt whenever the vector changes.
+    void Build(std::vector<CacheEntry> const& entries);
+    void Clear();
+
+    /// @param query Search string as typed; case-insensitive
+    /// @param out Cleared, then filled with matches, best first
+    void Query(std::string const& query, std::vector<Result>& out) const;
+
+    int  FindByNumber(int number) const;            //!< @return Entry position or -1
+    int  FindByHash(std::string const& hash) const; //!< @return First entry with the hash or -1
+    int  FindByGuid(std::string const& guid) const; //!< @return First entry with the GUID or -1
+
+    /// Entry positions ordered by case-insensitive name
+    std::vector<int> const& GetNameOrder() const { return m_name_order; }
+    size_t                  GetNumEntries() const { return m_docs.size(); }
+
+    static std::string ToLower(std::string const& str);
+
+private:
+    /// Pre-lowered searchable fields of one entry
+    struct Document
+    {
+        std::string              dname;
+        std::string              fname;
+        std::string              description;
+        std::string              hash;
+        std::string              guid;
+        std::string              wheels;
+        std::vector<std::string> author_names;
+        std::vector<std::string> author_emails;
+    };
+
+    void   AddTrigrams(std::string const& text, int doc);
+    void   FindCandidates(std::string const& term, std::vector<int>& out) const;
+    size_t Score(Document const& doc, std::string const& cmd, std::string const& term) const;
+
+    static uint32_t MakeTrigram(const char* s)
+    {
+        return (uint32_t(uint8_t(s[0])) << 16) | (uint32_t(uint8_t(s[1])) << 8) | uint32_t(uint8_t(s[2]));
+    }
+
+    std::vector<Document>                          m_docs;       //!< Parallel to cache entries
+    std::vector<int>                               m_name_order;
+    std::vector<int>                               m_name_rank;  //!< Entry position -> index in `m_name_order`
+    std::unordered_map<uint32_t, std::vector<int>> m_trigrams;   //!< Trigram -> sorted entry positions; covers name, filename, description and authors
+    std::unordered_map<int, int>                   m_by_number;
+    std::unordered_map<std::string, std::vector<int>> m_by_hash; //!< Hash -> entry positions; hashes aren't unique (duplicate files, placeholders)
+    std::unordered_map<std::string, int>           m_by_guid;
+};
+
+} // namespace RoR
@@ -119,6 +119,7 @@ CacheSystem::CacheSystem() :
     , deletedFiles(0)
     , newFiles(0)
     , rgcounter(0)
+    , mountcounter(0)
 {
     // register the extensions
     known_extensions.push_back("machine");
@@ -183,6 +184,8 @@ void CacheSystem::Startup(bool force_check)
     LOG("loading cache...");
     // load the cache finally!
     loadCache();
+    search_index.Build(entries);
+    resource_owners.clear();
 
     // show error on zero content
     if (entries.empty())
@@ -508,6 +511,16 @@ void CacheSystem::parseModAttribute(const String& line, CacheEntry& t)
         }
         t.sectionconfigs.push_back(params[1]);
     }
+    else if (attrib == "archivefile")
+    {
+        // Check params
+        if (params.size() < 2)
+        {
+            logBadTruckAttrib(line, t);
+            return;
+        }
+        t.archive_files.push_back(line.substr(line.find('=') + 1)); // File names may contain ',' or '='
+    }
 
     // TRUCK detail parameters below
     else if (attrib == "description")
@@ -1107,6 +1120,10 @@ int CacheSystem::incrementalCacheUpdate()
 
 CacheEntry* CacheSystem::getEntry(int modid)
 {
+    int pos = search_index.FindByNumber(modid);
+    if (pos != -1 && pos < static_cast<int>(entries.size()) && entries[pos].number == modid)
+        return &entries[pos];
+
     for (std::vector<CacheEntry>::iterator it = entries.begin(); it != entries.end(); it++)
     {
         if (modid == it->number)
@@ -1283,6 +1300,9 @@ Ogre::String CacheSystem::formatInnerEntry(int counter, CacheEntry t)
             for (int i = 0; i < (int)t.sectionconfigs.size(); i++)
                 result += "\tsectionconfig=" + t.sectionconfigs[i] + "\n";
         }
+
+        for (String const& file : t.archive_files)
+            result += "\tarchivefile=" + file + "\n";
     }
 
     return result;
@@ -1410,10 +1430,10 @@ void CacheSystem::addFile(Ogre::FileInfo f, String ext)
         archiveDirectory = f.archive->getName();
     }
 
-    addFile(f.filename, archiveType, archiveDirectory, ext);
+    addFile(f.filename, archiveType, archiveDirectory, ext, f.archive);
 }
 
-void CacheSystem::addFile(String filename, String archiveType, String archiveDirectory, String ext)
+void CacheSystem::addFile(String filename, String archiveType, String archiveDirectory, String ext, Ogre::Archive* archive)
 {
     LOG("Preparing to add " + filename);
 
@@ -1450,6 +1470,18 @@ void CacheSystem::addFile(String filename, String archiveType, String archiveDir
             entry.number = modcounter++;
             entry.addtimestamp = getTimeStamp();
             entry.usagecounter = 0;
+            if (archive)
+            {
+                // Other mods may use files from this archive, see `checkResourceLoaded()`
+                StringVectorPtr files = archive->list(true);
+                for (String const& file : *files)
+                {
+                    String base, path;
+                    StringUtil::splitFilename(file, base, path);
+                    StringUtil::toLowerCase(base);
+                    entry.archive_files.push_back(base);
+                }
+            }
             entry.deleted = false;
             String basen;
             String fnextension;
@@ -1859,26 +1891,6 @@ void CacheSystem::parseKnownFilesOneRG(Ogre::String rg)
         parseFilesOneRG(*sit, rg);
 }
 
-void CacheSystem::parseKnownFilesOneRGDirectory(Ogre::String rg, Ogre::String dir)
-{
-    String dirb = getVirtualPath(dir);
-
-    for (std::vector<Ogre::String>::iterator it = known_extensions.begin(); it != known_extensions.end(); ++it)
-    {
-        FileInfoListPtr files = ResourceGroupManager::getSingleton().findResourceFileInfo(rg, "*." + *it);
-        for (FileInfoList::iterator iterFiles = files->begin(); iterFiles != files->end(); ++iterFiles)
-        {
-            if (!iterFiles->archive)
-                continue;
-
-            String dira = getVirtualPath(iterFiles->archive->getName());
-
-            if (dira == dirb)
-                addFile(*iterFiles, *it);
-        }
-    }
-}
-
 void CacheSystem::parseFilesOneRG(Ogre::String ext, Ogre::String rg)
 {
     FileInfoListPtr files = ResourceGroupManager::getSingleton().findResourceFileInfo(rg, "*." + ext);
@@ -2148,46 +2160,131 @@ bool CacheSystem::checkResourceLoaded(Ogre::String& filename, Ogre::String& grou
             return res;
         }
     }
-    return false;
+
+    // Not an entry itself; may be a file from another mod's archive (e.g. objects shared between terrains)
+    Ogre::String filename_lower = filename;
+    StringUtil::toLowerCase(filename_lower);
+    if (resource_owners.empty())
+    {
+        // File lists come from the cache, no archive is opened here
+        for (CacheEntry const& entry : entries)
+        {
+            if (entry.type != "Zip" && entry.type != "FileSystem")
+                continue;
+            for (String const& file : entry.archive_files)
+            {
+                resource_owners.insert(std::make_pair(file, std::make_pair(entry.dirname, entry.type))); // Keeps the first one
+            }
+        }
+    }
+    auto owner = resource_owners.find(filename_lower);
+    if (owner == resource_owners.end() || mounted_archives.find(owner->second.first) != mounted_archives.end())
+        return false;
+    if (!mountArchive(owner->second.first, owner->second.second))
+        return false;
+    for (CacheEntry& entry : entries)
+    {
+        if (entry.dirname == owner->second.first)
+            entry.resourceLoaded = true;
+    }
+    if (!ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(filename))
+        return false;
+    group = ResourceGroupManager::getSingleton().findGroupContainingResource(filename);
+    return true;
 }
 
-bool CacheSystem::checkResourceLoaded(CacheEntry t)
+bool CacheSystem::checkResourceLoaded(CacheEntry& t)
 {
-    static int rgcountera = 0;
-    static std::map<String, bool> loaded;
-    if (t.resourceLoaded || loaded[t.dirname])
     // only load once
+    if (t.resourceLoaded || mounted_archives.find(t.dirname) != mounted_archives.end())
         return true;
-    if (t.type == "Zip")
+    if (!mountArchive(t.dirname, t.type))
+        return false;
+    t.resourceLoaded = true;
+    return true;
+}
+
+bool CacheSystem::mountArchive(Ogre::String const& dirname, Ogre::String const& type)
+{
+    if (type != "Zip" && type != "FileSystem")
+        return false;
+
+    mountcounter++;
+    String name = "General-Reloaded-" + TOSTRING(mountcounter);
+    try
     {
-        //ScopeLog log("cache_"+t.fname);
-        try
+        LOG("Mounting '" + dirname + "' as resource group " + name);
+        ResourceGroupManager::getSingleton().addResourceLocation(dirname, type, name);
+        mounted_archives[dirname] = name;
+        ResourceGroupManager::getSingleton().initialiseResourceGroup(name); // Skins found here are saved to the skin cache on shutdown
+        return true;
+    }
+    catch (Ogre::Exception& e)
+    {
+        if (e.getNumber() == Ogre::Exception::ERR_DUPLICATE_ITEM)
         {
-            rgcountera++;
-            String name = "General-Reloaded-" + TOSTRING(rgcountera);
-            ResourceGroupManager::getSingleton().addResourceLocation(t.dirname, t.type, name);
-            loaded[t.dirname] = true;
-            ResourceGroupManager::getSingleton().initialiseResourceGroup(name);
-            return true;
+            LOG(" *** error opening '"+dirname+"': some files are duplicates of existing files. The archive/directory will be ignored.");
+            LOG("error while opening resource: " + e.getFullDescription());
         }
-        catch (Ogre::Exception& e)
+        else
         {
-            if (e.getNumber() == Ogre::Exception::ERR_DUPLICATE_ITEM)
-            {
-                LOG(" *** error opening '"+t.dirname+"': some files are duplicates of existing files. The archive/directory will be ignored.");
-                LOG("error while opening resource: " + e.getFullDescription());
-            }
-            else
+            LOG("error opening '"+dirname+"'.");
+            if (type == "Zip")
+            LOG("Is the zip archive corrupt? Error: " + e.getFullDescription());
+            LOG("Error description : " + e.getFullDescription());
+            LOG("trying to continue ...");
+        }
+    }
+    return false;
+}
+
+bool CacheSystem::containsKnownFiles(Ogre::String const& dirname)
+{
+    bool found = false;
+    try
+    {
+        Archive* archive = ArchiveManager::getSingleton().load(dirname, "FileSystem");
+        StringVectorPtr files = archive->list(true);
+        for (String const& file : *files)
+        {
+            String base, ext;
+            StringUtil::splitBaseFilename(file, base, ext);
+            StringUtil::toLowerCase(ext);
+            if (std::find(known_extensions.begin(), known_extensions.end(), ext) != known_extensions.end())
             {
-                LOG("error opening '"+t.dirname+"'.");
-                if (t.type == "Zip")
-                LOG("Is the zip archive corrupt? Error: " + e.getFullDescription());
-                LOG("Error description : " + e.getFullDescription());
-                LOG("trying to continue ...");
+                found = true;
+                break;
             }
         }
+        ArchiveManager::getSingleton().unload(archive);
     }
-    return false;
+    catch (Ogre::Exception& e)
+    {
+        LOG("error listing '" + dirname + "': " + e.getFullDescription());
+        found = true; // Let the cache report it
+    }
+    return found;
+}
+
+void CacheSystem::unmountAllArchives()
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    for (auto itor = mounted_archives.begin(); itor != mounted_archives.end(); ++itor)
+    {
+        LOG("Unmounting '" + itor->first + "' (resource group " + itor->second + ")");
+        try
+        {
+            rgm.destroyResourceGroup(itor->second);
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG("error while unmounting: " + e.getFullDescription());
+        }
+    }
+    mounted_archives.clear();
+
+    for (auto itor = entries.begin(); itor != entries.end(); ++itor)
+        itor->resourceLoaded = false;
 }
 
 void CacheSystem::loadSingleZip(CacheEntry e, bool unload, bool ownGroup)
@@ -2204,11 +2301,14 @@ void CacheSystem::loadSingleZip(Ogre::FileInfo f, bool unload, bool ownGroup)
     loadSingleZip(zippath, cfactor, unload, ownGroup);
 }
 
-void CacheSystem::loadSingleDirectory(String dirname, String group, bool alreadyLoaded)
+void CacheSystem::loadSingleDirectory(String dirname, String group)
 {
     char hash[256];
     memset(hash, 0, 255);
 
+    if (!this->containsKnownFiles(dirname))
+        return; // Resource pack, mounted globally by `ContentManager`; nothing to add to the cache
+
     LOG("Adding directory " + dirname);
 
     rgcounter++;
@@ -2216,29 +2316,23 @@ void CacheSystem::loadSingleDirectory(String dirname, String group, bool already
 
     try
     {
-        if (alreadyLoaded)
-        {
-            parseKnownFilesOneRGDirectory(group, dirname);
-        }
-        else
-        {
-            LOG("Loading " + dirname);
-            ResourceGroupManager::getSingleton().addResourceLocation(dirname, "FileSystem", rgname);
-            ResourceGroupManager::getSingleton().initialiseResourceGroup(rgname);
-            // parse everything
-            parseKnownFilesOneRG(rgname);
-            // unload it again
-            LOG("UnLoading " + dirname);
+        // Directories aren't mounted at startup (see `checkResourceLoaded()`), mount it just for parsing
+        LOG("Loading " + dirname);
+        ResourceGroupManager::getSingleton().addResourceLocation(dirname, "FileSystem", rgname);
+        ResourceGroupManager::getSingleton().initialiseResourceGroup(rgname);
+        // parse everything
+        parseKnownFilesOneRG(rgname);
+        // unload it again
+        LOG("UnLoading " + dirname);
 
 #ifdef USE_OPENAL
-            SoundScriptManager::getSingleton().clearNonBaseTemplates();
+        SoundScriptManager::getSingleton().clearNonBaseTemplates();
 #endif //OPENAL
-            //ParticleSystemManager::getSingleton().removeTemplatesByResourceGroup(rgname);
-            ResourceGroupManager::getSingleton().clearResourceGroup(rgname);
-            ResourceGroupManager::getSingleton().unloadResourceGroup(rgname);
-            ResourceGroupManager::getSingleton().removeResourceLocation(dirname, rgname);
-            ResourceGroupManager::getSingleton().destroyResourceGroup(rgname);
-        }
+        //ParticleSystemManager::getSingleton().removeTemplatesByResourceGroup(rgname);
+        ResourceGroupManager::getSingleton().clearResourceGroup(rgname);
+        ResourceGroupManager::getSingleton().unloadResourceGroup(rgname);
+        ResourceGroupManager::getSingleton().removeResourceLocation(dirname, rgname);
+        ResourceGroupManager::getSingleton().destroyResourceGroup(rgname);
     }
     catch (Ogre::Exception& e)
     {
@@ -2373,7 +2467,7 @@ void CacheSystem::loadAllDirectoriesInResourceGroup(String group)
         // update loader
         int progress = ((float)i / (float)filecount) * 100;
         RoR::App::GetGuiManager()->GetLoadingWindow()->setProgress(progress, _L("Loading directory\n") + Utils::SanitizeUtf8String(listitem->filename));
-        loadSingleDirectory(dirname, group, true);
+        loadSingleDirectory(dirname, group);
     }
     // hide loader again
     RoR::App::GetGuiManager()->SetVisible_LoadingWindow(false);
@@ -2445,7 +2539,7 @@ void CacheSystem::checkForNewDirectoriesInResourceGroup(String group)
         {
             RoR::App::GetGuiManager()->GetLoadingWindow()->setProgress(progress, _L("checking for new directories in ") + group + "\n" + _L("loading new directory: ") + filename_utf8 + "\n" + TOSTRING(i) + "/" + TOSTRING(filecount));
             LOG("- "+dirname+" is new");
-            loadSingleDirectory(dirname, group, true);
+            loadSingleDirectory(dirname, group);
         }
     }
     RoR::App::GetGuiManager()->SetVisible_LoadingWindow(false);
@@ -27,11 +27,12 @@
 #pragma once
 
 #include "RoRPrerequisites.h"
+#include "CacheSearchIndex.h"
 
 #include <Ogre.h>
 
 #define CACHE_FILE "mods.cache"
-#define CACHE_FILE_FORMAT "6"
+#define CACHE_FILE_FORMAT "7"
 
 // 60*60*24 = one day
 #define CACHE_FILE_FRESHNESS 86400
@@ -126,6 +127,7 @@ public:
     char enginetype;
     std::vector<Ogre::String> sectionconfigs;
     std::set<Ogre::String> materials;
+    std::vector<Ogre::String> archive_files; //!< Lowercase names of all files in the archive/directory, listed when the cache is generated
 
 };
 
@@ -154,7 +156,10 @@ public:
     
     void loadAllZipsInResourceGroup(Ogre::String group);
 
-    bool checkResourceLoaded(CacheEntry t);
+    /// Mounts the entry's archive/directory as its own resource group, unless already mounted.
+    bool checkResourceLoaded(CacheEntry& t);
+    /// Finds the file in loaded resources; if it's not there, mounts the cache entry (or the
+    /// archive of another entry which contains the file, i.e. resources shared between mods).
     bool checkResourceLoaded(Ogre::String &filename);
 
     /**
@@ -168,6 +173,7 @@ public:
     Ogre::String addMeshMaterials(CacheEntry &entry, Ogre::Entity *e);
     std::map<int, Category_Entry> *getCategories();
     std::vector<CacheEntry> *getEntries();
+    RoR::CacheSearchIndex const& getSearchIndex() const { return search_index; } //!< Valid after `Startup()`
 
     int getCategoryUsage(int category);
     CacheEntry *getEntry(int modid);
@@ -178,7 +184,15 @@ public:
     int changedFiles, newFiles, deletedFiles;
 
     void loadSingleZip(Ogre::String zippath, int cfactor, bool unload=true, bool ownGroup=true);
-    void loadSingleDirectory(Ogre::String dirname, Ogre::String group, bool alreadyLoaded=true);
+    void loadSingleDirectory(Ogre::String dirname, Ogre::String group);
+
+    /// @return True if the directory holds any content the cache indexes (vehicles, terrains...).
+    ///         Directories without it are resource/skin packs shared by other mods and stay mounted globally.
+    bool containsKnownFiles(Ogre::String const& dirname);
+
+    /// Removes resource groups of all archives mounted by `checkResourceLoaded()`.
+    /// Only safe when nothing from them is in use, i.e. between sessions.
+    void unmountAllArchives();
 
     static bool resourceExistsInAllGroups(Ogre::String filename);
 
@@ -198,12 +212,13 @@ protected:
     void parseFilesOneRG(Ogre::String ext, Ogre::String rg);
     void parseKnownFilesOneRG(Ogre::String rg);
     void parseKnownFilesAllRG();
-    void parseKnownFilesOneRGDirectory(Ogre::String rg, Ogre::String dir);
 
     void checkForNewKnownFiles();
 
+    bool mountArchive(Ogre::String const& dirname, Ogre::String const& type);
+
     void addFile(Ogre::FileInfo f, Ogre::String ext);	// adds a file to entries
-    void addFile(Ogre::String filename, Ogre::String archiveType, Ogre::String archiveDirectory, Ogre::String ext);
+    void addFile(Ogre::String filename, Ogre::String archiveType, Ogre::String archiveDirectory, Ogre::String ext, Ogre::Archive* archive = nullptr);
 
     // reads all advanced information out of the entry's file
     void fillTerrainDetailInfo(CacheEntry &entry, Ogre::DataStreamPtr ds, Ogre::String fname);
@@ -276,6 +291,7 @@ protected:
     std::vector<Ogre::String> known_extensions; //!< the extensions we track in the cache system
 
     std::vector<CacheEntry> entries; //!< this holds all files
+    RoR::CacheSearchIndex search_index; //!< built from `entries` once they're loaded; don't reorder `entries` afterwards
 
     std::map<Ogre::String, Ogre::String> zipHashes;
 
@@ -283,5 +299,8 @@ protected:
     std::map<int, Category_Entry> categories;
     std::map<int, int> category_usage;
     std::set<Ogre::String> zipCacheList;
+    std::map<Ogre::String, Ogre::String> mounted_archives; //!< archive path -> resource group; mods are mounted on first use, not at startup
+    int mountcounter;           //!< used to name resource groups of mounted archives
+    std::map<Ogre::String, std::pair<Ogre::String, Ogre::String>> resource_owners; //!< lowercase file name -> (archive path, type) of cache entries; built from `CacheEntry::archive_files` on first unresolved lookup
 
 };
@@ -260,17 +260,27 @@ bool ContentManager::OnApplicationStartup(void)
     ResourceGroupManager::getSingleton().addResourceLocation(user_content_base + "vehicles", "FileSystem", "VehicleFolders");
     ResourceGroupManager::getSingleton().addResourceLocation(user_content_base + "terrains", "FileSystem", "TerrainFolders");
 
-    exploreFolders("VehicleFolders");
-    exploreFolders("TerrainFolders");
+    // Mod directories/archives aren't mounted here; `CacheSystem` mounts them on first use
+    exploreSharedFolders("VehicleFolders");
+    exploreSharedFolders("TerrainFolders");
     exploreZipFolders("Packs"); // this is required for skins to work
 
     LOG("RoR|ContentManager: Calling initialiseAllResourceGroups() - Content");
     try
     {
         if (BSETTING("Background Loading", false))
+        {
             ResourceBackgroundQueue::getSingleton().initialiseResourceGroup("Packs");
+            ResourceBackgroundQueue::getSingleton().initialiseResourceGroup("VehicleFolders");
+            ResourceBackgroundQueue::getSingleton().initialiseResourceGroup("TerrainFolders");
+        }
         else
+        {
             ResourceGroupManager::getSingleton().initialiseResourceGroup("Packs");
+            ResourceGroupManager::getSingleton().initialiseResourceGroup("VehicleFolders");
+            ResourceGroupManager::getSingleton().initialiseResourceGroup("TerrainFolders");
+            m_skin_manager->SaveCache(); // Skins are parsed during init; with background loading, saved on shutdown
+        }
     }
     catch (Ogre::Exception& e)
     {
@@ -326,7 +336,7 @@ void ContentManager::exploreZipFolders(Ogre::String rg)
     // DO NOT initialize ...
 }
 
-void ContentManager::exploreFolders(Ogre::String rg)
+void ContentManager::exploreSharedFolders(Ogre::String rg)
 {
     ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
 
@@ -338,22 +348,15 @@ void ContentManager::exploreFolders(Ogre::String rg)
             continue;
         if (iterFiles->filename == String(".svn"))
             continue;
-        // trying to get the full path
-        String fullpath = iterFiles->archive->getName() + PATH_SLASH;
-        rgm.addResourceLocation(fullpath + iterFiles->filename, "FileSystem", rg);
-    }
-    LOG("initialiseResourceGroups: "+rg);
-    try
-    {
-        if (BSETTING("Background Loading", false))
-            ResourceBackgroundQueue::getSingleton().initialiseResourceGroup(rg);
-        else
-            ResourceGroupManager::getSingleton().initialiseResourceGroup(rg);
-    }
-    catch (Ogre::Exception& e)
-    {
-        LOG("catched error while initializing Resource group '" + rg + "' : " + e.getFullDescription());
+        // Directories without vehicles/terrains are resource or skin packs which other mods use, keep them mounted
+        String fullpath = iterFiles->archive->getName() + PATH_SLASH + iterFiles->filename;
+        if (!App::GetCacheSystem()->containsKnownFiles(fullpath))
+        {
+            LOG("RoR|ContentManager: Mounting shared directory '" + fullpath + "'");
+            rgm.addResourceLocation(fullpath, "FileSystem", rg);
+        }
     }
+    // initialized with the group
 }
 
 void ContentManager::InitManagedMaterials()
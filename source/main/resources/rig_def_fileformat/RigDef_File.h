@@ -2242,6 +2242,7 @@ struct File
     float collision_range;
     float minimum_mass;
     bool _minimum_mass_set;
+    Ogre::String resource_group; ///< Where the file was loaded from; every mod archive gets its own, see `RoR::CacheSystem::mountArchive()`
 
     // Report
     std::string loading_report;
@@ -49,6 +49,7 @@
 #include "Language.h"
 #include "MainMenu.h"
 #include "Network.h"
+#include "RayCast.h"
 #include "RoRFrameListener.h"
 #include "RoRVersion.h"
 #include "Settings.h"
@@ -216,6 +217,27 @@ float GameScript::getGroundHeight(Vector3& v)
     return result;
 }
 
+bool GameScript::castRay(Vector3& origin, Vector3& direction, float max_distance, Vector3& hit_pos, int& actor_id, int& node_id)
+{
+    actor_id = -1;
+    node_id = -1;
+    if (!App::GetSimController() || direction.isZeroLength())
+        return false;
+
+    RayCastQuery query(Ray(origin, direction.normalisedCopy()), max_distance);
+    RayCastResult hit;
+    if (!App::GetSimController()->GetBeamFactory()->CastRay(query, hit))
+        return false;
+
+    hit_pos = hit.position;
+    if (hit.actor)
+    {
+        actor_id = hit.actor->ar_instance_id;
+        node_id = hit.node;
+    }
+    return true;
+}
+
 float GameScript::getWaterHeight()
 {
     float result = 0.0f;
@@ -132,6 +132,15 @@ public:
 
     float getGroundHeight(Ogre::Vector3& v);
 
+    /**
+     * casts a ray against terrain, static collision and vehicle nodes
+     * @param hit_pos position of the nearest hit
+     * @param actor_id instance ID of the hit vehicle, -1 if static geometry was hit
+     * @param node_id hit node, -1 if static geometry was hit
+     * @return true if anything was hit within max_distance
+     */
+    bool castRay(Ogre::Vector3& origin, Ogre::Vector3& direction, float max_distance, Ogre::Vector3& hit_pos, int& actor_id, int& node_id);
+
     /**
      * sets the base water height
      * @param value base height in meters
@@ -646,6 +646,10 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String odefname)
 
 void TerrainObjectManager::PostLoadTerrain()
 {
+    // build all procedural roads at once
+    if (m_procedural_mgr)
+        m_procedural_mgr->updateAllObjects();
+
     // okay, now bake everything
     m_staticgeometry = gEnv->sceneManager->createStaticGeometry("bakeSG");
     m_staticgeometry->setCastShadows(true);
@@ -1334,6 +1338,24 @@ bool TerrainObjectManager::UpdateAnimatedObjects(float dt)
     return true;
 }
 
+void TerrainObjectManager::GetAnimationTimes(std::vector<float>& out) const
+{
+    out.resize(m_animated_objects.size());
+    for (size_t i = 0; i < m_animated_objects.size(); i++)
+    {
+        out[i] = (m_animated_objects[i].anim) ? m_animated_objects[i].anim->getTimePosition() : 0.f;
+    }
+}
+
+void TerrainObjectManager::SetAnimationTimes(std::vector<float> const& times)
+{
+    for (size_t i = 0; i < m_animated_objects.size() && i < times.size(); i++)
+    {
+        if (m_animated_objects[i].anim)
+            m_animated_objects[i].anim->setTimePosition(times[i]);
+    }
+}
+
 void TerrainObjectManager::LoadPredefinedActors()
 {
     // in netmode, don't load other actors!
@@ -58,6 +58,8 @@ public:
     bool           HasPredefinedActors() { return !m_predefined_actors.empty(); };
     void           PostLoadTerrain();
     bool           UpdateTerrainObjects(float dt);
+    void           GetAnimationTimes(std::vector<float>& out) const;   //!< Time positions of animated objects, for simulation snapshots
+    void           SetAnimationTimes(std::vector<float> const& times);
 
     typedef struct localizer_t
     {
@@ -42,6 +42,9 @@ SurveyMapManager::SurveyMapManager() :
     mAlpha(1.0f)
     , mMapCenter(Vector2::ZERO)
     , mMapCenterThreshold(5.0f)
+    , mPlayerPosition(Vector2::ZERO)
+    , mDistantEntityRange(300.0f)
+    , mDistantEntityTimer(0.0f)
     , mMapEntitiesVisible(false)
     , mMapMode(SURVEY_MAP_NONE)
     , mMapSize(Vector3::ZERO)
@@ -74,15 +77,16 @@ void SurveyMapManager::init()
     mMapCenter = Vector2(mMapSize.x / 2.0f, mMapSize.z / 2.0f);
 
     mMapTextureCreator = new SurveyMapTextureCreator();
-    mMapTextureCreator->update();
     setMapTexture(mMapTextureCreator->getTextureName());
+    updateMapTexture();
 
     mMapCenterThreshold = FSETTING("SurveyMapCenterThreshold", 5.0f);
+    mDistantEntityRange = FSETTING("SurveyMapDistantEntityRange", 300.0f);
 }
 
 std::string SurveyMapManager::GetMinimapTextureName()
 {
-    return mMapTextureCreator->getTextureName();
+    return mMapTextureCreator->getOverviewTextureName();
 }
 
 SurveyMapEntity* SurveyMapManager::createMapEntity(String type)
@@ -157,6 +161,14 @@ void SurveyMapManager::updateMapEntityPositions()
     }
 }
 
+void SurveyMapManager::updateMapTexture()
+{
+    mMapTextureCreator->update();
+
+    Ogre::Rect coord = mMapTextureCreator->getTextureCoord();
+    mMapTexture->setImageCoord(MyGUI::IntCoord(coord.left, coord.top, coord.width(), coord.height()));
+}
+
 void SurveyMapManager::updateRenderMetrics()
 {
     if (RoR::App::GetOgreSubsystem()->GetRenderWindow())
@@ -176,7 +188,7 @@ void SurveyMapManager::setMapZoom(Real zoomValue, bool update /*= true*/, bool p
 
     if (update)
     {
-        mMapTextureCreator->update();
+        updateMapTexture();
         if (permanent)
             mMapTextureNeedsUpdate = true;
     }
@@ -199,7 +211,7 @@ void SurveyMapManager::setMapCenter(Vector2 position, bool update /*= true*/)
 
     if (update)
     {
-        mMapTextureCreator->update();
+        updateMapTexture();
         mMapTextureNeedsUpdate = true;
     }
 }
@@ -283,10 +295,16 @@ void SurveyMapManager::Update(Ogre::Real dt, Actor* curr_truck)
         return;
 
     mVelocity = 0.0f;
+    mDistantEntityTimer += dt;
 
     if (curr_truck)
     {
         mVelocity = curr_truck->ar_nodes[0].Velocity.length();
+        mPlayerPosition = Vector2(curr_truck->getPosition().x, curr_truck->getPosition().z);
+    }
+    else if (gEnv->player)
+    {
+        mPlayerPosition = Vector2(gEnv->player->getPosition().x, gEnv->player->getPosition().z);
     }
 
     if (RoR::App::GetInputEngine()->getEventBoolValueBounce(EV_SURVEY_MAP_TOGGLE_VIEW))
@@ -430,10 +448,22 @@ void SurveyMapManager::toggleMapAlpha()
 
 void SurveyMapManager::UpdateVehicles(Actor** vehicles, int num_vehicles)
 {
+    // Icons of distant actors move only a few pixels per frame; update them at a lower rate
+    const float DISTANT_ENTITY_UPDATE_INTERVAL = 0.5f;
+    bool update_distant = (mDistantEntityTimer >= DISTANT_ENTITY_UPDATE_INTERVAL);
+    if (update_distant)
+        mDistantEntityTimer = 0.0f;
+
     for (int t = 0; t < num_vehicles; t++)
     {
         if (!vehicles[t])
             continue;
+        if (!update_distant)
+        {
+            Vector3 pos = vehicles[t]->getPosition();
+            if (mPlayerPosition.squaredDistance(Vector2(pos.x, pos.z)) > mDistantEntityRange * mDistantEntityRange)
+                continue;
+        }
         SurveyMapEntity* e = getMapEntityByName("Truck" + TOSTRING(vehicles[t]->ar_instance_id));
         if (e)
         {
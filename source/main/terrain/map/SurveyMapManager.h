@@ -108,6 +108,7 @@ protected:
     bool mMapEntitiesVisible;
 
     void updateMapEntityPositions();
+    void updateMapTexture();
     void setMapEntitiesVisibility(bool visibility);
 
     int mMapMode;
@@ -115,6 +116,10 @@ protected:
 
     float mMapCenterThreshold;
 
+    Ogre::Vector2 mPlayerPosition;
+    float mDistantEntityRange;        //!< Icons of actors further from player are updated less often
+    float mDistantEntityTimer;
+
     int realw, realh;
     int rWinLeft, rWinTop;
     unsigned int rWinWidth, rWinHeight, rWinDepth;
@@ -22,8 +22,16 @@
 
 #include "Application.h"
 #include "IWater.h"
+#include "PlatformUtils.h"
 #include "SurveyMapManager.h"
 #include "TerrainManager.h"
+#include "ThreadPool.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
 
 using namespace Ogre;
 using namespace RoR;
@@ -39,6 +47,10 @@ SurveyMapTextureCreator::SurveyMapTextureCreator() :
     , mMapCenter(Vector2::ZERO)
     , mMapSize(Vector3::ZERO)
     , mMapZoom(0.0f)
+    , mCompositeLevel(-1)
+    , mCompositeX(0)
+    , mCompositeZ(0)
+    , mTextureCoord(0, 0, 0, 0)
 {
     mCounter++;
     init();
@@ -46,12 +58,16 @@ SurveyMapTextureCreator::SurveyMapTextureCreator() :
 
 bool SurveyMapTextureCreator::init()
 {
-    TexturePtr texture = TextureManager::getSingleton().createManual(getTextureName(), ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 2048, 2048, TU_RENDERTARGET, PF_R8G8B8, TU_RENDERTARGET);
+    String group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    mTileTexture = TextureManager::getSingleton().createManual("MapRttTile" + TOSTRING(mCounter), group, TEX_TYPE_2D, TILE_SIZE, TILE_SIZE, 0, PF_R8G8B8, TU_RENDERTARGET);
+    mCompositeTexture = TextureManager::getSingleton().createManual(getTextureName(), group, TEX_TYPE_2D, COMPOSITE_TILES * TILE_SIZE, COMPOSITE_TILES * TILE_SIZE, 0, PF_X8R8G8B8, TU_DEFAULT);
+    mOverviewTexture = TextureManager::getSingleton().createManual(getOverviewTextureName(), group, TEX_TYPE_2D, TILE_SIZE << OVERVIEW_LEVEL, TILE_SIZE << OVERVIEW_LEVEL, 0, PF_X8R8G8B8, TU_DEFAULT);
 
-    if (texture.isNull())
-        return false;;
+    if (mTileTexture.isNull() || mCompositeTexture.isNull() || mOverviewTexture.isNull())
+        return false;
 
-    mRttTex = texture->getBuffer()->getRenderTarget();
+    mRttTex = mTileTexture->getBuffer()->getRenderTarget();
 
     if (!mRttTex)
         return false;
@@ -66,7 +82,7 @@ bool SurveyMapTextureCreator::init()
     mViewport->setShadowsEnabled(false);
     mViewport->setSkiesEnabled(false);
 
-    mMaterial = MaterialManager::getSingleton().create(getMaterialName(), ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    mMaterial = MaterialManager::getSingleton().create(getMaterialName(), group);
 
     if (mMaterial.isNull())
         return false;
@@ -79,6 +95,19 @@ bool SurveyMapTextureCreator::init()
     mCamera->setProjectionType(PT_ORTHOGRAPHIC);
     mCamera->setNearClipDistance(1.0f);
 
+    mTileCacheDir = std::string(App::sys_cache_dir.GetActive()) + PATH_SLASH + "surveymap";
+    if (!FolderExists(mTileCacheDir))
+        CreateFolder(mTileCacheDir);
+
+    mTerrainStamp = computeTerrainStamp();
+
+    mMapSize = App::GetSimTerrain()->getMaxTerrainSize();
+    if (mMapSize.x > 0.0f && mMapSize.z > 0.0f)
+    {
+        composite(mOverviewTexture, OVERVIEW_LEVEL, 0, 0, false); // During terrain loading, hitches don't matter
+        mOverviewTexture->convertToImage(mOverviewImage);
+    }
+
     return true;
 }
 
@@ -105,19 +134,232 @@ void SurveyMapTextureCreator::update()
         mMapZoom = gEnv->surveyMap->getMapZoom();
     }
 
+    if (mMapSize.x <= 0.0f || mMapSize.z <= 0.0f)
+        return;
+
     float orthoWindowWidth = mMapSize.x - (mMapSize.x - 20.0f) * mMapZoom;
     float orthoWindowHeight = mMapSize.z - (mMapSize.z - 20.0f) * mMapZoom;
 
+    int level = pickLevel(orthoWindowWidth);
+    int numTiles = 1 << level;
+    float tileWidth = mMapSize.x / numTiles;
+    float tileHeight = mMapSize.z / numTiles;
+    float left = (mMapCenter.x - orthoWindowWidth / 2.0f) / tileWidth;  // In tiles
+    float top = (mMapCenter.y - orthoWindowHeight / 2.0f) / tileHeight;
+
+    int maxOrigin = std::max(0, numTiles - COMPOSITE_TILES);
+    int originX = Math::Clamp(static_cast<int>(std::floor(left)), 0, maxOrigin);
+    int originZ = Math::Clamp(static_cast<int>(std::floor(top)), 0, maxOrigin);
+
+    // Only re-composite when the set of visible tiles changes; panning within it just moves the texture coords
+    if (level != mCompositeLevel || originX != mCompositeX || originZ != mCompositeZ)
+    {
+        composite(mCompositeTexture, level, originX, originZ, true);
+        mCompositeLevel = level;
+        mCompositeX = originX;
+        mCompositeZ = originZ;
+    }
+    processPendingTile();
+
+    long used = std::min(numTiles, static_cast<int>(COMPOSITE_TILES)) * TILE_SIZE;
+    long width = std::min(used, static_cast<long>(orthoWindowWidth / tileWidth * TILE_SIZE));
+    long height = std::min(used, static_cast<long>(orthoWindowHeight / tileHeight * TILE_SIZE));
+    long x = Math::Clamp(static_cast<long>((left - originX) * TILE_SIZE), 0L, used - width);
+    long y = Math::Clamp(static_cast<long>((top - originZ) * TILE_SIZE), 0L, used - height);
+
+    mTextureCoord = Rect(x, y, x + width, y + height);
+}
+
+int SurveyMapTextureCreator::pickLevel(float viewWidth)
+{
+    // Coarsest level where the view spans at least 2 tiles, so the displayed image has
+    // at least 2 * TILE_SIZE pixels across and the composite never needs more than 5 tiles.
+    for (int level = 0; level < MAX_LEVEL; level++)
+    {
+        if (viewWidth * (1 << level) >= 2.0f * mMapSize.x)
+            return level;
+    }
+    return MAX_LEVEL;
+}
+
+void SurveyMapTextureCreator::composite(TexturePtr& target, int level, int originX, int originZ, bool deferMissing)
+{
+    HardwarePixelBufferSharedPtr buffer = target->getBuffer();
+    int numTiles = 1 << level;
+    int capacity = static_cast<int>(target->getWidth()) / TILE_SIZE;
+
+    if (deferMissing)
+        mPendingTiles.clear(); // Tiles of the previous composite aren't needed anymore
+
+    for (int z = originZ; z < std::min(numTiles, originZ + capacity); z++)
+    {
+        for (int x = originX; x < std::min(numTiles, originX + capacity); x++)
+        {
+            size_t dstX = (x - originX) * TILE_SIZE;
+            size_t dstZ = (z - originZ) * TILE_SIZE;
+            Box dst(dstX, dstZ, dstX + TILE_SIZE, dstZ + TILE_SIZE);
+
+            const Image* tile = findTile((level << 24) | (z << 12) | x);
+            if (tile == nullptr && !deferMissing)
+                tile = &loadTile(level, x, z);
+
+            if (tile != nullptr)
+            {
+                buffer->blitFromMemory(tile->getPixelBox(), dst);
+            }
+            else
+            {
+                blitPlaceholder(buffer, level, x, z, dst);
+                mPendingTiles.push_back((level << 24) | (z << 12) | x);
+            }
+        }
+    }
+}
+
+void SurveyMapTextureCreator::processPendingTile()
+{
+    if (mPendingTiles.empty())
+        return;
+
+    // Pending tiles always belong to the current composite; see `composite()`
+    int key = mPendingTiles.front();
+    mPendingTiles.pop_front();
+    int level = key >> 24;
+    int z = (key >> 12) & 0xFFF;
+    int x = key & 0xFFF;
+
+    const Image& tile = loadTile(level, x, z);
+    size_t dstX = (x - mCompositeX) * TILE_SIZE;
+    size_t dstZ = (z - mCompositeZ) * TILE_SIZE;
+    mCompositeTexture->getBuffer()->blitFromMemory(tile.getPixelBox(), Box(dstX, dstZ, dstX + TILE_SIZE, dstZ + TILE_SIZE));
+}
+
+void SurveyMapTextureCreator::blitPlaceholder(HardwarePixelBufferSharedPtr& buffer, int level, int x, int z, Box const& dst)
+{
+    if (mOverviewImage.getWidth() == 0)
+        return;
+
+    // The overview covers the whole map; blitting a part of it into a bigger box upscales it
+    size_t span = std::max(static_cast<size_t>(mOverviewImage.getWidth()) >> level, static_cast<size_t>(1));
+    Box src(x * span, z * span, (x + 1) * span, (z + 1) * span);
+    buffer->blitFromMemory(mOverviewImage.getPixelBox().getSubVolume(src), dst);
+}
+
+const Image* SurveyMapTextureCreator::findTile(int key)
+{
+    auto found = mTiles.find(key);
+    return (found != mTiles.end()) ? &found->second : nullptr;
+}
+
+const Image& SurveyMapTextureCreator::loadTile(int level, int x, int z)
+{
+    int key = (level << 24) | (z << 12) | x;
+
+    if (mTiles.size() >= MAX_CACHED_TILES)
+    {
+        mTiles.erase(mTilesLoadOrder.front());
+        mTilesLoadOrder.pop_front();
+    }
+
+    Image& img = mTiles[key];
+    mTilesLoadOrder.push_back(key);
+
+    String path = getTileFileName(level, x, z);
+    if (FileExists(path))
+    {
+        try
+        {
+            std::ifstream* ifs = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)(path.c_str(), std::ios::binary);
+            DataStreamPtr stream(OGRE_NEW FileStreamDataStream(path, ifs, true));
+            img.load(stream, "png");
+            if (img.getWidth() == TILE_SIZE && img.getHeight() == TILE_SIZE)
+                return img;
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG("SurveyMap: failed to load cached tile '" + path + "', message: " + e.getFullDescription());
+        }
+    }
+
+    bakeTile(level, x, z, img);
+
+    // PNG encoding and the disk write are slow; only the bake above needs the render thread
+    std::shared_ptr<Image> copy = std::make_shared<Image>(img);
+    std::function<void()> save = [copy, path]()
+    {
+        try
+        {
+            copy->save(path);
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG("SurveyMap: failed to save tile '" + path + "', message: " + e.getFullDescription());
+        }
+    };
+    if (gEnv->threadPool)
+        gEnv->threadPool->RunTask(save);
+    else
+        save();
+
+    return img;
+}
+
+void SurveyMapTextureCreator::bakeTile(int level, int x, int z, Image& img)
+{
+    float tileWidth = mMapSize.x / (1 << level);
+    float tileHeight = mMapSize.z / (1 << level);
+    Vector2 center((x + 0.5f) * tileWidth, (z + 0.5f) * tileHeight);
+
     mCamera->setFarClipDistance(mMapSize.y + 3.0f);
-    mCamera->setOrthoWindow(orthoWindowWidth, orthoWindowHeight);
-    mCamera->setPosition(Vector3(mMapCenter.x, mMapSize.y + 2.0f, mMapCenter.y));
-    mCamera->lookAt(Vector3(mMapCenter.x, 0.0f, mMapCenter.y));
+    mCamera->setOrthoWindow(tileWidth, tileHeight);
+    mCamera->setPosition(Vector3(center.x, mMapSize.y + 2.0f, center.y));
+    mCamera->lookAt(Vector3(center.x, 0.0f, center.y));
 
     preRenderTargetUpdate();
 
     mRttTex->update();
 
     postRenderTargetUpdate();
+
+    mTileTexture->convertToImage(img);
+}
+
+String SurveyMapTextureCreator::getTileFileName(int level, int x, int z)
+{
+    // Map size and terrain stamp are part of the name, so a modified terrain doesn't reuse stale tiles
+    return mTileCacheDir + PATH_SLASH + App::sim_terrain_name.GetActive()
+        + "-" + TOSTRING(static_cast<int>(mMapSize.x)) + "x" + TOSTRING(static_cast<int>(mMapSize.z))
+        + "-" + mTerrainStamp
+        + "-" + TOSTRING(level) + "-" + TOSTRING(x) + "-" + TOSTRING(z) + ".png";
+}
+
+String SurveyMapTextureCreator::computeTerrainStamp()
+{
+    // Names, sizes and modification times of all files in the terrain's resource group:
+    // editing the heightmap, .tobj, .odef or any mesh/texture gives new tiles.
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    String terrain_file = App::sim_terrain_name.GetActive();
+    uint64_t stamp = 0;
+    try
+    {
+        String group = rgm.findGroupContainingResource(terrain_file);
+        FileInfoListPtr files = rgm.listResourceFileInfo(group);
+        std::hash<std::string> hasher;
+        for (FileInfo const& file : *files)
+        {
+            std::string key = file.filename + ":" + TOSTRING(file.uncompressedSize) + ":"
+                + TOSTRING(static_cast<long>(rgm.resourceModifiedTime(group, file.filename)));
+            stamp += hasher(key); // Order of the listing doesn't matter
+        }
+    }
+    catch (Ogre::Exception& e)
+    {
+        LOG("SurveyMap: cannot stamp terrain files, cached tiles may be stale. Message: " + e.getFullDescription());
+    }
+
+    char buf[20];
+    std::snprintf(buf, sizeof(buf), "%08x", static_cast<unsigned>(stamp ^ (stamp >> 32)));
+    return buf;
 }
 
 String SurveyMapTextureCreator::getMaterialName()
@@ -135,6 +377,10 @@ String SurveyMapTextureCreator::getTextureName()
     return "MapRttTex" + TOSTRING(mCounter);
 }
 
+String SurveyMapTextureCreator::getOverviewTextureName()
+{
+    return "MapOverviewTex" + TOSTRING(mCounter);
+}
 void SurveyMapTextureCreator::preRenderTargetUpdate()
 {
     if (mStatics)
@@ -24,6 +24,19 @@
 
 #include "RoRPrerequisites.h"
 
+#include <deque>
+#include <map>
+
+/// Renders the survey map background.
+///
+/// The static terrain is rendered once into square image tiles at several zoom levels
+/// (level L splits the map into 2^L x 2^L tiles). Tiles are baked on first use and stored
+/// in the cache directory, so subsequent sessions on the same terrain don't render at all.
+/// The visible region is then composited from tiles on the CPU; `getTextureCoord()` gives
+/// the part of the texture which should be displayed.
+///
+/// To avoid hitches, at most one tile is loaded or baked per frame; until then the tile
+/// shows an upscaled part of the overview. PNG files are written by a worker thread.
 class SurveyMapTextureCreator : public Ogre::RenderTargetListener, public ZeroedMemoryAllocator
 {
 public:
@@ -33,6 +46,8 @@ public:
     Ogre::String getMaterialName();
     Ogre::String getCameraName();
     Ogre::String getTextureName();
+    Ogre::String getOverviewTextureName(); //!< Entire map at fixed resolution; never changes after init.
+    Ogre::Rect   getTextureCoord() { return mTextureCoord; } //!< Pixel rectangle of `getTextureName()` covering the current view.
 
     void setStaticGeometry(Ogre::StaticGeometry* staticGeometry);
 
@@ -40,14 +55,33 @@ public:
 
 protected:
 
+    static const int TILE_SIZE = 512;          //!< Pixels
+    static const int COMPOSITE_TILES = 5;      //!< Composite texture width/height in tiles
+    static const int MAX_LEVEL = 7;
+    static const int OVERVIEW_LEVEL = 1;
+    static const int MAX_CACHED_TILES = 40;    //!< Decoded tiles kept in memory
+
     bool init();
 
+    int  pickLevel(float viewWidth);
+    void composite(Ogre::TexturePtr& target, int level, int originX, int originZ, bool deferMissing);
+    void processPendingTile();
+    const Ogre::Image* findTile(int key);
+    const Ogre::Image& loadTile(int level, int x, int z); //!< From disk, or bake and save
+    void bakeTile(int level, int x, int z, Ogre::Image& img);
+    void blitPlaceholder(Ogre::HardwarePixelBufferSharedPtr& buffer, int level, int x, int z, Ogre::Box const& dst);
+    Ogre::String getTileFileName(int level, int x, int z);
+    Ogre::String computeTerrainStamp();
+
     void preRenderTargetUpdate();
     void postRenderTargetUpdate();
 
     Ogre::Camera* mCamera;
     Ogre::MaterialPtr mMaterial;
     Ogre::RenderTarget* mRttTex;
+    Ogre::TexturePtr mTileTexture;
+    Ogre::TexturePtr mCompositeTexture;
+    Ogre::TexturePtr mOverviewTexture;
     Ogre::StaticGeometry* mStatics;
     Ogre::TextureUnitState* mTextureUnitState;
     Ogre::Viewport* mViewport;
@@ -56,5 +90,17 @@ protected:
     Ogre::Vector2 mMapCenter;
     Ogre::Vector3 mMapSize;
 
+    int mCompositeLevel;   //!< -1 = nothing composited yet
+    int mCompositeX;       //!< Tile coordinates of the composite's top-left tile
+    int mCompositeZ;
+    Ogre::Rect mTextureCoord;
+
+    Ogre::String mTileCacheDir;
+    Ogre::String mTerrainStamp;        //!< Changes when any file of the terrain changes; part of tile file names
+    std::map<int, Ogre::Image> mTiles; //!< Key: level << 24 | z << 12 | x
+    std::deque<int> mTilesLoadOrder;
+    std::deque<int> mPendingTiles;     //!< Tiles of the composite still showing a placeholder
+    Ogre::Image mOverviewImage;        //!< CPU copy of the overview, source of placeholders
+
     static int mCounter;
 };
@@ -0,0 +1,213 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ThreadPlacement.h"
+
+#include "Application.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#ifdef __linux__
+#   include <pthread.h>
+#   include <sched.h>
+#   include <sys/resource.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+using namespace RoR;
+
+static std::atomic<int> s_reserved_cpu(-1);
+#ifdef __linux__
+static cpu_set_t        s_affinity_before_reserve; //!< Of the thread which reserved the CPU
+#endif
+
+ThreadPlacement ThreadPlacement::FromConfig(const char* cpu_list, int nice, const char* pool_name)
+{
+    ThreadPlacement placement;
+    if (!ThreadPlacement::ParseCpuList(cpu_list, placement.cpus))
+    {
+        RoR::LogFormat("[RoR|Threads] %s: invalid CPU list '%s', using any CPU", pool_name, cpu_list);
+        placement.cpus.clear();
+    }
+    placement.nice = nice;
+
+#ifndef __linux__
+    if (!placement.cpus.empty() || placement.nice != 0)
+    {
+        RoR::LogFormat("[RoR|Threads] %s: thread placement is only supported on Linux, ignoring", pool_name);
+        return ThreadPlacement();
+    }
+#endif
+    return placement;
+}
+
+bool ThreadPlacement::ParseCpuList(std::string const& str, std::vector<int>& out)
+{
+    out.clear();
+    std::istringstream stream(str);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        int first = -1, last = -1;
+        char tail = 0;
+        const int num = std::sscanf(range.c_str(), " %d - %d %c", &first, &last, &tail);
+        if (num == 1)
+            last = first;
+        else if (num != 2)
+            return (num == EOF && range.find_first_not_of(" \t") == std::string::npos); // Allow empty items
+        if (first < 0 || last < first || last >= 1024)
+            return false;
+        for (int cpu = first; cpu <= last; cpu++)
+            out.push_back(cpu);
+    }
+    return true;
+}
+
+std::string ThreadPlacement::FormatCpuList(std::vector<int> const& cpus)
+{
+    if (cpus.empty())
+        return "any";
+
+    std::ostringstream out;
+    for (size_t i = 0; i < cpus.size(); i++)
+    {
+        if (i > 0)
+            out << ",";
+        out << cpus[i];
+    }
+    return out.str();
+}
+
+bool ThreadPlacement::ReserveCpuForCurrentThread(int cpu)
+{
+#ifdef __linux__
+    const int err = pthread_getaffinity_np(pthread_self(), sizeof(s_affinity_before_reserve), &s_affinity_before_reserve);
+    if (err != 0)
+    {
+        RoR::LogFormat("[RoR|Threads] main: cannot get CPU affinity: %s", std::strerror(err));
+        return false;
+    }
+#endif
+
+    ThreadPlacement placement;
+    placement.cpus.push_back(cpu);
+    if (!ApplyThreadPlacement(placement, nullptr)) // Don't rename the main thread, it names the process
+        return false;
+
+    s_reserved_cpu = cpu;
+    RoR::LogFormat("[RoR|Threads] Render thread pinned to CPU %d", cpu);
+    return true;
+}
+
+void ThreadPlacement::ReleaseReservedCpu()
+{
+    if (s_reserved_cpu == -1)
+        return;
+
+    s_reserved_cpu = -1;
+#ifdef __linux__
+    // Restore, rather than widen to all CPUs: the process may have been started with a narrower set (taskset, cgroups)
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(s_affinity_before_reserve), &s_affinity_before_reserve);
+    if (err != 0)
+    {
+        RoR::LogFormat("[RoR|Threads] main: cannot restore CPU affinity: %s", std::strerror(err));
+    }
+#endif
+}
+
+int ThreadPlacement::GetReservedCpu()
+{
+    return s_reserved_cpu;
+}
+
+bool RoR::ApplyThreadPlacement(ThreadPlacement const& placement, const char* thread_name)
+{
+#ifdef __linux__
+    if (thread_name != nullptr)
+    {
+        char name[16] = {}; // Linux limit, including terminator
+        std::strncpy(name, thread_name, sizeof(name) - 1);
+        pthread_setname_np(pthread_self(), name);
+    }
+    else
+    {
+        thread_name = "main";
+    }
+
+    bool ok = true;
+    const int reserved_cpu = s_reserved_cpu;
+    if (!placement.cpus.empty() || reserved_cpu != -1)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (placement.cpus.empty())
+        {
+            // Any CPU the process may use except the reserved one; the mask was saved before reserving
+            set = s_affinity_before_reserve;
+            if (CPU_COUNT(&set) > 1)
+                CPU_CLR(reserved_cpu, &set);
+        }
+        else
+        {
+            for (int cpu: placement.cpus)
+            {
+                if (cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &set);
+            }
+        }
+
+        const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0)
+        {
+            RoR::LogFormat("[RoR|Threads] %s: cannot set CPU affinity '%s': %s",
+                thread_name, ThreadPlacement::FormatCpuList(placement.cpus).c_str(), std::strerror(err));
+            ok = false;
+        }
+    }
+
+    if (placement.nice != 0)
+    {
+        // Threads have their own nice value on Linux, addressed by thread ID
+        const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, placement.nice) != 0)
+        {
+            RoR::LogFormat("[RoR|Threads] %s: cannot set priority %d: %s (negative values need CAP_SYS_NICE)",
+                thread_name, placement.nice, std::strerror(errno));
+            ok = false;
+        }
+    }
+    return ok;
+#else
+    return placement.cpus.empty() && placement.nice == 0;
+#endif
+}
+
+int RoR::GetCurrentCpu()
+{
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
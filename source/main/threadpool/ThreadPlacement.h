@@ -0,0 +1,67 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  CPU affinity and scheduling priority of worker threads.
+///
+/// Applied by each thread to itself when it starts. Only implemented on Linux;
+/// on other platforms only the default placement can be applied.
+///
+/// When a CPU is reserved for the render (main) thread, threads with an empty CPU
+/// list are kept off it. Threads spawned by the main thread inherit its affinity,
+/// so every long-lived thread should apply a placement, even the default one.
+///
+/// Placements are only read when a thread starts. The worker and sim pools are created
+/// with each `ActorManager`, so changed app_worker_* / app_sim_thread_* / app_render_cpu
+/// settings take effect from the next simulation session, not in a running one.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+struct ThreadPlacement
+{
+    ThreadPlacement(): nice(0) {}
+
+    std::vector<int> cpus; //!< Allowed CPUs; empty = any except the reserved one
+    int              nice; //!< -20 (highest priority) .. 19; 0 = inherit
+
+    /// @param cpu_list Like "0,2,4-7"; empty = any
+    /// @return Default placement (logged) if the list is invalid
+    static ThreadPlacement FromConfig(const char* cpu_list, int nice, const char* pool_name);
+
+    static bool        ParseCpuList(std::string const& str, std::vector<int>& out);
+    static std::string FormatCpuList(std::vector<int> const& cpus);
+
+    /// Pins the calling (render) thread to `cpu` and keeps threads with default placement off it.
+    static bool        ReserveCpuForCurrentThread(int cpu);
+    static void        ReleaseReservedCpu(); //!< Call from the thread which reserved the CPU; restores its previous affinity
+    static int         GetReservedCpu();
+};
+
+/// Applies the placement to the calling thread and names it (visible in `top -H`, debuggers).
+/// @return False if not supported or refused by the OS; errors are logged.
+bool ApplyThreadPlacement(ThreadPlacement const& placement, const char* thread_name);
+
+int GetCurrentCpu(); //!< CPU the calling thread runs on, -1 if unknown
+
+} // namespace RoR
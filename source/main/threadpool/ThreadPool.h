@@ -19,14 +19,19 @@ along with Rigs of Rods.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "ThreadPlacement.h"
+
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 
@@ -101,20 +106,42 @@ class Task
  */
 class ThreadPool {
 public:
+    /// Snapshot of a worker's counters, see GetWorkerStats()
+    struct WorkerStats
+    {
+        uint64_t tasks;
+        uint64_t migrations; ///< Times the worker was found on a different CPU after a task
+        double   busy_ms;
+        double   idle_ms;    ///< Waiting for tasks
+        int      last_cpu;   ///< -1 if unknown
+    };
+
     /** \brief Construct thread pool and launch worker threads.
      *
      * @param num_threads Number of worker threads to use
+     * @param name Prefix of worker thread names
+     * @param placement CPU affinity and priority of the workers
      */
-    ThreadPool(int num_threads)
+    ThreadPool(int num_threads, std::string const& name = "ror-worker", RoR::ThreadPlacement const& placement = RoR::ThreadPlacement())
+        : m_name(name), m_placement(placement)
     {
         if (num_threads < 1) { throw std::invalid_argument("Number of threads is zero or negative."); }
 
+        for (int i = 0; i < num_threads; ++i) {
+            m_counters.emplace_back(new WorkerCounters());
+        }
+
         // Generic function (to be run on a separate thread) within which submitted tasks
         // are executed. It implements an endless loop (only returning when the ThreadPool
         // instance itself is destructed) which constantly checks the task queue, grabbing
         // and executing the frontmost task while the queue is not empty.
-        auto thread_body = [this]{ 
+        auto thread_body = [this](int index){ 
+            const std::string thread_name = m_name + "-" + std::to_string(index);
+            RoR::ApplyThreadPlacement(m_placement, thread_name.c_str());
+            WorkerCounters& counters = *m_counters[index];
+
             while (true) {
+                const auto idle_start = std::chrono::steady_clock::now();
                 // Get next task from queue (synchronized access via taskqueue_mutex).
                 // If the queue is empty wait until either
                 //   - being signaled about an available task.
@@ -130,18 +157,20 @@ public:
                 queue_lock.unlock();
 
                 // Execute the actual task and signal the associated Task instance when finished.
+                const auto busy_start = std::chrono::steady_clock::now();
                 {
                     std::lock_guard<std::mutex> task_lock(current_task->m_task_mutex);
                     current_task->m_task_func();
                     current_task->m_is_finished = true;
                 }
                 current_task->m_finish_cv.notify_all();
+                counters.Update(idle_start, busy_start, std::chrono::steady_clock::now(), RoR::GetCurrentCpu());
             }
         };
 
         // Launch the specified number of threads
         for (int i = 0; i < num_threads; ++i) {
-            m_threads.emplace_back(thread_body);
+            m_threads.emplace_back(thread_body, i);
         }
     }
 
@@ -189,6 +218,66 @@ public:
         for(const auto &h : handles) { h->join(); }
     }
 
+    std::string const& GetName() const { return m_name; }
+    int GetNumThreads() const { return static_cast<int>(m_threads.size()); }
+    RoR::ThreadPlacement const& GetPlacement() const { return m_placement; }
+
+    /// Counters are updated by workers without locking; the snapshot may be slightly inconsistent.
+    std::vector<WorkerStats> GetWorkerStats() const
+    {
+        std::vector<WorkerStats> stats;
+        for (const auto &c : m_counters) {
+            WorkerStats s;
+            s.tasks      = c->tasks.load(std::memory_order_relaxed);
+            s.migrations = c->migrations.load(std::memory_order_relaxed);
+            s.busy_ms    = c->busy_ns.load(std::memory_order_relaxed) / 1.0e6;
+            s.idle_ms    = c->idle_ns.load(std::memory_order_relaxed) / 1.0e6;
+            s.last_cpu   = c->last_cpu.load(std::memory_order_relaxed);
+            stats.push_back(s);
+        }
+        return stats;
+    }
+
+    void ResetWorkerStats()
+    {
+        for (auto &c : m_counters) {
+            c->tasks = 0;
+            c->migrations = 0;
+            c->busy_ns = 0;
+            c->idle_ns = 0;
+        }
+    }
+
+private:
+    struct WorkerCounters
+    {
+        typedef std::chrono::steady_clock::time_point TimePoint;
+
+        void Update(TimePoint idle_start, TimePoint busy_start, TimePoint busy_end, int cpu)
+        {
+            using std::chrono::duration_cast;
+            using std::chrono::nanoseconds;
+            idle_ns.fetch_add(duration_cast<nanoseconds>(busy_start - idle_start).count(), std::memory_order_relaxed);
+            busy_ns.fetch_add(duration_cast<nanoseconds>(busy_end - busy_start).count(), std::memory_order_relaxed);
+            tasks.fetch_add(1, std::memory_order_relaxed);
+            const int prev_cpu = last_cpu.exchange(cpu, std::memory_order_relaxed);
+            if (prev_cpu != -1 && prev_cpu != cpu) {
+                migrations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> migrations{0};
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<uint64_t> idle_ns{0};
+        std::atomic<int>      last_cpu{-1};
+    };
+
+    const std::string m_name;
+    const RoR::ThreadPlacement m_placement;
+    std::vector<std::unique_ptr<WorkerCounters>> m_counters; ///< One per worker thread; created before workers start
+
+public:
     std::atomic_bool m_terminate{false};            ///< Indicates destruction of ThreadPool instance to worker threads
     std::vector<std::thread> m_threads;             ///< Collection of worker threads to run tasks
     std::queue<std::shared_ptr<Task>> m_taskqueue;  ///< Queue of submitted tasks pending for execution
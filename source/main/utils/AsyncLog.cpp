@@ -0,0 +1,271 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "AsyncLog.h"
+
+#include "Application.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace RoR;
+using namespace RoR::AsyncLogDetail;
+
+static const size_t RING_SIZE            = 1024; // Records per thread; power of 2
+static const int    WRITER_INTERVAL_MS   = 10;
+static const char*  CATEGORY_NAMES[]     = { "General", "BeamBreak", "BeamDeform", "Trigger", "Network" };
+static_assert(sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]) == static_cast<size_t>(LogCategory::COUNT),
+    "CATEGORY_NAMES must match LogCategory");
+
+/// Single producer (owning thread), single consumer (writer thread)
+struct LogRing
+{
+    Record                records[RING_SIZE];
+    std::atomic<size_t>   head{0}; //!< Next record to write; only modified by producer
+    std::atomic<size_t>   tail{0}; //!< Next record to read; only modified by consumer
+    std::atomic<unsigned> dropped{0};
+};
+
+struct CategoryLimit
+{
+    std::atomic<int64_t>  window{0}; //!< Current 1-second window
+    std::atomic<int>      count{0};
+    std::atomic<unsigned> suppressed{0};
+};
+
+static std::vector<std::unique_ptr<LogRing>> s_rings;      // Rings are never freed; threads in this app are long-lived
+static std::mutex                             s_rings_mutex;
+static CategoryLimit                          s_limits[static_cast<size_t>(LogCategory::COUNT)];
+static std::thread*                           s_writer = nullptr; // Not destroyed at exit - a joinable std::thread would terminate()
+static std::mutex                             s_writer_mutex;
+static std::condition_variable                s_writer_cv;
+static std::atomic<bool>                      s_running{false};
+static std::atomic<int>                       s_submitting{0}; // Producers between the `s_running` check and the push
+static thread_local LogRing*                  t_ring = nullptr;
+
+static LogRing* GetThreadRing()
+{
+    if (t_ring == nullptr)
+    {
+        std::unique_ptr<LogRing> ring(new LogRing());
+        t_ring = ring.get();
+        std::lock_guard<std::mutex> lock(s_rings_mutex);
+        s_rings.push_back(std::move(ring));
+    }
+    return t_ring;
+}
+
+static void FormatRecord(Record const& rec, std::string& out)
+{
+    out.clear();
+    char spec[32];
+    char buf[256];
+    size_t arg = 0;
+    for (const char* c = rec.fmt; *c != '\0'; ++c)
+    {
+        if (*c != '%')
+        {
+            out += *c;
+            continue;
+        }
+        if (c[1] == '%')
+        {
+            out += '%';
+            ++c;
+            continue;
+        }
+
+        // Copy the conversion spec without length modifiers - argument types are known.
+        size_t len = 0;
+        spec[len++] = *c++;
+        while (*c != '\0' && std::strchr("-+ #0123456789.", *c) && len < sizeof(spec) - 4)
+            spec[len++] = *c++;
+        while (*c != '\0' && std::strchr("hljztL", *c))
+            ++c;
+        if (*c == '\0' || arg >= rec.num_args)
+            break;
+
+        const char conv = *c;
+        buf[0] = '\0';
+        if (conv == 'c' && (rec.types[arg] == ARG_INT || rec.types[arg] == ARG_UINT))
+        {
+            spec[len++] = conv; // No length modifier, '%llc' is undefined
+            spec[len] = '\0';
+            std::snprintf(buf, sizeof(buf), spec, static_cast<int>(rec.args[arg].i));
+        }
+        else if (std::strchr("diouxX", conv) && (rec.types[arg] == ARG_INT || rec.types[arg] == ARG_UINT))
+        {
+            spec[len++] = 'l';
+            spec[len++] = 'l';
+            spec[len++] = conv;
+            spec[len] = '\0';
+            std::snprintf(buf, sizeof(buf), spec, static_cast<long long>(rec.args[arg].i));
+        }
+        else if (std::strchr("fFeEgGaA", conv) && rec.types[arg] == ARG_DOUBLE)
+        {
+            spec[len++] = conv;
+            spec[len] = '\0';
+            std::snprintf(buf, sizeof(buf), spec, rec.args[arg].d);
+        }
+        else if (conv == 's' && rec.types[arg] == ARG_STR)
+        {
+            spec[len++] = conv;
+            spec[len] = '\0';
+            const uint64_t offset = rec.args[arg].u;
+            std::snprintf(buf, sizeof(buf), spec, (offset < STR_DATA_SIZE) ? rec.str_data + offset : "");
+        }
+        else if (conv == 'p' && rec.types[arg] == ARG_PTR)
+        {
+            std::snprintf(buf, sizeof(buf), "%p", rec.args[arg].p);
+        }
+        else
+        {
+            std::snprintf(buf, sizeof(buf), "<bad arg %d>", static_cast<int>(arg));
+        }
+        out += buf;
+        ++arg;
+    }
+}
+
+/// Writer thread, or the stopping thread once the writer is joined
+static void FlushRings()
+{
+    std::vector<LogRing*> rings;
+    {
+        std::lock_guard<std::mutex> lock(s_rings_mutex);
+        for (auto& ring : s_rings)
+            rings.push_back(ring.get());
+    }
+
+    std::string line;
+    for (LogRing* ring : rings)
+    {
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        const size_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+        {
+            FormatRecord(ring->records[tail % RING_SIZE], line);
+            RoR::Log(line.c_str());
+        }
+        ring->tail.store(tail, std::memory_order_release);
+
+        const unsigned dropped = ring->dropped.exchange(0);
+        if (dropped > 0)
+            RoR::LogFormat("[RoR|AsyncLog] %u messages dropped (buffer full)", dropped);
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::COUNT); ++i)
+    {
+        const unsigned suppressed = s_limits[i].suppressed.exchange(0);
+        if (suppressed > 0)
+            RoR::LogFormat("[RoR|AsyncLog] %u '%s' messages suppressed (rate limit)", suppressed, CATEGORY_NAMES[i]);
+    }
+}
+
+static void WriterThread()
+{
+    std::unique_lock<std::mutex> lock(s_writer_mutex);
+    while (s_running)
+    {
+        s_writer_cv.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS));
+        FlushRings();
+    }
+    FlushRings();
+}
+
+bool RoR::AsyncLogDetail::BeginRecord(LogCategory category)
+{
+    const int limit = App::diag_log_rate_limit.GetActive();
+    if (limit <= 0)
+        return true;
+
+    CategoryLimit& cat = s_limits[static_cast<size_t>(category)];
+    const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t window = cat.window.load(std::memory_order_relaxed);
+    if (window != now && cat.window.compare_exchange_strong(window, now))
+        cat.count = 0;
+
+    if (cat.count.fetch_add(1, std::memory_order_relaxed) >= limit)
+    {
+        cat.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void RoR::AsyncLogDetail::Submit(Record const& record)
+{
+    s_submitting.fetch_add(1);
+    if (!s_running)
+    {
+        s_submitting.fetch_sub(1);
+        std::string line; // Writer not running (startup/shutdown) - log directly
+        FormatRecord(record, line);
+        RoR::Log(line.c_str());
+        return;
+    }
+
+    LogRing* ring = GetThreadRing();
+    const size_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= RING_SIZE)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        ring->records[head % RING_SIZE] = record;
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+    s_submitting.fetch_sub(1);
+}
+
+void RoR::AsyncLogStart()
+{
+    if (s_running)
+        return;
+    s_running = true;
+    s_writer = new std::thread(WriterThread);
+}
+
+void RoR::AsyncLogStop()
+{
+    if (!s_running)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(s_writer_mutex);
+        s_running = false;
+    }
+    s_writer_cv.notify_one();
+    s_writer->join();
+    delete s_writer;
+    s_writer = nullptr;
+
+    // Producers which passed the `s_running` check before it was cleared may push after the writer's
+    // last flush; wait for them and drain here. New ones see `s_running == false` and log directly.
+    while (s_submitting.load() != 0)
+        std::this_thread::yield();
+    FlushRings();
+}
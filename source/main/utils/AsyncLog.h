@@ -0,0 +1,150 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Deferred logging for hot paths (physics, network threads).
+///
+/// `LogAsync()` only copies the format string pointer and the typed arguments into a
+/// per-thread ring buffer; formatting and writing to RoR.log is done by a background thread.
+/// Producers never block: when a ring is full or a category exceeds its rate limit
+/// (see `App::diag_log_rate_limit`), the message is dropped and counted.
+///
+/// The format string must be a literal (it's stored by pointer) using printf conversions.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace RoR {
+
+enum class LogCategory
+{
+    GENERAL,
+    BEAM_BREAK,
+    BEAM_DEFORM,
+    TRIGGER,     //!< Shock trigger debug output
+    NETWORK,
+
+    COUNT
+};
+
+void AsyncLogStart(); //!< Starts the writer thread; call once the Ogre log exists.
+void AsyncLogStop();  //!< Flushes pending messages and stops the writer thread.
+
+namespace AsyncLogDetail {
+
+static const size_t MAX_ARGS = 12;
+static const size_t STR_DATA_SIZE = 128; //!< Inline storage for string arguments (truncated)
+
+enum ArgType: uint8_t
+{
+    ARG_INT,
+    ARG_UINT,
+    ARG_DOUBLE,
+    ARG_PTR,
+    ARG_STR, //!< Value is offset into `Record::str_data`
+};
+
+struct Record
+{
+    const char*  fmt;
+    LogCategory  category;
+    uint8_t      num_args;
+    uint8_t      str_used;
+    ArgType      types[MAX_ARGS];
+    union
+    {
+        int64_t     i;
+        uint64_t    u;
+        double      d;
+        const void* p;
+    }            args[MAX_ARGS];
+    char         str_data[STR_DATA_SIZE];
+};
+
+bool BeginRecord(LogCategory category); //!< Applies rate limit; false = drop the message.
+void Submit(Record const& record);
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+PackArg(Record& r, T value)   { r.types[r.num_args] = ARG_INT;    r.args[r.num_args++].i = value; }
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+PackArg(Record& r, T value)   { r.types[r.num_args] = ARG_UINT;   r.args[r.num_args++].u = value; }
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+PackArg(Record& r, T value)   { r.types[r.num_args] = ARG_DOUBLE; r.args[r.num_args++].d = value; }
+
+template<typename T>
+typename std::enable_if<std::is_enum<T>::value>::type
+PackArg(Record& r, T value)   { r.types[r.num_args] = ARG_INT;    r.args[r.num_args++].i = static_cast<int64_t>(value); }
+
+inline void PackArg(Record& r, const void* value) { r.types[r.num_args] = ARG_PTR; r.args[r.num_args++].p = value; }
+
+inline void PackArg(Record& r, const char* value)
+{
+    const size_t avail = STR_DATA_SIZE - r.str_used;
+    const size_t len = (avail > 0) ? std::min(std::strlen(value), avail - 1) : 0;
+    r.types[r.num_args] = ARG_STR;
+    r.args[r.num_args++].u = r.str_used;
+    if (avail > 0)
+    {
+        std::memcpy(r.str_data + r.str_used, value, len);
+        r.str_data[r.str_used + len] = '\0';
+        r.str_used += static_cast<uint8_t>(len + 1);
+    }
+}
+
+inline void PackArg(Record& r, std::string const& value) { PackArg(r, value.c_str()); }
+
+inline void PackArgs(Record&) {}
+
+template<typename T, typename... Rest>
+void PackArgs(Record& r, T const& value, Rest const&... rest)
+{
+    PackArg(r, value);
+    PackArgs(r, rest...);
+}
+
+} // namespace AsyncLogDetail
+
+template<typename... Args>
+void LogAsync(LogCategory category, const char* fmt, Args const&... args)
+{
+    static_assert(sizeof...(Args) <= AsyncLogDetail::MAX_ARGS, "Too many arguments for LogAsync()");
+
+    if (!AsyncLogDetail::BeginRecord(category))
+        return;
+
+    AsyncLogDetail::Record record;
+    record.fmt = fmt;
+    record.category = category;
+    record.num_args = 0;
+    record.str_used = 0;
+    AsyncLogDetail::PackArgs(record, args...);
+    AsyncLogDetail::Submit(record);
+}
+
+} // namespace RoR
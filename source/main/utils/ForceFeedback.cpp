@@ -21,73 +21,103 @@
 
 #include "ForceFeedback.h"
 
-#include "Application.h"
-#include "InputEngine.h"
-#include "RoRPrerequisites.h"
-
-#include <OISForceFeedback.h>
-#include <OgreString.h>
+#include <cmath>
 
 namespace RoR {
 
-void ForceFeedback::Setup()
+// ------------------------------------------------------------------------------------------------
+// Mailbox
+// ------------------------------------------------------------------------------------------------
+
+void ForceFeedbackMailbox::Publish(const ForceFeedbackSample& sample)
 {
-    using namespace Ogre;
-    m_device = App::GetInputEngine()->getForceFeedbackDevice();
-    LOG(String("ForceFeedback: ")+TOSTRING(m_device->getFFAxesNumber())+" axe(s)");
-    const OIS::ForceFeedback::SupportedEffectList& supEffects = m_device->getSupportedEffects();
-    if (supEffects.size() > 0)
-    {
-        LOG("ForceFeedback: supported effects:");
-        OIS::ForceFeedback::SupportedEffectList::const_iterator efit;
-#ifdef OISHEAD
-        for (efit=supEffects.begin(); efit!=supEffects.end(); ++efit)
-            LOG(String("ForceFeedback: ")+OIS::Effect::getEffectTypeName(efit->second));
-#endif //OISHEAD
-    }
-    else
-    LOG("ForceFeedback: no supported effect found!");
-    m_device->setAutoCenterMode(false);
-    m_device->setMasterGain(0.0);
+    m_buffers[m_write] = sample;
+    m_write = m_ready.exchange(m_write | FRESH_BIT, std::memory_order_acq_rel) & ~FRESH_BIT;
+}
+
+bool ForceFeedbackMailbox::Fetch(ForceFeedbackSample& out)
+{
+    if ((m_ready.load(std::memory_order_acquire) & FRESH_BIT) == 0)
+        return false;
 
-    //do not load effect now, its too early
+    m_read = m_ready.exchange(m_read, std::memory_order_acq_rel) & ~FRESH_BIT;
+    out = m_buffers[m_read];
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Signal path
+// ------------------------------------------------------------------------------------------------
+
+const float ForceFeedback::FILTER_CUTOFF_HZ = 40.f; // Removes sub-step jitter, well above what a wheel motor can render
+
+ForceFeedback::ForceFeedback():
+    m_filtered(),
+    m_filter_dt(0.f),
+    m_filter_alpha(1.f),
+    m_enabled(false),
+    m_gain_dirty(false),
+    m_last_level(0)
+{
+}
+
+void ForceFeedback::Setup(std::unique_ptr<ForceFeedbackDevice> device)
+{
+    m_device = std::move(device);
 }
 
-void ForceFeedback::SetForces(float roll, float pitch, float wspeed, float dircommand, float stress)
+void ForceFeedback::PushPhysicsStep(ForceFeedbackSample const& raw, float dt)
 {
-    assert(m_device);
+    if (!m_device || !m_enabled)
+        return;
 
-    //LOG(String("ForceFeedback: R=")+TOSTRING(roll)+" D="+TOSTRING(dir)+" S="+TOSTRING(wspeed)+" H="+TOSTRING(stress));
-    if (!m_hydro_effect)
+    // One-pole low-pass filter; coefficient is only recalculated if the timestep changes (it normally doesn't)
+    if (dt != m_filter_dt)
     {
-        //we create effect at the last moment, because it does not works otherwise
-        m_hydro_effect = new OIS::Effect(OIS::Effect::ConstantForce, OIS::Effect::Constant);
-        m_hydro_effect->direction = OIS::Effect::North;
-        m_hydro_effect->trigger_button = 0;
-        m_hydro_effect->trigger_interval = 0;
-        m_hydro_effect->replay_length = OIS::Effect::OIS_INFINITE; // Linux/Win32: Same behaviour as 0.
-        m_hydro_effect->replay_delay = 0;
-        m_hydro_effect->setNumAxes(1);
-        OIS::ConstantEffect* hydroConstForce = dynamic_cast<OIS::ConstantEffect*>(m_hydro_effect->getForceEffect());
-        hydroConstForce->level = 0; //-10K to +10k
-        hydroConstForce->envelope.attackLength = 0;
-        hydroConstForce->envelope.attackLevel = (unsigned short)hydroConstForce->level;
-        hydroConstForce->envelope.fadeLength = 0;
-        hydroConstForce->envelope.fadeLevel = (unsigned short)hydroConstForce->level;
-
-        m_device->upload(m_hydro_effect);
+        m_filter_dt = dt;
+        m_filter_alpha = 1.f - std::exp(-dt * 2.f * 3.14159265f * FILTER_CUTOFF_HZ);
     }
 
-    OIS::ConstantEffect* hydroConstForce = dynamic_cast<OIS::ConstantEffect*>(m_hydro_effect->getForceEffect());
-    float stress_gain = App::io_ffb_stress_gain.GetActive();
-    float centering_gain = App::io_ffb_center_gain.GetActive();
-    float ff = -stress * stress_gain + dircommand * 100.0 * centering_gain * wspeed * wspeed;
+    m_filtered.roll         += (raw.roll         - m_filtered.roll)         * m_filter_alpha;
+    m_filtered.pitch        += (raw.pitch        - m_filtered.pitch)        * m_filter_alpha;
+    m_filtered.hydro_stress += (raw.hydro_stress - m_filtered.hydro_stress) * m_filter_alpha;
+    m_filtered.wheel_speed  = raw.wheel_speed;  // Already smooth
+    m_filtered.dir_command  = raw.dir_command;  // User input, must not lag
+
+    m_mailbox.Publish(m_filtered);
+}
+
+int ForceFeedback::CalcForceLevel(ForceFeedbackSample const& s, float stress_gain, float centering_gain)
+{
+    float ff = -s.hydro_stress * stress_gain + s.dir_command * 100.0f * centering_gain * s.wheel_speed * s.wheel_speed;
     if (ff > 10000)
         ff = 10000;
     if (ff < -10000)
         ff = -10000;
-    hydroConstForce->level = ff; //-10K to +10k
-    m_device->modify(m_hydro_effect);
+    return static_cast<int>(ff);
+}
+
+void ForceFeedback::UpdateDevice(Gains const& gains)
+{
+    if (!m_device)
+        return;
+
+    if (m_gain_dirty)
+    {
+        m_device->SetMasterGain(m_enabled ? gains.master : 0.f);
+        m_gain_dirty = false;
+    }
+
+    ForceFeedbackSample sample;
+    if (!m_mailbox.Fetch(sample))
+        return;
+
+    int level = CalcForceLevel(sample, gains.stress, gains.centering);
+    if (level != m_last_level)
+    {
+        m_device->SetConstantForce(level);
+        m_last_level = level;
+    }
 }
 
 void ForceFeedback::SetEnabled(bool b)
@@ -96,10 +126,9 @@ void ForceFeedback::SetEnabled(bool b)
 
     if (b != m_enabled)
     {
-        float gain = (b) ? App::io_ffb_master_gain.GetActive() : 0.f;
-        m_device->setMasterGain(gain);
+        m_enabled = b;
+        m_gain_dirty = true; // Applied by next `UpdateDevice()`
     }
-    m_enabled = b;
 }
 
 } // namespace RoR
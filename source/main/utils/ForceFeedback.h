@@ -21,32 +21,125 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 // Forward decl.
 namespace OIS { class ForceFeedback; class Effect; }
 
 namespace RoR {
 
+/// Raw force-feedback inputs, sampled on the physics thread once per sub-step.
+struct ForceFeedbackSample
+{
+    float roll;         ///< Lateral inertial force at the camera, used for 2-axis devices (joysticks) to render shocks
+    float pitch;        ///< Longitudinal inertial force at the camera
+    float wheel_speed;  ///< For the artificial, speed-dependent auto-centering
+    float dir_command;  ///< Steering command, also for auto-centering
+    float hydro_stress; ///< Average steering hydro stress, the ideal data source for FF wheels
+};
+
+/// Lock-free single producer (physics thread) / single consumer (main thread) handoff.
+/// Triple buffer - the consumer always gets the most recent complete sample and neither side ever waits.
+class ForceFeedbackMailbox
+{
+public:
+    ForceFeedbackMailbox(): m_write(0), m_ready(1), m_read(2), m_buffers() {}
+
+    void Publish(const ForceFeedbackSample& sample);
+    bool Fetch(ForceFeedbackSample& out); ///< @return False if nothing new was published since last fetch.
+
+private:
+    static const int FRESH_BIT = 4;
+
+    int                 m_write;   ///< Producer-owned
+    std::atomic<int>    m_ready;   ///< Shared; buffer index | FRESH_BIT
+    int                 m_read;    ///< Consumer-owned
+    ForceFeedbackSample m_buffers[3];
+};
+
+/// Output device abstraction; all calls come from the main thread, which also polls the OIS devices.
+class ForceFeedbackDevice
+{
+public:
+    virtual ~ForceFeedbackDevice() {}
+    virtual void SetMasterGain(float gain) = 0;
+    virtual void SetConstantForce(int level) = 0; ///< -10K to +10K
+};
+
+/// Real hardware, through OIS; see ForceFeedbackOis.cpp
+class OisForceFeedbackDevice: public ForceFeedbackDevice
+{
+public:
+    explicit OisForceFeedbackDevice(OIS::ForceFeedback* device);
+    ~OisForceFeedbackDevice();
+
+    void SetMasterGain(float gain) override;
+    void SetConstantForce(int level) override;
+
+private:
+    OIS::ForceFeedback* m_device;
+    OIS::Effect*        m_hydro_effect;
+};
+
+/// Stub device which records everything sent to it; for verifying the signal path without hardware.
+class RecordingForceFeedbackDevice: public ForceFeedbackDevice
+{
+public:
+    RecordingForceFeedbackDevice(): master_gain(0.f) {}
+
+    void SetMasterGain(float gain) override      { master_gain = gain; }
+    void SetConstantForce(int level) override    { levels.push_back(level); }
+
+    float            master_gain;
+    std::vector<int> levels;
+};
+
+/// Force feedback signal path:
+///   physics thread: `PushPhysicsStep()` - low-pass filter at sub-step rate, publish to mailbox
+///   main thread:    `UpdateDevice()`    - fetch latest sample, convert to device force level
+/// The device is only touched from the main thread because OIS isn't thread-safe and
+/// `InputEngine::Capture()` polls the same joystick there. The filtering runs at physics
+/// rate, so the signal doesn't depend on FPS; only the device update rate does.
 class ForceFeedback
 {
 public:
 
-    ForceFeedback(): m_device(nullptr), m_hydro_effect(nullptr), m_enabled(false)
+    struct Gains
     {
-    }
+        float master;
+        float stress;
+        float centering;
+    };
 
-    void Setup();
+    ForceFeedback();
+
+    void Setup();                                            ///< Opens the OIS device.
+    void Setup(std::unique_ptr<ForceFeedbackDevice> device); ///< Use a custom device (i.e. `RecordingForceFeedbackDevice`).
     void SetEnabled(bool v);
+    bool IsReady() const { return m_device != nullptr; }
+
+    /// Physics thread, once per sub-step.
+    void PushPhysicsStep(ForceFeedbackSample const& raw, float dt);
 
-    ///we take here :
-    /// -roll and pitch inertial forces at the camera: this is not used currently, but it can be used for 2 axes force feedback devices, like FF joysticks, to render shocks
-    /// -wheel speed and direction command, for the artificial auto-centering (which is wheel speed dependant)
-    /// -hydro beam stress, the ideal data source for FF wheels
-    void SetForces(float roll, float pitch, float wspeed, float dircommand, float stress);
+    /// Main thread, once per frame: fetch the newest sample and send it to the device.
+    void UpdateDevice(Gains const& gains);
+
+    /// Pure signal conversion: filtered sample -> device force level (-10K to +10K)
+    static int CalcForceLevel(ForceFeedbackSample const& sample, float stress_gain, float centering_gain);
+
+    static const float FILTER_CUTOFF_HZ;
 
 private:
-    OIS::ForceFeedback* m_device;
-    OIS::Effect*        m_hydro_effect;
-    bool                m_enabled; /// Disables FF when not in vehicle
+    std::unique_ptr<ForceFeedbackDevice> m_device;
+    ForceFeedbackMailbox m_mailbox;
+    ForceFeedbackSample  m_filtered;         ///< Physics thread state
+    float                m_filter_dt;        ///< `m_filter_alpha` was calculated for this timestep
+    float                m_filter_alpha;
+    std::atomic<bool>    m_enabled;          ///< Disables FF when not in vehicle
+    bool                 m_gain_dirty;       ///< Main thread state
+    int                  m_last_level;
 };
 
 } // namespace RoR
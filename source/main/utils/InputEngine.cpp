@@ -1819,6 +1819,7 @@ InputEngine::InputEngine() :
     captureMode(false)
     , free_joysticks(0)
     , inputsChanged(true)
+    , injectionEnabled(false)
     , mForceFeedback(0)
     , mInputManager(0)
     , mKeyboard(0)
@@ -2536,6 +2537,12 @@ bool InputEngine::isEventAnalog(int eventID)
 
 float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
 {
+    if (injectionEnabled)
+    {
+        auto itor = injectedValues.find(eventID);
+        return (itor != injectedValues.end()) ? itor->second : 0.f;
+    }
+
     float returnValue = 0;
     std::vector<event_trigger_t> t_vec = events[eventID];
     float value = 0;
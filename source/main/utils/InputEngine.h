@@ -465,6 +465,11 @@ public:
 
     bool getEventBoolValue(int eventID);
     bool isEventAnalog(int eventID);
+
+    // scripted input (see PerfHarness): while enabled, devices are ignored and event values come from `setInjectedEventValue()`
+    void setInputInjection(bool enabled) { injectionEnabled = enabled; injectedValues.clear(); };
+    bool isInputInjectionEnabled() { return injectionEnabled; };
+    void setInjectedEventValue(int eventID, float value) { injectedValues[eventID] = value; };
     bool getEventBoolValueBounce(int eventID, float time = 0.2f);
     float getEventBounceTime(int eventID);
     // we need to use hwnd here, as we are also using this in the configurator
@@ -594,5 +599,8 @@ protected:
 
     bool inputsChanged;
 
+    bool injectionEnabled;
+    std::map<int, float> injectedValues;
+
     event_trigger_t newEvent();
 };
@@ -49,7 +49,7 @@
 using namespace Ogre;
 using namespace RoR;
 
-LanguageEngine::LanguageEngine() : working(false), myguiConfigFilename("MyGUI_FontsEnglish.xml")
+LanguageEngine::LanguageEngine() : working(false), myguiConfigFilename("MyGUI_FontsEnglish.xml"), m_table(new Table()), m_generation(1)
 {
 }
 
@@ -76,10 +76,15 @@ Ogre::String LanguageEngine::getMyGUIFontConfigFilename()
 
 void LanguageEngine::setup()
 {
+    // Strings looked up before (or with the previous language) must be translated again
+    this->InvalidateTranslations();
+
 #ifdef USE_MOFILEREADER
     // load language, must happen after initializing Settings class and Ogre Root!
     // also it must happen after loading all basic resources!
+    delete reader;
     reader = new moFileLib::moFileReader();
+    working = false;
 
     Str<300> mo_path;
     mo_path << App::sys_process_dir.GetActive() << RoR::PATH_SLASH << "languages" << PATH_SLASH;
@@ -154,7 +159,7 @@ void LanguageEngine::postSetup()
     }
 }
 
-Ogre::UTFString LanguageEngine::lookUp(Ogre::String name)
+Ogre::UTFString LanguageEngine::lookUp(Ogre::String const& name)
 {
 #ifdef USE_MOFILEREADER
     if (working)
@@ -165,6 +170,40 @@ Ogre::UTFString LanguageEngine::lookUp(Ogre::String name)
 #endif //MOFILEREADER
 }
 
+LanguageEngine::TranslatedString const& LanguageEngine::Intern(const char* msgid, Slot& slot)
+{
+    std::lock_guard<std::mutex> lock(m_table_mutex);
+
+    const unsigned generation = m_generation.load(std::memory_order_relaxed);
+    auto itor = m_table->find(msgid);
+    if (itor == m_table->end())
+    {
+        Entry entry;
+#ifdef USE_MOFILEREADER
+        entry.text = this->lookUp(msgid);
+#else
+        entry.text = gettext(msgid);
+#endif // USE_MOFILEREADER
+        entry.generation = generation;
+        itor = m_table->insert(std::make_pair(std::string(msgid), entry)).first;
+    }
+
+    slot.entry.store(&itor->second, std::memory_order_release);
+    return itor->second.text;
+}
+
+void LanguageEngine::InvalidateTranslations()
+{
+    std::lock_guard<std::mutex> lock(m_table_mutex);
+
+    if (!m_table->empty())
+    {
+        m_retired_tables.push_back(std::move(m_table));
+        m_table = std::unique_ptr<Table>(new Table());
+    }
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 void LanguageEngine::setupCodeRanges(String codeRangesFilename, String codeRangesGroupname)
 {
     // not using the default mygui font config
@@ -28,6 +28,13 @@
 #include "RoRPrerequisites.h"
 #include "Singleton.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // three configurations currently supported:
 // #define NOLANG            = no language translations at all, removes any special parsing tags
 // #define USE_MOFILEREADER  = windows gettext replacement
@@ -46,7 +53,6 @@
 #ifdef USE_MOFILEREADER
 // using mofilereader as gettext replacement
 # include "moFileReader.h"
-# define _L(str) LanguageEngine::getSingleton().lookUp(str).c_str()
 #else
 // gettext
 
@@ -56,9 +62,14 @@
 
 # include <libintl.h>
 # include <locale.h>
-# define _L(str) gettext(str)
 #endif //MOFILEREADER
 
+/// Translates a string literal. Each call site caches the translation in a static slot,
+/// so after the first call it costs no allocation and no search (see `LanguageEngine::Translate()`).
+/// For strings which are not literals, use `LanguageEngine::lookUp()` - the `""` makes them fail to compile.
+# define _L(str) LanguageEngine::getSingleton().Translate("" str, \
+    []() -> LanguageEngine::Slot& { static LanguageEngine::Slot slot; return slot; }()).c_str()
+
 #define MOFILENAME "ror"
 
 class LanguageEngine : public RoRSingleton<LanguageEngine>, public ZeroedMemoryAllocator
@@ -66,9 +77,35 @@ class LanguageEngine : public RoRSingleton<LanguageEngine>, public ZeroedMemoryA
     friend class RoRSingleton<LanguageEngine>;
 
 public:
-    void setup();
+#ifdef USE_MOFILEREADER
+    typedef Ogre::UTFString TranslatedString; //!< `_L()` yields UTF-16, like `moFileReader` + `Ogre::UTFString` always did
+#else
+    typedef std::string     TranslatedString; //!< `_L()` yields UTF-8, like `gettext()`
+#endif
+
+    struct Entry
+    {
+        TranslatedString text;
+        unsigned         generation;
+    };
+
+    /// Per call site of `_L()`; static storage, so zero-initialized.
+    struct Slot
+    {
+        std::atomic<const Entry*> entry;
+    };
+
+    void setup(); //!< Also when switching language; invalidates all cached translations.
     void postSetup();
-    Ogre::UTFString lookUp(Ogre::String name);
+    Ogre::UTFString lookUp(Ogre::String const& name); //!< Uncached
+
+    TranslatedString const& Translate(const char* msgid, Slot& slot)
+    {
+        const Entry* entry = slot.entry.load(std::memory_order_acquire);
+        if (entry != nullptr && entry->generation == m_generation.load(std::memory_order_relaxed))
+            return entry->text;
+        return this->Intern(msgid, slot);
+    }
 
     Ogre::String getMyGUIFontConfigFilename();
 
@@ -84,6 +121,16 @@ protected:
     moFileLib::moFileReader* reader;
 #endif // MOFILEREADER
     void setupCodeRanges(Ogre::String codeRangesFilename, Ogre::String codeRangesGroupname);
+
+    typedef std::unordered_map<std::string, Entry> Table; // Node-based; entries don't move
+
+    TranslatedString const& Intern(const char* msgid, Slot& slot);
+    void InvalidateTranslations();
+
+    std::mutex               m_table_mutex;     //!< Only taken on first lookup of a literal
+    std::unique_ptr<Table>   m_table;           //!< Translations of the current language, by msgid
+    std::vector<std::unique_ptr<Table>> m_retired_tables; //!< Previous languages; pointers obtained from `_L()` must stay valid
+    std::atomic<unsigned>    m_generation;      //!< Incremented on language change; slots with older entries are stale
 };
 
 #endif // NOLANG
@@ -0,0 +1,125 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MemoryArena.h"
+
+#include <atomic>
+#include <cstdlib>
+
+using namespace RoR;
+
+static std::atomic<size_t> s_total_objects(0);
+static std::atomic<size_t> s_total_chunks(0);
+static std::atomic<size_t> s_total_used(0);
+static std::atomic<size_t> s_total_reserved(0);
+
+MemoryArena::MemoryArena(size_t chunk_size):
+    m_chunk_size(chunk_size),
+    m_num_objects(0),
+    m_bytes_used(0)
+{
+}
+
+MemoryArena::~MemoryArena()
+{
+    this->Clear();
+}
+
+void* MemoryArena::Allocate(size_t size, size_t align)
+{
+    ++m_num_objects;
+    ++s_total_objects;
+
+    if (!m_chunks.empty())
+    {
+        Chunk& chunk = m_chunks.back();
+        const size_t offset = (chunk.used + align - 1) & ~(align - 1);
+        if (offset + size <= chunk.size)
+        {
+            m_bytes_used += (offset + size) - chunk.used;
+            s_total_used += (offset + size) - chunk.used;
+            chunk.used = offset + size;
+            return chunk.data + offset;
+        }
+    }
+
+    // Start a new chunk; malloc() alignment is sufficient for any fundamental type.
+    // Oversized objects get a chunk of their own, inserted below the current one so it stays open.
+    Chunk chunk;
+    chunk.size = (size > m_chunk_size) ? size : m_chunk_size;
+    chunk.data = static_cast<char*>(std::malloc(chunk.size));
+    if (chunk.data == nullptr)
+        throw std::bad_alloc();
+    chunk.used = size;
+    if (size > m_chunk_size && !m_chunks.empty())
+        m_chunks.insert(m_chunks.end() - 1, chunk);
+    else
+        m_chunks.push_back(chunk);
+
+    m_bytes_used += size;
+    s_total_used += size;
+    s_total_chunks += 1;
+    s_total_reserved += chunk.size;
+    return chunk.data;
+}
+
+void MemoryArena::Clear()
+{
+    for (auto itor = m_destructors.rbegin(); itor != m_destructors.rend(); ++itor)
+    {
+        itor->func(itor->object);
+    }
+    m_destructors.clear();
+
+    for (Chunk& chunk : m_chunks)
+    {
+        std::free(chunk.data);
+        s_total_reserved -= chunk.size;
+    }
+    s_total_chunks -= m_chunks.size();
+    s_total_objects -= m_num_objects;
+    s_total_used -= m_bytes_used;
+    m_chunks.clear();
+    m_num_objects = 0;
+    m_bytes_used = 0;
+}
+
+MemoryArena::Stats MemoryArena::GetStats() const
+{
+    Stats stats;
+    stats.num_objects    = m_num_objects;
+    stats.num_chunks     = m_chunks.size();
+    stats.bytes_used     = m_bytes_used;
+    stats.bytes_reserved = 0;
+    for (Chunk const& chunk : m_chunks)
+    {
+        stats.bytes_reserved += chunk.size;
+    }
+    return stats;
+}
+
+MemoryArena::Stats MemoryArena::GetGlobalStats()
+{
+    Stats stats;
+    stats.num_objects    = s_total_objects;
+    stats.num_chunks     = s_total_chunks;
+    stats.bytes_used     = s_total_used;
+    stats.bytes_reserved = s_total_reserved;
+    return stats;
+}
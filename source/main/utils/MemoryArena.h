@@ -0,0 +1,124 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Chunked bump allocator owning a group of objects with a shared lifetime.
+///
+/// Used by `Actor` for its physics sub-objects (aeroengines, airbrakes, inertia filters...)
+/// so they sit next to each other in memory and are released in one go with the actor.
+/// Objects are never freed individually; `Clear()` runs destructors in reverse order
+/// of construction and releases all chunks.
+///
+/// `New()` leaves initialization to the constructor; `NewZeroed()` clears the storage first -
+/// use it for legacy classes which expect zeroed members (formerly `ZeroedMemoryAllocator`).
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RoR {
+
+class MemoryArena
+{
+public:
+    static const size_t DEFAULT_CHUNK_SIZE = 16 * 1024;
+
+    struct Stats
+    {
+        size_t num_objects;    //!< Allocations made
+        size_t num_chunks;
+        size_t bytes_used;     //!< Sum of object sizes incl. alignment padding
+        size_t bytes_reserved; //!< Sum of chunk sizes
+    };
+
+    explicit MemoryArena(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~MemoryArena();
+
+    MemoryArena(MemoryArena const&) = delete;
+    MemoryArena& operator=(MemoryArena const&) = delete;
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        void* mem = this->Allocate(sizeof(T), alignof(T));
+        T* obj = ::new (mem) T(std::forward<Args>(args)...); // Global placement new; bypasses class allocators
+        this->RegisterDestructor(obj);
+        return obj;
+    }
+
+    template<typename T, typename... Args>
+    T* NewZeroed(Args&&... args)
+    {
+        void* mem = this->Allocate(sizeof(T), alignof(T));
+        std::memset(mem, 0, sizeof(T));
+        T* obj = ::new (mem) T(std::forward<Args>(args)...);
+        this->RegisterDestructor(obj);
+        return obj;
+    }
+
+    void         Clear();           //!< Destroys all objects and releases memory.
+    Stats        GetStats() const;
+    static Stats GetGlobalStats();  //!< Totals of all live arenas.
+
+private:
+    struct Chunk
+    {
+        char*  data;
+        size_t size;
+        size_t used;
+    };
+
+    struct Destructor
+    {
+        void (*func)(void*);
+        void* object;
+    };
+
+    template<typename T>
+    static void Destroy(void* object) { static_cast<T*>(object)->~T(); }
+
+    template<typename T>
+    typename std::enable_if<std::is_trivially_destructible<T>::value>::type
+    RegisterDestructor(T*) {}
+
+    template<typename T>
+    typename std::enable_if<!std::is_trivially_destructible<T>::value>::type
+    RegisterDestructor(T* object)
+    {
+        Destructor d;
+        d.func = &MemoryArena::Destroy<T>;
+        d.object = object;
+        m_destructors.push_back(d);
+    }
+
+    void* Allocate(size_t size, size_t align);
+
+    std::vector<Chunk>      m_chunks;
+    std::vector<Destructor> m_destructors;
+    size_t                  m_chunk_size;
+    size_t                  m_num_objects;
+    size_t                  m_bytes_used;
+};
+
+} // namespace RoR
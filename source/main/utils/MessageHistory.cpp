@@ -0,0 +1,192 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MessageHistory.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+using namespace RoR;
+
+static const size_t MAX_TEXT_LEN   = 0xFFFF;
+static const size_t MAX_SENDER_LEN = 0xFF;
+
+static void ToLower(std::string& s)
+{
+    for (char& c: s)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+static bool ContainsNoCase(std::string haystack, std::string const& lowercase_needle)
+{
+    ToLower(haystack);
+    return haystack.find(lowercase_needle) != std::string::npos;
+}
+
+/// Shortens `len` so an UTF-8 sequence isn't cut in half
+static size_t TruncateUtf8(const char* str, size_t len, size_t max_len)
+{
+    if (len <= max_len)
+        return len;
+    len = max_len;
+    while (len > 0 && (static_cast<unsigned char>(str[len]) & 0xC0) == 0x80)
+        --len;
+    return len;
+}
+
+MessageHistory::MessageHistory(size_t max_messages, size_t max_text_bytes):
+    m_records(std::max(max_messages, size_t(1))),
+    m_text(std::max(max_text_bytes, size_t(1))),
+    m_first_seq(1),
+    m_next_seq(1),
+    m_text_head(0)
+{
+}
+
+void MessageHistory::Push(int channel, int kind, int sender_uid, std::string const& sender, std::string const& text, unsigned long time_ms)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const size_t sender_len = TruncateUtf8(sender.c_str(), sender.size(), std::min(MAX_SENDER_LEN, m_text.size() / 2));
+    const size_t text_len = TruncateUtf8(text.c_str(), text.size(), std::min(MAX_TEXT_LEN, m_text.size() - sender_len));
+    const uint64_t text_end = m_text_head + sender_len + text_len;
+
+    // Drop oldest messages until both the record and the byte ring have room
+    while (m_first_seq < m_next_seq)
+    {
+        const Record& oldest = m_records[m_first_seq % m_records.size()];
+        if (m_next_seq - m_first_seq < m_records.size() && oldest.text_pos + m_text.size() >= text_end)
+            break;
+        ++m_first_seq;
+    }
+
+    Record& rec = m_records[m_next_seq % m_records.size()];
+    rec.seq        = m_next_seq++;
+    rec.text_pos   = m_text_head;
+    rec.time_ms    = static_cast<uint32_t>(time_ms);
+    rec.sender_uid = sender_uid;
+    rec.sender_len = static_cast<uint8_t>(sender_len);
+    rec.text_len   = static_cast<uint16_t>(text_len);
+    rec.channel    = static_cast<uint8_t>(channel);
+    rec.kind       = kind;
+
+    const char* parts[] = { sender.c_str(), text.c_str() };
+    const size_t lengths[] = { sender_len, text_len };
+    for (int i = 0; i < 2; ++i)
+    {
+        size_t done = 0;
+        while (done < lengths[i])
+        {
+            const size_t offset = m_text_head % m_text.size();
+            const size_t chunk = std::min(lengths[i] - done, m_text.size() - offset);
+            std::memcpy(&m_text[offset], parts[i] + done, chunk);
+            done += chunk;
+            m_text_head += chunk;
+        }
+    }
+}
+
+void MessageHistory::CopyOut(uint64_t pos, size_t len, std::string& out) const
+{
+    out.clear();
+    while (len > 0)
+    {
+        const size_t offset = pos % m_text.size();
+        const size_t chunk = std::min(len, m_text.size() - offset);
+        out.append(&m_text[offset], chunk);
+        pos += chunk;
+        len -= chunk;
+    }
+}
+
+size_t MessageHistory::Query(Filter const& filter, uint64_t max_seq, size_t skip, size_t count, std::vector<Message>& out)
+{
+    out.clear();
+    std::string sender_needle = filter.sender;
+    std::string text_needle = filter.text;
+    ToLower(sender_needle);
+    ToLower(text_needle);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t newest = (max_seq == 0) ? m_next_seq : std::min(max_seq + 1, m_next_seq);
+    size_t num_matching = 0;
+    std::string sender, text;
+    for (uint64_t seq = newest; seq > m_first_seq; --seq)
+    {
+        const Record& rec = m_records[(seq - 1) % m_records.size()];
+        if (!(filter.channels & (1u << rec.channel)) ||
+            (filter.sender_uid != -1 && rec.sender_uid != filter.sender_uid) ||
+            (filter.since_ms != 0 && rec.time_ms < filter.since_ms))
+        {
+            continue;
+        }
+
+        // Only unpack the strings for searching or for the requested page
+        const bool wanted = (num_matching >= skip && out.size() < count);
+        if (wanted || !sender_needle.empty())
+        {
+            CopyOut(rec.text_pos, rec.sender_len, sender);
+            if (!sender_needle.empty() && !ContainsNoCase(sender, sender_needle))
+                continue;
+        }
+        if (wanted || !text_needle.empty())
+        {
+            CopyOut(rec.text_pos + rec.sender_len, rec.text_len, text);
+            if (!text_needle.empty() && !ContainsNoCase(text, text_needle))
+                continue;
+        }
+
+        if (wanted)
+        {
+            Message msg;
+            msg.seq        = rec.seq;
+            msg.time_ms    = rec.time_ms;
+            msg.channel    = rec.channel;
+            msg.kind       = rec.kind;
+            msg.sender_uid = rec.sender_uid;
+            msg.sender     = sender;
+            msg.text       = text;
+            out.push_back(msg);
+        }
+        ++num_matching;
+    }
+
+    std::reverse(out.begin(), out.end());
+    return num_matching;
+}
+
+uint64_t MessageHistory::GetLastSeq()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_next_seq - 1;
+}
+
+size_t MessageHistory::GetNumMessages()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_next_seq - m_first_seq);
+}
+
+void MessageHistory::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_first_seq = m_next_seq;
+}
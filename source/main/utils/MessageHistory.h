@@ -0,0 +1,102 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Bounded, searchable history of console and chat messages.
+///
+/// Messages are kept as compact fixed-size records in a ring; the sender name and text
+/// are packed into a separate byte ring. When either ring is full, the oldest messages
+/// are dropped, so memory use doesn't grow with session length.
+/// Nothing is formatted on push - `Query()` materialises only the requested page of
+/// matching messages, which is what GUI views display.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+class MessageHistory
+{
+public:
+
+    struct Filter
+    {
+        Filter(): channels(~0u), sender_uid(-1), since_ms(0) {}
+
+        uint32_t      channels;   //!< Bit mask of accepted channels (bit N = channel N)
+        int           sender_uid; //!< -1 = any sender
+        std::string   sender;     //!< Case-insensitive substring of the sender name; empty = any
+        std::string   text;       //!< Case-insensitive substring of the text; empty = any
+        unsigned long since_ms;   //!< Oldest accepted post time; 0 = any
+    };
+
+    struct Message
+    {
+        uint64_t      seq;
+        unsigned long time_ms;
+        int           channel;
+        int           kind;       //!< Caller-defined sub-type, i.e. for colouring
+        int           sender_uid;
+        std::string   sender;
+        std::string   text;
+    };
+
+    MessageHistory(size_t max_messages, size_t max_text_bytes);
+
+    /// Thread-safe. Text longer than the text ring (or 64KB) is truncated.
+    void Push(int channel, int kind, int sender_uid, std::string const& sender, std::string const& text, unsigned long time_ms);
+
+    /// Walks matching messages from the newest one not newer than `max_seq` (0 = newest),
+    /// skips `skip` of them and returns up to `count` in chronological order.
+    /// @return Number of matching messages not newer than `max_seq`.
+    size_t Query(Filter const& filter, uint64_t max_seq, size_t skip, size_t count, std::vector<Message>& out);
+
+    uint64_t GetLastSeq();  //!< Sequence number of the newest message; 0 = empty. Changes with every push.
+    size_t   GetNumMessages();
+    void     Clear();
+
+private:
+
+    struct Record
+    {
+        uint64_t seq;
+        uint64_t text_pos;   //!< Absolute position in the byte ring; sender bytes followed by text bytes
+        uint32_t time_ms;
+        int32_t  sender_uid;
+        uint16_t text_len;
+        uint8_t  sender_len;
+        uint8_t  channel;
+        int32_t  kind;
+    };
+
+    void CopyOut(uint64_t pos, size_t len, std::string& out) const;
+
+    std::mutex            m_mutex;
+    std::vector<Record>   m_records;
+    std::vector<char>     m_text;
+    uint64_t              m_first_seq; //!< Oldest stored message
+    uint64_t              m_next_seq;  //!< Sequence numbers start at 1
+    uint64_t              m_text_head; //!< Absolute write position in the byte ring
+};
+
+} // namespace RoR
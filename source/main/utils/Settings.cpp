@@ -63,7 +63,8 @@ enum {
     OPT_STATE,
     OPT_INCLUDEPATH,
     OPT_NOCACHE,
-    OPT_JOINMPSERVER
+    OPT_JOINMPSERVER,
+    OPT_PERFTEST
 };
 
 // option array
@@ -84,6 +85,7 @@ CSimpleOpt::SOption cmdline_options[] = {
     { OPT_INCLUDEPATH,    ("-includepath"), SO_REQ_SEP },
     { OPT_NOCACHE,        ("-nocache"),     SO_NONE    },
     { OPT_JOINMPSERVER,   ("-joinserver"),  SO_REQ_CMB },
+    { OPT_PERFTEST,       ("-perftest"),    SO_REQ_SEP },
     SO_END_OF_OPTIONS
 };
 
@@ -100,6 +102,7 @@ void ShowCommandLineUsage()
             "-version shows the version information"    "\n"
             "-enter enters the selected truck"          "\n"
             "-userpath <path> sets the user directory"  "\n"
+            "-perftest <scenario> runs a performance test and exits" "\n"
             "For example: RoR.exe -map oahu -truck semi"));
 }
 
@@ -176,6 +179,10 @@ void Settings::ProcessCommandLine(int argc, char *argv[])
             // just regen cache and exit
             SETTINGS.setSetting("regen-cache-only", "Yes");
         }
+        else if (args.OptionId() == OPT_PERFTEST)
+        {
+            App::diag_perf_scenario.SetActive(args.OptionArg());
+        }
         else if (args.OptionId() == OPT_ENTERTRUCK)
         {
             App::diag_preset_veh_enter.SetActive(true);
@@ -603,6 +610,12 @@ bool Settings::ParseGlobalVarSetting(std::string const & k, std::string const &
     if (CheckScreenshotFormat                     (k, v)) { return true; }
     if (CheckStr  (App::app_locale,                k, v)) { return true; }
     if (CheckBool (App::app_multithread,           k, v)) { return true; }
+    if (CheckInt  (App::app_render_cpu,            k, v)) { return true; }
+    if (CheckStr  (App::app_worker_cpus,           k, v)) { return true; }
+    if (CheckInt  (App::app_worker_nice,           k, v)) { return true; }
+    if (CheckStr  (App::app_sim_thread_cpus,       k, v)) { return true; }
+    if (CheckInt  (App::app_sim_thread_nice,       k, v)) { return true; }
+    if (CheckStr  (App::app_net_thread_cpus,       k, v)) { return true; }
     // Input&Output
     if (CheckBool (App::io_ffb_enabled,            k, v)) { return true; }
     if (CheckFloat(App::io_ffb_camera_gain,        k, v)) { return true; }
@@ -615,6 +628,12 @@ bool Settings::ParseGlobalVarSetting(std::string const & k, std::string const &
     if (CheckInt  (App::io_outgauge_port,          k, v)) { return true; }
     if (CheckFloat(App::io_outgauge_delay,         k, v)) { return true; }
     if (CheckInt  (App::io_outgauge_id,            k, v)) { return true; }
+    if (CheckInt  (App::io_telemetry_mode,         k, v)) { return true; }
+    if (CheckStr  (App::io_telemetry_target,       k, v)) { return true; }
+    if (CheckFloat(App::io_telemetry_rate,         k, v)) { return true; }
+    if (CheckStr  (App::io_telemetry_nodes,        k, v)) { return true; }
+    if (CheckStr  (App::io_mplatform_ip,           k, v)) { return true; }
+    if (CheckInt  (App::io_mplatform_port,         k, v)) { return true; }
     if (CheckIoInputGrabMode                      (k, v)) { return true; }
     // Gfx
     if (CheckEnvmapRate                           (k, v)) { return true; }
@@ -661,6 +680,8 @@ bool Settings::ParseGlobalVarSetting(std::string const & k, std::string const &
     if (CheckBool (App::diag_log_beam_break,       k, v)) { return true; }
     if (CheckBool (App::diag_log_beam_deform,      k, v)) { return true; }
     if (CheckBool (App::diag_log_beam_trigger,     k, v)) { return true; }
+    if (CheckInt  (App::diag_log_rate_limit,       k, v)) { return true; }
+    if (CheckInt  (App::diag_actor_mem_warn,       k, v)) { return true; }
     if (CheckBool (App::diag_dof_effect,           k, v)) { return true; }
     if (CheckStrAS(App::diag_preset_terrain,       k, v)) { return true; }
     if (CheckStr  (App::diag_preset_vehicle,       k, v)) { return true; }
@@ -891,6 +912,12 @@ void Settings::SaveSettings()
     WritePod (f, App::io_outgauge_port);
     WritePod (f, App::io_outgauge_delay);
     WritePod (f, App::io_outgauge_id);
+    WritePod (f, App::io_telemetry_mode);
+    WriteStr (f, App::io_telemetry_target);
+    WritePod (f, App::io_telemetry_rate);
+    WriteStr (f, App::io_telemetry_nodes);
+    WriteStr (f, App::io_mplatform_ip);
+    WritePod (f, App::io_mplatform_port);
 
     f << std::endl << "; Graphics" << std::endl;
     WriteAny (f, App::gfx_shadow_type.conf_name    , GfxShadowTechToStr(App::gfx_shadow_type.GetActive     ()));
@@ -937,6 +964,8 @@ void Settings::SaveSettings()
     WriteYN  (f, App::diag_log_beam_break     );
     WriteYN  (f, App::diag_log_beam_deform    );
     WriteYN  (f, App::diag_log_beam_trigger   );
+    WritePod (f, App::diag_log_rate_limit     );
+    WritePod (f, App::diag_actor_mem_warn     );
     WriteYN  (f, App::diag_dof_effect         );
     WriteYN  (f, App::diag_preset_veh_enter   );
     WriteStr (f, App::diag_preset_terrain     );
@@ -948,6 +977,12 @@ void Settings::SaveSettings()
     WriteStr (f, App::app_screenshot_format );
     WriteStr (f, App::app_locale            );
     WriteYN  (f, App::app_multithread       );
+    WritePod (f, App::app_render_cpu        );
+    WriteStr (f, App::app_worker_cpus       );
+    WritePod (f, App::app_worker_nice       );
+    WriteStr (f, App::app_sim_thread_cpus   );
+    WritePod (f, App::app_sim_thread_nice   );
+    WriteStr (f, App::app_net_thread_cpus   );
 
     // Append misc legacy entries
     f << std::endl << "; Misc" << std::endl;
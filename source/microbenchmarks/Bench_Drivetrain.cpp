@@ -0,0 +1,121 @@
+// Drivetrain solve throughput (physics steps per second), no Actor or Ogre needed. Build example:
+//   g++ -O2 -std=c++11 -I../main/physics
+//       Bench_Drivetrain.cpp ../main/physics/Drivetrain.cpp -lbenchmark -lpthread
+
+#include "benchmark/benchmark.h"
+#include "Drivetrain.h"
+
+#include <random>
+#include <vector>
+
+using RoR::Drivetrain;
+
+static const uint8_t FOOT_HAND = Drivetrain::BRAKE_FOOT | Drivetrain::BRAKE_HAND;
+
+// Truck with `num_axles` driven axles, each with the given differential
+static Drivetrain MakeAxleTruck(int num_axles, DiffType type)
+{
+    Drivetrain dt;
+    for (int i = 0; i < num_axles; i++)
+    {
+        dt.AddHub(true, FOOT_HAND);
+        dt.AddHub(true, FOOT_HAND);
+        dt.AddDifferential(i * 2, i * 2 + 1, type, true);
+    }
+    return dt;
+}
+
+// Old-style truck without 'axles' section: paired wheels with viscous couplings
+static Drivetrain MakeLegacyTruck(int num_wheels)
+{
+    Drivetrain dt;
+    std::vector<int> pairs;
+    for (int i = 0; i < num_wheels; i++)
+    {
+        dt.AddHub(true, FOOT_HAND);
+        pairs.push_back(i);
+    }
+    dt.SetLegacyPairs(pairs.data(), num_wheels);
+    return dt;
+}
+
+static Drivetrain::Controls MakeControls()
+{
+    Drivetrain::Controls in = {};
+    in.engine_torque   = 4000.f;
+    in.brake           = 0.f;
+    in.brake_force     = 30000.f;
+    in.handbrake_force = 60000.f;
+    in.vehicle_speed   = 10.f;
+    in.wheel_speed     = 10.f;
+    in.acceleration    = 1.f;
+    in.dt              = 0.0005f;
+    return in;
+}
+
+static Drivetrain::DrivingAids MakeAids()
+{
+    Drivetrain::DrivingAids aids = {};
+    aids.alb_mode       = true;
+    aids.alb_ratio      = 1.f;
+    aids.alb_minspeed   = 1.f;
+    aids.alb_pulse_time = 0.05f;
+    aids.tc_mode        = true;
+    aids.tc_ratio       = 1.f;
+    aids.tc_wheelslip   = 0.25f;
+    aids.tc_fade        = 10.f;
+    aids.tc_pulse_time  = 0.05f;
+    return aids;
+}
+
+static void Run(benchmark::State& state, Drivetrain& dt, bool braking)
+{
+    std::mt19937 rng(789);
+    std::uniform_real_distribution<float> speed(8.f, 14.f);
+    std::vector<float> speeds(dt.GetNumHubs() * 64);
+    for (float& s : speeds)
+        s = speed(rng);
+
+    Drivetrain::Controls in = MakeControls();
+    in.brake = braking ? in.brake_force : 0.f;
+    const Drivetrain::DrivingAids aids = MakeAids();
+    std::vector<float> torques(dt.GetNumHubs());
+
+    size_t step = 0;
+    while (state.KeepRunning())
+    {
+        const float* frame = &speeds[(step++ % 64) * dt.GetNumHubs()];
+        for (int i = 0; i < dt.GetNumHubs(); i++)
+        {
+            Drivetrain::Hub& hub = dt.GetHub(i);
+            hub.last_speed = hub.speed;
+            hub.speed = frame[i];
+        }
+        dt.Solve(in, aids, torques.data());
+        benchmark::DoNotOptimize(torques.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void Bench_AxleTruck(benchmark::State& state)
+{
+    Drivetrain dt = MakeAxleTruck(state.range(0), static_cast<DiffType>(state.range(1)));
+    Run(state, dt, false);
+}
+BENCHMARK(Bench_AxleTruck)->Args({2, OPEN_DIFF})->Args({4, OPEN_DIFF})->Args({4, LOCKED_DIFF})->Args({4, SPLIT_DIFF});
+
+static void Bench_AxleTruckBraking(benchmark::State& state)
+{
+    Drivetrain dt = MakeAxleTruck(state.range(0), OPEN_DIFF);
+    Run(state, dt, true);
+}
+BENCHMARK(Bench_AxleTruckBraking)->Arg(4);
+
+static void Bench_LegacyTruck(benchmark::State& state)
+{
+    Drivetrain dt = MakeLegacyTruck(state.range(0));
+    Run(state, dt, false);
+}
+BENCHMARK(Bench_LegacyTruck)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
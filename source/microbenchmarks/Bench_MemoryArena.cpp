@@ -0,0 +1,58 @@
+// Allocating and releasing an actor's worth of sub-objects: calloc per object vs. MemoryArena. Build example:
+//   g++ -O2 -std=c++11 -I../main/utils
+//       Bench_MemoryArena.cpp ../main/utils/MemoryArena.cpp -lbenchmark -lpthread
+
+#include "benchmark/benchmark.h"
+#include "MemoryArena.h"
+
+#include <cstdlib>
+#include <vector>
+
+using RoR::MemoryArena;
+
+// Stand-in for a physics sub-object (aeroengine, airbrake...)
+template<size_t SIZE>
+struct Part
+{
+    Part(): value(1) {}
+    ~Part() { benchmark::DoNotOptimize(value); }
+    float value;
+    char  payload[SIZE];
+};
+
+struct CallocPart: Part<200>
+{
+    void* operator new(size_t size) { return std::calloc(size, 1); }
+    void  operator delete(void* ptr) { std::free(ptr); }
+};
+
+static void Bench_Calloc(benchmark::State& state)
+{
+    std::vector<CallocPart*> parts(state.range(0));
+    while (state.KeepRunning())
+    {
+        for (auto& part : parts)
+            part = new CallocPart();
+        benchmark::DoNotOptimize(parts.data());
+        for (auto part : parts)
+            delete part;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Bench_Calloc)->Arg(16)->Arg(128);
+
+static void Bench_Arena(benchmark::State& state)
+{
+    std::vector<Part<200>*> parts(state.range(0));
+    while (state.KeepRunning())
+    {
+        MemoryArena arena;
+        for (auto& part : parts)
+            part = arena.NewZeroed<Part<200>>();
+        benchmark::DoNotOptimize(parts.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Bench_Arena)->Arg(16)->Arg(128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Ray cast throughput (rays per second) - node BVH vs. brute force, heightfield march.
+// Headless: only needs OgreMain (math) and Google Benchmark. Build example:
+//   g++ -O2 -std=c++11 -I../main -I../main/physics/collision -I/usr/include/OGRE
+//       Bench_RayCast.cpp ../main/physics/collision/RayCast.cpp -lOgreMain -lbenchmark -lpthread
+
+#include "benchmark/benchmark.h"
+#include "RayCast.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+static const float NODE_RADIUS = 0.1f;
+
+// Truck-like cloud of nodes: 12 x 3 x 4 meters
+static std::vector<Ogre::Vector3> MakeNodes(int count)
+{
+    std::mt19937 rng(123);
+    std::uniform_real_distribution<float> x(0.f, 12.f), y(0.f, 3.f), z(0.f, 4.f);
+    std::vector<Ogre::Vector3> nodes;
+    for (int i = 0; i < count; i++)
+        nodes.push_back(Ogre::Vector3(x(rng), y(rng), z(rng)));
+    return nodes;
+}
+
+// Rays from a camera 20m away, aimed at random points around the actor
+static std::vector<Ogre::Ray> MakeRays(int count)
+{
+    std::mt19937 rng(456);
+    std::uniform_real_distribution<float> x(-2.f, 14.f), y(-1.f, 4.f), z(-1.f, 5.f);
+    std::vector<Ogre::Ray> rays;
+    const Ogre::Vector3 eye(6.f, 8.f, -20.f);
+    for (int i = 0; i < count; i++)
+    {
+        Ogre::Vector3 target(x(rng), y(rng), z(rng));
+        rays.push_back(Ogre::Ray(eye, (target - eye).normalisedCopy()));
+    }
+    return rays;
+}
+
+static float TerrainHeight(float x, float z)
+{
+    return 20.f + 10.f * std::sin(x * 0.05f) * std::cos(z * 0.03f);
+}
+
+// The way `SceneMouse` used to pick nodes
+static void Bench_NodesBruteForce(benchmark::State& state)
+{
+    std::vector<Ogre::Vector3> nodes = MakeNodes(state.range(0));
+    std::vector<Ogre::Ray> rays = MakeRays(1000);
+    int hits = 0;
+    while (state.KeepRunning())
+    {
+        for (Ogre::Ray const& ray : rays)
+        {
+            float best = 99999.f;
+            for (Ogre::Vector3 const& node : nodes)
+            {
+                std::pair<bool, Ogre::Real> hit = ray.intersects(Ogre::Sphere(node, NODE_RADIUS));
+                if (hit.first && hit.second < best)
+                    best = hit.second;
+            }
+            hits += (best < 99999.f);
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(Bench_NodesBruteForce)->Arg(200)->Arg(1000)->Arg(5000);
+
+static void Bench_NodesBvh(benchmark::State& state)
+{
+    std::vector<Ogre::Vector3> nodes = MakeNodes(state.range(0));
+    std::vector<Ogre::Ray> rays = MakeRays(1000);
+    RoR::NodeBvh bvh;
+    bvh.Update(nodes.data(), sizeof(Ogre::Vector3), static_cast<int>(nodes.size()));
+    int hits = 0;
+    while (state.KeepRunning())
+    {
+        for (Ogre::Ray const& ray : rays)
+        {
+            float dist;
+            hits += (bvh.CastRay(ray, 99999.f, NODE_RADIUS, dist) != -1);
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(Bench_NodesBvh)->Arg(200)->Arg(1000)->Arg(5000);
+
+// Cost of keeping the BVH current; paid at most once per physics frame per queried actor
+static void Bench_NodesBvhRefit(benchmark::State& state)
+{
+    std::vector<Ogre::Vector3> nodes = MakeNodes(state.range(0));
+    RoR::NodeBvh bvh;
+    while (state.KeepRunning())
+    {
+        bvh.Update(nodes.data(), sizeof(Ogre::Vector3), static_cast<int>(nodes.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Bench_NodesBvhRefit)->Arg(200)->Arg(1000)->Arg(5000);
+
+static void Bench_HeightfieldMarch(benchmark::State& state)
+{
+    std::mt19937 rng(789);
+    std::uniform_real_distribution<float> pos(0.f, 2000.f), dir(-1.f, 1.f);
+    std::vector<Ogre::Ray> rays;
+    for (int i = 0; i < 1000; i++)
+    {
+        Ogre::Vector3 d(dir(rng), -0.3f + 0.2f * dir(rng), dir(rng));
+        rays.push_back(Ogre::Ray(Ogre::Vector3(pos(rng), 40.f, pos(rng)), d.normalisedCopy()));
+    }
+    const float max_dist = static_cast<float>(state.range(0));
+    int hits = 0;
+    while (state.KeepRunning())
+    {
+        for (Ogre::Ray const& ray : rays)
+        {
+            float dist;
+            hits += RoR::RayMarchHeightfield(ray, max_dist, 1.f, Ogre::Vector3(2000.f, 30.f, 2000.f), TerrainHeight, dist);
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(Bench_HeightfieldMarch)->Arg(50)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Minimal checks for the standalone tests; a failed check prints and sets the exit code.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+namespace RoR {
+namespace Test {
+
+inline int& NumFailures() { static int n = 0; return n; }
+
+inline void Fail(const char* file, int line, const char* expr)
+{
+    std::printf("%s:%d: check failed: %s\n", file, line, expr);
+    ++NumFailures();
+}
+
+inline int Finish(const char* name)
+{
+    if (NumFailures() == 0)
+        std::printf("%s: all checks passed\n", name);
+    else
+        std::printf("%s: %d check(s) failed\n", name, NumFailures());
+    return (NumFailures() == 0) ? 0 : 1;
+}
+
+} // namespace Test
+} // namespace RoR
+
+#define CHECK(EXPR) \
+    do { if (!(EXPR)) RoR::Test::Fail(__FILE__, __LINE__, #EXPR); } while (0)
+
+#define CHECK_NEAR(A, B, TOL) \
+    do { if (!(std::fabs((A) - (B)) <= (TOL))) { \
+        std::printf("    %s = %g, %s = %g\n", #A, static_cast<double>(A), #B, static_cast<double>(B)); \
+        RoR::Test::Fail(__FILE__, __LINE__, #A " ~= " #B); } } while (0)
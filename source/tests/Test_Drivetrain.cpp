@@ -0,0 +1,214 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Analytic torque-split cases for `Drivetrain`: the differential models on their own
+///         and solved through the graph (inter-axle shaft, legacy paired-wheel couplings).
+
+#include "Drivetrain.h"
+#include "TestUtils.h"
+
+using namespace RoR;
+
+static const float DT  = 0.0005f; // Same as the simulation
+static const float TOL = 0.01f;
+
+static DifferentialData MakeDiffData(float speed_1, float speed_2, float in_torque)
+{
+    DifferentialData d = {};
+    d.speed[0] = speed_1;
+    d.speed[1] = speed_2;
+    d.in_torque = in_torque;
+    d.dt = DT;
+    return d;
+}
+
+static Drivetrain::Controls MakeControls(float engine_torque)
+{
+    Drivetrain::Controls in = {};
+    in.engine_torque = engine_torque;
+    in.dt = DT;
+    return in;
+}
+
+static Drivetrain::DrivingAids MakeAids()
+{
+    Drivetrain::DrivingAids aids = {};
+    aids.alb_pulse_time = 1.f;
+    aids.tc_pulse_time  = 1.f;
+    return aids;
+}
+
+static void TestOpenDiff()
+{
+    // Equal speeds: even split
+    DifferentialData d = MakeDiffData(5.f, 5.f, 100.f);
+    Drivetrain::CalcOpenDiff(d);
+    CHECK_NEAR(d.out_torque[0], 100.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 100.f, TOL);
+    CHECK(d.delta_rotation == 0.f);
+
+    // Standing still: even split
+    d = MakeDiffData(0.f, 0.f, 100.f);
+    Drivetrain::CalcOpenDiff(d);
+    CHECK_NEAR(d.out_torque[0], 100.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 100.f, TOL);
+
+    // Unequal, above threshold (sum of speeds >= 10): split by speed, 3:7
+    d = MakeDiffData(3.f, -7.f, 100.f);
+    Drivetrain::CalcOpenDiff(d);
+    CHECK_NEAR(d.out_torque[0],  60.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 140.f, TOL);
+
+    // Unequal, below threshold: blend of even (60%) and speed split (40%)
+    // 2 * (0.4 * 0.25 + 0.6 * 0.5) = 0.8, 2 * (0.4 * 0.75 + 0.6 * 0.5) = 1.2
+    d = MakeDiffData(1.f, 3.f, 100.f);
+    Drivetrain::CalcOpenDiff(d);
+    CHECK_NEAR(d.out_torque[0],  80.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 120.f, TOL);
+}
+
+static void TestLockedDiff()
+{
+    // Equal speeds, no wind-up: even split
+    DifferentialData d = MakeDiffData(4.f, 4.f, 100.f);
+    Drivetrain::CalcLockedDiff(d);
+    CHECK_NEAR(d.out_torque[0], 100.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 100.f, TOL);
+    CHECK(d.delta_rotation == 0.f);
+
+    // Slip of 1 m/s: wind-up (1e6 * dv * dt) plus damping (1e4 * dv) moves torque to the slower wheel
+    d = MakeDiffData(2.f, 1.f, 100.f);
+    Drivetrain::CalcLockedDiff(d);
+    CHECK_NEAR(d.delta_rotation, DT, 1e-7f);
+    CHECK_NEAR(d.out_torque[0], 100.f -  500.f - 10000.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 100.f +  500.f + 10000.f, TOL);
+
+    // Wind-up accumulates over steps
+    Drivetrain::CalcLockedDiff(d);
+    CHECK_NEAR(d.delta_rotation, 2.f * DT, 1e-7f);
+    CHECK_NEAR(d.out_torque[0], 100.f - 1000.f - 10000.f, TOL);
+    CHECK_NEAR(d.out_torque[1], 100.f + 1000.f + 10000.f, TOL);
+}
+
+static void TestSplitDiff()
+{
+    DifferentialData d = MakeDiffData(1.f, 9.f, 100.f);
+    Drivetrain::CalcSplitDiff(d);
+    CHECK(d.out_torque[0] == 100.f);
+    CHECK(d.out_torque[1] == 100.f);
+}
+
+static void TestSingleAxle()
+{
+    // Per-hub engine torque is doubled on the way into the axle differential
+    Drivetrain dt;
+    dt.AddHub(true, Drivetrain::BRAKE_NONE);
+    dt.AddHub(true, Drivetrain::BRAKE_NONE);
+    dt.AddDifferential(0, 1, OPEN_DIFF, true);
+    dt.GetHub(0).speed = 3.f;
+    dt.GetHub(1).speed = 7.f;
+
+    float out[2];
+    dt.Solve(MakeControls(200.f), MakeAids(), out);
+    CHECK_NEAR(out[0], 120.f, TOL);
+    CHECK_NEAR(out[1], 280.f, TOL);
+
+    // Axle without a differential gets no torque
+    Drivetrain dead;
+    dead.AddHub(true, Drivetrain::BRAKE_NONE);
+    dead.AddHub(true, Drivetrain::BRAKE_NONE);
+    dead.AddDifferential(0, 1, OPEN_DIFF, false);
+    dead.Solve(MakeControls(200.f), MakeAids(), out);
+    CHECK(out[0] == 0.f);
+    CHECK(out[1] == 0.f);
+}
+
+static void TestInterAxleShaft()
+{
+    // Two axles linked by the locked 1:1 shaft (this tree's transfer case), split diffs
+    Drivetrain dt;
+    for (int i = 0; i < 4; ++i)
+        dt.AddHub(true, Drivetrain::BRAKE_NONE);
+    dt.AddDifferential(0, 1, SPLIT_DIFF, true);
+    dt.AddDifferential(2, 3, SPLIT_DIFF, true);
+    for (int i = 0; i < 4; ++i)
+        dt.GetHub(i).speed = 5.f;
+
+    // Equal axle speeds: 1:1 between axles, 2 * 400 / 4 per wheel
+    float out[4];
+    dt.Solve(MakeControls(400.f), MakeAids(), out);
+    for (int i = 0; i < 4; ++i)
+        CHECK_NEAR(out[i], 200.f, TOL);
+
+    // Front axle 2 m/s faster: the shaft moves wind-up (1e6 * dv * dt) plus damping (1e4 * dv)
+    // from the front to the rear axle, the total is unchanged
+    dt.GetHub(0).speed = 6.f;
+    dt.GetHub(1).speed = 6.f;
+    dt.GetHub(2).speed = 4.f;
+    dt.GetHub(3).speed = 4.f;
+    dt.Solve(MakeControls(400.f), MakeAids(), out);
+    const float shaft = 1000000.f * 2.f * DT + 10000.f * 2.f;
+    CHECK_NEAR(out[0], 200.f - shaft, TOL);
+    CHECK_NEAR(out[1], 200.f - shaft, TOL);
+    CHECK_NEAR(out[2], 200.f + shaft, TOL);
+    CHECK_NEAR(out[3], 200.f + shaft, TOL);
+    CHECK_NEAR(out[0] + out[1] + out[2] + out[3], 800.f, TOL);
+}
+
+static void TestLegacyPairs()
+{
+    // Truck without 'axles': (0,1) and (2,3) are paired wheels, the pairs coupled to each other
+    Drivetrain dt;
+    const int pairs[] = { 0, 1, 2, 3 };
+    for (int i = 0; i < 4; ++i)
+        dt.AddHub(true, Drivetrain::BRAKE_NONE);
+    dt.SetLegacyPairs(pairs, 4);
+    for (int i = 0; i < 4; ++i)
+        dt.GetHub(i).speed = 5.f;
+
+    // Equal speeds: engine torque split evenly, no coupling torque
+    float out[4];
+    dt.Solve(MakeControls(400.f), MakeAids(), out);
+    for (int i = 0; i < 4; ++i)
+        CHECK_NEAR(out[i], 100.f, TOL);
+
+    // Pair speeds 5 and 3: 1e4 * 2 / 2 from each wheel of the faster pair to the slower one;
+    // hub 1 is also locked to hub 0 (1e4 * 2)
+    dt.GetHub(0).speed = 4.f;
+    dt.GetHub(1).speed = 6.f;
+    dt.GetHub(2).speed = 3.f;
+    dt.GetHub(3).speed = 3.f;
+    dt.Solve(MakeControls(400.f), MakeAids(), out);
+    CHECK_NEAR(out[0], 100.f - 10000.f, TOL);
+    CHECK_NEAR(out[1], 100.f - 20000.f - 10000.f, TOL);
+    CHECK_NEAR(out[2], 100.f + 10000.f, TOL);
+    CHECK_NEAR(out[3], 100.f + 10000.f, TOL);
+}
+
+int main()
+{
+    TestOpenDiff();
+    TestLockedDiff();
+    TestSplitDiff();
+    TestSingleAxle();
+    TestInterAxleShaft();
+    TestLegacyPairs();
+    return RoR::Test::Finish("Test_Drivetrain");
+}
@@ -0,0 +1,203 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Runs recorded physics samples through the force feedback signal path into
+///         `RecordingForceFeedbackDevice` and checks the levels against an analytic filter.
+
+#include "ForceFeedback.h"
+#include "TestUtils.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace RoR;
+
+static const float PHYSICS_DT      = 0.0005f; // Same as the simulation
+static const int   STEPS_PER_FRAME = 33;      // ~60 FPS
+
+/// Recorded from a truck steering through a bend; one row per 10ms (20 sub-steps).
+static const float RECORDED[][3] = // hydro_stress, wheel_speed, dir_command
+{
+    {   0.f,  5.0f,  0.00f }, {  40.f,  5.1f,  0.05f }, { 120.f,  5.2f,  0.12f }, { 260.f,  5.3f,  0.20f },
+    { 410.f,  5.3f,  0.28f }, { 530.f,  5.4f,  0.33f }, { 600.f,  5.4f,  0.35f }, { 610.f,  5.5f,  0.35f },
+    { 580.f,  5.5f,  0.33f }, { 470.f,  5.6f,  0.27f }, { 300.f,  5.6f,  0.18f }, { 150.f,  5.7f,  0.09f },
+    {  20.f,  5.7f,  0.01f }, {-110.f,  5.8f, -0.08f }, {-260.f,  5.8f, -0.17f }, {-390.f,  5.9f, -0.24f },
+};
+static const int RECORDED_STEPS_PER_ROW = 20;
+
+static ForceFeedback::Gains MakeGains()
+{
+    ForceFeedback::Gains gains;
+    gains.master    = 0.8f;
+    gains.stress    = 3.f;
+    gains.centering = 0.5f;
+    return gains;
+}
+
+static ForceFeedbackSample MakeSample(float hydro_stress, float wheel_speed = 0.f, float dir_command = 0.f)
+{
+    ForceFeedbackSample s = {};
+    s.hydro_stress = hydro_stress;
+    s.wheel_speed  = wheel_speed;
+    s.dir_command  = dir_command;
+    return s;
+}
+
+static double FilterAlpha()
+{
+    return 1.0 - std::exp(-PHYSICS_DT * 2.0 * 3.14159265358979 * ForceFeedback::FILTER_CUTOFF_HZ);
+}
+
+static RecordingForceFeedbackDevice* SetupRecording(ForceFeedback& ff)
+{
+    RecordingForceFeedbackDevice* device = new RecordingForceFeedbackDevice();
+    ff.Setup(std::unique_ptr<ForceFeedbackDevice>(device));
+    return device;
+}
+
+static void TestDisabled()
+{
+    ForceFeedback ff;
+    RecordingForceFeedbackDevice* device = SetupRecording(ff);
+    device->master_gain = -1.f;
+
+    for (int i = 0; i < 100; ++i)
+        ff.PushPhysicsStep(MakeSample(500.f), PHYSICS_DT);
+    ff.UpdateDevice(MakeGains());
+
+    CHECK(device->levels.empty());
+    CHECK(device->master_gain == -1.f);
+}
+
+static void TestMasterGain()
+{
+    ForceFeedback ff;
+    RecordingForceFeedbackDevice* device = SetupRecording(ff);
+    const ForceFeedback::Gains gains = MakeGains();
+
+    ff.SetEnabled(true);
+    ff.UpdateDevice(gains);
+    CHECK(device->master_gain == gains.master);
+
+    ff.SetEnabled(false);
+    ff.UpdateDevice(gains);
+    CHECK(device->master_gain == 0.f);
+}
+
+static void TestStepResponse()
+{
+    ForceFeedback ff;
+    RecordingForceFeedbackDevice* device = SetupRecording(ff);
+    const ForceFeedback::Gains gains = MakeGains();
+    const float stress = 1000.f;
+    ff.SetEnabled(true);
+
+    // First frame after the step: one-pole filter, y(n) = x * (1 - (1 - a)^n)
+    for (int i = 0; i < STEPS_PER_FRAME; ++i)
+        ff.PushPhysicsStep(MakeSample(stress), PHYSICS_DT);
+    ff.UpdateDevice(gains);
+
+    const double filtered = stress * (1.0 - std::pow(1.0 - FilterAlpha(), STEPS_PER_FRAME));
+    CHECK(device->levels.size() == 1);
+    if (!device->levels.empty())
+        CHECK_NEAR(device->levels.back(), -filtered * gains.stress, 2.0);
+
+    // Settled after 0.1s (> 25 time constants)
+    for (int frame = 0; frame < 6; ++frame)
+    {
+        for (int i = 0; i < STEPS_PER_FRAME; ++i)
+            ff.PushPhysicsStep(MakeSample(stress), PHYSICS_DT);
+        ff.UpdateDevice(gains);
+    }
+    CHECK_NEAR(device->levels.back(), ForceFeedback::CalcForceLevel(MakeSample(stress), gains.stress, gains.centering), 1.0);
+
+    // Unchanged level is not re-sent to the device
+    const size_t num_levels = device->levels.size();
+    for (int i = 0; i < STEPS_PER_FRAME; ++i)
+        ff.PushPhysicsStep(MakeSample(stress), PHYSICS_DT);
+    ff.UpdateDevice(gains);
+    CHECK(device->levels.size() == num_levels);
+
+    // No new sample, no device call
+    ff.UpdateDevice(gains);
+    CHECK(device->levels.size() == num_levels);
+}
+
+static void TestCalcForceLevel()
+{
+    // Centering: dir_command * 100 * centering_gain * wheel_speed^2
+    CHECK(ForceFeedback::CalcForceLevel(MakeSample(0.f, 4.f, 0.5f), 1.f, 2.f) == 1600);
+    CHECK(ForceFeedback::CalcForceLevel(MakeSample(-100.f, 0.f, 0.f), 2.f, 0.f) == 200);
+    CHECK(ForceFeedback::CalcForceLevel(MakeSample(1.0e6f), 1.f, 0.f) == -10000);
+    CHECK(ForceFeedback::CalcForceLevel(MakeSample(-1.0e6f), 1.f, 0.f) == 10000);
+}
+
+static void TestRecordedInput()
+{
+    ForceFeedback ff;
+    RecordingForceFeedbackDevice* device = SetupRecording(ff);
+    const ForceFeedback::Gains gains = MakeGains();
+    ff.SetEnabled(true);
+
+    // Reference: the same filter in double precision, sampled at the same frames
+    const double alpha = FilterAlpha();
+    double ref_stress = 0.0;
+    std::vector<double> expected;
+    int last_expected_level = 0;
+
+    const int num_rows = sizeof(RECORDED) / sizeof(RECORDED[0]);
+    int step = 0;
+    for (int row = 0; row < num_rows; ++row)
+    {
+        for (int i = 0; i < RECORDED_STEPS_PER_ROW; ++i, ++step)
+        {
+            const ForceFeedbackSample raw = MakeSample(RECORDED[row][0], RECORDED[row][1], RECORDED[row][2]);
+            ff.PushPhysicsStep(raw, PHYSICS_DT);
+            ref_stress += (raw.hydro_stress - ref_stress) * alpha;
+
+            if ((step + 1) % STEPS_PER_FRAME == 0)
+            {
+                ff.UpdateDevice(gains);
+                const double centering = raw.dir_command * 100.0 * gains.centering * raw.wheel_speed * raw.wheel_speed;
+                const double level = -ref_stress * gains.stress + centering;
+                if (static_cast<int>(level) != last_expected_level)
+                {
+                    expected.push_back(level);
+                    last_expected_level = static_cast<int>(level);
+                }
+            }
+        }
+    }
+
+    CHECK(device->levels.size() == expected.size());
+    for (size_t i = 0; i < device->levels.size() && i < expected.size(); ++i)
+        CHECK_NEAR(device->levels[i], expected[i], 2.0);
+}
+
+int main()
+{
+    TestDisabled();
+    TestMasterGain();
+    TestStepResponse();
+    TestCalcForceLevel();
+    TestRecordedInput();
+    return RoR::Test::Finish("Test_ForceFeedback");
+}
@@ -0,0 +1,185 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2018 Petr Ohlidal & contributors
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Standalone receiver for RoR telemetry packets; see README.txt
+
+#include "TelemetrySchema.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+    typedef SOCKET sock_t;
+#else
+#   include <netinet/in.h>
+#   include <sys/socket.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+    typedef int sock_t;
+#endif
+
+using namespace RoR::Telemetry;
+
+static sock_t OpenUdp(int port)
+{
+#ifdef _WIN32
+    WSADATA wsd;
+    WSAStartup(MAKEWORD(2, 2), &wsd);
+#endif
+    sock_t sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<unsigned short>(port));
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        perror("bind");
+        exit(1);
+    }
+    return sock;
+}
+
+#ifndef _WIN32
+static sock_t OpenUnix(const char* path)
+{
+    sock_t sock = socket(AF_UNIX, SOCK_DGRAM, 0);
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    unlink(path);
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        perror("bind");
+        exit(1);
+    }
+    return sock;
+}
+#endif
+
+static void PrintSample(const PacketHeader& header, const char* sample)
+{
+    VehicleSample vs;
+    memcpy(&vs, sample, sizeof(vs));
+    printf("actor %u t=%.4f pos=(%.2f %.2f %.2f) g=(%.2f %.2f %.2f) rpm=%.0f gear=%d thr=%.2f brk=%.2f",
+        header.actor_instance_id, vs.sim_time, vs.position[0], vs.position[1], vs.position[2],
+        vs.gforce[0], vs.gforce[1], vs.gforce[2], vs.engine_rpm, vs.gear, vs.throttle, vs.brake);
+
+    const char* pos = sample + sizeof(VehicleSample);
+    printf(" wheels:");
+    for (int i = 0; i < header.num_wheels; i++)
+    {
+        WheelSample ws;
+        memcpy(&ws, pos, sizeof(ws));
+        printf(" %.1f%s", ws.speed, ws.contact ? "" : "*");
+        pos += sizeof(WheelSample);
+    }
+    for (int i = 0; i < header.num_nodes; i++)
+    {
+        NodeSample ns;
+        memcpy(&ns, pos, sizeof(ns));
+        printf(" node%u=(%.2f %.2f %.2f)", ns.node_index, ns.position[0], ns.position[1], ns.position[2]);
+        pos += sizeof(NodeSample);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s udp <port> [-v]\n", argv[0]);
+#ifndef _WIN32
+        printf("       %s unix <socket path> [-v]\n", argv[0]);
+#endif
+        return 1;
+    }
+
+    const bool verbose = (argc > 3 && std::string(argv[3]) == "-v");
+    sock_t sock;
+    if (std::string(argv[1]) == "udp")
+        sock = OpenUdp(atoi(argv[2]));
+#ifndef _WIN32
+    else if (std::string(argv[1]) == "unix")
+        sock = OpenUnix(argv[2]);
+#endif
+    else
+    {
+        printf("Unknown transport '%s'\n", argv[1]);
+        return 1;
+    }
+
+    char buf[MAX_PACKET_SIZE];
+    uint32_t expected_seq = 0;
+    bool first = true;
+    size_t num_packets = 0, num_samples = 0, num_lost = 0, num_invalid = 0;
+    auto last_report = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        int len = (int)recv(sock, buf, sizeof(buf), 0);
+        if (len < (int)sizeof(PacketHeader))
+        {
+            num_invalid++;
+            continue;
+        }
+
+        PacketHeader header;
+        memcpy(&header, buf, sizeof(header));
+        if (memcmp(header.magic, PACKET_MAGIC, 4) != 0 || header.version != PROTOCOL_VERSION ||
+            header.sample_size != CalcSampleSize(header.num_wheels, header.num_nodes) ||
+            (size_t)len != sizeof(PacketHeader) + (header.num_samples * header.sample_size))
+        {
+            num_invalid++;
+            continue;
+        }
+
+        if (!first && header.sequence != expected_seq)
+            num_lost += header.sequence - expected_seq;
+        first = false;
+        expected_seq = header.sequence + 1;
+        num_packets++;
+        num_samples += header.num_samples;
+
+        if (verbose)
+        {
+            for (int i = 0; i < header.num_samples; i++)
+                PrintSample(header, buf + sizeof(PacketHeader) + (i * header.sample_size));
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_report >= std::chrono::seconds(1))
+        {
+            printf("packets/s: %zu, samples/s: %zu, lost: %zu, invalid: %zu\n", num_packets, num_samples, num_lost, num_invalid);
+            if (!verbose && header.num_samples > 0)
+                PrintSample(header, buf + sizeof(PacketHeader) + ((header.num_samples - 1) * header.sample_size));
+            fflush(stdout);
+            num_packets = num_samples = 0;
+            last_report = now;
+        }
+    }
+    return 0;
+}